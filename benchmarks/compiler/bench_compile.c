@@ -0,0 +1,203 @@
+/*
+ * Forge Benchmarks - Compile Throughput
+ *
+ * Generates a synthetic component whose @template holds 100 - 10k element
+ * nodes and times each compiler phase over it:
+ *
+ *   parse     lexer + parser (the parser drives the lexer's template modes,
+ *             so the two are timed together)
+ *   analyze   analyze_program
+ *   codegen   codegen_component, C for the wasm build
+ *   bindings  binding_gen_component, the no-wasm JS renderer
+ *
+ * Generated output goes to /dev/null, so the numbers exclude disk writes.
+ * Each phase reports the median of several runs.
+ *
+ * Build and run with `make bench`; `--json` prints the results as JSON.
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime */
+
+#include "../../compiler/src/analyzer.h"
+#include "../../compiler/src/binding_gen.h"
+#include "../../compiler/src/codegen.h"
+#include "../../compiler/src/lexer.h"
+#include "../../compiler/src/parser.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RUNS 7
+
+enum { PH_PARSE, PH_ANALYZE, PH_CODEGEN, PH_BINDINGS, PH_COUNT };
+
+static const char *PHASE_NAMES[PH_COUNT] = { "parse", "analyze", "codegen", "bindings" };
+
+static const int SIZES[] = { 100, 1000, 10000 };
+#define SIZE_COUNT (int)(sizeof(SIZES) / sizeof(SIZES[0]))
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+/* ─── Synthetic Source ────────────────────────────────────────────────────── */
+
+typedef struct {
+    char  *data;
+    size_t len;
+    size_t cap;
+} Buf;
+
+static void put(Buf *b, const char *s) {
+    size_t n = strlen(s);
+    if (b->len + n + 1 > b->cap) {
+        b->cap  = (b->len + n + 1) * 2;
+        b->data = realloc(b->data, b->cap);
+        if (!b->data) { perror("bench_compile"); exit(1); }
+    }
+    memcpy(b->data + b->len, s, n + 1);
+    b->len += n;
+}
+
+/* A row is 4 elements with a text binding, an attribute binding and an
+ * event; every 10 rows share a section, so nesting stays a few levels
+ * deep the way real templates are */
+static const char ROW[] =
+    "        <div class=\"row\">\n"
+    "          <span class=\"count\">{state.count}</span>\n"
+    "          <button class={state.active ? \"on\" : \"off\"} onclick={@toggle}>Toggle</button>\n"
+    "          <p>{state.label}</p>\n"
+    "        </div>\n";
+#define ROW_NODES 4
+
+/* Rows that bring main + sections + rows closest to `nodes` */
+static int rows_for(int nodes) {
+    int rows = (nodes - 1) * 10 / (ROW_NODES * 10 + 1);
+    return rows < 1 ? 1 : rows;
+}
+
+static int node_count(int rows) {
+    return 1 + (rows + 9) / 10 + rows * ROW_NODES;
+}
+
+static char *make_source(int nodes, size_t *len) {
+    Buf b = { 0 };
+    put(&b,
+        "#include <forge/web.h>\n\n"
+        "@component Bench {\n"
+        "  @state {\n"
+        "    int  count  = 0;\n"
+        "    int  active = 0;\n"
+        "    char label[32];\n"
+        "  }\n\n"
+        "  @style {\n"
+        "    display: block;\n"
+        "    color:   {state.active ? \"#111\" : \"#999\"};\n"
+        "  }\n\n"
+        "  @on(toggle) {\n"
+        "    state.active = !state.active;\n"
+        "    state.count++;\n"
+        "  }\n\n"
+        "  @template {\n"
+        "    <main class=\"bench\">\n");
+    int rows = rows_for(nodes);
+    for (int r = 0; r < rows; r++) {
+        if (r % 10 == 0) put(&b, "      <section>\n");
+        put(&b, ROW);
+        if (r % 10 == 9 || r == rows - 1) put(&b, "      </section>\n");
+    }
+    put(&b, "    </main>\n  }\n}\n");
+    *len = b.len;
+    return b.data;
+}
+
+/* ─── Harness ─────────────────────────────────────────────────────────────── */
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+/* One pass of every phase; 0 on success */
+static int compile_once(const char *src, FILE *sink, double *ms) {
+    double t0 = now_ms();
+    Lexer lex;
+    lexer_init(&lex, src, "bench.cx");
+    Parser parser;
+    parser_init(&parser, &lex);
+    Program *prog = parser_parse(&parser);
+    ms[PH_PARSE] = now_ms() - t0;
+    if (parser_error_count(&parser) > 0 || prog->component_count != 1) {
+        ast_free_program(prog);
+        return 1;
+    }
+
+    t0 = now_ms();
+    AnalysisResult ar = analyze_program(prog);
+    ms[PH_ANALYZE] = now_ms() - t0;
+    if (ar.error_count > 0) {
+        ast_free_program(prog);
+        return 1;
+    }
+
+    CodegenOptions cg_opts = { 0 };
+    t0 = now_ms();
+    codegen_component(prog->components[0], &cg_opts, sink);
+    ms[PH_CODEGEN] = now_ms() - t0;
+
+    BindingOptions b_opts = { .web_component = 1, .no_wasm = 1 };
+    t0 = now_ms();
+    binding_gen_component(prog->components[0], &b_opts, sink);
+    ms[PH_BINDINGS] = now_ms() - t0;
+
+    ast_free_program(prog);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int json = argc > 1 && strcmp(argv[1], "--json") == 0;
+    FILE *sink = fopen("/dev/null", "w");
+    if (!sink) { perror("bench_compile: /dev/null"); return 1; }
+
+    if (json) printf("{\n  \"suite\": \"compile\",\n  \"results\": [");
+    else printf("%6s %8s %10s %10s %10s %10s %10s\n",
+                "nodes", "bytes", "parse ms", "analyze", "codegen", "bindings", "MB/s");
+
+    for (int k = 0; k < SIZE_COUNT; k++) {
+        size_t len;
+        char  *src = make_source(SIZES[k], &len);
+        double runs[PH_COUNT][RUNS], med[PH_COUNT], total = 0;
+
+        for (int r = 0; r < RUNS; r++) {
+            double ms[PH_COUNT];
+            if (compile_once(src, sink, ms) != 0) {
+                fprintf(stderr, "bench_compile: synthetic source failed to compile\n");
+                return 1;
+            }
+            for (int p = 0; p < PH_COUNT; p++) runs[p][r] = ms[p];
+        }
+        for (int p = 0; p < PH_COUNT; p++) {
+            qsort(runs[p], RUNS, sizeof(double), cmp_double);
+            med[p] = runs[p][RUNS / 2];
+            total += med[p];
+        }
+        double mbps = total > 0 ? (double)len / 1e3 / total : 0;
+
+        if (json) {
+            printf("%s\n    {\"nodes\": %d, \"bytes\": %zu", k ? "," : "", node_count(rows_for(SIZES[k])), len);
+            for (int p = 0; p < PH_COUNT; p++) printf(", \"%s_ms\": %.3f", PHASE_NAMES[p], med[p]);
+            printf(", \"total_ms\": %.3f, \"mb_per_s\": %.1f}", total, mbps);
+        } else {
+            printf("%6d %8zu %10.3f %10.3f %10.3f %10.3f %10.1f\n", node_count(rows_for(SIZES[k])), len,
+                   med[PH_PARSE], med[PH_ANALYZE], med[PH_CODEGEN], med[PH_BINDINGS], mbps);
+        }
+        free(src);
+    }
+    if (json) printf("\n  ]\n}\n");
+    fclose(sink);
+    return 0;
+}
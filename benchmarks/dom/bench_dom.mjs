@@ -0,0 +1,165 @@
+/*
+ * Forge Benchmarks - DOM Update Paths
+ *
+ * js-framework-benchmark style operations on rows of the todo app's
+ * <forge-todo-item>, run headlessly on dom-shim.mjs:
+ *
+ *   create_N   mount N rows into an empty list
+ *   update_N   change the text of every 10th row
+ *   swap_N     swap rows 1 and N - 2
+ *   clear_N    remove every row
+ *
+ * for N = 1000 and 10000.  Each operation is timed from the first DOM call
+ * until the runtime is idle again (microtasks and frames drained), and the
+ * median of several runs is reported.
+ *
+ * USAGE:
+ *   node benchmarks/dom/bench_dom.mjs <dist dir> [--json]
+ *
+ * The dist dir holds TodoItem.forge.js from `forge compile`, with or without
+ * --no-wasm.  WASM builds also need TodoItem.wasm and forge-runtime.js next
+ * to it; without the .wasm the suite reports itself skipped.
+ */
+
+import { settle, document } from './dom-shim.mjs';
+import fs from 'node:fs';
+import path from 'node:path';
+import { pathToFileURL } from 'node:url';
+
+const args = process.argv.slice(2);
+const json = args.includes('--json');
+const dist = path.resolve(args.find((a) => !a.startsWith('--')) || 'dist');
+const RUNS = 5;
+const SIZES = [1000, 10000];
+
+const entry = path.join(dist, 'TodoItem.forge.js');
+const variant = fs.existsSync(entry) && fs.readFileSync(entry, 'utf8').includes('no-wasm mode')
+  ? 'no-wasm' : 'wasm';
+
+function emit(result) {
+  if (json) {
+    console.log(JSON.stringify({ suite: 'dom', variant, ...result }, null, 2));
+  } else if (result.skipped) {
+    console.log(`dom (${variant}): skipped, ${result.skipped}`);
+  } else {
+    console.log(`dom (${variant})`);
+    for (const r of result.results) console.log(`  ${r.name.padEnd(12)} ${r.ms.toFixed(2).padStart(9)} ms`);
+  }
+}
+
+if (!fs.existsSync(entry)) {
+  emit({ skipped: `no ${entry}` });
+  process.exit(0);
+}
+if (variant === 'wasm' && !fs.existsSync(path.join(dist, 'TodoItem.wasm'))) {
+  emit({ skipped: 'no TodoItem.wasm (needs clang with the wasm32 target)' });
+  process.exit(0);
+}
+
+/* loadWasm fetches next to the module; serve file: URLs from disk */
+const netFetch = globalThis.fetch;
+globalThis.fetch = async (url, init) => {
+  const u = String(url);
+  if (!u.startsWith('file:')) return netFetch(url, init);
+  const bytes = fs.readFileSync(new URL(u));
+  return new Response(bytes, { headers: { 'Content-Type': 'application/wasm' } });
+};
+
+const mod = await import(pathToFileURL(entry).href);
+const TodoItem = mod.TodoItem;
+if (TodoItem.wasmReady) await TodoItem.wasmReady;
+
+/* ─── Operations ─────────────────────────────────────────────────────────── */
+
+const ADJECTIVES = ['pretty', 'large', 'big', 'small', 'tall', 'short', 'long', 'handsome'];
+const NOUNS = ['table', 'chair', 'house', 'bbq', 'desk', 'car', 'pony', 'cookie'];
+let nextId = 1;
+
+function label(i) {
+  return `${ADJECTIVES[i % ADJECTIVES.length]} ${NOUNS[(i * 7) % NOUNS.length]}`;
+}
+
+function makeList() {
+  const ul = document.createElement('ul');
+  document.body.appendChild(ul);
+  return ul;
+}
+
+async function create(list, n) {
+  for (let i = 0; i < n; i++) {
+    const row = document.createElement(TodoItem.tag);
+    row.setAttribute('id', String(nextId++));
+    row.setAttribute('text', label(i));
+    row.setAttribute('done', String(i & 1));
+    list.appendChild(row);
+  }
+  await settle();
+}
+
+async function update(list) {
+  let i = 0;
+  for (let row = list.firstChild; row; row = row.nextSibling, i++)
+    if (i % 10 === 0) row.setAttribute('text', row.getAttribute('text') + ' !!!');
+  await settle();
+}
+
+async function swap(list) {
+  const rows = list.children;
+  const a = rows[1], b = rows[rows.length - 2];
+  const afterB = b.nextSibling;
+  list.insertBefore(b, a);
+  list.insertBefore(a, afterB);
+  await settle();
+}
+
+async function clear(list) {
+  list.textContent = '';
+  await settle();
+}
+
+/* The rows really rendered: catches a broken shim timing empty work */
+function check(list, n) {
+  const rows = list.children;
+  if (rows.length !== n) throw new Error(`expected ${n} rows, found ${rows.length}`);
+  if (!rows[0].firstChild || !rows[0].textContent.includes(label(0).split(' ')[0]))
+    throw new Error(`row did not render: "${rows[0].textContent}"`);
+}
+
+async function time(fn) {
+  const t0 = performance.now();
+  await fn();
+  return performance.now() - t0;
+}
+
+function median(xs) {
+  const s = [...xs].sort((a, b) => a - b);
+  return s[s.length >> 1];
+}
+
+/* Components log while hydrating (a moved row reconnects and hydrates its
+ * own DOM); a terminal costs far more per line than devtools, so logging
+ * is muted for the run */
+const quiet = { log: console.log, warn: console.warn };
+console.log = console.warn = () => {};
+
+const results = [];
+for (const n of SIZES) {
+  const ms = { create: [], update: [], swap: [], clear: [] };
+  for (let r = 0; r <= RUNS; r++) {
+    const list = makeList();
+    const t = {
+      create: await time(() => create(list, n)),
+    };
+    check(list, n);
+    t.update = await time(() => update(list));
+    t.swap   = await time(() => swap(list));
+    t.clear  = await time(() => clear(list));
+    list.remove();
+    if (r === 0) continue; /* warm-up */
+    for (const k in t) ms[k].push(t[k]);
+  }
+  for (const k in ms) results.push({ name: `${k}_${n}`, rows: n, ms: +median(ms[k]).toFixed(3) });
+}
+
+Object.assign(console, quiet);
+emit({ results });
@@ -0,0 +1,457 @@
+/*
+ * Forge Benchmarks - Minimal DOM for Node
+ *
+ * Just enough of the DOM for the generated .forge.js outputs and
+ * forge-runtime.js to mount, update and unmount custom elements headlessly:
+ * nodes as linked lists, attributes, listeners, <template> parsing,
+ * customElements with connected / disconnected / attributeChanged
+ * callbacks, and a manual requestAnimationFrame queue.
+ *
+ * It is a cost model, not a browser: there is no layout, style or paint, so
+ * the DOM suite compares Forge's own work between builds, not against
+ * browser numbers.  Importing the module installs the globals.
+ */
+
+const ELEMENT = 1, TEXT = 3, COMMENT = 8, DOCUMENT = 9, FRAGMENT = 11;
+
+const VOID_TAGS = new Set(['area', 'br', 'col', 'embed', 'hr', 'img', 'input',
+  'link', 'meta', 'source', 'track', 'wbr']);
+
+/* ─── Nodes ──────────────────────────────────────────────────────────────── */
+
+class Node {
+  constructor(type) {
+    this.nodeType = type;
+    this.parentNode = null;
+    this.firstChild = null;
+    this.lastChild = null;
+    this.nextSibling = null;
+    this.previousSibling = null;
+  }
+
+  get childNodes() {
+    const out = [];
+    for (let n = this.firstChild; n; n = n.nextSibling) out.push(n);
+    return out;
+  }
+
+  get isConnected() {
+    let n = this;
+    while (n.parentNode) n = n.parentNode;
+    return n.nodeType === DOCUMENT;
+  }
+
+  get parentElement() {
+    const p = this.parentNode;
+    return p && p.nodeType === ELEMENT ? p : null;
+  }
+
+  appendChild(child) { return this.insertBefore(child, null); }
+
+  insertBefore(child, ref) {
+    if (child.nodeType === FRAGMENT) {
+      while (child.firstChild) this.insertBefore(child.firstChild, ref);
+      return child;
+    }
+    /* A move disconnects and reconnects, as in a browser */
+    if (child.parentNode) child.parentNode.removeChild(child);
+    child.parentNode = this;
+    child.nextSibling = ref || null;
+    child.previousSibling = ref ? ref.previousSibling : this.lastChild;
+    if (child.previousSibling) child.previousSibling.nextSibling = child;
+    else this.firstChild = child;
+    if (ref) ref.previousSibling = child;
+    else this.lastChild = child;
+    if (this.isConnected) _connect(child);
+    return child;
+  }
+
+  removeChild(child) {
+    const was = child.isConnected;
+    this._unlink(child);
+    if (was) _disconnect(child);
+    return child;
+  }
+
+  replaceChild(child, old) {
+    this.insertBefore(child, old);
+    return this.removeChild(old);
+  }
+
+  _unlink(child) {
+    if (child.previousSibling) child.previousSibling.nextSibling = child.nextSibling;
+    else this.firstChild = child.nextSibling;
+    if (child.nextSibling) child.nextSibling.previousSibling = child.previousSibling;
+    else this.lastChild = child.previousSibling;
+    child.parentNode = child.nextSibling = child.previousSibling = null;
+  }
+
+  remove() { if (this.parentNode) this.parentNode.removeChild(this); }
+
+  replaceWith(node) {
+    const p = this.parentNode;
+    if (!p) return;
+    p.insertBefore(node, this);
+    p.removeChild(this);
+  }
+
+  replaceChildren(...nodes) {
+    while (this.firstChild) this.removeChild(this.firstChild);
+    for (const n of nodes) this.appendChild(typeof n === 'string' ? new Text(n) : n);
+  }
+
+  append(...nodes) {
+    for (const n of nodes) this.appendChild(typeof n === 'string' ? new Text(n) : n);
+  }
+
+  contains(n) {
+    for (; n; n = n.parentNode) if (n === this) return true;
+    return false;
+  }
+
+  get textContent() {
+    let s = '';
+    for (let n = this.firstChild; n; n = n.nextSibling)
+      if (n.nodeType !== COMMENT) s += n.textContent;
+    return s;
+  }
+
+  set textContent(v) {
+    this.replaceChildren();
+    if (v !== '' && v != null) this.appendChild(new Text(String(v)));
+  }
+}
+
+class CharacterData extends Node {
+  constructor(type, data) { super(type); this.data = data; }
+  get textContent() { return this.data; }
+  set textContent(v) { this.data = String(v); }
+  get nodeValue() { return this.data; }
+  set nodeValue(v) { this.data = String(v); }
+  cloneNode() { return new this.constructor(this.data); }
+}
+
+class Text extends CharacterData { constructor(d = '') { super(TEXT, d); } }
+class Comment extends CharacterData { constructor(d = '') { super(COMMENT, d); } }
+
+class DocumentFragment extends Node {
+  constructor() { super(FRAGMENT); }
+  cloneNode(deep) { return _cloneChildren(this, new DocumentFragment(), deep); }
+}
+
+/* ─── Elements ───────────────────────────────────────────────────────────── */
+
+let _pendingTag = null;  /* localName for the element being constructed */
+
+class Element extends Node {
+  constructor() {
+    super(ELEMENT);
+    this.localName = _pendingTag || _tagOf.get(new.target) || 'div';
+    _pendingTag = null;
+    this._attrs = new Map();
+    this._listeners = null;
+    this.style = {};
+  }
+
+  get tagName() { return this.localName.toUpperCase(); }
+  get nodeName() { return this.tagName; }
+
+  get children() {
+    const out = [];
+    for (let n = this.firstChild; n; n = n.nextSibling) if (n.nodeType === ELEMENT) out.push(n);
+    return out;
+  }
+  get firstElementChild() {
+    for (let n = this.firstChild; n; n = n.nextSibling) if (n.nodeType === ELEMENT) return n;
+    return null;
+  }
+  get nextElementSibling() {
+    for (let n = this.nextSibling; n; n = n.nextSibling) if (n.nodeType === ELEMENT) return n;
+    return null;
+  }
+  get childElementCount() { return this.children.length; }
+
+  get attributes() {
+    return Array.from(this._attrs, ([name, value]) => ({ name, value }));
+  }
+  getAttribute(name) { const v = this._attrs.get(name); return v === undefined ? null : v; }
+  hasAttribute(name) { return this._attrs.has(name); }
+  setAttribute(name, value) {
+    const old = this.getAttribute(name);
+    value = String(value);
+    this._attrs.set(name, value);
+    this._attributeChanged(name, old, value);
+  }
+  removeAttribute(name) {
+    const old = this.getAttribute(name);
+    if (this._attrs.delete(name)) this._attributeChanged(name, old, null);
+  }
+  toggleAttribute(name, force) {
+    const on = force === undefined ? !this.hasAttribute(name) : force;
+    if (on) this.setAttribute(name, ''); else this.removeAttribute(name);
+    return on;
+  }
+  _attributeChanged(name, old, value) {
+    const cls = this.constructor;
+    if (this.attributeChangedCallback && cls.observedAttributes &&
+        cls.observedAttributes.includes(name))
+      this.attributeChangedCallback(name, old, value);
+  }
+
+  get id() { return this.getAttribute('id') || ''; }
+  set id(v) { this.setAttribute('id', v); }
+  get className() { return this.getAttribute('class') || ''; }
+  set className(v) { this.setAttribute('class', v); }
+  get classList() {
+    const el = this;
+    const list = () => el.className.split(/\s+/).filter(Boolean);
+    return {
+      contains: (c) => list().includes(c),
+      add: (...cs) => { el.className = [...new Set([...list(), ...cs])].join(' '); },
+      remove: (...cs) => { el.className = list().filter((c) => !cs.includes(c)).join(' '); },
+      toggle: (c, force) => {
+        const on = force === undefined ? !list().includes(c) : force;
+        if (on) el.classList.add(c); else el.classList.remove(c);
+        return on;
+      },
+    };
+  }
+
+  addEventListener(type, fn, opts) {
+    const capture = typeof opts === 'boolean' ? opts : !!(opts && opts.capture);
+    (this._listeners || (this._listeners = [])).push({ type, fn, capture });
+  }
+  removeEventListener(type, fn, opts) {
+    if (!this._listeners) return;
+    const capture = typeof opts === 'boolean' ? opts : !!(opts && opts.capture);
+    const i = this._listeners.findIndex((l) => l.type === type && l.fn === fn && l.capture === capture);
+    if (i >= 0) this._listeners.splice(i, 1);
+  }
+  dispatchEvent(ev) {
+    if (!ev.target) ev.target = this;
+    for (let n = this; n && !ev._stopped; n = ev.bubbles ? n.parentNode : null) {
+      ev.currentTarget = n;
+      for (const l of (n._listeners || []).slice()) if (l.type === ev.type) l.fn.call(n, ev);
+    }
+    return !ev.defaultPrevented;
+  }
+
+  closest(sel) {
+    for (let n = this; n && n.nodeType === ELEMENT; n = n.parentNode) if (_matches(n, sel)) return n;
+    return null;
+  }
+  querySelector(sel) { return _find(this, (n) => _matches(n, sel)); }
+  querySelectorAll(sel) {
+    const out = [];
+    _walk(this, (n) => { if (_matches(n, sel)) out.push(n); });
+    return out;
+  }
+
+  get innerHTML() { return ''; }
+  set innerHTML(html) {
+    this.replaceChildren();
+    _parseInto(html, this);
+  }
+
+  cloneNode(deep) {
+    const el = document.createElement(this.localName);
+    for (const [k, v] of this._attrs) el._attrs.set(k, v);
+    return _cloneChildren(this, el, deep);
+  }
+}
+
+class HTMLElement extends Element {}
+
+class HTMLTemplateElement extends HTMLElement {
+  constructor() { super(); this.content = new DocumentFragment(); }
+  set innerHTML(html) {
+    this.content = new DocumentFragment();
+    _parseInto(html, this.content);
+  }
+  get innerHTML() { return ''; }
+}
+
+function _cloneChildren(from, to, deep) {
+  if (deep) for (let n = from.firstChild; n; n = n.nextSibling) to.appendChild(n.cloneNode(true));
+  return to;
+}
+
+/* Simple selectors only: tag, #id, .class, [attr] and [attr="v"] */
+function _matches(el, sel) {
+  if (el.nodeType !== ELEMENT) return false;
+  const m = /^([a-z0-9-]*)(?:#([\w-]+))?((?:\.[\w-]+)*)(?:\[([\w-]+)(?:="([^"]*)")?\])?$/i.exec(sel.trim());
+  if (!m) return false;
+  if (m[1] && el.localName !== m[1].toLowerCase()) return false;
+  if (m[2] && el.id !== m[2]) return false;
+  if (m[3]) for (const c of m[3].split('.').filter(Boolean)) if (!el.classList.contains(c)) return false;
+  if (m[4] && (m[5] === undefined ? !el.hasAttribute(m[4]) : el.getAttribute(m[4]) !== m[5])) return false;
+  return true;
+}
+
+function _walk(root, fn) {
+  for (let n = root.firstChild; n; n = n.nextSibling) {
+    if (n.nodeType !== ELEMENT) continue;
+    fn(n);
+    _walk(n, fn);
+  }
+}
+
+function _find(root, pred) {
+  for (let n = root.firstChild; n; n = n.nextSibling) {
+    if (n.nodeType !== ELEMENT) continue;
+    if (pred(n)) return n;
+    const hit = _find(n, pred);
+    if (hit) return hit;
+  }
+  return null;
+}
+
+/* ─── HTML Parsing ───────────────────────────────────────────────────────── */
+
+/* Well-formed fragments only, which is what the compiler emits */
+function _parseInto(html, root) {
+  const stack = [root];
+  let i = 0;
+  const top = () => stack[stack.length - 1];
+  while (i < html.length) {
+    if (html.startsWith('<!--', i)) {
+      const end = html.indexOf('-->', i + 4);
+      top().appendChild(new Comment(html.slice(i + 4, end)));
+      i = end + 3;
+    } else if (html.startsWith('</', i)) {
+      const end = html.indexOf('>', i);
+      const tag = html.slice(i + 2, end).trim().toLowerCase();
+      while (stack.length > 1 && stack.pop().localName !== tag);
+      i = end + 1;
+    } else if (html[i] === '<') {
+      const tagRe = /<([a-zA-Z][\w-]*)((?:\s+[^\s=>\/]+(?:\s*=\s*(?:"[^"]*"|'[^']*'|[^\s>]+))?)*)\s*(\/?)>/y;
+      tagRe.lastIndex = i;
+      const m = tagRe.exec(html);
+      if (!m) { top().appendChild(new Text(html.slice(i))); break; }
+      const el = document.createElement(m[1].toLowerCase());
+      const attrRe = /([^\s=>\/]+)(?:\s*=\s*(?:"([^"]*)"|'([^']*)'|([^\s>]+)))?/g;
+      let a;
+      while ((a = attrRe.exec(m[2]))) el._attrs.set(a[1], _unescape(a[2] ?? a[3] ?? a[4] ?? ''));
+      top().appendChild(el);
+      if (!m[3] && !VOID_TAGS.has(el.localName)) stack.push(el);
+      i = tagRe.lastIndex;
+    } else {
+      const end = html.indexOf('<', i);
+      const text = html.slice(i, end < 0 ? html.length : end);
+      top().appendChild(new Text(_unescape(text)));
+      i = end < 0 ? html.length : end;
+    }
+  }
+}
+
+function _unescape(s) {
+  return s.replace(/&(amp|lt|gt|quot|#39);/g, (_, e) =>
+    ({ amp: '&', lt: '<', gt: '>', quot: '"', '#39': "'" })[e]);
+}
+
+/* ─── Custom Elements ────────────────────────────────────────────────────── */
+
+const _registry = new Map();  /* name → class */
+const _tagOf = new Map();     /* class → name */
+
+const customElements = {
+  define(name, cls) {
+    if (_registry.has(name)) throw new Error(`'${name}' is already defined`);
+    _registry.set(name, cls);
+    _tagOf.set(cls, name);
+  },
+  get(name) { return _registry.get(name); },
+  whenDefined(name) { return Promise.resolve(_registry.get(name)); },
+};
+
+function _connect(node) {
+  if (node.nodeType !== ELEMENT && node.nodeType !== FRAGMENT) return;
+  if (node.connectedCallback) node.connectedCallback();
+  for (let n = node.firstChild; n; n = n.nextSibling) _connect(n);
+}
+
+function _disconnect(node) {
+  if (node.nodeType !== ELEMENT) return;
+  if (node.disconnectedCallback) node.disconnectedCallback();
+  for (let n = node.firstChild; n; n = n.nextSibling) _disconnect(n);
+}
+
+/* ─── Document ───────────────────────────────────────────────────────────── */
+
+class Document extends Node {
+  constructor() {
+    super(DOCUMENT);
+    this.documentElement = new HTMLElement();
+    this.documentElement.localName = 'html';
+    this.appendChild(this.documentElement);
+    this.head = this.createElement('head');
+    this.body = this.createElement('body');
+    this.documentElement.appendChild(this.head);
+    this.documentElement.appendChild(this.body);
+  }
+  createElement(tag) {
+    tag = String(tag).toLowerCase();
+    const cls = _registry.get(tag);
+    _pendingTag = tag;
+    const el = cls ? new cls() : tag === 'template' ? new HTMLTemplateElement() : new HTMLElement();
+    _pendingTag = null;
+    return el;
+  }
+  createTextNode(data) { return new Text(String(data)); }
+  createComment(data) { return new Comment(String(data)); }
+  createDocumentFragment() { return new DocumentFragment(); }
+  getElementById(id) { return _find(this.documentElement, (n) => n.id === id) || null; }
+  querySelector(sel) { return this.documentElement.querySelector(sel); }
+  querySelectorAll(sel) { return this.documentElement.querySelectorAll(sel); }
+  addEventListener() {}
+  removeEventListener() {}
+}
+
+class Event {
+  constructor(type, init = {}) {
+    this.type = type;
+    this.bubbles = !!init.bubbles;
+    this.target = null;
+    this.currentTarget = null;
+    this.defaultPrevented = false;
+    this._stopped = false;
+  }
+  preventDefault() { this.defaultPrevented = true; }
+  stopPropagation() { this._stopped = true; }
+}
+
+/* ─── Frames ─────────────────────────────────────────────────────────────── */
+
+let _frames = [];
+let _frameId = 0;
+
+function requestAnimationFrame(fn) {
+  _frames.push({ id: ++_frameId, fn });
+  return _frameId;
+}
+
+function cancelAnimationFrame(id) {
+  _frames = _frames.filter((f) => f.id !== id);
+}
+
+/* Run queued microtasks and frames until nothing is pending, the way a
+ * browser reaches an idle frame */
+export async function settle() {
+  for (let guard = 0; guard < 100; guard++) {
+    await new Promise((r) => setImmediate(r));
+    if (!_frames.length) return;
+    const now = performance.now();
+    const run = _frames;
+    _frames = [];
+    for (const f of run) f.fn(now);
+  }
+}
+
+export const document = new Document();
+
+Object.assign(globalThis, {
+  Node, Text, Comment, DocumentFragment, Element, HTMLElement, HTMLTemplateElement,
+  Document, Event, CustomEvent: Event, document, customElements,
+  requestAnimationFrame, cancelAnimationFrame,
+  window: globalThis,
+});
@@ -0,0 +1,44 @@
+/*
+ * Forge Benchmarks - Results File
+ *
+ * Merges the per-suite JSON that `make bench` writes into one document
+ * tagged with the version, commit and host, for tracking regressions
+ * across releases:
+ *
+ *   node benchmarks/report.mjs <bench dir> <forge version> > results.json
+ *
+ * Suites that were skipped keep their entry with a "skipped" reason, so
+ * two results files always list the same suites.
+ */
+
+import { execSync } from 'node:child_process';
+import fs from 'node:fs';
+import os from 'node:os';
+import path from 'node:path';
+
+const [dir = 'build/bench', version = ''] = process.argv.slice(2);
+const SUITES = ['compile', 'runtime', 'mem', 'dom-no-wasm', 'dom-wasm', 'ssr'];
+
+let commit = '';
+try { commit = execSync('git rev-parse --short HEAD', { stdio: ['ignore', 'pipe', 'ignore'] }).toString().trim(); }
+catch (e) { /* not a checkout */ }
+
+const suites = {};
+for (const name of SUITES) {
+  const file = path.join(dir, `${name}.json`);
+  try { suites[name] = JSON.parse(fs.readFileSync(file, 'utf8')); }
+  catch (e) { suites[name] = { skipped: `no valid ${file}` }; }
+}
+
+console.log(JSON.stringify({
+  forge_version: version,
+  commit,
+  date: new Date().toISOString(),
+  host: {
+    platform: `${os.platform()}-${os.arch()}`,
+    cpu: (os.cpus()[0] || {}).model || '',
+    cpus: os.cpus().length,
+    node: process.version,
+  },
+  suites,
+}, null, 2));
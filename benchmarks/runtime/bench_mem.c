@@ -0,0 +1,135 @@
+/*
+ * Forge Benchmarks - Memory Primitives
+ *
+ * Times forge_memset / forge_memcpy / forge_memcmp / forge_strlen against
+ * the byte-at-a-time loops they replaced, at sizes typical of component
+ * props and state structs (16 B - 4 KB).
+ *
+ * Build and run with `make bench`.  Native builds measure the 8-byte word
+ * paths; the wasm paths are selected the same way from target features.
+ * `--json` prints the same results as JSON for build/bench/results.json.
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime */
+
+#include "../../runtime/include/forge/types.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* ─── Byte-Loop Baselines ─────────────────────────────────────────────────── */
+
+/* noinline + the volatile sink stop the compiler from turning these into
+ * libc calls or folding them away, so they stay one byte per iteration */
+
+__attribute__((noinline))
+static void *byte_memset(void *dst, int c, size_t n) {
+    volatile u8 *p = (volatile u8 *)dst;
+    while (n--) *p++ = (u8)c;
+    return dst;
+}
+
+__attribute__((noinline))
+static void *byte_memcpy(void *dst, const void *src, size_t n) {
+    volatile u8 *d = (volatile u8 *)dst;
+    const u8    *s = (const u8 *)src;
+    while (n--) *d++ = *s++;
+    return dst;
+}
+
+__attribute__((noinline))
+static int byte_memcmp(const void *a, const void *b, size_t n) {
+    const volatile u8 *ap = (const volatile u8 *)a;
+    const volatile u8 *bp = (const volatile u8 *)b;
+    while (n--) {
+        if (*ap != *bp) return *ap - *bp;
+        ap++; bp++;
+    }
+    return 0;
+}
+
+__attribute__((noinline))
+static int byte_strlen(const char *s) {
+    const volatile char *p = s;
+    int n = 0;
+    while (*p++) n++;
+    return n;
+}
+
+/* ─── Harness ─────────────────────────────────────────────────────────────── */
+
+enum { OP_MEMSET, OP_MEMCPY, OP_MEMCMP, OP_STRLEN, OP_COUNT };
+
+static const char *OP_NAMES[OP_COUNT] = { "memset", "memcpy", "memcmp", "strlen" };
+
+static const size_t SIZES[] = { 16, 64, 256, 1024, 4096 };
+#define SIZE_COUNT (sizeof(SIZES) / sizeof(SIZES[0]))
+
+static u8 _a[4096 + 64] __attribute__((aligned(16)));
+static u8 _b[4096 + 64] __attribute__((aligned(16)));
+
+static volatile u64 _sink;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* Nanoseconds per call.  The +1 offset keeps the buffers misaligned the
+ * way arena strings and props blobs usually are. */
+static double run(int op, int forge, size_t n, long iters) {
+    u8 *a = _a + 1, *b = _b + 1;
+    forge_memset(a, 'x', n);
+    forge_memset(b, 'x', n);
+    a[n - 1] = 0;
+
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        switch (op) {
+        case OP_MEMSET: forge ? forge_memset(a, (int)i, n) : byte_memset(a, (int)i, n); break;
+        case OP_MEMCPY: forge ? forge_memcpy(b, a, n)      : byte_memcpy(b, a, n);      break;
+        case OP_MEMCMP: _sink += (u64)(forge ? forge_memcmp(a, b, n) : byte_memcmp(a, b, n)); break;
+        case OP_STRLEN: _sink += (u64)(forge ? forge_strlen((char *)a) : byte_strlen((char *)a)); break;
+        }
+        /* keep memset/memcpy results observable and strlen's terminator */
+        _sink += a[0] + b[n - 1];
+        if (op == OP_MEMSET) a[n - 1] = 0;
+    }
+    return (now_ns() - t0) / (double)iters;
+}
+
+int main(int argc, char **argv) {
+    /* Total bytes processed per measurement; scaled down for big sizes */
+    long budget = 200L * 1000 * 1000;
+    int  json   = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) json = 1;
+        else budget = atol(argv[i]);
+    }
+
+    if (json) printf("{\n  \"suite\": \"mem\",\n  \"results\": [");
+    else printf("%-8s %6s %12s %12s %8s\n", "op", "bytes", "byte ns", "forge ns", "speedup");
+    int first = 1;
+    for (int op = 0; op < OP_COUNT; op++) {
+        for (size_t k = 0; k < SIZE_COUNT; k++) {
+            size_t n     = SIZES[k];
+            long   iters = budget / (long)n;
+            run(op, 1, n, iters / 10); /* warm up */
+            double base  = run(op, 0, n, iters);
+            double fast  = run(op, 1, n, iters);
+            if (json) {
+                printf("%s\n    {\"op\": \"%s\", \"bytes\": %zu, \"byte_ns\": %.2f, \"forge_ns\": %.2f}",
+                       first ? "" : ",", OP_NAMES[op], n, base, fast);
+                first = 0;
+            } else {
+                printf("%-8s %6zu %12.2f %12.2f %7.1fx\n",
+                       OP_NAMES[op], n, base, fast, fast > 0 ? base / fast : 0.0);
+            }
+        }
+    }
+    if (json) printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * Forge Benchmarks - Runtime Hot Paths
+ *
+ * Times the allocator, the context registry and the string formatter as the
+ * native build of forge_runtime.a runs them:
+ *
+ *   arena     arena_alloc at fixed and mixed sizes, arena_mark/rewind
+ *   registry  registry_get hits and misses, registry_resolve and a
+ *             remove + set churn, at 1k / 10k / 100k live contexts
+ *   sprintf   forge_sprintf on typical template expressions
+ *
+ * Build and run with `make bench`; `--json` prints the results as JSON.
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime */
+
+#include "../../runtime/include/forge/web.h"
+#include "../../runtime/src/arena.h"
+#include "../../runtime/src/registry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+void forge_runtime_init(void);
+
+/* ─── Host Imports ────────────────────────────────────────────────────────── */
+
+/* The JS side of the env imports; nothing here reaches the DOM */
+void forge_dom_flush(const u32 *buf, u32 words) { (void)buf; (void)words; }
+void js_schedule_raf(void) {}
+void js_console_log(const char *msg, int len) { (void)msg; (void)len; }
+void js_console_log_int(const char *msg, int len, int v) { (void)msg; (void)len; (void)v; }
+void js_trap(const char *msg, int len) { (void)msg; (void)len; }
+
+/* ─── Harness ─────────────────────────────────────────────────────────────── */
+
+static volatile u64 _sink;
+static int _json;
+static int _first = 1;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void report(const char *group, const char *name, long n, double ns) {
+    if (_json) {
+        printf("%s\n    {\"group\": \"%s\", \"name\": \"%s\", \"n\": %ld, \"ns_per_op\": %.2f}",
+               _first ? "" : ",", group, name, n, ns);
+    } else {
+        printf("%-9s %-24s %8ld %10.2f\n", group, name, n, ns);
+    }
+    _first = 0;
+}
+
+/* xorshift, so lookups do not walk the table in insertion order */
+static u32 _rng = 0x9e3779b9u;
+static u32 rnd(void) {
+    _rng ^= _rng << 13;
+    _rng ^= _rng >> 17;
+    _rng ^= _rng << 5;
+    return _rng;
+}
+
+/* ─── Arena ───────────────────────────────────────────────────────────────── */
+
+/* Allocations per reset stay inside the initial block, so this measures
+ * the bump path rather than chunk growth */
+#define ARENA_BATCH 4096
+
+static void bench_arena(long iters) {
+    static const size_t MIXED[8] = { 8, 24, 16, 64, 40, 128, 12, 256 };
+
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        if (i % ARENA_BATCH == 0) arena_reset(&g_render_arena);
+        _sink += (u64)(uintptr_t)arena_alloc(&g_render_arena, 16);
+    }
+    report("arena", "alloc_16", iters, (now_ns() - t0) / (double)iters);
+
+    t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        if (i % ARENA_BATCH == 0) arena_reset(&g_render_arena);
+        _sink += (u64)(uintptr_t)arena_alloc(&g_render_arena, MIXED[i & 7]);
+    }
+    report("arena", "alloc_mixed", iters, (now_ns() - t0) / (double)iters);
+
+    t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        ArenaMark m = arena_mark(&g_render_arena);
+        _sink += (u64)(uintptr_t)arena_alloc(&g_render_arena, 64);
+        arena_rewind(&g_render_arena, m);
+    }
+    report("arena", "mark_alloc_rewind", iters, (now_ns() - t0) / (double)iters);
+    arena_reset(&g_render_arena);
+}
+
+/* ─── Registry ────────────────────────────────────────────────────────────── */
+
+static void bench_registry(long iters) {
+    static const u32 OCCUPANCY[] = { 1000, 10000, 100000 };
+    static const char *NAMES[][4] = {
+        { "get_hit_1k",   "get_miss_1k",   "resolve_1k",   "churn_1k"   },
+        { "get_hit_10k",  "get_miss_10k",  "resolve_10k",  "churn_10k"  },
+        { "get_hit_100k", "get_miss_100k", "resolve_100k", "churn_100k" },
+    };
+    u32 max = OCCUPANCY[2];
+    forge_ctx_t *ctxs    = calloc(max, sizeof(forge_ctx_t));
+    u32         *handles = calloc(max, sizeof(u32));
+    if (!ctxs || !handles) return;
+
+    for (int k = 0; k < 3; k++) {
+        u32 n = OCCUPANCY[k];
+        registry_init();
+        /* Element IDs are sparse in practice: nodes outnumber components */
+        for (u32 i = 0; i < n; i++) {
+            ctxs[i].el_id = i * 7 + 1;
+            handles[i]    = registry_set(ctxs[i].el_id, &ctxs[i]);
+        }
+
+        double t0 = now_ns();
+        for (long i = 0; i < iters; i++)
+            _sink += (u64)(uintptr_t)registry_get((rnd() % n) * 7 + 1);
+        report("registry", NAMES[k][0], n, (now_ns() - t0) / (double)iters);
+
+        t0 = now_ns();
+        for (long i = 0; i < iters; i++)
+            _sink += (u64)(uintptr_t)registry_get((rnd() % n) * 7 + 2);
+        report("registry", NAMES[k][1], n, (now_ns() - t0) / (double)iters);
+
+        t0 = now_ns();
+        for (long i = 0; i < iters; i++)
+            _sink += (u64)(uintptr_t)registry_resolve(handles[rnd() % n]);
+        report("registry", NAMES[k][2], n, (now_ns() - t0) / (double)iters);
+
+        /* Unmount one component and mount another under a fresh ID,
+         * keeping occupancy constant */
+        u32 next_id = n * 7 + 1;
+        t0 = now_ns();
+        for (long i = 0; i < iters; i++) {
+            u32 slot = rnd() % n;
+            registry_remove(ctxs[slot].el_id);
+            ctxs[slot].el_id = next_id;
+            handles[slot]    = registry_set(next_id, &ctxs[slot]);
+            next_id += 7;
+        }
+        report("registry", NAMES[k][3], n, (now_ns() - t0) / (double)iters);
+    }
+    registry_init();
+    free(ctxs);
+    free(handles);
+}
+
+/* ─── Strings ─────────────────────────────────────────────────────────────── */
+
+static void bench_sprintf(long iters) {
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        if (i % ARENA_BATCH == 0) arena_reset(&g_render_arena);
+        _sink += forge_sprintf("%d", (int)i);
+    }
+    report("sprintf", "int", iters, (now_ns() - t0) / (double)iters);
+
+    t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        if (i % ARENA_BATCH == 0) arena_reset(&g_render_arena);
+        _sink += forge_sprintf("%s: %d items", "Cart", (int)(i & 255));
+    }
+    report("sprintf", "str_int", iters, (now_ns() - t0) / (double)iters);
+
+    t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        if (i % ARENA_BATCH == 0) arena_reset(&g_render_arena);
+        _sink += forge_sprintf("$%.2f", (double)i * 0.01);
+    }
+    report("sprintf", "float_2", iters, (now_ns() - t0) / (double)iters);
+    arena_reset(&g_render_arena);
+}
+
+int main(int argc, char **argv) {
+    long iters = 2L * 1000 * 1000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) _json = 1;
+        else iters = atol(argv[i]);
+    }
+
+    forge_runtime_init();
+
+    if (_json) printf("{\n  \"suite\": \"runtime\",\n  \"results\": [");
+    else printf("%-9s %-24s %8s %10s\n", "group", "name", "n", "ns/op");
+    bench_arena(iters);
+    bench_registry(iters);
+    bench_sprintf(iters);
+    if (_json) printf("\n  ]\n}\n");
+    return 0;
+}
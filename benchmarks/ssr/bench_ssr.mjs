@@ -0,0 +1,162 @@
+/*
+ * Forge Benchmarks - SSR Server Throughput
+ *
+ * Starts a generated forge-ssr-server.js on a free port and drives it with
+ * a closed loop of keep-alive clients, recording requests/sec and latency
+ * percentiles for:
+ *
+ *   page_stream    GET /                      streamed SSR (the default)
+ *   page_buffered  GET /                      SSR_STREAM=0
+ *   state          GET /__forge_state?path=/  route state for client navigation
+ *
+ * USAGE:
+ *   node benchmarks/ssr/bench_ssr.mjs <dist dir> [--json]
+ *        [--duration <ms>] [--concurrency <n>]
+ *
+ * The dist dir comes from `forge compile --ssr`, with the page's index.html
+ * in its parent directory as in the examples.  Client and server share
+ * the machine, so compare runs on the same host only.
+ */
+
+import { spawn } from 'node:child_process';
+import fs from 'node:fs';
+import http from 'node:http';
+import net from 'node:net';
+import path from 'node:path';
+
+const args = process.argv.slice(2);
+const flag = (name, def) => {
+  const i = args.indexOf(name);
+  return i >= 0 ? Number(args[i + 1]) : def;
+};
+const json = args.includes('--json');
+const DURATION = flag('--duration', 3000);
+const CONCURRENCY = flag('--concurrency', 32);
+const dist = path.resolve(args.find((a, i) => !a.startsWith('--') &&
+  !['--duration', '--concurrency'].includes(args[i - 1])) || 'dist');
+const server = path.join(dist, 'forge-ssr-server.js');
+
+function emit(result) {
+  if (json) {
+    console.log(JSON.stringify({ suite: 'ssr', concurrency: CONCURRENCY, duration_ms: DURATION, ...result }, null, 2));
+  } else if (result.skipped) {
+    console.log(`ssr: skipped, ${result.skipped}`);
+  } else {
+    console.log(`ssr (${CONCURRENCY} connections, ${DURATION} ms each)`);
+    for (const r of result.results)
+      console.log(`  ${r.name.padEnd(14)} ${String(r.rps).padStart(8)} req/s  ` +
+                  `p50 ${r.p50_ms.toFixed(2)} ms  p99 ${r.p99_ms.toFixed(2)} ms  errors ${r.errors}`);
+  }
+}
+
+/* The server renders into the page shell one level above dist/ */
+for (const need of [server, path.join(dist, '..', 'index.html')]) {
+  if (!fs.existsSync(need)) {
+    emit({ skipped: `no ${need}` });
+    process.exit(0);
+  }
+}
+
+function freePort() {
+  return new Promise((resolve, reject) => {
+    const s = net.createServer().listen(0, () => {
+      const { port } = s.address();
+      s.close(() => resolve(port));
+    }).on('error', reject);
+  });
+}
+
+/* ─── Server ─────────────────────────────────────────────────────────────── */
+
+async function start(env) {
+  const port = await freePort();
+  const child = spawn(process.execPath, [server], {
+    env: { ...process.env, PORT: String(port), SSR_WORKERS: '0', ...env },
+    stdio: ['ignore', 'ignore', 'inherit'],
+  });
+  /* Up once it answers */
+  for (let i = 0; i < 100; i++) {
+    const ok = await new Promise((resolve) => {
+      http.get({ port, path: '/__forge_metrics' }, (res) => { res.resume(); resolve(true); })
+        .on('error', () => resolve(false));
+    });
+    if (ok) return { port, child };
+    await new Promise((r) => setTimeout(r, 50));
+  }
+  child.kill();
+  throw new Error('forge-ssr-server.js did not start');
+}
+
+function stop({ child }) {
+  return new Promise((resolve) => {
+    child.on('exit', resolve);
+    child.kill();
+  });
+}
+
+/* ─── Load ───────────────────────────────────────────────────────────────── */
+
+function request(agent, port, reqPath) {
+  return new Promise((resolve) => {
+    const t0 = process.hrtime.bigint();
+    http.get({ agent, port, path: reqPath }, (res) => {
+      res.on('data', () => {});
+      res.on('end', () => resolve({
+        ms: Number(process.hrtime.bigint() - t0) / 1e6,
+        ok: res.statusCode === 200,
+      }));
+    }).on('error', () => resolve({ ms: 0, ok: false }));
+  });
+}
+
+async function load(port, reqPath) {
+  const agent = new http.Agent({ keepAlive: true, maxSockets: CONCURRENCY });
+  const latencies = [];
+  let errors = 0;
+  const run = async (until) => {
+    while (performance.now() < until) {
+      const r = await request(agent, port, reqPath);
+      if (r.ok) latencies.push(r.ms); else errors++;
+    }
+  };
+  const clients = (ms) => {
+    const until = performance.now() + ms;
+    return Promise.all(Array.from({ length: CONCURRENCY }, () => run(until)));
+  };
+
+  await clients(Math.min(500, DURATION / 4));  /* warm-up: JIT, caches */
+  latencies.length = 0;
+  errors = 0;
+  const t0 = performance.now();
+  await clients(DURATION);
+  const elapsed = performance.now() - t0;
+  agent.destroy();
+
+  latencies.sort((a, b) => a - b);
+  const pct = (p) => latencies.length
+    ? latencies[Math.min(latencies.length - 1, Math.floor(latencies.length * p))] : 0;
+  return {
+    requests: latencies.length,
+    rps: Math.round(latencies.length / (elapsed / 1000)),
+    p50_ms: +pct(0.5).toFixed(3),
+    p99_ms: +pct(0.99).toFixed(3),
+    errors,
+  };
+}
+
+const CASES = [
+  { name: 'page_stream',   env: {},                 path: '/' },
+  { name: 'page_buffered', env: { SSR_STREAM: '0' }, path: '/' },
+  { name: 'state',         env: {},                 path: '/__forge_state?path=/' },
+];
+
+const results = [];
+for (const c of CASES) {
+  const srv = await start(c.env);
+  try {
+    results.push({ name: c.name, path: c.path, ...(await load(srv.port, c.path)) });
+  } finally {
+    await stop(srv);
+  }
+}
+emit({ results });
@@ -9,6 +9,7 @@
  */
 
 #include "analyzer.h"
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -38,42 +39,78 @@ static void ana_warn(AnalyzerCtx *ctx, const char *msg) {
 
 /* ─── Reactivity: scan expression strings for state.X / props.X ─────────── */
 
-static void scan_expr_for_deps(AnalyzerCtx *ctx, const char *expr) {
+/* Dependency bit for a field: state fields first, then props.  Components
+ * with more than 31 reactive fields share the top bit for the overflow. */
+unsigned analyzer_dep_bit(const ComponentNode *c, int is_prop, int index) {
+  int bit = is_prop ? c->state_count + index : index;
+  if (bit > 31)
+    bit = 31;
+  return 1u << bit;
+}
+
+/* Does `expr` reference `<prefix><name>` as a whole identifier?  Guards
+ * against "state.count" matching inside "state.counter". */
+static int refs_field(const char *expr, const char *prefix, const char *name) {
+  char pattern[256];
+  snprintf(pattern, sizeof(pattern), "%s%s", prefix, name);
+  size_t len = strlen(pattern);
+  for (const char *p = strstr(expr, pattern); p; p = strstr(p + 1, pattern)) {
+    char before = p > expr ? p[-1] : ' ';
+    char after = p[len];
+    if ((isalnum((unsigned char)before) || before == '_') ||
+        (isalnum((unsigned char)after) || after == '_'))
+      continue;
+    return 1;
+  }
+  return 0;
+}
+
+static unsigned scan_expr_for_deps(AnalyzerCtx *ctx, const char *expr) {
   if (!expr)
-    return;
+    return 0;
   ComponentNode *c = ctx->comp;
+  unsigned mask = 0;
 
   /* Check state fields */
   for (int i = 0; i < c->state_count; i++) {
-    char pattern[256];
-    snprintf(pattern, sizeof(pattern), "state.%s", c->state[i].name);
-    if (strstr(expr, pattern)) {
+    if (refs_field(expr, "state.", c->state[i].name)) {
       c->state[i].is_reactive = 1;
       c->state_used_in_template[i] = 1;
+      mask |= analyzer_dep_bit(c, 0, i);
     }
   }
 
   /* Check props fields */
   for (int i = 0; i < c->prop_count; i++) {
-    char pattern[256];
-    snprintf(pattern, sizeof(pattern), "props.%s", c->props[i].name);
-    if (strstr(expr, pattern)) {
+    if (refs_field(expr, "props.", c->props[i].name)) {
       c->props[i].is_reactive = 1;
       c->props_used_in_template[i] = 1;
+      mask |= analyzer_dep_bit(c, 1, i);
     }
   }
+
+  /* Computed fields inherit the deps of their expression */
+  for (int i = 0; i < c->computed_count; i++) {
+    if (c->computed[i].field.name &&
+        refs_field(expr, "computed.", c->computed[i].field.name))
+      mask |= c->computed[i].dep_mask;
+  }
+  return mask;
 }
 
 /* ─── Walk HTML tree ────────────────────────────────────────────────────────
+ * Records per-attribute masks and, on every node, the union of all masks in
+ * its subtree.
  */
 
-static void walk_html(AnalyzerCtx *ctx, const HtmlNode *node) {
+static unsigned walk_html(AnalyzerCtx *ctx, HtmlNode *node) {
   if (!node)
-    return;
+    return 0;
 
+  unsigned mask = 0;
   switch (node->kind) {
   case HTML_EXPR:
-    scan_expr_for_deps(ctx, node->text);
+    mask = scan_expr_for_deps(ctx, node->text);
     break;
 
   case HTML_ELEMENT:
@@ -82,13 +119,14 @@ static void walk_html(AnalyzerCtx *ctx, const HtmlNode *node) {
   case HTML_FOR:
     /* Scan attribute expressions */
     for (int i = 0; i < node->attr_count; i++) {
-      if (node->attrs[i].is_expr) {
-        scan_expr_for_deps(ctx, node->attrs[i].value);
-      }
+      node->attrs[i].dep_mask =
+          node->attrs[i].is_expr ? scan_expr_for_deps(ctx, node->attrs[i].value)
+                                 : 0;
+      mask |= node->attrs[i].dep_mask;
     }
     /* Recurse into children */
     for (int i = 0; i < node->child_count; i++) {
-      walk_html(ctx, &node->children[i]);
+      mask |= walk_html(ctx, &node->children[i]);
     }
     break;
 
@@ -96,6 +134,8 @@ static void walk_html(AnalyzerCtx *ctx, const HtmlNode *node) {
     /* Plain text — no deps */
     break;
   }
+  node->dep_mask = mask;
+  return mask;
 }
 
 /* ─── Validate event handlers ───────────────────────────────────────────────
@@ -110,7 +150,7 @@ static void check_event_handlers(AnalyzerCtx *ctx) {
     }
     /* Mark state fields mutated in handlers as reactive */
     if (c->handlers[i].body) {
-      scan_expr_for_deps(ctx, c->handlers[i].body);
+      c->handlers[i].dep_mask = scan_expr_for_deps(ctx, c->handlers[i].body);
     }
   }
 }
@@ -127,7 +167,8 @@ static void check_computed(AnalyzerCtx *ctx) {
                c->computed[i].field.name ? c->computed[i].field.name : "?");
       ana_error(ctx, msg);
     }
-    scan_expr_for_deps(ctx, c->computed[i].expression);
+    c->computed[i].dep_mask =
+        scan_expr_for_deps(ctx, c->computed[i].expression);
   }
 }
 
@@ -169,16 +210,18 @@ static void check_template(AnalyzerCtx *ctx) {
 /* ─── Public API ────────────────────────────────────────────────────────────
  */
 
-AnalysisResult analyze_component(ComponentNode *c) {
+AnalysisResult analyze_component(ComponentNode *c, AstArena *arena) {
   /* Allocate reactivity arrays */
-  c->state_used_in_template = calloc((size_t)(c->state_count + 1), sizeof(int));
-  c->props_used_in_template = calloc((size_t)(c->prop_count + 1), sizeof(int));
+  c->state_used_in_template =
+      ast_alloc(arena, sizeof(int) * (size_t)(c->state_count + 1));
+  c->props_used_in_template =
+      ast_alloc(arena, sizeof(int) * (size_t)(c->prop_count + 1));
 
   AnalyzerCtx ctx = {.comp = c, .errors = 0, .warnings = 0};
 
   check_template(&ctx);
-  check_event_handlers(&ctx);
   check_computed(&ctx);
+  check_event_handlers(&ctx);
 
   /* Walk the template tree to find reactive dependencies */
   if (c->template_root) {
@@ -202,7 +245,7 @@ AnalysisResult analyze_component(ComponentNode *c) {
 AnalysisResult analyze_program(Program *p) {
   AnalysisResult total = {0, 0};
   for (int i = 0; i < p->component_count; i++) {
-    AnalysisResult r = analyze_component(p->components[i]);
+    AnalysisResult r = analyze_component(p->components[i], &p->arena);
     total.error_count += r.error_count;
     total.warning_count += r.warning_count;
   }
@@ -23,6 +23,17 @@ typedef struct {
 /* ─── Public API ──────────────────────────────────────────────────────────── */
 
 AnalysisResult analyze_program(Program *p);
-AnalysisResult analyze_component(ComponentNode *c);
+/* Reactivity arrays come from the arena of the Program owning `c` */
+AnalysisResult analyze_component(ComponentNode *c, AstArena *arena);
+
+/* ─── Dependency Masks ────────────────────────────────────────────────────────
+ * After analysis every template attribute, node, handler and computed field
+ * carries a `dep_mask` of the state/props fields it touches.  Bit layout:
+ * state fields first, then props; fields past bit 30 share bit 31.
+ */
+
+#define FORGE_DEP_ALL 0xFFFFFFFFu
+
+unsigned analyzer_dep_bit(const ComponentNode *c, int is_prop, int index);
 
 #endif /* FORGE_ANALYZER_H */
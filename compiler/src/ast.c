@@ -8,21 +8,88 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* ─── Arena ───────────────────────────────────────────────────────────────── */
+
+#define AST_CHUNK_SIZE (64 * 1024)
+#define AST_ALIGN      (sizeof(void *) > sizeof(double) ? sizeof(void *) : sizeof(double))
+
+struct AstChunk {
+    AstChunk *next;
+    size_t    size; /* bytes after the header */
+};
+
+static size_t align_up(size_t n) {
+    return (n + AST_ALIGN - 1) & ~(AST_ALIGN - 1);
+}
+
+/* Chunks double with the arena, so a large file takes O(log n) of them */
+static void arena_grow(AstArena *a, size_t size) {
+    size_t bytes = a->chunks ? a->chunks->size * 2 : AST_CHUNK_SIZE;
+    if (bytes < size) bytes = size;
+    AstChunk *c = malloc(align_up(sizeof(AstChunk)) + bytes);
+    if (!c) {
+        fprintf(stderr, "forge: out of memory\n");
+        exit(1);
+    }
+    c->next   = a->chunks;
+    c->size   = bytes;
+    a->chunks = c;
+    a->ptr    = (char *)c + align_up(sizeof(AstChunk));
+    a->end    = a->ptr + bytes;
+}
+
+void *ast_alloc(AstArena *a, size_t size) {
+    size = align_up(size ? size : 1);
+    if (!a->ptr || size > (size_t)(a->end - a->ptr)) arena_grow(a, size);
+    void *p = a->ptr;
+    a->ptr += size;
+    memset(p, 0, size);
+    return p;
+}
+
+void *ast_grow(AstArena *a, void *p, size_t old_size, size_t new_size) {
+    if (!p) return ast_alloc(a, new_size);
+    char *bp = p;
+    if (bp + align_up(old_size) == a->ptr && new_size <= (size_t)(a->end - bp)) {
+        a->ptr = bp + align_up(new_size);
+        return p;
+    }
+    void *q = ast_alloc(a, new_size);
+    memcpy(q, p, old_size < new_size ? old_size : new_size);
+    return q;
+}
+
+char *ast_strndup(AstArena *a, const char *s, size_t n) {
+    char *d = ast_alloc(a, n + 1);
+    memcpy(d, s, n);
+    return d; /* ast_alloc zeroed the terminator */
+}
+
+char *ast_strdup(AstArena *a, const char *s) {
+    return s ? ast_strndup(a, s, strlen(s)) : NULL;
+}
+
 /* ─── Allocators ──────────────────────────────────────────────────────────── */
 
-ComponentNode *ast_new_component(void) {
-    ComponentNode *c = calloc(1, sizeof(ComponentNode));
-    return c;
+Program *ast_new_program(void) {
+    AstArena arena = { 0 };
+    Program *p = ast_alloc(&arena, sizeof(Program));
+    p->arena = arena; /* the arena now lives inside what it allocated */
+    return p;
 }
 
-HtmlNode *ast_new_html_node(HtmlKind kind) {
-    HtmlNode *n = calloc(1, sizeof(HtmlNode));
+ComponentNode *ast_new_component(AstArena *a) {
+    return ast_alloc(a, sizeof(ComponentNode));
+}
+
+HtmlNode *ast_new_html_node(AstArena *a, HtmlKind kind) {
+    HtmlNode *n = ast_alloc(a, sizeof(HtmlNode));
     n->kind = kind;
     return n;
 }
 
-TypeRef *ast_new_type(TypeKind kind) {
-    TypeRef *t = calloc(1, sizeof(TypeRef));
+TypeRef *ast_new_type(AstArena *a, TypeKind kind) {
+    TypeRef *t = ast_alloc(a, sizeof(TypeRef));
     t->kind       = kind;
     t->array_size = -1;
     return t;
@@ -36,61 +103,15 @@ Field ast_new_field(void) {
 
 /* ─── Freeing ─────────────────────────────────────────────────────────────── */
 
-static void free_type(TypeRef *t) {
-    if (!t) return;
-    free(t->name);
-    free_type(t->inner);
-    free_type(t->ret_type);
-    for (int i = 0; i < t->param_count; i++) free_type(t->param_types[i]);
-    free(t->param_types);
-    free(t);
-}
-
-static void free_field(Field *f) {
-    free(f->name);
-    free_type(f->type);
-    free(f->init_expr);
-}
-
-static void free_html(HtmlNode *n, int count) {
-    if (!n) return;
-    for (int i = 0; i < count; i++) {
-        free(n[i].tag);
-        free(n[i].text);
-        for (int j = 0; j < n[i].attr_count; j++) {
-            free(n[i].attrs[j].name);
-            free(n[i].attrs[j].value);
-        }
-        free(n[i].attrs);
-        free_html(n[i].children, n[i].child_count);
-    }
-}
-
-void ast_free_component(ComponentNode *c) {
-    if (!c) return;
-    free(c->name);
-    for (int i = 0; i < c->prop_count;     i++) free_field(&c->props[i]);
-    for (int i = 0; i < c->state_count;    i++) free_field(&c->state[i]);
-    for (int i = 0; i < c->style_count;    i++) { free(c->style[i].property); free(c->style[i].value); }
-    for (int i = 0; i < c->handler_count;  i++) { free(c->handlers[i].event_name); free(c->handlers[i].body); }
-    for (int i = 0; i < c->computed_count; i++) { free_field(&c->computed[i].field); free(c->computed[i].expression); }
-    for (int i = 0; i < c->include_count;  i++) free(c->includes[i]);
-    free(c->props);   free(c->state);    free(c->style);
-    free(c->handlers); free(c->computed); free(c->includes);
-    free(c->state_used_in_template);
-    free(c->props_used_in_template);
-    if (c->template_root) {
-        free_html(c->template_root, 1);
-        free(c->template_root);
-    }
-    free(c);
-}
-
+/* O(chunks): no walk over the tree */
 void ast_free_program(Program *p) {
     if (!p) return;
-    for (int i = 0; i < p->component_count; i++) ast_free_component(p->components[i]);
-    free(p->components);
-    free(p);
+    AstChunk *c = p->arena.chunks; /* p itself is in one of them */
+    while (c) {
+        AstChunk *next = c->next;
+        free(c);
+        c = next;
+    }
 }
 
 /* ─── Debug Dump ──────────────────────────────────────────────────────────── */
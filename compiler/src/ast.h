@@ -80,6 +80,7 @@ struct Attribute {
   char *name;  /* e.g. "class", "onclick", "href" */
   char *value; /* raw string or C expression       */
   int is_expr; /* 1 if value is a {} C expression  */
+  unsigned dep_mask; /* set by analyzer: state/props bits read */
 };
 
 /* ─── HTML / Template Node ──────────────────────────────────────────────────
@@ -103,6 +104,7 @@ struct HtmlNode {
   int child_count;
   char *text; /* for HTML_TEXT / HTML_EXPR           */
   int self_closing;
+  unsigned dep_mask; /* set by analyzer: bits read anywhere in subtree */
 };
 
 /* ─── Event Handler ─────────────────────────────────────────────────────────
@@ -111,6 +113,7 @@ struct HtmlNode {
 typedef struct {
   char *event_name; /* "click", "change", "submit", etc. */
   char *body;       /* raw C statement block             */
+  unsigned dep_mask; /* set by analyzer: state/props bits touched */
 } EventHandler;
 
 /* ─── Computed Field ────────────────────────────────────────────────────────
@@ -119,6 +122,7 @@ typedef struct {
 typedef struct {
   Field field;      /* type + name                */
   char *expression; /* right-hand-side expression */
+  unsigned dep_mask; /* set by analyzer: state/props bits read */
 } ComputedField;
 
 /* ─── Component Node (root of AST) ───────────────────────────────────────── */
@@ -154,21 +158,44 @@ typedef struct {
   int *props_used_in_template; /* bool array [prop_count]   */
 } ComponentNode;
 
+/* ─── AST Arena ─────────────────────────────────────────────────────────────
+ * Every node, array and string of a Program is bump-allocated from the
+ * Program's own arena, so nothing in the tree is freed on its own and
+ * ast_free_program releases the whole file in one pass over its chunks.
+ * Programs parsed on different threads never share an arena.
+ */
+
+typedef struct AstChunk AstChunk;
+
+typedef struct {
+  AstChunk *chunks; /* newest first */
+  char *ptr;        /* next free byte of chunks */
+  char *end;
+} AstArena;
+
+void *ast_alloc(AstArena *a, size_t size); /* zeroed */
+/* Resize an array: in place when it is the latest allocation, otherwise
+ * a copy (the old block stays until teardown).  Growth is not zeroed. */
+void *ast_grow(AstArena *a, void *p, size_t old_size, size_t new_size);
+char *ast_strndup(AstArena *a, const char *s, size_t n);
+char *ast_strdup(AstArena *a, const char *s); /* NULL stays NULL */
+
 /* ─── Program (collection of components) ─────────────────────────────────── */
 
 typedef struct {
   ComponentNode **components;
   int component_count;
+  AstArena arena; /* owns the Program itself and everything under it */
 } Program;
 
 /* ─── Allocator Helpers ─────────────────────────────────────────────────────
  */
 
-ComponentNode *ast_new_component(void);
-HtmlNode *ast_new_html_node(HtmlKind kind);
-TypeRef *ast_new_type(TypeKind kind);
+Program *ast_new_program(void);
+ComponentNode *ast_new_component(AstArena *a);
+HtmlNode *ast_new_html_node(AstArena *a, HtmlKind kind);
+TypeRef *ast_new_type(AstArena *a, TypeKind kind);
 Field ast_new_field(void);
-void ast_free_component(ComponentNode *c);
 void ast_free_program(Program *p);
 
 /* ─── Debug Dump ────────────────────────────────────────────────────────────
@@ -8,6 +8,7 @@
  */
 
 #include "binding_gen.h"
+#include "analyzer.h"
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -121,11 +122,483 @@ static void emit_expr_js(const char *expr, FILE *out, const char *local_item) {
   }
 }
 
+/* ─── Growable string buffer ────────────────────────────────────────────────
+ */
+
+typedef struct {
+  char *s;
+  size_t len, cap;
+} StrBuf;
+
+static void sb_putn(StrBuf *b, const char *s, size_t n) {
+  if (b->len + n + 1 > b->cap) {
+    b->cap = (b->len + n + 1) * 2;
+    b->s = realloc(b->s, b->cap);
+  }
+  memcpy(b->s + b->len, s, n);
+  b->len += n;
+  b->s[b->len] = '\0';
+}
+
+static void sb_puts(StrBuf *b, const char *s) { sb_putn(b, s, strlen(s)); }
+
+/* Append s with HTML escaping (quotes too, so it is safe in attributes) */
+static void sb_put_html(StrBuf *b, const char *s, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    switch (s[i]) {
+    case '&': sb_puts(b, "&amp;"); break;
+    case '<': sb_puts(b, "&lt;"); break;
+    case '>': sb_puts(b, "&gt;"); break;
+    case '"': sb_puts(b, "&quot;"); break;
+    case '\n': sb_puts(b, " "); break;
+    default: sb_putn(b, &s[i], 1); break;
+    }
+  }
+}
+
+/* Merge the run of HTML_TEXT children starting at `i` the way the no-wasm
+ * renderer does (each piece trimmed, joined by one space).  Returns the
+ * index just past the run; `out` receives the merged text (possibly ""). */
+static int nw_merge_text(const HtmlNode *n, int i, StrBuf *out) {
+  int j = i;
+  while (j < n->child_count && n->children[j].kind == HTML_TEXT &&
+         n->children[j].text)
+    j++;
+  int first = 1;
+  for (int k = i; k < j; k++) {
+    const char *ts = n->children[k].text;
+    while (*ts == ' ' || *ts == '\t' || *ts == '\n' || *ts == '\r')
+      ts++;
+    if (!*ts)
+      continue;
+    const char *te = ts + strlen(ts) - 1;
+    while (te > ts && (*te == ' ' || *te == '\t' || *te == '\n' || *te == '\r'))
+      te--;
+    if (!first)
+      sb_puts(out, " ");
+    sb_putn(out, ts, (size_t)(te - ts + 1));
+    first = 0;
+  }
+  if (!out->s)
+    sb_puts(out, "");
+  return j;
+}
+
 /* ─── No-WASM: Emit DOM creation JS for an HTML node ────────────────────────
  */
 
 static int _nw_id = 0;
 
+/* Where emitted updaters register and whether hydration applies.  These
+ * point at the component-wide lists by default; <for> rows swap them for
+ * row-local lists while their children are emitted. */
+static const char *_nw_exprs = "this._exprNodes";
+static const char *_nw_updaters = "this._attrUpdaters";
+static const char *_nw_hydrate = "this._hydrate";
+
+/* Place of the node being emitted among the server-rendered children of its
+ * parent: its index among the element children, or for {expr} nodes the
+ * index of its <!----> marker.  Set by emit_nw_children(). */
+static int _nw_slot_el = 0, _nw_slot_mark = 0;
+
+static int nw_hydrating(void) { return strcmp(_nw_hydrate, "false") != 0; }
+
+/* Set while emitting the wiring for a cloned <template> cluster: the nodes
+ * already exist, so only updaters and listeners are emitted. */
+static int _nw_in_cluster = 0;
+
+/* --profile: updaters count their DOM writes on the module's `__prof` */
+static int _nw_profile = 0;
+
+/* Cluster HTML strings collected while emitting _render(); written out as a
+ * module-level table after the class body. */
+static char **_nw_tpls = NULL;
+static int _nw_tpl_count = 0, _nw_tpl_cap = 0;
+
+/* Mask attached to an updater as `__deps`.  Expressions that read no
+ * tracked field (globals, loop items) fall back to running on every refresh. */
+static unsigned nw_deps(unsigned mask) { return mask ? mask : FORGE_DEP_ALL; }
+
+/* Fields an event attribute may dirty: its own inline code plus the bodies
+ * of every @handler it invokes. */
+static unsigned nw_event_deps(const ComponentNode *comp, const Attribute *a) {
+  unsigned mask = a->dep_mask;
+  for (const char *p = a->value ? a->value : ""; *p; p++) {
+    if (*p != '@')
+      continue;
+    const char *name = ++p;
+    while (isalnum((unsigned char)*p) || *p == '_')
+      p++;
+    size_t len = (size_t)(p - name);
+    for (int i = 0; i < comp->handler_count; i++) {
+      const char *ev = comp->handlers[i].event_name;
+      if (ev && strlen(ev) == len && strncmp(ev, name, len) == 0)
+        mask |= comp->handlers[i].dep_mask;
+    }
+    if (!*p)
+      break;
+  }
+  return mask;
+}
+
+/* ─── No-WASM: <template> clusters ──────────────────────────────────────────
+ *
+ * A maximal element subtree made only of elements, text and {expr} nodes is
+ * emitted once as an HTML string in a cached <template>.  Rendering clones
+ * it and reaches the dynamic holes (elements with bound attributes or
+ * listeners, and expression text nodes, which start as <!----> comments)
+ * through child-index paths computed here.  Hydration walks the server
+ * markup with a second set of paths: element-child indices plus {expr}
+ * marker indices, which whitespace in the server HTML cannot shift.
+ */
+
+typedef struct {
+  int id;
+  int is_expr; /* 1: expression text node, 0: element */
+  const char *tag;
+  char path[256];  /* ".childNodes[i]..." relative to the cluster root */
+  char hpath[512]; /* hydration lookup: __forgeAt / __forgeHole chain */
+} NwHole;
+
+static int nw_is_event_attr(const Attribute *a) {
+  return strncmp(a->name, "on", 2) == 0 && islower((unsigned char)a->name[2]);
+}
+
+static int nw_is_void_tag(const char *tag) {
+  static const char *voids[] = {"img", "input", "br", "hr", "meta", "link",
+                                "area", "base", "col", "embed", "source",
+                                "track", "wbr", NULL};
+  for (int i = 0; voids[i]; i++)
+    if (strcmp(tag, voids[i]) == 0)
+      return 1;
+  return 0;
+}
+
+/* Can this subtree round-trip through the HTML parser unchanged?  Table and
+ * form-control content models, raw-text elements and block content inside
+ * <p> would all be restructured by the parser, so they stay node-by-node. */
+static int nw_clusterable(const HtmlNode *n, const HtmlNode *parent) {
+  static const char *unsafe[] = {"table", "thead", "tbody", "tfoot", "tr",
+                                 "td", "th", "caption", "colgroup", "select",
+                                 "option", "optgroup", "textarea", "template",
+                                 "script", "style", "title", "svg", NULL};
+  static const char *phrasing[] = {"span", "a", "strong", "em", "small", "b",
+                                   "i", "u", "br", "img", "code", "sup",
+                                   "sub", "label", "abbr", "mark", NULL};
+  switch (n->kind) {
+  case HTML_TEXT:
+    return 1;
+  case HTML_EXPR:
+    return n->text != NULL;
+  case HTML_ELEMENT: {
+    const char *tag = n->tag ? n->tag : "div";
+    for (int i = 0; unsafe[i]; i++)
+      if (strcmp(tag, unsafe[i]) == 0)
+        return 0;
+    if (strchr(tag, '-') || (nw_is_void_tag(tag) && n->child_count > 0))
+      return 0;
+    if (parent && parent->tag && strcmp(parent->tag, "p") == 0) {
+      int ok = 0;
+      for (int i = 0; phrasing[i]; i++)
+        if (strcmp(tag, phrasing[i]) == 0)
+          ok = 1;
+      if (!ok)
+        return 0;
+    }
+    for (int i = 0; i < n->attr_count; i++)
+      if (strncmp(n->attrs[i].name, "data-f", 6) == 0)
+        return 0;
+    for (int i = 0; i < n->child_count; i++)
+      if (!nw_clusterable(&n->children[i], n))
+        return 0;
+    return 1;
+  }
+  default:
+    return 0;
+  }
+}
+
+static const Attribute *nw_find_attr(const HtmlNode *n, const char *name) {
+  for (int i = 0; i < n->attr_count; i++)
+    if (strcmp(n->attrs[i].name, name) == 0)
+      return &n->attrs[i];
+  return NULL;
+}
+
+/* <for virtual> defaults: estimated row height (px) and rows kept mounted
+ * past each edge of the viewport */
+#define NW_VIRTUAL_ITEM_HEIGHT 40
+#define NW_VIRTUAL_OVERSCAN 3
+#define NW_VIRTUAL_SSR_HEIGHT 1200 /* px of rows rendered on the server */
+
+/* A numeric attribute as a JS expression: {expr}, a literal, or `def` */
+static void emit_nw_number_attr(const Attribute *a, int def, FILE *out,
+                                const char *local_item) {
+  char *end;
+  if (!a || !a->value || !a->value[0]) {
+    fprintf(out, "%d", def);
+  } else if (a->is_expr) {
+    fprintf(out, "(");
+    emit_expr_js(a->value, out, local_item);
+    fprintf(out, ")");
+  } else if (strtod(a->value, &end), *end == '\0') {
+    fprintf(out, "%s", a->value);
+  } else {
+    fprintf(out, "Number(");
+    emit_js_str(a->value, out);
+    fprintf(out, ")");
+  }
+}
+
+/* Nodes that render as one element in server markup: elements, component
+ * hosts and the display:contents wrappers of <if> and <for> */
+static int nw_makes_element(const HtmlNode *n) {
+  return n->kind == HTML_ELEMENT || n->kind == HTML_COMPONENT ||
+         n->kind == HTML_IF || n->kind == HTML_FOR;
+}
+
+static int nw_count_nodes(const HtmlNode *n) {
+  int c = 1;
+  for (int i = 0; i < n->child_count; i++)
+    c += nw_count_nodes(&n->children[i]);
+  return c;
+}
+
+/* Serialise the cluster, consuming _nw_id exactly as emit_nw_html does, and
+ * record every hole that the wiring pass will need a variable for. */
+static void nw_cluster_build(const HtmlNode *n, const char *path,
+                             const char *hpath, StrBuf *html, NwHole *holes,
+                             int *hole_count, int max_holes) {
+  const char *tag = n->tag ? n->tag : "div";
+  int id = _nw_id++;
+  int dynamic = (path[0] == '\0'); /* the root always gets a variable */
+
+  sb_puts(html, "<");
+  sb_puts(html, tag);
+  for (int i = 0; i < n->attr_count; i++) {
+    const Attribute *a = &n->attrs[i];
+    if (nw_is_event_attr(a)) {
+      dynamic = 1;
+    } else if (a->is_expr) {
+      dynamic = 1;
+      _nw_id++; /* attribute updater id */
+    } else {
+      sb_puts(html, " ");
+      sb_puts(html, a->name);
+      sb_puts(html, "=\"");
+      sb_put_html(html, a->value ? a->value : "", strlen(a->value ? a->value : ""));
+      sb_puts(html, "\"");
+    }
+  }
+  sb_puts(html, ">");
+
+  if (dynamic && *hole_count < max_holes) {
+    NwHole *h = &holes[(*hole_count)++];
+    h->id = id;
+    h->is_expr = 0;
+    h->tag = tag;
+    snprintf(h->path, sizeof(h->path), "%s", path);
+    snprintf(h->hpath, sizeof(h->hpath), "%s", hpath);
+  }
+
+  int idx = 0, el = 0, mark = 0;
+  for (int i = 0; i < n->child_count; i++) {
+    const HtmlNode *ch = &n->children[i];
+    char cpath[256], chpath[512];
+    if (snprintf(cpath, sizeof(cpath), "%s.childNodes[%d]", path, idx) >=
+        (int)sizeof(cpath))
+      *hole_count = max_holes; /* too deep: caller falls back */
+    if (ch->kind == HTML_ELEMENT)
+      snprintf(chpath, sizeof(chpath), "__forgeAt(%s, %d, '%s')", hpath, el++,
+               ch->tag ? ch->tag : "div");
+    else
+      snprintf(chpath, sizeof(chpath), "__forgeHole(%s, %d)", hpath, mark);
+    if (strlen(chpath) >= sizeof(chpath) - 1)
+      *hole_count = max_holes;
+    if (ch->kind == HTML_TEXT && ch->text) {
+      StrBuf text = {0};
+      i = nw_merge_text(n, i, &text) - 1;
+      if (text.len) {
+        sb_put_html(html, text.s, text.len);
+        idx++;
+      }
+      free(text.s);
+    } else if (ch->kind == HTML_EXPR && ch->text) {
+      sb_puts(html, "<!---->");
+      if (*hole_count < max_holes) {
+        NwHole *h = &holes[(*hole_count)++];
+        h->id = _nw_id;
+        h->is_expr = 1;
+        h->tag = NULL;
+        snprintf(h->path, sizeof(h->path), "%s", cpath);
+        snprintf(h->hpath, sizeof(h->hpath), "%s", chpath);
+      }
+      _nw_id++;
+      idx++;
+      mark++;
+    } else if (ch->kind == HTML_ELEMENT) {
+      nw_cluster_build(ch, cpath, chpath, html, holes, hole_count, max_holes);
+      idx++;
+    }
+  }
+
+  if (!nw_is_void_tag(tag)) {
+    sb_puts(html, "</");
+    sb_puts(html, tag);
+    sb_puts(html, ">");
+  }
+}
+
+static void emit_nw_html(const HtmlNode *n, const char *parent_var,
+                         const ComponentNode *comp, FILE *out,
+                         const char *local_item);
+
+/* Try to emit `n` as a cloned template cluster.  Returns 0 (emitting
+ * nothing) when the subtree is not eligible. */
+static int emit_nw_cluster(const HtmlNode *n, const char *parent_var,
+                           const ComponentNode *comp, FILE *out,
+                           const char *local_item) {
+  enum { MAX_HOLES = 256 };
+  if (_nw_in_cluster || !nw_clusterable(n, NULL) || nw_count_nodes(n) < 3)
+    return 0;
+
+  int start_id = _nw_id;
+  StrBuf html = {0};
+  NwHole holes[MAX_HOLES];
+  int hole_count = 0;
+  char root_var[32];
+  snprintf(root_var, sizeof(root_var), "__e%d", _nw_id);
+  nw_cluster_build(n, "", root_var, &html, holes, &hole_count, MAX_HOLES);
+  if (hole_count >= MAX_HOLES) {
+    /* Too many holes (or too deep) to track — build node by node */
+    free(html.s);
+    _nw_id = start_id;
+    return 0;
+  }
+
+  if (_nw_tpl_count >= _nw_tpl_cap) {
+    _nw_tpl_cap = _nw_tpl_cap ? _nw_tpl_cap * 2 : 8;
+    _nw_tpls = realloc(_nw_tpls, sizeof(char *) * (size_t)_nw_tpl_cap);
+  }
+  int tpl = _nw_tpl_count++;
+  _nw_tpls[tpl] = html.s;
+
+  int root = holes[0].id;
+  int hydrate = nw_hydrating();
+  fprintf(out, "      let ");
+  for (int i = 0; i < hole_count; i++)
+    fprintf(out, "%s__%s%d", i ? ", " : "", holes[i].is_expr ? "tn" : "e",
+            holes[i].id);
+  fprintf(out, ";\n");
+
+  if (hydrate) {
+    fprintf(out, "      __e%d = %s && __forgeAt(%s, %d, '%s');\n", root,
+            _nw_hydrate, parent_var, _nw_slot_el, holes[0].tag);
+    fprintf(out, "      if (!__e%d) {\n", root);
+  }
+  fprintf(out, "        __e%d = __forgeClone(%d);\n", root, tpl);
+  for (int i = 1; i < hole_count; i++) {
+    if (holes[i].is_expr)
+      fprintf(out,
+              "        __tn%d = document.createTextNode(''); "
+              "__e%d%s.replaceWith(__tn%d);\n",
+              holes[i].id, root, holes[i].path, holes[i].id);
+    else
+      fprintf(out, "        __e%d = __e%d%s;\n", holes[i].id, root,
+              holes[i].path);
+  }
+  if (hydrate) {
+    fprintf(out, "      } else {\n");
+    for (int i = 1; i < hole_count; i++) {
+      if (holes[i].is_expr)
+        fprintf(out, "        __tn%d = %s || document.createTextNode('');\n",
+                holes[i].id, holes[i].hpath);
+      else
+        fprintf(out, "        __e%d = %s || document.createElement('%s');\n",
+                holes[i].id, holes[i].hpath, holes[i].tag);
+    }
+    fprintf(out, "      }\n");
+  }
+
+  /* Wiring pass: same walk as node-by-node emission, minus node creation */
+  _nw_id = start_id;
+  _nw_in_cluster = 1;
+  emit_nw_html(n, parent_var, comp, out, local_item);
+  _nw_in_cluster = 0;
+
+  if (hydrate)
+    fprintf(out, "      if (!__e%d.parentNode) %s.appendChild(__e%d);\n", root,
+            parent_var, root);
+  else
+    fprintf(out, "      %s.appendChild(__e%d);\n", parent_var, root);
+  return 1;
+}
+
+/* Module-level template table and clone helper for the clusters above. */
+static void emit_nw_templates(FILE *out) {
+  if (_nw_tpl_count == 0)
+    return;
+  fprintf(out, "const __forgeTpls = [\n");
+  for (int i = 0; i < _nw_tpl_count; i++) {
+    fprintf(out, "  ");
+    emit_js_str(_nw_tpls[i], out);
+    fprintf(out, ",\n");
+    free(_nw_tpls[i]);
+  }
+  fprintf(out, "];\n");
+  fprintf(out, "const __forgeTplCache = [];\n");
+  fprintf(out,
+          "function __forgeClone(i) {\n"
+          "  let t = __forgeTplCache[i];\n"
+          "  if (!t) {\n"
+          "    t = __forgeTplCache[i] = document.createElement('template');\n"
+          "    t.innerHTML = __forgeTpls[i];\n"
+          "  }\n"
+          "  return t.content.firstChild.cloneNode(true);\n"
+          "}\n\n");
+  _nw_tpl_count = 0;
+}
+
+/* Children of an element or <if>.  Text runs are merged into one node and
+ * left alone when hydrating; every other child is told its slot in the
+ * server markup and emitted with `hydrate` as its hydration condition. */
+static void emit_nw_children(const HtmlNode *n, const char *child_var,
+                             const char *hydrate, const ComponentNode *comp,
+                             FILE *out, const char *local_item) {
+  const char *saved_hydrate = _nw_hydrate;
+  _nw_hydrate = hydrate;
+  int el = 0, mark = 0;
+  for (int i = 0; i < n->child_count; i++) {
+    const HtmlNode *ch = &n->children[i];
+    if (ch->kind == HTML_TEXT && ch->text) {
+      StrBuf text = {0};
+      int j = nw_merge_text(n, i, &text);
+      if (!_nw_in_cluster && text.len) {
+        fprintf(out, "      ");
+        if (nw_hydrating())
+          fprintf(out, "if (!%s) ", _nw_hydrate);
+        fprintf(out, "%s.appendChild(document.createTextNode(", child_var);
+        for (char *c = text.s; *c; c++)
+          if (*c == '\n')
+            *c = ' ';
+        emit_js_str(text.s, out);
+        fprintf(out, "));\n");
+      }
+      free(text.s);
+      i = j - 1;
+      continue;
+    }
+    _nw_slot_el = el;
+    _nw_slot_mark = mark;
+    emit_nw_html(ch, child_var, comp, out, local_item);
+    if (nw_makes_element(ch))
+      el++;
+    else if (ch->kind == HTML_EXPR && ch->text)
+      mark++;
+  }
+  _nw_hydrate = saved_hydrate;
+}
+
 static void emit_nw_html(const HtmlNode *n, const char *parent_var,
                          const ComponentNode *comp, FILE *out,
                          const char *local_item) {
@@ -149,36 +622,42 @@ static void emit_nw_html(const HtmlNode *n, const char *parent_var,
     if (n->text) {
       int id = _nw_id++;
       fprintf(out, "      { \n");
-      fprintf(out,
-              "        let __tn%d = this._hydrate ? "
-              "%s.querySelector('[data-fexpr=\"%d\"]') : null;\n",
-              id, parent_var, id);
-      fprintf(out,
-              "        if (this._hydrate && !__tn%d) console.warn(`Forge: "
-              "Hydration target fexpr-%d not found in`, %s);\n",
-              id, id, parent_var);
-      fprintf(out,
-              "        if (!__tn%d) __tn%d = document.createTextNode('');\n",
-              id, id);
+      if (!_nw_in_cluster && nw_hydrating())
+        fprintf(out,
+                "        const __tn%d = %s && __forgeHole(%s, %d) || "
+                "document.createTextNode('');\n",
+                id, _nw_hydrate, parent_var, _nw_slot_mark);
+      else if (!_nw_in_cluster)
+        fprintf(out, "        const __tn%d = document.createTextNode('');\n",
+                id);
       /* Build a reactive updater */
       fprintf(out, "        __tn%d.__forgeUpdate = () => {\n", id);
       fprintf(out, "          const __val = String(");
       emit_expr_js(n->text, out, local_item);
       fprintf(out, ");\n");
-      fprintf(out,
-              "          if (__tn%d.textContent !== __val) __tn%d.textContent "
-              "= __val;\n",
-              id, id);
+      if (_nw_profile)
+        fprintf(out,
+                "          if (__tn%d.textContent !== __val) { __tn%d.textContent "
+                "= __val; __prof.domOps++; }\n",
+                id, id);
+      else
+        fprintf(out,
+                "          if (__tn%d.textContent !== __val) __tn%d.textContent "
+                "= __val;\n",
+                id, id);
       fprintf(out, "        };\n");
+      fprintf(out, "        __tn%d.__deps = 0x%x;\n", id, nw_deps(n->dep_mask));
       fprintf(out, "        __tn%d.__forgeUpdate();\n", id);
-      fprintf(out, "        this._exprNodes.push(__tn%d);\n", id);
-      fprintf(out, "        if (!this._hydrate) {\n");
-      fprintf(out,
-              "          if (__tn%d.setAttribute) "
-              "__tn%d.setAttribute('data-fexpr', '%d');\n",
-              id, id, id);
-      fprintf(out, "          %s.appendChild(__tn%d);\n", parent_var, id);
-      fprintf(out, "        }\n");
+      fprintf(out, "        %s.push(__tn%d);\n", _nw_exprs, id);
+      if (_nw_in_cluster) {
+        fprintf(out, "      }\n");
+        break;
+      }
+      if (nw_hydrating())
+        fprintf(out, "        if (!__tn%d.parentNode) %s.appendChild(__tn%d);\n",
+                id, parent_var, id);
+      else
+        fprintf(out, "        %s.appendChild(__tn%d);\n", parent_var, id);
       fprintf(out, "      }\n");
     }
     break;
@@ -188,17 +667,18 @@ static void emit_nw_html(const HtmlNode *n, const char *parent_var,
     char ctag[256];
     kebab(ctag, n->tag ? n->tag : "div");
     fprintf(out, "      { \n");
-    /* Try to reuse existing element during hydration; fall back to createElement
-     * if querySelector returns null (e.g. SSR content has no data-fid markers) */
-    fprintf(out,
-            "        let __cc%d = this._hydrate ? "
-            "%s.querySelector(':scope > forge-%s[data-fid=\"%d\"]') : null;\n",
-            id, parent_var, ctag, id);
+    /* Reuse the server-rendered host during hydration; create it when the
+     * markup has none at this position */
+    if (nw_hydrating())
+      fprintf(out,
+              "        let __cc%d = %s && __forgeAt(%s, %d, 'forge-%s') || null;\n",
+              id, _nw_hydrate, parent_var, _nw_slot_el, ctag);
+    else
+      fprintf(out, "        let __cc%d = null;\n", id);
     fprintf(out, "        const __cc_new%d = !__cc%d;\n", id, id);
-    fprintf(out, "        if (!__cc%d) {\n", id);
-    fprintf(out, "          __cc%d = document.createElement('forge-%s');\n", id, ctag);
-    fprintf(out, "          __cc%d.setAttribute('data-fid', '%d');\n", id, id);
-    fprintf(out, "        }\n");
+    fprintf(out,
+            "        if (!__cc%d) __cc%d = document.createElement('forge-%s');\n",
+            id, id, ctag);
     /* Set props BEFORE appendChild so connectedCallback sees them */
     for (int i = 0; i < n->attr_count; i++) {
       const char *aname = n->attrs[i].name;
@@ -217,14 +697,14 @@ static void emit_nw_html(const HtmlNode *n, const char *parent_var,
     fprintf(out, "        if (__cc_new%d) %s.appendChild(__cc%d);\n",
             id, parent_var, id);
 
-    /* For singleton components (not inside a <for> loop), register a prop
-     * updater so app._refresh() keeps props in sync with parent state.
-     * Inside <for> loops (local_item != NULL) the loop's own attrUpdater
-     * recreates child elements with fresh props on each refresh. */
-    if (!local_item) {
+    /* Register a prop updater so _refresh() keeps props in sync with parent
+     * state.  Inside <for> rows it lands in the row's own updater list and
+     * runs whenever the reconciler reuses the row. */
+    {
       int has_expr = 0;
+      unsigned deps = 0;
       for (int i = 0; i < n->attr_count; i++)
-        if (n->attrs[i].is_expr) { has_expr = 1; break; }
+        if (n->attrs[i].is_expr) { has_expr = 1; deps |= n->attrs[i].dep_mask; }
       if (has_expr) {
         fprintf(out, "      ((ref) => {\n");
         fprintf(out, "        const __ae%d_p = () => {\n", id);
@@ -233,12 +713,13 @@ static void emit_nw_html(const HtmlNode *n, const char *parent_var,
           const char *aval  = n->attrs[i].value ? n->attrs[i].value : "";
           if (n->attrs[i].is_expr) {
             fprintf(out, "          ref['%s'] = ", aname);
-            emit_expr_js(aval, out, NULL);
+            emit_expr_js(aval, out, local_item);
             fprintf(out, ";\n");
           }
         }
         fprintf(out, "        };\n");
-        fprintf(out, "        this._attrUpdaters.push(__ae%d_p);\n", id);
+        fprintf(out, "        __ae%d_p.__deps = 0x%x;\n", id, nw_deps(deps));
+        fprintf(out, "        %s.push(__ae%d_p);\n", _nw_updaters, id);
         fprintf(out, "      })(__cc%d);\n", id);
       }
     }
@@ -248,13 +729,21 @@ static void emit_nw_html(const HtmlNode *n, const char *parent_var,
   }
 
   case HTML_ELEMENT: {
+    if (emit_nw_cluster(n, parent_var, comp, out, local_item))
+      break;
     int id = _nw_id++;
-    fprintf(out,
-            "      const __e%d = this._hydrate ? "
-            "(%s.querySelector('[data-fid=\"%d\"]') || "
-            "document.createElement('%s')) : document.createElement('%s');\n",
-            id, parent_var, id, n->tag ? n->tag : "div",
-            n->tag ? n->tag : "div");
+    const char *etag = n->tag ? n->tag : "div";
+    int hydrate = !_nw_in_cluster && nw_hydrating();
+    if (hydrate) {
+      fprintf(out,
+              "      const __e%d = %s && __forgeAt(%s, %d, '%s') || "
+              "document.createElement('%s');\n",
+              id, _nw_hydrate, parent_var, _nw_slot_el, etag, etag);
+      fprintf(out, "      const __h%d = !!__e%d.parentNode;\n", id, id);
+    } else if (!_nw_in_cluster) {
+      fprintf(out, "      const __e%d = document.createElement('%s');\n", id,
+              etag);
+    }
 
     /* Attributes */
     for (int i = 0; i < n->attr_count; i++) {
@@ -290,7 +779,14 @@ static void emit_nw_html(const HtmlNode *n, const char *parent_var,
           }
           fprintf(out, ";\n");
         }
-        fprintf(out, "        this._refresh();\n");
+        /* No known deps: mark everything, since another listener may have
+         * set bits this batch and `_dirty || -1` would not fall back */
+        unsigned dirty = nw_event_deps(comp, &n->attrs[i]);
+        if (dirty)
+          fprintf(out, "        this._dirty |= 0x%x;\n", dirty);
+        else
+          fprintf(out, "        this._dirty |= -1;\n");
+        fprintf(out, "        __forgeSchedule(this);\n");
         fprintf(out, "      });\n");
       } else if (n->attrs[i].is_expr) {
         int aid = _nw_id++;
@@ -298,128 +794,84 @@ static void emit_nw_html(const HtmlNode *n, const char *parent_var,
         fprintf(out, "          __e%d.setAttribute('%s', String(", id, aname);
         emit_expr_js(aval, out, local_item);
         fprintf(out, "));\n");
+        if (_nw_profile)
+          fprintf(out, "          __prof.domOps++;\n");
         fprintf(out, "        };\n");
+        fprintf(out, "        __ae%d.__deps = 0x%x;\n", aid,
+                nw_deps(n->attrs[i].dep_mask));
         fprintf(out, "        __ae%d();\n", aid);
-        fprintf(out, "        this._attrUpdaters.push(__ae%d);\n", aid);
+        fprintf(out, "        %s.push(__ae%d);\n", _nw_updaters, aid);
         fprintf(out, "      }\n");
-      } else {
+      } else if (!_nw_in_cluster) {
         fprintf(out, "      __e%d.setAttribute('%s', ", id, aname);
         emit_js_str(aval, out);
         fprintf(out, ");\n");
       }
     }
 
-    if (id == 0) {
-      /* Root element of component template */
-    }
-
-    /* Recurse children */
-    char child_var[64];
+    /* Children hydrate only if this element came from the server */
+    char child_var[64], child_hydrate[64];
     snprintf(child_var, sizeof(child_var), "__e%d", id);
-    for (int i = 0; i < n->child_count; i++) {
-      /* Merge consecutive HTML_TEXT children into one text node */
-      if (n->children[i].kind == HTML_TEXT && n->children[i].text) {
-        int j = i;
-        while (j < n->child_count && n->children[j].kind == HTML_TEXT &&
-               n->children[j].text)
-          j++;
-        if (j > i) {
-          fprintf(out,
-                  "      if (!this._hydrate) "
-                  "%s.appendChild(document.createTextNode(",
-                  child_var);
-          int first = 1;
-          for (int k = i; k < j; k++) {
-            const char *t = n->children[k].text;
-            int all_ws = 1;
-            for (const char *c = t; *c; c++) {
-              if (*c != ' ' && *c != '\t' && *c != '\n' && *c != '\r') {
-                all_ws = 0;
-                break;
-              }
-            }
-            if (all_ws)
-              continue;
-            const char *ts = t;
-            while (*ts == ' ' || *ts == '\t' || *ts == '\n' || *ts == '\r')
-              ts++;
-            const char *te = t + strlen(t) - 1;
-            while (te > ts &&
-                   (*te == ' ' || *te == '\t' || *te == '\n' || *te == '\r'))
-              te--;
-            size_t tlen = (size_t)(te - ts + 1);
-            if (tlen == 0)
-              continue;
-            if (!first)
-              fprintf(out, " + ' ' + ");
-            fprintf(out, "'");
-            for (size_t ci = 0; ci < tlen; ci++) {
-              char ch = ts[ci];
-              if (ch == '\'')
-                fprintf(out, "\\'");
-              else if (ch == '\\')
-                fprintf(out, "\\\\");
-              else if (ch == '\n')
-                fprintf(out, " ");
-              else
-                fputc(ch, out);
-            }
-            fprintf(out, "'");
-            first = 0;
-          }
-          if (first)
-            fprintf(out, "''");
-          fprintf(out, "));\n");
-          i = j - 1;
-          continue;
-        }
-      }
-      emit_nw_html(&n->children[i], child_var, comp, out, local_item);
-    }
-
-    fprintf(out, "      if (!this._hydrate) %s.appendChild(__e%d);\n",
-            parent_var, id);
-    fprintf(out,
-            "      if (!this._hydrate) __e%d.setAttribute('data-fid', '%d');\n",
-            id, id);
+    snprintf(child_hydrate, sizeof(child_hydrate), "__h%d", id);
+    emit_nw_children(n, child_var, hydrate ? child_hydrate : _nw_hydrate, comp,
+                     out, local_item);
+
+    if (_nw_in_cluster)
+      break;
+    if (hydrate)
+      fprintf(out, "      if (!__h%d) %s.appendChild(__e%d);\n", id,
+              parent_var, id);
+    else
+      fprintf(out, "      %s.appendChild(__e%d);\n", parent_var, id);
     break;
   }
 
   case HTML_IF: {
     int id = _nw_id++;
     char *condition = "true";
+    unsigned cond_deps = 0;
     for (int i = 0; i < n->attr_count; i++) {
       if (strcmp(n->attrs[i].name, "condition") == 0) {
         condition = n->attrs[i].value;
+        cond_deps = n->attrs[i].dep_mask;
         break;
       }
     }
+    int hydrate = nw_hydrating();
     fprintf(out, "      { \n");
-    fprintf(out,
-            "        const __e%d = this._hydrate ? (%s.querySelector(':scope > "
-            "[data-fif=\"%d\"]') || document.createElement('div')) : "
-            "document.createElement('div');\n",
-            id, parent_var, id);
+    if (hydrate) {
+      fprintf(out,
+              "        const __e%d = %s && __forgeAt(%s, %d, 'div') || "
+              "document.createElement('div');\n",
+              id, _nw_hydrate, parent_var, _nw_slot_el);
+      fprintf(out, "        const __h%d = !!__e%d.parentNode;\n", id, id);
+    } else {
+      fprintf(out, "        const __e%d = document.createElement('div');\n", id);
+    }
     fprintf(out, "        __e%d.style.display = 'contents';\n", id);
-    fprintf(out, "        if (!this._hydrate) {\n");
-    fprintf(out, "          __e%d.setAttribute('data-fif', '%d');\n", id, id);
-    fprintf(out, "          %s.appendChild(__e%d);\n", parent_var, id);
-    fprintf(out, "        }\n");
+    if (hydrate)
+      fprintf(out, "        if (!__h%d) %s.appendChild(__e%d);\n", id,
+              parent_var, id);
+    else
+      fprintf(out, "        %s.appendChild(__e%d);\n", parent_var, id);
     /* Reactive toggle */
     fprintf(out, "        const __ae%d = () => {\n", id);
     fprintf(out, "          __e%d.style.display = (", id);
     emit_expr_js(condition, out, local_item);
     fprintf(out, ") ? 'contents' : 'none';\n");
+    if (_nw_profile)
+      fprintf(out, "          __prof.domOps++;\n");
     fprintf(out, "        };\n");
+    fprintf(out, "        __ae%d.__deps = 0x%x;\n", id, nw_deps(cond_deps));
     fprintf(out, "        __ae%d();\n", id);
-    fprintf(out, "        this._attrUpdaters.push(__ae%d);\n", id);
+    fprintf(out, "        %s.push(__ae%d);\n", _nw_updaters, id);
 
     /* Children */
-    char child_var[32];
+    char child_var[32], child_hydrate[32];
     sprintf(child_var, "__e%d", id);
-    for (int i = 0; i < n->child_count; i++) {
-      emit_nw_html(&n->children[i], child_var, comp, out, local_item);
-    }
+    sprintf(child_hydrate, "__h%d", id);
+    emit_nw_children(n, child_var, hydrate ? child_hydrate : _nw_hydrate, comp,
+                     out, local_item);
     fprintf(out, "      }\n");
     break;
   }
@@ -428,39 +880,458 @@ static void emit_nw_html(const HtmlNode *n, const char *parent_var,
     int id = _nw_id++;
     char *each = "[]";
     char *as = "item";
+    char *key = NULL;
+    const Attribute *item_height = nw_find_attr(n, "item-height");
+    const Attribute *overscan = nw_find_attr(n, "overscan");
+    int virt = nw_find_attr(n, "virtual") != NULL;
     for (int i = 0; i < n->attr_count; i++) {
       if (strcmp(n->attrs[i].name, "each") == 0)
         each = n->attrs[i].value;
       if (strcmp(n->attrs[i].name, "as") == 0)
         as = n->attrs[i].value;
+      if (strcmp(n->attrs[i].name, "key") == 0)
+        key = n->attrs[i].value;
+    }
+    if (nw_hydrating()) {
+      /* Server rows are dropped and rebuilt by the reconciler below */
+      fprintf(out,
+              "      const __e%d = %s && __forgeAt(%s, %d, 'div') || "
+              "document.createElement('div');\n",
+              id, _nw_hydrate, parent_var, _nw_slot_el);
+      fprintf(out, "      __e%d.style.display = 'contents';\n", id);
+      fprintf(out,
+              "      if (__e%d.parentNode) __e%d.textContent = ''; "
+              "else %s.appendChild(__e%d);\n",
+              id, id, parent_var, id);
+    } else {
+      fprintf(out, "      const __e%d = document.createElement('div');\n", id);
+      fprintf(out, "      __e%d.style.display = 'contents';\n", id);
+      fprintf(out, "      %s.appendChild(__e%d);\n", parent_var, id);
     }
-    fprintf(out, "      const __e%d = document.createElement('div');\n", id);
-    fprintf(out, "      __e%d.style.display = 'contents';\n", id);
-    fprintf(out, "      %s.appendChild(__e%d);\n", parent_var, id);
     fprintf(out, "      { \n");
+
+    /* Row factory: builds one row into a fragment and returns its top-level
+     * nodes plus the row-local updaters.  Rows own their updaters so the
+     * list can be reconciled without touching the component-wide lists. */
+    fprintf(out, "        const __mk%d = (__item) => {\n", id);
+    fprintf(out, "          let %s = __item;\n", as);
+    fprintf(out, "          const __rx = [], __ru = [];\n");
+    fprintf(out,
+            "          const __f%d = document.createDocumentFragment();\n", id);
+    {
+      const char *saved_exprs = _nw_exprs, *saved_updaters = _nw_updaters;
+      const char *saved_hydrate = _nw_hydrate;
+      _nw_exprs = "__rx";
+      _nw_updaters = "__ru";
+      _nw_hydrate = "false";
+      char frag_var[64];
+      snprintf(frag_var, sizeof(frag_var), "__f%d", id);
+      for (int i = 0; i < n->child_count; i++) {
+        emit_nw_html(&n->children[i], frag_var, comp, out, as);
+      }
+      _nw_exprs = saved_exprs;
+      _nw_updaters = saved_updaters;
+      _nw_hydrate = saved_hydrate;
+    }
+    fprintf(out, "          return {\n");
+    fprintf(out, "            key: undefined,\n");
+    fprintf(out, "            nodes: Array.from(__f%d.childNodes),\n", id);
+    fprintf(out, "            set: (v) => { %s = v; },\n", as);
+    fprintf(out, "            update: () => {\n");
+    fprintf(out, "              for (const fn of __rx) fn.__forgeUpdate();\n");
+    fprintf(out, "              for (const fn of __ru) fn();\n");
+    fprintf(out, "            },\n");
+    fprintf(out, "          };\n");
+    fprintf(out, "        };\n");
+
+    /* Reconciling updater: rows are matched by key={...} (index when no key
+     * is given), so only inserted/removed/moved rows touch the DOM.  A
+     * virtual list keeps only the visible window of those rows. */
+    if (virt) {
+      fprintf(out, "        const __v%d = __forgeVirtual(__e%d, __mk%d, ", id,
+              id, id);
+      emit_nw_number_attr(item_height, NW_VIRTUAL_ITEM_HEIGHT, out,
+                          local_item);
+      fprintf(out, ", ");
+      emit_nw_number_attr(overscan, NW_VIRTUAL_OVERSCAN, out, local_item);
+      fprintf(out, ");\n");
+    } else {
+      fprintf(out, "        let __rows%d = [];\n", id);
+    }
     fprintf(out, "        const __ae%d = () => {\n", id);
-    fprintf(out, "          __e%d.innerHTML = '';\n", id);
     fprintf(out, "          const __list = ");
     emit_expr_js(each, out, local_item);
     fprintf(out, ";\n");
-    fprintf(out, "          if (Array.isArray(__list)) {\n");
-    fprintf(out, "            __list.forEach((%s) => {\n", as);
-    char _for_var[64];
-    snprintf(_for_var, sizeof(_for_var), "__e%d", id);
-    for (int i = 0; i < n->child_count; i++) {
-      emit_nw_html(&n->children[i], _for_var, comp, out, as);
-    }
-    fprintf(out, "            });\n");
-    fprintf(out, "          }\n");
+    if (virt)
+      fprintf(out,
+              "          __v%d.update(Array.isArray(__list) ? __list : [],\n",
+              id);
+    else
+      fprintf(out,
+              "          __rows%d = __forgeReconcile(__e%d, __rows%d, "
+              "Array.isArray(__list) ? __list : [],\n",
+              id, id, id);
+    fprintf(out, "            (%s, __i) => (", as);
+    if (key && key[0])
+      emit_expr_js(key, out, as);
+    else
+      fprintf(out, "__i");
+    if (virt)
+      fprintf(out, "));\n");
+    else
+      fprintf(out, "), __mk%d);\n", id);
     fprintf(out, "        };\n");
+    /* Row expressions may read component fields too, so the block depends
+     * on its whole subtree, not just `each`. */
+    fprintf(out, "        __ae%d.__deps = 0x%x;\n", id, nw_deps(n->dep_mask));
     fprintf(out, "        __ae%d();\n", id);
-    fprintf(out, "        this._attrUpdaters.push(__ae%d);\n", id);
+    fprintf(out, "        %s.push(__ae%d);\n", _nw_updaters, id);
     fprintf(out, "      }\n");
     break;
   }
   }
 }
 
+/* Virtual list for <for virtual>: only rows intersecting the viewport (plus
+ * `overscan` on each side) are in the DOM, between two spacer divs that
+ * stand in for the rest.  Heights start at the item-height estimate and are
+ * replaced by measured sizes, cached per key, so variable-height rows settle
+ * after they are first seen.  Rows leaving the window go to a pool and are
+ * re-pointed at a new item (set + update) instead of being rebuilt.  The
+ * viewport is the window clipped to the nearest scrolling ancestor. */
+static void emit_nw_virtual_helpers(FILE *out) {
+  fprintf(out,
+          "function __forgeVirtual(parent, create, estimate, overscan) {\n"
+          "  const top = document.createElement('div');\n"
+          "  const bottom = document.createElement('div');\n"
+          "  parent.appendChild(top);\n"
+          "  parent.appendChild(bottom);\n"
+          "  const sizes = new Map(), rows = new Map(), pool = [];\n"
+          "  let list = [], keys = [], offs = new Float64Array(1);\n"
+          "  let stale = true, frame = 0, listening = false, scroller;\n"
+          "  const layout = () => {\n"
+          "    offs = new Float64Array(list.length + 1);\n"
+          "    for (let i = 0; i < list.length; i++)\n"
+          "      offs[i + 1] = offs[i] + (sizes.get(keys[i]) ?? estimate);\n"
+          "    stale = false;\n"
+          "  };\n"
+          "  const find = (y) => {\n"
+          "    let lo = 0, hi = list.length;\n"
+          "    while (lo < hi) {\n"
+          "      const mid = (lo + hi) >> 1;\n"
+          "      if (offs[mid + 1] <= y) lo = mid + 1; else hi = mid;\n"
+          "    }\n"
+          "    return lo;\n"
+          "  };\n"
+          "  const viewport = () => {\n"
+          "    if (scroller === undefined) {\n"
+          "      scroller = null;\n"
+          "      for (let n = parent.parentNode; n && n.nodeType === 1; n = "
+          "n.parentNode) {\n"
+          "        const o = getComputedStyle(n).overflowY;\n"
+          "        if (o === 'auto' || o === 'scroll') { scroller = n; break; }\n"
+          "      }\n"
+          "    }\n"
+          "    let lo = 0, hi = innerHeight;\n"
+          "    if (scroller) {\n"
+          "      const b = scroller.getBoundingClientRect();\n"
+          "      lo = Math.max(lo, b.top); hi = Math.min(hi, b.bottom);\n"
+          "    }\n"
+          "    const y = top.getBoundingClientRect().top;\n"
+          "    return [lo - y, hi - y];\n"
+          "  };\n"
+          "  const measure = (r) => {\n"
+          "    let h = 0;\n"
+          "    for (const n of r.nodes) if (n.nodeType === 1) h += n.offsetHeight;\n"
+          "    return h;\n"
+          "  };\n"
+          "  const render = (refresh) => {\n"
+          "    if (stale) layout();\n"
+          "    const n = list.length, [v0, v1] = viewport();\n"
+          "    const start = Math.max(0, find(v0) - overscan);\n"
+          "    const end = Math.min(n, find(Math.max(v0, v1)) + 1 + overscan);\n"
+          "    for (const [i, r] of rows) {\n"
+          "      if (i >= start && i < end && r.key === keys[i]) continue;\n"
+          "      for (const x of r.nodes) x.remove();\n"
+          "      rows.delete(i);\n"
+          "      pool.push(r);\n"
+          "    }\n"
+          "    let ref = bottom;\n"
+          "    for (let i = end - 1; i >= start; i--) {\n"
+          "      let r = rows.get(i);\n"
+          "      if (!r) {\n"
+          "        r = pool.pop();\n"
+          "        if (r) { r.set(list[i]); r.update(); } else r = "
+          "create(list[i]);\n"
+          "        r.key = keys[i];\n"
+          "        rows.set(i, r);\n"
+          "      } else if (refresh) { r.set(list[i]); r.update(); }\n"
+          "      const last = r.nodes[r.nodes.length - 1];\n"
+          "      if (last && last.nextSibling !== ref)\n"
+          "        for (const x of r.nodes) parent.insertBefore(x, ref);\n"
+          "      ref = r.nodes[0] || ref;\n"
+          "    }\n"
+          "    top.style.height = offs[start] + 'px';\n"
+          "    bottom.style.height = (offs[n] - offs[end]) + 'px';\n"
+          "    for (const [i, r] of rows) {\n"
+          "      const h = measure(r);\n"
+          "      if (h && h !== sizes.get(keys[i])) { sizes.set(keys[i], h); "
+          "stale = true; }\n"
+          "    }\n"
+          "    if (stale) schedule();\n"
+          "  };\n"
+          "  const schedule = () => {\n"
+          "    if (frame) return;\n"
+          "    frame = requestAnimationFrame(() => {\n"
+          "      frame = 0;\n"
+          "      if (top.isConnected) render(false);\n"
+          "    });\n"
+          "  };\n"
+          "  const onScroll = () => {\n"
+          "    if (top.isConnected) { schedule(); return; }\n"
+          "    document.removeEventListener('scroll', onScroll, true);\n"
+          "    removeEventListener('resize', onScroll);\n"
+          "    listening = false;\n"
+          "  };\n"
+          "  return {\n"
+          "    update(next, keyOf) {\n"
+          "      list = next;\n"
+          "      keys = list.map(keyOf);\n"
+          "      stale = true;\n"
+          "      if (!listening) {\n"
+          "        listening = true;\n"
+          "        document.addEventListener('scroll', onScroll, { capture: "
+          "true, passive: true });\n"
+          "        addEventListener('resize', onScroll);\n"
+          "      }\n"
+          "      render(true);\n"
+          "    },\n"
+          "  };\n"
+          "}\n\n");
+}
+
+/* True if the subtree rooted at n contains a node of the given kind. */
+static int html_has_kind(const HtmlNode *n, HtmlKind kind) {
+  if (!n)
+    return 0;
+  if (n->kind == kind)
+    return 1;
+  for (int i = 0; i < n->child_count; i++)
+    if (html_has_kind(&n->children[i], kind))
+      return 1;
+  return 0;
+}
+
+/* True if the subtree contains a <for virtual> */
+static int html_has_virtual_for(const HtmlNode *n) {
+  if (!n)
+    return 0;
+  if (n->kind == HTML_FOR && nw_find_attr(n, "virtual"))
+    return 1;
+  for (int i = 0; i < n->child_count; i++)
+    if (html_has_virtual_for(&n->children[i]))
+      return 1;
+  return 0;
+}
+
+/* Update scheduler shared by every Forge component on the page (it lives on
+ * globalThis because each component is its own module).  Setters and event
+ * listeners only queue the component; one microtask later the queue is
+ * flushed parents-first, so a child whose props are pushed by its parent's
+ * refresh is refreshed once with everything that changed in that tick.
+ * Components queued during a flush are picked up by the same flush. */
+static void emit_nw_scheduler(FILE *out) {
+  fprintf(out,
+          "const __forgeSched = globalThis.__forgeSched || "
+          "(globalThis.__forgeSched = (() => {\n"
+          "  let queue = [], pending = false;\n"
+          "  const depth = (el) => { let d = 0; for (let n = el; n; n = "
+          "n.parentNode) d++; return d; };\n"
+          "  const flush = () => {\n"
+          "    pending = false;\n"
+          "%s"
+          "    while (queue.length) {\n"
+          "      const batch = queue.map((el) => [depth(el), el]);\n"
+          "      queue = [];\n"
+          "      batch.sort((a, b) => a[0] - b[0]);\n"
+          "%s"
+          "      for (const [, el] of batch) {\n"
+          "        if (!el._queued) continue;\n"
+          "        el._queued = false;\n"
+          "        if (el._mounted) el._refresh();\n"
+          "      }\n"
+          "    }\n"
+          "%s"
+          "  };\n"
+          "  const schedule = (el) => {\n"
+          "    if (el._queued) return;\n"
+          "    el._queued = true;\n"
+          "    queue.push(el);\n"
+          "    if (!pending) { pending = true; queueMicrotask(flush); }\n"
+          "  };\n"
+          "  return { schedule, flush };\n"
+          "})());\n"
+          "const __forgeSchedule = __forgeSched.schedule;\n\n",
+          _nw_profile ? "    const t0 = performance.now();\n" : "",
+          _nw_profile ? "      __forgeProf.queued(batch.length);\n" : "",
+          _nw_profile ? "    __forgeProf.flushed(t0);\n" : "");
+}
+
+/* --profile: counters shared by every component module on the page, read
+ * by the forge-dev overlay.  Each component has a `components` entry;
+ * `flush` covers the scheduler (flushes, most components refreshed in one
+ * batch, time).  Renders, refreshes and flushes are also recorded as
+ * performance.measure() entries, named "forge:<Component> render" and so
+ * on; ours are cleared every few thousand to keep the buffer bounded. */
+static void emit_nw_profiler(FILE *out) {
+  fprintf(out,
+          "const __forgeProf = globalThis.__forgeProf || "
+          "(globalThis.__forgeProf = (() => {\n"
+          "  const components = {};\n"
+          "  const flush = { count: 0, peak: 0, ms: 0 };\n"
+          "  const names = new Set();\n"
+          "  let measures = 0;\n"
+          "  const measure = (name, start) => {\n"
+          "    const end = performance.now();\n"
+          "    if (performance.measure) {\n"
+          "      performance.measure(name, { start, end });\n"
+          "      names.add(name);\n"
+          "      if (++measures >= 8192) {\n"
+          "        for (const n of names) performance.clearMeasures(n);\n"
+          "        names.clear();\n"
+          "        measures = 0;\n"
+          "      }\n"
+          "    }\n"
+          "    return end - start;\n"
+          "  };\n"
+          "  const component = (name) => components[name] || (components[name] = "
+          "{\n"
+          "    name, renders: 0, refreshes: 0, updaters: 0, domOps: 0, "
+          "renderMs: 0, refreshMs: 0 });\n"
+          "  const rendered = (c, start) => { c.renders++; c.renderMs += "
+          "measure(`forge:${c.name} render`, start); };\n"
+          "  const refreshed = (c, start, n) => {\n"
+          "    c.refreshes++; c.updaters += n;\n"
+          "    c.refreshMs += measure(`forge:${c.name} refresh`, start);\n"
+          "  };\n"
+          "  const queued = (n) => { if (n > flush.peak) flush.peak = n; };\n"
+          "  const flushed = (start) => { flush.count++; flush.ms += "
+          "measure('forge:flush', start); };\n"
+          "  return { components, flush, component, rendered, refreshed, "
+          "queued, flushed };\n"
+          "})());\n\n");
+}
+
+/* Hydration lookups.  Server markup (binding_gen_prerender and the SSR
+ * renderer) has the same element structure as the template, and each
+ * {expr} is a <!----> marker followed by its text (<!--/--> separates it
+ * from static text that follows).  __forgeAt() returns the i-th element
+ * child if it has the expected tag; __forgeHole() the text node of the k-th
+ * marker, creating it after an empty one.  Markers are collected once per
+ * parent, so hydration visits each server node a constant number of times.
+ *
+ * hydrate="idle" on a host defers hydration until the page is idle or the
+ * user first interacts with the component. */
+static void emit_nw_hydrate_helpers(FILE *out) {
+  fprintf(out,
+          "function __forgeAt(el, i, tag) {\n"
+          "  const n = el && el.children[i];\n"
+          "  return n && n.localName === tag ? n : null;\n"
+          "}\n"
+          "function __forgeHole(el, k) {\n"
+          "  if (!el) return null;\n"
+          "  let m = el.__forgeMarks;\n"
+          "  if (!m) {\n"
+          "    m = el.__forgeMarks = [];\n"
+          "    for (let n = el.firstChild; n; n = n.nextSibling)\n"
+          "      if (n.nodeType === 8 && n.data === '') m.push(n);\n"
+          "  }\n"
+          "  const c = m[k];\n"
+          "  if (!c) { console.warn(`Forge: Hydration marker ${k} not found in`, "
+          "el); return null; }\n"
+          "  const t = c.nextSibling;\n"
+          "  if (t && t.nodeType === 3) return t;\n"
+          "  return el.insertBefore(document.createTextNode(''), t);\n"
+          "}\n"
+          "function __forgeIdle(el, mount) {\n"
+          "  const wake = ['pointerdown', 'focusin', 'keydown'];\n"
+          "  const run = () => {\n"
+          "    for (const t of wake) el.removeEventListener(t, run, true);\n"
+          "    if (el.isConnected && !el._mounted) mount();\n"
+          "  };\n"
+          "  for (const t of wake) el.addEventListener(t, run, true);\n"
+          "  if (globalThis.requestIdleCallback) requestIdleCallback(run, "
+          "{ timeout: 2000 });\n"
+          "  else setTimeout(run, 200);\n"
+          "}\n\n");
+}
+
+/* Module-level list reconciler shared by every <for> block in the file.
+ *
+ * Old rows are matched to new items by key; unmatched rows are removed and
+ * missing ones created.  Rows whose old positions form the longest
+ * increasing subsequence stay put — everything else is moved with one
+ * insertBefore per node, walking from the end so the reference node is
+ * always already in its final place. */
+static void emit_nw_reconcile_helpers(FILE *out) {
+  fprintf(out,
+          "function __forgeLis(a) {\n"
+          "  const p = new Int32Array(a.length), m = [];\n"
+          "  for (let i = 0; i < a.length; i++) {\n"
+          "    const v = a[i];\n"
+          "    if (v < 0) continue;\n"
+          "    let lo = 0, hi = m.length;\n"
+          "    while (lo < hi) {\n"
+          "      const mid = (lo + hi) >> 1;\n"
+          "      if (a[m[mid]] < v) lo = mid + 1; else hi = mid;\n"
+          "    }\n"
+          "    p[i] = lo > 0 ? m[lo - 1] : -1;\n"
+          "    m[lo] = i;\n"
+          "  }\n"
+          "  const out = new Array(m.length);\n"
+          "  for (let i = m.length - 1, k = m[m.length - 1]; i >= 0; i--) {\n"
+          "    out[i] = k;\n"
+          "    k = p[k];\n"
+          "  }\n"
+          "  return out;\n"
+          "}\n\n");
+  fprintf(out,
+          "function __forgeReconcile(parent, rows, list, keyOf, create) {\n"
+          "  const oldIdx = new Map();\n"
+          "  for (let j = 0; j < rows.length; j++)\n"
+          "    if (!oldIdx.has(rows[j].key)) oldIdx.set(rows[j].key, j);\n"
+          "  const next = new Array(list.length);\n"
+          "  const src = new Int32Array(list.length);\n"
+          "  const used = new Uint8Array(rows.length);\n"
+          "  for (let i = 0; i < list.length; i++) {\n"
+          "    const k = keyOf(list[i], i);\n"
+          "    const j = oldIdx.get(k);\n"
+          "    if (j !== undefined && !used[j]) {\n"
+          "      used[j] = 1;\n"
+          "      rows[j].set(list[i]);\n"
+          "      rows[j].update();\n"
+          "      next[i] = rows[j];\n"
+          "      src[i] = j;\n"
+          "    } else {\n"
+          "      next[i] = create(list[i]);\n"
+          "      next[i].key = k;\n"
+          "      src[i] = -1;\n"
+          "    }\n"
+          "  }\n"
+          "  for (let j = 0; j < rows.length; j++)\n"
+          "    if (!used[j]) for (const n of rows[j].nodes) n.remove();\n"
+          "  const keep = __forgeLis(src);\n"
+          "  let ref = null;\n"
+          "  for (let i = next.length - 1, l = keep.length - 1; i >= 0; i--) {\n"
+          "    const r = next[i];\n"
+          "    if (l >= 0 && keep[l] === i) l--;\n"
+          "    else for (const n of r.nodes) parent.insertBefore(n, ref);\n"
+          "    ref = r.nodes[0] || ref;\n"
+          "  }\n"
+          "  return next;\n"
+          "}\n\n");
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════ *
  *  NO-WASM BINDING: Self-contained JS component with full DOM rendering     *
  * ═══════════════════════════════════════════════════════════════════════════
@@ -482,6 +1353,18 @@ static int emit_nowasm_component(const ComponentNode *c,
           " */\n\n",
           c->name, c->name);
 
+  _nw_profile = opts && opts->profile;
+  if (_nw_profile)
+    emit_nw_profiler(out);
+  emit_nw_scheduler(out);
+  if (_nw_profile)
+    fprintf(out, "const __prof = __forgeProf.component('%s');\n\n", c->name);
+  emit_nw_hydrate_helpers(out);
+  if (html_has_kind(c->template_root, HTML_FOR))
+    emit_nw_reconcile_helpers(out);
+  if (html_has_virtual_for(c->template_root))
+    emit_nw_virtual_helpers(out);
+
   /* Start class */
   fprintf(out, "class %s extends HTMLElement {\n", c->name);
   fprintf(out, "  static tag = 'forge-%s';\n\n", tag);
@@ -493,6 +1376,8 @@ static int emit_nowasm_component(const ComponentNode *c,
   fprintf(out, "    this._state = {};\n");
   fprintf(out, "    this._exprNodes = [];\n");
   fprintf(out, "    this._attrUpdaters = [];\n");
+  fprintf(out, "    this._dirty = 0;\n");
+  fprintf(out, "    this._queued = false;\n");
   fprintf(out, "    this._mounted = false;\n");
   fprintf(out, "  }\n\n");
 
@@ -510,7 +1395,8 @@ static int emit_nowasm_component(const ComponentNode *c,
               "    if (val !== undefined) this._props['%s'] = Number(val);\n",
               pname);
     }
-    fprintf(out, "    if (this._mounted) this._refresh();\n");
+    fprintf(out, "    this._dirty |= 0x%x;\n", analyzer_dep_bit(c, 1, i));
+    fprintf(out, "    if (this._mounted) __forgeSchedule(this);\n");
     fprintf(out, "  }\n\n");
   }
 
@@ -623,13 +1509,23 @@ static int emit_nowasm_component(const ComponentNode *c,
             fprintf(out, "return `");
             int vi = 0;
             for (const char *f = fmt; *f; f++) {
+              if (*f == '%' && f[1] == '%') {
+                f++;
+                fputc('%', out);
+                continue;
+              }
               if (*f == '%') {
                 f++; /* skip '%' */
-                /* skip flags: -, +, space, 0, # */
+                /* flags: -, +, space, 0, # */
+                int left = 0, zero = 0;
                 while (*f == '-' || *f == '+' || *f == ' ' ||
-                       *f == '0'  || *f == '#') f++;
-                /* skip width digits */
-                while (*f >= '0' && *f <= '9') f++;
+                       *f == '0'  || *f == '#') {
+                  if (*f == '-') left = 1;
+                  if (*f == '0') zero = 1;
+                  f++;
+                }
+                int width = 0;
+                while (*f >= '0' && *f <= '9') width = width * 10 + (*f++ - '0');
                 /* optional precision: .N */
                 int prec = -1;
                 if (*f == '.') {
@@ -640,20 +1536,31 @@ static int emit_nowasm_component(const ComponentNode *c,
                     f++;
                   }
                 }
-                /* f now at conversion char */
-                if (*f == 'f' || *f == 'e' || *f == 'g') {
+                /* length modifiers carry no meaning in JS */
+                while (*f == 'h' || *f == 'l' || *f == 'z') f++;
+                if (!*f) break;
+                /* f now at conversion char; width pads the converted text
+                 * the way the runtime's forge_str_vfmt does */
+                fprintf(out, width ? "${String(" : "${");
+                if (*f == 'f' || *f == 'F' || *f == 'e' || *f == 'g') {
                   /* Coerce with (+x||0) so string prices or undefined don't crash */
-                  if (prec >= 0) fprintf(out, "${(+__v%d||0).toFixed(%d)}", vi, prec);
-                  else           fprintf(out, "${(+__v%d||0).toFixed(2)}", vi);
+                  fprintf(out, "(+__v%d||0).toFixed(%d)", vi, prec >= 0 ? prec : 2);
                 } else if (*f == 'd' || *f == 'i' || *f == 'u') {
-                  fprintf(out, "${Math.floor(+__v%d||0)}", vi);
-                } else if (*f == 's') {
-                  fprintf(out, "${__v%d}", vi);
-                } else if (*f) {
-                  /* unknown specifier — emit literally */
-                  fprintf(out, "%%");
-                  fputc(*f, out);
+                  fprintf(out, "Math.floor(+__v%d||0)", vi);
+                } else if (*f == 'x' || *f == 'X') {
+                  fprintf(out, "(Math.floor(+__v%d||0) >>> 0).toString(16)%s",
+                          vi, *f == 'X' ? ".toUpperCase()" : "");
+                } else if (*f == 'c') {
+                  fprintf(out, "String.fromCharCode(__v%d)", vi);
+                } else if (*f == 's' && prec >= 0) {
+                  fprintf(out, "String(__v%d).slice(0, %d)", vi, prec);
+                } else {
+                  fprintf(out, "__v%d", vi);
                 }
+                if (width)
+                  fprintf(out, ").%s(%d, '%c')", left ? "padEnd" : "padStart",
+                          width, zero && !left && *f != 's' ? '0' : ' ');
+                fputc('}', out);
                 vi++;
               } else if (*f == '`') {
                 fprintf(out, "\\`");
@@ -695,29 +1602,52 @@ static int emit_nowasm_component(const ComponentNode *c,
     fprintf(out, "  }\n\n");
   }
 
-  /* Refresh: re-evaluate all reactive expressions and dynamic attributes */
+  /* Refresh: re-evaluate reactive expressions and dynamic attributes whose
+   * dependency mask overlaps the dirty fields.  Nothing marked dirty (e.g. a
+   * caller mutated this._state directly) means refresh everything. */
   fprintf(out, "  _refresh() {\n");
-  fprintf(out, "    for (const fn of this._exprNodes) { if (fn.__forgeUpdate) "
-               "fn.__forgeUpdate(); }\n");
-  fprintf(out, "    for (const fn of this._attrUpdaters) fn();\n");
+  if (_nw_profile) {
+    /* The refresh closing _render() (not yet mounted) counts as render */
+    fprintf(out, "    const __t0 = performance.now();\n");
+    fprintf(out, "    const __d = this._dirty || -1;\n");
+    fprintf(out, "    this._dirty = 0;\n");
+    fprintf(out, "    let __n = 0;\n");
+    fprintf(out, "    for (const fn of this._exprNodes) { if (fn.__forgeUpdate && "
+                 "(fn.__deps & __d)) { fn.__forgeUpdate(); __n++; } }\n");
+    fprintf(out, "    for (const fn of this._attrUpdaters) { if (fn.__deps & __d) "
+                 "{ fn(); __n++; } }\n");
+    fprintf(out, "    if (this._mounted) __forgeProf.refreshed(__prof, __t0, __n);\n");
+  } else {
+    fprintf(out, "    const __d = this._dirty || -1;\n");
+    fprintf(out, "    this._dirty = 0;\n");
+    fprintf(out, "    for (const fn of this._exprNodes) { if (fn.__forgeUpdate && "
+                 "(fn.__deps & __d)) fn.__forgeUpdate(); }\n");
+    fprintf(out, "    for (const fn of this._attrUpdaters) { if (fn.__deps & __d) "
+                 "fn(); }\n");
+  }
   fprintf(out, "  }\n\n");
 
   /* Render: build or hydrate DOM */
   fprintf(out, "  _render() {\n");
-  fprintf(out, "    this._hydrate = this.innerHTML.trim() !== '';\n");
+  if (_nw_profile)
+    fprintf(out, "    const __t0 = performance.now();\n");
+  fprintf(out, "    this._hydrate = this.firstElementChild !== null;\n");
   fprintf(out, "    this._exprNodes = [];\n");
-  fprintf(out, "    this._attrUpdaters = [];\n\n");
+  fprintf(out, "    this._attrUpdaters = [];\n");
+  fprintf(out, "    this._dirty = 0;\n");
+  fprintf(out, "    this._queued = false;\n\n");
   fprintf(
       out,
       "    if (this._hydrate) { console.log(`Forge: Hydrating "
       "${this.localName} with ${this.attributes.length} attributes`); }\n\n");
 
-  /* Inject scoped CSS */
+  /* Inject scoped CSS, keyed by tag: forge-dev's hot swap removes it as
+   * forge-style-<tag> */
   if (c->style_count > 0) {
     fprintf(out, "    if (!document.getElementById('forge-style-%s')) {\n",
-            lname);
+            tag);
     fprintf(out, "      const __style = document.createElement('style');\n");
-    fprintf(out, "      __style.id = 'forge-style-%s';\n", lname);
+    fprintf(out, "      __style.id = 'forge-style-%s';\n", tag);
     fprintf(out, "      __style.textContent = `forge-%s {\n", tag);
     for (int i = 0; i < c->style_count; i++) {
       if (!c->style[i].is_dynamic) {
@@ -732,17 +1662,31 @@ static int emit_nowasm_component(const ComponentNode *c,
 
   /* Emit DOM tree from template */
   _nw_id = 0;
+  _nw_tpl_count = 0;
+  _nw_slot_el = 0;
+  _nw_slot_mark = 0;
   if (c->template_root) {
     emit_nw_html(c->template_root, "this", c, out, NULL);
   }
 
   fprintf(out, "    this._refresh();\n");
+  if (_nw_profile)
+    fprintf(out, "    __forgeProf.rendered(__prof, __t0);\n");
   fprintf(out, "  }\n\n");
 
   /* Lifecycle: connectedCallback */
   fprintf(out, "  connectedCallback() {\n");
   fprintf(out, "    this._syncProps();\n");
   fprintf(out, "    this._initState();\n");
+  fprintf(out, "    if (this.getAttribute('hydrate') === 'idle' && "
+               "this.firstElementChild) {\n");
+  fprintf(out, "      __forgeIdle(this, () => { this._syncProps(); "
+               "this._mount(); });\n");
+  fprintf(out, "      return;\n");
+  fprintf(out, "    }\n");
+  fprintf(out, "    this._mount();\n");
+  fprintf(out, "  }\n\n");
+  fprintf(out, "  _mount() {\n");
   fprintf(out, "    this._render();\n");
   fprintf(out, "    this._mounted = true;\n");
   fprintf(out, "  }\n\n");
@@ -753,9 +1697,10 @@ static int emit_nowasm_component(const ComponentNode *c,
   fprintf(out, "  }\n\n");
 
   /* Lifecycle: attributeChangedCallback */
+  /* Through the prop setter: marks the field dirty and schedules a refresh
+   * instead of re-rendering (which would hydrate the live DOM again) */
   fprintf(out, "  attributeChangedCallback(name, oldVal, newVal) {\n");
-  fprintf(out, "    this._props[name] = newVal;\n");
-  fprintf(out, "    if (this._mounted) { this._render(); }\n");
+  fprintf(out, "    this[name] = newVal;\n");
   fprintf(out, "  }\n\n");
 
   /* Sync props from attributes and JS properties */
@@ -786,16 +1731,24 @@ static int emit_nowasm_component(const ComponentNode *c,
             c->state[i].name);
     fprintf(out, "  set %s(val) {\n", c->state[i].name);
     fprintf(out, "    this._state.%s = val;\n", c->state[i].name);
-    fprintf(out, "    this._refresh();\n");
+    fprintf(out, "    this._dirty |= 0x%x;\n", analyzer_dep_bit(c, 0, i));
+    fprintf(out, "    if (this._mounted) __forgeSchedule(this);\n");
     fprintf(out, "  }\n\n");
   }
 
   fprintf(out, "}\n\n");
 
-  /* Register custom element */
+  /* Templates referenced by __forgeClone() in _render() */
+  emit_nw_templates(out);
+
+  /* Register custom element.  A re-import (forge-dev hot update) cannot
+   * redefine the tag, so hand the new class to the dev client instead. */
   if (!opts || opts->web_component) {
     fprintf(out, "if (!customElements.get('forge-%s')) {\n", tag);
     fprintf(out, "  customElements.define('forge-%s', %s);\n", tag, c->name);
+    fprintf(out, "} else if (globalThis.__forgeHot) {\n");
+    fprintf(out, "  globalThis.__forgeHot(customElements.get('forge-%s'), %s);\n",
+            tag, c->name);
     fprintf(out, "}\n\n");
   }
 
@@ -841,21 +1794,21 @@ static int emit_wasm_component(const ComponentNode *c,
   }
 
   /* ── WASM loader ── */
-  fprintf(out, "let __wasm_%s = null;\n\n", lname);
+  /* loadWasm streams and instantiates each URL once, so under --bundle
+   * every component of the page shares one fetch, compile and instance */
+  fprintf(out, "let __wasm_%s = null;\n", lname);
+  fprintf(out, "let __props_%s = null; /* props layout from the module's schema */\n\n",
+          lname);
   fprintf(out, "async function __load_%s() {\n", lname);
-  fprintf(out, "  const url = new URL('./%s.wasm', import.meta.url);\n",
-          c->name);
-  fprintf(out, "  const res = await fetch(url);\n");
-  fprintf(out,
-          "  if (!res.ok) throw new Error(`[Forge] Failed to load %s.wasm: "
-          "${res.status}`);\n",
-          c->name);
-  fprintf(out, "  const buf  = await res.arrayBuffer();\n");
-  fprintf(out, "  const env  = ForgeRuntime.wasmImports('%s');\n", lname);
-  fprintf(out, "  const inst = await WebAssembly.instantiate(buf, { env });\n");
-  fprintf(out, "  __wasm_%s = inst.instance.exports;\n", lname);
+  if (opts && opts->bundle)
+    fprintf(out, "  const url = new URL('./%s', import.meta.url);\n", opts->bundle);
+  else
+    fprintf(out, "  const url = new URL('./%s.wasm', import.meta.url);\n", c->name);
+  fprintf(out, "  __wasm_%s = await ForgeRuntime.loadWasm(url);\n", lname);
   fprintf(out, "  ForgeRuntime.registerExports('%s', __wasm_%s);\n", lname,
           lname);
+  fprintf(out, "  __props_%s = ForgeRuntime.propsLayout(__wasm_%s, '%s', %s.observedProps);\n",
+          lname, lname, lname, c->name);
   fprintf(out, "}\n\n");
   fprintf(out, "const __%s_ready = __load_%s();\n\n", lname, lname);
 
@@ -871,32 +1824,42 @@ static int emit_wasm_component(const ComponentNode *c,
   }
   fprintf(out, "];\n\n");
 
-  /* mount */
+  /* mount: props go into the module's staging block (handle 0), which
+   * forge_mount copies into the new context */
   fprintf(out, "  mount(el) {\n");
-  fprintf(out, "    const json = ForgeRuntime.serializeProps(this._props);\n");
-  fprintf(out,
-          "    __wasm_%s.forge_mount_%s(el.__forgeId, json.ptr, json.len);\n",
+  fprintf(out, "    this._propVals = [];\n");
+  fprintf(out, "    ForgeRuntime.writeProps(__props_%s, __wasm_%s.forge_props_ptr_%s(0), "
+               "this._props, this._propVals);\n",
+          lname, lname, lname);
+  fprintf(out, "    this._ctxHandle = __wasm_%s.forge_mount_%s(el.__forgeId);\n",
           lname, lname);
   fprintf(out, "  }\n\n");
 
-  /* update */
+  /* update: write only the fields that changed, in place, and pass their
+   * mask so the context's dirty bits name exactly those props */
   fprintf(out, "  update(el, newProps) {\n");
-  fprintf(out, "    const json = ForgeRuntime.serializeProps(newProps);\n");
-  fprintf(out,
-          "    __wasm_%s.forge_update_%s(el.__forgeId, json.ptr, json.len);\n",
+  fprintf(out, "    const ptr = __wasm_%s.forge_props_ptr_%s(this._ctxHandle);\n",
+          lname, lname);
+  fprintf(out, "    if (!ptr) return;\n");
+  fprintf(out, "    const changed = ForgeRuntime.writeProps(__props_%s, ptr, newProps, "
+               "this._propVals);\n",
+          lname);
+  fprintf(out, "    if (changed) __wasm_%s.forge_update_%s(this._ctxHandle, changed);\n",
           lname, lname);
   fprintf(out, "  }\n\n");
 
   /* dispatch */
   fprintf(out, "  dispatch(el, event) {\n");
   fprintf(out, "    const ev = ForgeRuntime.serializeEvent(event);\n");
-  fprintf(out, "    __wasm_%s.forge_dispatch_%s(el.__forgeId, ev.ptr);\n",
+  fprintf(out, "    __wasm_%s.forge_dispatch_%s(this._ctxHandle, ev.ptr);\n",
           lname, lname);
   fprintf(out, "  }\n\n");
 
   /* unmount */
   fprintf(out, "  unmount(el) {\n");
-  fprintf(out, "    __wasm_%s.forge_unmount_%s(el.__forgeId);\n", lname, lname);
+  fprintf(out, "    __wasm_%s.forge_unmount_%s(this._ctxHandle);\n", lname, lname);
+  fprintf(out, "    ForgeRuntime.releaseProps(__props_%s, this._propVals);\n", lname);
+  fprintf(out, "    this._ctxHandle = 0;\n");
   fprintf(out, "  }\n");
 
   fprintf(out, "}\n\n");
@@ -990,14 +1953,42 @@ int binding_gen_types(const ComponentNode *c, FILE *out) {
 /* ─── Pre-rendering (SSG) ───────────────────────────────────────────────────
  */
 
-static int _prerender_id = 0;
+/* Same element structure as the no-wasm renderer builds, with no id
+ * attributes: hydration finds nodes by position (see __forgeAt and
+ * __forgeHole).  {expr} holes are empty <!----> markers. */
+
+static void emit_prerender_html_recursive(const HtmlNode *n,
+                                          const ComponentNode **registry,
+                                          int registry_count, FILE *out);
+
+static void emit_prerender_children(const HtmlNode *n,
+                                    const ComponentNode **registry,
+                                    int registry_count, FILE *out) {
+  for (int i = 0; i < n->child_count; i++) {
+    const HtmlNode *ch = &n->children[i];
+    if (ch->kind == HTML_TEXT && ch->text) {
+      /* Text runs as the client renders them: trimmed, one space apart */
+      StrBuf text = {0}, html = {0};
+      i = nw_merge_text(n, i, &text) - 1;
+      sb_put_html(&html, text.s, text.len);
+      fputs(html.s ? html.s : "", out);
+      free(text.s);
+      free(html.s);
+      continue;
+    }
+    emit_prerender_html_recursive(ch, registry, registry_count, out);
+    /* Keep following text out of the expression's text node */
+    if (ch->kind == HTML_EXPR && ch->text && i + 1 < n->child_count &&
+        n->children[i + 1].kind == HTML_TEXT && n->children[i + 1].text)
+      fprintf(out, "<!--/-->");
+  }
+}
 
 static void emit_prerender_html_recursive(const HtmlNode *n,
                                           const ComponentNode **registry,
                                           int registry_count, FILE *out) {
   if (!n)
     return;
-  int id = _prerender_id++;
 
   switch (n->kind) {
   case HTML_TEXT:
@@ -1006,14 +1997,14 @@ static void emit_prerender_html_recursive(const HtmlNode *n,
     break;
 
   case HTML_EXPR:
-    /* SSG output for expression: wrap in a marker so hydration can find it */
-    fprintf(out, "<span data-fexpr=\"%d\"></span>", id);
+    if (n->text)
+      fprintf(out, "<!---->");
     break;
 
   case HTML_COMPONENT: {
     char tag[256];
     kebab(tag, n->tag);
-    fprintf(out, "<forge-%s data-fid=\"%d\"", tag, id);
+    fprintf(out, "<forge-%s", tag);
     for (int i = 0; i < n->attr_count; i++) {
       if (!n->attrs[i].is_expr) {
         fprintf(out, " %s=\"%s\"", n->attrs[i].name,
@@ -1029,19 +2020,16 @@ static void emit_prerender_html_recursive(const HtmlNode *n,
         break;
       }
     }
-    if (target && target->template_root) {
-      int prev_id = _prerender_id;
-      _prerender_id = 0;
+    if (target && target->template_root)
       emit_prerender_html_recursive(target->template_root, registry,
                                     registry_count, out);
-      _prerender_id = prev_id;
-    }
     fprintf(out, "</forge-%s>", tag);
     break;
   }
 
   case HTML_ELEMENT: {
-    fprintf(out, "<%s data-fid=\"%d\"", n->tag ? n->tag : "div", id);
+    const char *tag = n->tag ? n->tag : "div";
+    fprintf(out, "<%s", tag);
     for (int i = 0; i < n->attr_count; i++) {
       if (!n->attrs[i].is_expr) {
         fprintf(out, " %s=\"%s\"", n->attrs[i].name,
@@ -1049,25 +2037,21 @@ static void emit_prerender_html_recursive(const HtmlNode *n,
       }
     }
     fprintf(out, ">");
-    for (int i = 0; i < n->child_count; i++) {
-      emit_prerender_html_recursive(&n->children[i], registry, registry_count,
-                                    out);
-    }
-    fprintf(out, "</%s>", n->tag ? n->tag : "div");
+    emit_prerender_children(n, registry, registry_count, out);
+    if (!nw_is_void_tag(tag))
+      fprintf(out, "</%s>", tag);
     return;
   }
 
-  case HTML_IF: {
-    fprintf(out, "<div data-fif=\"%d\" style=\"display:contents\">", id);
-    for (int i = 0; i < n->child_count; i++) {
-      emit_prerender_html_recursive(&n->children[i], registry, registry_count,
-                                    out);
-    }
+  case HTML_IF:
+    fprintf(out, "<div style=\"display:contents\">");
+    emit_prerender_children(n, registry, registry_count, out);
     fprintf(out, "</div>");
     break;
-  }
 
   case HTML_FOR:
+    /* Rows depend on runtime data; only the container is rendered */
+    fprintf(out, "<div style=\"display:contents\"></div>");
     break;
   }
 }
@@ -1077,20 +2061,98 @@ int binding_gen_prerender(const ComponentNode *c,
                           FILE *out) {
   if (!c || !c->template_root)
     return 0;
-  _prerender_id = 0;
   emit_prerender_html_recursive(c->template_root, registry, registry_count,
                                 out);
   return 0;
 }
 
+/* ─── Preload Hints ─────────────────────────────────────────────────────────
+ */
+
+/* Mark every registry component `n` instantiates, directly or nested */
+static void mark_reachable(const HtmlNode *n, const ComponentNode **registry,
+                           int registry_count, char *seen) {
+  if (!n)
+    return;
+  if (n->kind == HTML_COMPONENT && n->tag) {
+    for (int k = 0; k < registry_count; k++) {
+      if (seen[k] || !registry[k] || strcmp(registry[k]->name, n->tag) != 0)
+        continue;
+      seen[k] = 1;
+      mark_reachable(registry[k]->template_root, registry, registry_count,
+                     seen);
+    }
+  }
+  for (int i = 0; i < n->child_count; i++)
+    mark_reachable(&n->children[i], registry, registry_count, seen);
+}
+
+/* One <link> per line, each wrapped in `pre` / `post` so the SSR server can
+ * embed the same list as JS string literals */
+static void emit_preload_links(const ComponentNode *c,
+                               const ComponentNode **registry,
+                               int registry_count, const BindingOptions *opts,
+                               const char *pre, const char *post, FILE *out) {
+  const char *base = opts && opts->asset_base ? opts->asset_base : "";
+  int esm = !opts || opts->es_modules;
+  const char *rel = esm ? "rel=\"modulepreload\"" : "rel=\"preload\" as=\"script\"";
+
+  char *seen = calloc((size_t)registry_count + 1, 1);
+  if (!seen)
+    return;
+  mark_reachable(c->template_root, registry, registry_count, seen);
+
+  if (esm)
+    fprintf(out, "%s<link %s href=\"%sforge-runtime.js\">%s", pre, rel, base,
+            post);
+  fprintf(out, "%s<link %s href=\"%s%s.forge.js\">%s", pre, rel, base, c->name,
+          post);
+  for (int k = 0; k < registry_count; k++)
+    if (seen[k] && registry[k] != c)
+      fprintf(out, "%s<link %s href=\"%s%s.forge.js\">%s", pre, rel, base,
+              registry[k]->name, post);
+
+  /* as="fetch" + crossorigin match the request loadWasm() makes, so the
+   * preloaded response is the one it consumes */
+  static const char wasm_link[] =
+      "%s<link rel=\"preload\" href=\"%s%s%s\" as=\"fetch\" "
+      "type=\"application/wasm\" crossorigin>%s";
+  if (opts && opts->bundle) {
+    fprintf(out, wasm_link, pre, base, opts->bundle, "", post);
+  } else {
+    fprintf(out, wasm_link, pre, base, c->name, ".wasm", post);
+    for (int k = 0; k < registry_count; k++)
+      if (seen[k] && registry[k] != c)
+        fprintf(out, wasm_link, pre, base, registry[k]->name, ".wasm", post);
+  }
+  free(seen);
+}
+
+int binding_gen_preload(const ComponentNode *c,
+                        const ComponentNode **registry, int registry_count,
+                        const BindingOptions *opts, FILE *out) {
+  if (!c)
+    return 1;
+  emit_preload_links(c, registry, registry_count, opts, "", "\n", out);
+  return 0;
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
  * SSR RENDERER GENERATOR
  * Generates ComponentName.forge.ssr.js — a Node.js module that exports
- *   render(state, props) => HTML string
+ *   render(state, props)       => HTML string
+ *   renderStream(state, props) => async iterable of HTML chunks
  * No browser APIs (document / window / customElements) used.
  * ═══════════════════════════════════════════════════════════════════════════
  */
 
+/* Set while emitting renderStream(): the main template yields at component
+ * boundaries and awaits state/props fields that are still promises.  Child
+ * renderers are always emitted in plain string mode. */
+static int _ssr_stream = 0;
+/* Fields already awaited on every path to the current point */
+static unsigned _ssr_settled = 0;
+
 /* Emit a Forge expression for SSR context.
  * state.X, props.X, computed.X are kept as-is (function parameters match). */
 static void emit_ssr_expr(const char *expr, FILE *out) {
@@ -1100,17 +2162,28 @@ static void emit_ssr_expr(const char *expr, FILE *out) {
   fprintf(out, "%s", expr);
 }
 
+/* A numeric <for virtual> attribute in the SSR renderer's scope */
+static void emit_ssr_number_attr(const Attribute *a, int def, FILE *out) {
+  char *end;
+  if (!a || !a->value || !a->value[0])
+    fprintf(out, "%d", def);
+  else if (a->is_expr) {
+    fprintf(out, "(");
+    emit_ssr_expr(a->value, out);
+    fprintf(out, ")");
+  } else if (strtod(a->value, &end), *end == '\0')
+    fprintf(out, "%s", a->value);
+  else {
+    fprintf(out, "Number(");
+    emit_js_str(a->value, out);
+    fprintf(out, ")");
+  }
+}
+
 /* Forward-declare so emit_ssr_children and emit_ssr_node can call each other */
 static void emit_ssr_node(const HtmlNode *n, const ComponentNode **registry,
                           int rc, int depth, FILE *out);
 
-static void emit_ssr_children(const HtmlNode *parent,
-                               const ComponentNode **registry, int rc,
-                               int depth, FILE *out) {
-  for (int i = 0; i < parent->child_count; i++)
-    emit_ssr_node(&parent->children[i], registry, rc, depth, out);
-}
-
 /* Indentation helper (max 8 levels) */
 static const char *_ssrind(int d) {
   static const char *T[] = {
@@ -1120,6 +2193,58 @@ static const char *_ssrind(int d) {
   return T[d < 0 ? 0 : d > 7 ? 7 : d];
 }
 
+/* Markup matches binding_gen_prerender's structure so the client can
+ * hydrate it by position; expressions are <!----> + text, and <!--/-->
+ * ends one that is followed by static text. */
+static void emit_ssr_children(const HtmlNode *parent,
+                               const ComponentNode **registry, int rc,
+                               int depth, FILE *out) {
+  for (int i = 0; i < parent->child_count; i++) {
+    const HtmlNode *ch = &parent->children[i];
+    if (ch->kind == HTML_TEXT && ch->text) {
+      StrBuf text = {0}, html = {0};
+      i = nw_merge_text(parent, i, &text) - 1;
+      sb_put_html(&html, text.s, text.len);
+      if (html.len) {
+        fprintf(out, "%s__h += ", _ssrind(depth));
+        emit_js_str(html.s, out);
+        fprintf(out, ";\n");
+      }
+      free(text.s);
+      free(html.s);
+      continue;
+    }
+    emit_ssr_node(ch, registry, rc, depth, out);
+    if (ch->kind == HTML_EXPR && ch->text && i + 1 < parent->child_count &&
+        parent->children[i + 1].kind == HTML_TEXT &&
+        parent->children[i + 1].text)
+      fprintf(out, "%s__h += '<!--/-->';\n", _ssrind(depth));
+  }
+}
+
+/* Stream mode: before reading fields in `mask`, flush the pending chunk and
+ * wait for any of them that are still promises. */
+static void emit_ssr_settle(unsigned mask, const char *ind, FILE *out) {
+  mask &= ~_ssr_settled;
+  if (!_ssr_stream || !mask) return;
+  _ssr_settled |= mask;
+  fprintf(out, "%sif (_pending(__fields, 0x%x)) {\n", ind, mask);
+  fprintf(out, "%s  if (__h) { yield __h; __h = ''; }\n", ind);
+  fprintf(out, "%s  await _settle(__fields, 0x%x);\n", ind, mask);
+  fprintf(out, "%s}\n", ind);
+}
+
+/* Props object literal body for a child component call */
+static void emit_ssr_props(const HtmlNode *n, FILE *out) {
+  for (int i = 0; i < n->attr_count; i++) {
+    const Attribute *a = &n->attrs[i];
+    fprintf(out, "'%s': (", a->name);
+    if (a->is_expr) emit_ssr_expr(a->value ? a->value : "''", out);
+    else            emit_js_str(a->value ? a->value : "", out);
+    fprintf(out, "), ");
+  }
+}
+
 static void emit_ssr_node(const HtmlNode *n, const ComponentNode **registry,
                           int rc, int depth, FILE *out) {
   if (!n) return;
@@ -1137,13 +2262,18 @@ static void emit_ssr_node(const HtmlNode *n, const ComponentNode **registry,
 
   case HTML_EXPR:
     if (n->text) {
-      fprintf(out, "%s__h += _e(", ind);
+      emit_ssr_settle(n->dep_mask, ind, out);
+      fprintf(out, "%s__h += '<!---->' + _e(", ind);
       emit_ssr_expr(n->text, out);
       fprintf(out, ");\n");
     }
     break;
 
   case HTML_ELEMENT: {
+    unsigned amask = 0;
+    for (int i = 0; i < n->attr_count; i++)
+      if (strncmp(n->attrs[i].name, "on", 2) != 0) amask |= n->attrs[i].dep_mask;
+    emit_ssr_settle(amask, ind, out);
     /* Tag open */
     fprintf(out, "%s__h += '<%s';\n", ind, n->tag ? n->tag : "div");
     /* Attributes */
@@ -1171,7 +2301,7 @@ static void emit_ssr_node(const HtmlNode *n, const ComponentNode **registry,
     }
     fprintf(out, "%s__h += '>';\n", ind);
     emit_ssr_children(n, registry, rc, depth, out);
-    if (!n->self_closing)
+    if (!nw_is_void_tag(n->tag ? n->tag : "div"))
       fprintf(out, "%s__h += '</%s>';\n", ind, n->tag ? n->tag : "div");
     break;
   }
@@ -1184,17 +2314,56 @@ static void emit_ssr_node(const HtmlNode *n, const ComponentNode **registry,
         found = 1; break;
       }
     }
-    if (found) {
-      fprintf(out, "%s__h += _render%s({", ind, n->tag);
-      for (int i = 0; i < n->attr_count; i++) {
-        const Attribute *a = &n->attrs[i];
-        fprintf(out, "'%s': (", a->name);
-        if (a->is_expr) emit_ssr_expr(a->value ? a->value : "''", out);
-        else            emit_js_str(a->value ? a->value : "", out);
-        fprintf(out, "), ");
+    /* Host element with the static attributes, as the client creates it */
+    char ctag[256];
+    kebab(ctag, n->tag ? n->tag : "div");
+    StrBuf host = {0};
+    sb_puts(&host, "<forge-");
+    sb_puts(&host, ctag);
+    for (int i = 0; i < n->attr_count; i++) {
+      const Attribute *a = &n->attrs[i];
+      if (a->is_expr) continue;
+      sb_puts(&host, " ");
+      sb_puts(&host, a->name);
+      sb_puts(&host, "=\"");
+      sb_put_html(&host, a->value ? a->value : "", strlen(a->value ? a->value : ""));
+      sb_puts(&host, "\"");
+    }
+    sb_puts(&host, ">");
+    fprintf(out, "%s__h += ", ind);
+    emit_js_str(host.s, out);
+    fprintf(out, ";\n");
+    free(host.s);
+    if (found && _ssr_stream) {
+      /* Stream boundary: flush what precedes the component, then the
+       * component itself.  If its props depend on unresolved fields it is
+       * rendered later behind an out-of-order placeholder. */
+      unsigned pmask = 0;
+      for (int i = 0; i < n->attr_count; i++) pmask |= n->attrs[i].dep_mask;
+      fprintf(out, "%s{\n", ind);
+      fprintf(out, "%s  const __props = () => ({", ind);
+      emit_ssr_props(n, out);
+      fprintf(out, "});\n");
+      if (pmask) {
+        fprintf(out, "%s  if (_pending(__fields, 0x%x)) {\n", ind, pmask);
+        fprintf(out, "%s    __h += `<template id=\"forge-ph-${__defer.length}\"></template>`;\n", ind);
+        fprintf(out, "%s    __defer.push(_quiet(_settle(__fields, 0x%x).then(() => _render%s(__props()))));\n",
+                ind, pmask, n->tag);
+        fprintf(out, "%s  } else {\n", ind);
+        fprintf(out, "%s    if (__h) { yield __h; __h = ''; }\n", ind);
+        fprintf(out, "%s    yield _render%s(__props());\n", ind, n->tag);
+        fprintf(out, "%s  }\n", ind);
+      } else {
+        fprintf(out, "%s  if (__h) { yield __h; __h = ''; }\n", ind);
+        fprintf(out, "%s  yield _render%s(__props());\n", ind, n->tag);
       }
+      fprintf(out, "%s}\n", ind);
+    } else if (found) {
+      fprintf(out, "%s__h += _render%s({", ind, n->tag);
+      emit_ssr_props(n, out);
       fprintf(out, "});\n");
     }
+    fprintf(out, "%s__h += '</forge-%s>';\n", ind, ctag);
     break;
   }
 
@@ -1202,10 +2371,19 @@ static void emit_ssr_node(const HtmlNode *n, const ComponentNode **registry,
     const char *cond = NULL;
     for (int i = 0; i < n->attr_count; i++)
       if (strcmp(n->attrs[i].name, "condition") == 0) { cond = n->attrs[i].value; break; }
+    for (int i = 0; i < n->attr_count; i++)
+      if (strcmp(n->attrs[i].name, "condition") == 0)
+        emit_ssr_settle(n->attrs[i].dep_mask, ind, out);
+    fprintf(out, "%s__h += '<div style=\"display:contents\">';\n", ind);
     if (cond) { fprintf(out, "%sif (", ind); emit_ssr_expr(cond, out); fprintf(out, ") {\n"); }
     else        fprintf(out, "%s{\n", ind);
-    emit_ssr_children(n, registry, rc, depth + 1, out);
+    {
+      unsigned settled = _ssr_settled; /* body may not run */
+      emit_ssr_children(n, registry, rc, depth + 1, out);
+      _ssr_settled = settled;
+    }
     fprintf(out, "%s}\n", ind);
+    fprintf(out, "%s__h += '</div>';\n", ind);
     break;
   }
 
@@ -1215,6 +2393,39 @@ static void emit_ssr_node(const HtmlNode *n, const ComponentNode **registry,
       if (strcmp(n->attrs[i].name, "each") == 0) each   = n->attrs[i].value;
       if (strcmp(n->attrs[i].name, "as")   == 0) as_var = n->attrs[i].value;
     }
+    for (int i = 0; i < n->attr_count; i++)
+      if (strcmp(n->attrs[i].name, "each") == 0)
+        emit_ssr_settle(n->attrs[i].dep_mask, ind, out);
+    fprintf(out, "%s__h += '<div style=\"display:contents\">';\n", ind);
+    if (each && as_var && nw_find_attr(n, "virtual")) {
+      /* Only the first window of rows; a spacer keeps the scroll height */
+      fprintf(out, "%s{\n", ind);
+      fprintf(out, "%s  const __l = (", ind);
+      emit_ssr_expr(each, out);
+      fprintf(out, ") || [], __ih = ");
+      emit_ssr_number_attr(nw_find_attr(n, "item-height"),
+                           NW_VIRTUAL_ITEM_HEIGHT, out);
+      fprintf(out, ";\n");
+      fprintf(out, "%s  const __n = Math.min(__l.length, Math.ceil(%d / __ih) + ",
+              ind, NW_VIRTUAL_SSR_HEIGHT);
+      emit_ssr_number_attr(nw_find_attr(n, "overscan"), NW_VIRTUAL_OVERSCAN,
+                           out);
+      fprintf(out, ");\n");
+      fprintf(out, "%s  for (const %s of __l.slice(0, __n)) {\n", ind, as_var);
+      {
+        unsigned settled = _ssr_settled;
+        emit_ssr_children(n, registry, rc, depth + 2, out);
+        _ssr_settled = settled;
+      }
+      fprintf(out, "%s  }\n", ind);
+      fprintf(out,
+              "%s  if (__l.length > __n) __h += `<div style=\"height:${(__l.length "
+              "- __n) * __ih}px\"></div>`;\n",
+              ind);
+      fprintf(out, "%s}\n", ind);
+      fprintf(out, "%s__h += '</div>';\n", ind);
+      break;
+    }
     if (each && as_var) {
       fprintf(out, "%sfor (const %s of (", ind, as_var);
       emit_ssr_expr(each, out);
@@ -1222,17 +2433,101 @@ static void emit_ssr_node(const HtmlNode *n, const ComponentNode **registry,
     } else {
       fprintf(out, "%s{\n", ind);
     }
-    emit_ssr_children(n, registry, rc, depth + 1, out);
+    {
+      unsigned settled = _ssr_settled; /* body may not run */
+      emit_ssr_children(n, registry, rc, depth + 1, out);
+      _ssr_settled = settled;
+    }
     fprintf(out, "%s}\n", ind);
+    fprintf(out, "%s__h += '</div>';\n", ind);
     break;
   }
   }
 }
 
+/* SSR render cache: a shared LRU of child component HTML.  Keys are the
+ * component name plus the JSON of the props fields its template reads. */
+static void emit_ssr_cache_runtime(FILE *out) {
+  fprintf(out,
+    "/* ── Render cache ────────────────────────────────────────────────────\n"
+    " * LRU over child renders; limits from SSR_CACHE_ENTRIES / SSR_CACHE_BYTES\n"
+    " * or configureCache({ entries, bytes }).  Byte sizes are approximate\n"
+    " * (UTF-16 code units x 2, key included).\n"
+    " */\n"
+    "const _cache = {\n"
+    "  map: new Map(), bytes: 0,\n"
+    "  maxEntries: parseInt(process.env.SSR_CACHE_ENTRIES || '1000', 10),\n"
+    "  maxBytes:   parseInt(process.env.SSR_CACHE_BYTES || String(8 << 20), 10),\n"
+    "  hits: 0, misses: 0, evictions: 0, components: {},\n"
+    "};\n"
+    "const _entrySize = (k, v) => (k.length + v.length) * 2;\n"
+    "function _trimCache() {\n"
+    "  while (_cache.map.size && (_cache.map.size > _cache.maxEntries ||\n"
+    "                             _cache.bytes > _cache.maxBytes)) {\n"
+    "    const [k, v] = _cache.map.entries().next().value;\n"
+    "    _cache.map.delete(k);\n"
+    "    _cache.bytes -= _entrySize(k, v);\n"
+    "    _cache.evictions++;\n"
+    "  }\n"
+    "}\n"
+    "function _memo(name, fn, fields) {\n"
+    "  const st = _cache.components[name] = { hits: 0, misses: 0 };\n"
+    "  return function (props) {\n"
+    "    if (!props) props = {};\n"
+    "    let k;\n"
+    "    try { k = name + '\\0' + JSON.stringify(fields(props)); }\n"
+    "    catch { return fn(props); } /* unserialisable props: bypass */\n"
+    "    const hit = _cache.map.get(k);\n"
+    "    if (hit !== undefined) {\n"
+    "      _cache.map.delete(k); _cache.map.set(k, hit); /* most recent */\n"
+    "      _cache.hits++; st.hits++;\n"
+    "      return hit;\n"
+    "    }\n"
+    "    _cache.misses++; st.misses++;\n"
+    "    const html = fn(props);\n"
+    "    const size = _entrySize(k, html);\n"
+    "    if (_cache.maxEntries > 0 && size <= _cache.maxBytes) {\n"
+    "      _cache.map.set(k, html);\n"
+    "      _cache.bytes += size;\n"
+    "      _trimCache();\n"
+    "    }\n"
+    "    return html;\n"
+    "  };\n"
+    "}\n"
+    "function configureCache(opts) {\n"
+    "  if (opts && opts.entries != null) _cache.maxEntries = opts.entries;\n"
+    "  if (opts && opts.bytes   != null) _cache.maxBytes   = opts.bytes;\n"
+    "  _trimCache();\n"
+    "}\n"
+    "function cacheStats() {\n"
+    "  const total = _cache.hits + _cache.misses;\n"
+    "  return { entries: _cache.map.size, bytes: _cache.bytes,\n"
+    "           maxEntries: _cache.maxEntries, maxBytes: _cache.maxBytes,\n"
+    "           hits: _cache.hits, misses: _cache.misses, evictions: _cache.evictions,\n"
+    "           hitRate: total ? _cache.hits / total : 0,\n"
+    "           components: _cache.components };\n"
+    "}\n\n");
+}
+
+/* Emit the key function for a memoized child: the state/props fields its
+ * template reads, in declaration order (in SSR a child's state is its props). */
+static void emit_ssr_cache_key(const ComponentNode *ch, FILE *out) {
+  unsigned mask = ch->template_root ? ch->template_root->dep_mask : 0;
+  fprintf(out, "p => [");
+  for (int i = 0; i < ch->state_count; i++)
+    if (mask & analyzer_dep_bit(ch, 0, i))
+      fprintf(out, "p['%s'], ", ch->state[i].name);
+  for (int i = 0; i < ch->prop_count; i++)
+    if (mask & analyzer_dep_bit(ch, 1, i))
+      fprintf(out, "p['%s'], ", ch->props[i].name);
+  fprintf(out, "]");
+}
+
 int binding_gen_ssr_js(const ComponentNode *c,
                         const ComponentNode **registry, int registry_count,
-                        FILE *out) {
+                        const BindingOptions *opts, FILE *out) {
   if (!c) return 1;
+  int cache = opts && opts->ssr_cache;
 
   fprintf(out,
     "/**\n"
@@ -1240,6 +2535,7 @@ int binding_gen_ssr_js(const ComponentNode *c,
     " * Component: %s  (Node.js, no browser APIs)\n"
     " * Usage: const { render } = require('./%s.forge.ssr.js');\n"
     " *        const html = render(state, props);\n"
+    " *        for await (const chunk of renderStream(state, props)) res.write(chunk);\n"
     " */\n"
     "'use strict';\n\n",
     c->name, c->name);
@@ -1250,12 +2546,22 @@ int binding_gen_ssr_js(const ComponentNode *c,
     "  .replace(/&/g, '&amp;').replace(/</g, '&lt;')\n"
     "  .replace(/>/g, '&gt;').replace(/\"/g, '&quot;');\n\n");
 
+  if (cache)
+    emit_ssr_cache_runtime(out);
+
   /* Emit helper renderers for every child component in the registry */
   for (int i = 0; i < registry_count; i++) {
     const ComponentNode *ch = registry[i];
     if (!ch || strcmp(ch->name, c->name) == 0) continue;
 
-    fprintf(out, "function _render%s(props) {\n", ch->name);
+    if (cache) {
+      fprintf(out, "const _render%s = _memo('%s', _render%s__uncached, ",
+              ch->name, ch->name, ch->name);
+      emit_ssr_cache_key(ch, out);
+      fprintf(out, ");\n");
+    }
+    fprintf(out, "function _render%s%s(props) {\n", ch->name,
+            cache ? "__uncached" : "");
     fprintf(out, "  if (!props) props = {};\n");
     fprintf(out, "  const state    = props; /* child: props === state in SSR */\n");
     fprintf(out, "  const computed = {}; /* computed fields are no-ops in SSR */\n");
@@ -1275,7 +2581,86 @@ int binding_gen_ssr_js(const ComponentNode *c,
     emit_ssr_node(c->template_root, registry, registry_count, 1, out);
   fprintf(out, "  return __h;\n}\n\n");
 
-  fprintf(out, "module.exports = { render };\n");
+  /* Streaming helpers */
+  fprintf(out,
+    "/* ── Streaming ───────────────────────────────────────────────────────\n"
+    " * renderStream() yields the shell as soon as it reaches an unresolved\n"
+    " * field or a child component.  State/props fields may be promises: the\n"
+    " * template waits for them where it reads them, and a child component\n"
+    " * whose props need them is streamed after the shell, behind a\n"
+    " * <template id=\"forge-ph-N\"> placeholder that __forgeFill(N) swaps out.\n"
+    " * Resolved values are written back into the state/props objects.\n"
+    " */\n"
+    "const _isThen = v => v != null && typeof v.then === 'function';\n"
+    "/* A deferred render is only awaited once the shell is out; if the shell\n"
+    " * throws or the client leaves first, its rejection must not go unhandled\n"
+    " * (that ends the process).  _drainDeferred still sees the failure. */\n"
+    "const _quiet = p => { p.catch(() => {}); return p; };\n"
+    "function _pending(fields, mask) {\n"
+    "  for (const f of fields)\n"
+    "    if ((f[2] & mask) && _isThen(f[0][f[1]])) return true;\n"
+    "  return false;\n"
+    "}\n"
+    "async function _settle(fields, mask) {\n"
+    "  await Promise.all(fields\n"
+    "    .filter(f => (f[2] & mask) && _isThen(f[0][f[1]]))\n"
+    "    .map(async f => { f[0][f[1]] = await f[0][f[1]]; }));\n"
+    "}\n"
+    "const _FILL_SCRIPT = '<script>function __forgeFill(i){'\n"
+    "  + 'var t=document.querySelector(\\'template[data-forge-fill=\"\\'+i+\\'\"]\\'),'\n"
+    "  + 'p=document.getElementById(\\'forge-ph-\\'+i);'\n"
+    "  + 'if(t&&p)p.replaceWith(t.content);if(t)t.remove();}</script>';\n"
+    "async function* _drainDeferred(defer) {\n"
+    "  if (!defer.length) return;\n"
+    "  yield _FILL_SCRIPT;\n"
+    "  const live = new Map(defer.map((d, i) => [i, d.then(\n"
+    "    html => [i, html],\n"
+    "    e => { console.error('[ssr] deferred render failed:', e && e.message); return [i, '']; })]));\n"
+    "  while (live.size) {\n"
+    "    const [i, html] = await Promise.race(live.values());\n"
+    "    live.delete(i);\n"
+    "    yield `<template data-forge-fill=\"${i}\">${html}</template><script>__forgeFill(${i})</script>`;\n"
+    "  }\n"
+    "}\n\n");
+
+  /* The template runs in _streamBody; renderStream wraps it so a stream
+   * that ends early (render threw, consumer broke off) still observes the
+   * field promises nobody will await now. */
+  fprintf(out, "async function* renderStream(state, props) {\n");
+  fprintf(out, "  if (!state) state = {};\n");
+  fprintf(out, "  if (!props) props = {};\n");
+  /* Field table in analyzer dep-bit order: [object, key, bit] */
+  fprintf(out, "  const __fields = [");
+  for (int i = 0; i < c->state_count; i++)
+    fprintf(out, "[state, '%s', 0x%x], ", c->state[i].name, analyzer_dep_bit(c, 0, i));
+  for (int i = 0; i < c->prop_count; i++)
+    fprintf(out, "[props, '%s', 0x%x], ", c->props[i].name, analyzer_dep_bit(c, 1, i));
+  fprintf(out, "];\n");
+  fprintf(out, "  try {\n");
+  fprintf(out, "    yield* _streamBody(state, props, __fields);\n");
+  fprintf(out, "  } finally {\n");
+  fprintf(out, "    for (const f of __fields) if (_isThen(f[0][f[1]])) _quiet(Promise.resolve(f[0][f[1]]));\n");
+  fprintf(out, "  }\n");
+  fprintf(out, "}\n\n");
+
+  fprintf(out, "async function* _streamBody(state, props, __fields) {\n");
+  fprintf(out, "  const computed = {}; /* computed fields are no-ops in SSR */\n");
+  fprintf(out, "  const __defer = [];\n");
+  fprintf(out, "  let __h = '';\n");
+  if (c->template_root) {
+    _ssr_stream = 1;
+    _ssr_settled = 0;
+    emit_ssr_node(c->template_root, registry, registry_count, 1, out);
+    _ssr_stream = 0;
+  }
+  fprintf(out, "  if (__h) yield __h;\n");
+  fprintf(out, "  yield* _drainDeferred(__defer);\n");
+  fprintf(out, "}\n\n");
+
+  if (cache)
+    fprintf(out, "module.exports = { render, renderStream, configureCache, cacheStats };\n");
+  else
+    fprintf(out, "module.exports = { render, renderStream };\n");
   return 0;
 }
 
@@ -1286,9 +2671,9 @@ int binding_gen_ssr_js(const ComponentNode *c,
  */
 int binding_gen_ssr_server(const ComponentNode *c,
                             const ComponentNode **registry, int registry_count,
-                            FILE *out) {
+                            const BindingOptions *opts, FILE *out) {
   if (!c) return 1;
-  (void)registry; (void)registry_count; /* reserved for future cross-component SSR */
+  int workers = opts ? opts->ssr_workers : 0;
 
   char tag[256];
   kebab(tag, c->name);
@@ -1306,14 +2691,19 @@ int binding_gen_ssr_server(const ComponentNode *c,
     " *\n"
     " * ENV VARS:\n"
     " *   PORT=3000  API_BASE=http://localhost:8000  API_TOKEN=<jwt>\n"
+    " *   SSR_STREAM=0   buffer the whole page instead of streaming it\n"
+    " *   SSR_WORKERS=%d  worker processes sharing the port (0/1 = single process)\n"
+    " *   API_MAX_SOCKETS=64  API_TIMEOUT=8000   backend keep-alive pool\n"
+    " *   STATIC_MAX_AGE=300   Cache-Control max-age of static files (seconds)\n"
     " *\n"
     " * EDIT resolveState() below to fetch your API data per route.\n"
     " * Everything else is auto-generated — do not edit other sections.\n"
     " */\n\n",
-    c->name, tag);
+    c->name, tag, workers);
 
   /* ── Node.js requires ── */
   fprintf(out,
+    "const cluster = require('cluster');\n"
     "const http   = require('http');\n"
     "const https  = require('https');\n"
     "const fs     = require('fs');\n"
@@ -1326,13 +2716,26 @@ int binding_gen_ssr_server(const ComponentNode *c,
     "const PORT      = parseInt(process.env.PORT      || '3000', 10);\n"
     "const API_BASE  = process.env.API_BASE  || 'http://localhost:8000';\n"
     "const API_TOKEN = process.env.API_TOKEN || '';\n"
+    "const STREAM    = process.env.SSR_STREAM !== '0';  /* chunked streaming SSR */\n"
+    "const WORKERS   = parseInt(process.env.SSR_WORKERS || '%d', 10);\n"
+    "const API_MAX_SOCKETS = parseInt(process.env.API_MAX_SOCKETS || '64', 10);\n"
+    "const API_TIMEOUT     = parseInt(process.env.API_TIMEOUT     || '8000', 10);\n"
+    "const STATIC_MAX_AGE  = parseInt(process.env.STATIC_MAX_AGE  || '300', 10);\n"
     "const DIST_DIR  = __dirname;\n"
-    "const ROOT_DIR  = path.resolve(DIST_DIR, '..');\n\n");
+    "const ROOT_DIR  = path.resolve(DIST_DIR, '..');\n\n",
+    workers);
+
+  /* ── Preload hints (WASM builds): the client's modules start loading
+   * while the SSR HTML is still streaming ── */
+  fprintf(out, "/* Added to every page's <head> */\nconst _PRELOAD = [\n");
+  if (opts && !opts->no_wasm)
+    emit_preload_links(c, registry, registry_count, opts, "  '", "',\n", out);
+  fprintf(out, "].join('\\n');\n\n");
 
   /* ── Component renderer reference ── */
   fprintf(out,
     "/* ── Component renderer (auto-generated, do not edit) ──────────────── */\n"
-    "const { render } = require('./%s.forge.ssr.js');\n\n",
+    "const { render, renderStream, cacheStats } = require('./%s.forge.ssr.js');\n\n",
     c->name);
 
   /* ── MIME table ── */
@@ -1346,12 +2749,109 @@ int binding_gen_ssr_server(const ComponentNode *c,
     "  '.html':'text/html; charset=utf-8',\n"
     "  '.png':'image/png', '.jpg':'image/jpeg', '.jpeg':'image/jpeg',\n"
     "  '.svg':'image/svg+xml', '.ico':'image/x-icon', '.woff2':'font/woff2',\n"
+    "  '.wasm':'application/wasm', '.webp':'image/webp', '.gif':'image/gif',\n"
+    "  '.txt':'text/plain; charset=utf-8', '.map':'application/json',\n"
     "};\n\n");
 
+  /* ── Static files ── */
+  fprintf(out,
+    "/* ── Static files ────────────────────────────────────────────────────── */\n"
+    "/* Streams from disk (never buffered whole), answers If-None-Match with\n"
+    " * 304, honours single byte ranges, and serves a precompressed .br / .gz\n"
+    " * sibling when the client accepts it — e.g. App.wasm.br for App.wasm. */\n"
+    "const _ENCODINGS = [['br', '.br'], ['gzip', '.gz']];\n\n"
+    "/* Weak (compressed variants share it).  Takes the inode and the full\n"
+    " * sub-millisecond mtime: a redeploy can rewrite a file within one second\n"
+    " * at the same size. */\n"
+    "function _etag(st) {\n"
+    "  return `W/\"${st.ino.toString(16)}-${st.size.toString(16)}-${st.mtimeMs.toString(16)}\"`;\n"
+    "}\n\n"
+    "function _statFile(p) {\n"
+    "  try { const st = fs.statSync(p); return st.isFile() ? st : null; } catch { return null; }\n"
+    "}\n\n"
+    "/* [start, end] inclusive, null for the whole file, false if unsatisfiable */\n"
+    "function _parseRange(header, size) {\n"
+    "  const m = /^bytes=(\\d*)-(\\d*)$/.exec(String(header || '').trim());\n"
+    "  if (!m || (m[1] === '' && m[2] === '')) return null;\n"
+    "  let start, end;\n"
+    "  if (m[1] === '') { start = Math.max(0, size - Number(m[2])); end = size - 1; }\n"
+    "  else { start = Number(m[1]); end = m[2] === '' ? size - 1 : Math.min(Number(m[2]), size - 1); }\n"
+    "  return start <= end && start < size ? [start, end] : false;\n"
+    "}\n\n"
+    "function _serveStatic(req, res, reqPath) {\n"
+    "  let rel;\n"
+    "  try { rel = decodeURIComponent(reqPath); } catch { rel = reqPath; }\n"
+    "  const file = path.join(ROOT_DIR, path.normalize(rel));\n"
+    "  const base = file.startsWith(ROOT_DIR + path.sep) ? _statFile(file) : null;\n"
+    "  if (!base) { res.writeHead(404); res.end('Not found'); return; }\n"
+    "\n"
+    "  let sendPath = file, st = base, encoding = null;\n"
+    "  const accept = String(req.headers['accept-encoding'] || '');\n"
+    "  for (const [enc, suffix] of _ENCODINGS) {\n"
+    "    const alt = accept.includes(enc) && _statFile(file + suffix);\n"
+    "    if (alt) { sendPath = file + suffix; st = alt; encoding = enc; break; }\n"
+    "  }\n"
+    "\n"
+    "  const etag = _etag(st);\n"
+    "  const headers = {\n"
+    "    'Content-Type': MIME[path.extname(file).toLowerCase()] || 'application/octet-stream',\n"
+    "    'Cache-Control': `public,max-age=${STATIC_MAX_AGE}`,\n"
+    "    'ETag': etag,\n"
+    "    'Last-Modified': st.mtime.toUTCString(),\n"
+    "    'Accept-Ranges': 'bytes',\n"
+    "    'Vary': 'Accept-Encoding',\n"
+    "  };\n"
+    "  if (encoding) headers['Content-Encoding'] = encoding;\n"
+    "\n"
+    "  const inm = req.headers['if-none-match'];\n"
+    "  if (inm && inm.split(',').some(t => t.trim() === etag || t.trim() === '*')) {\n"
+    "    res.writeHead(304, { 'ETag': etag, 'Cache-Control': headers['Cache-Control'], 'Vary': 'Accept-Encoding' });\n"
+    "    res.end(); return;\n"
+    "  }\n"
+    "\n"
+    "  let status = 200, range = null;\n"
+    "  /* If-Range needs a strong match, which a weak ETag never gives */\n"
+    "  if (req.headers.range && !req.headers['if-range']) {\n"
+    "    range = _parseRange(req.headers.range, st.size);\n"
+    "    if (range === false) {\n"
+    "      res.writeHead(416, { 'Content-Range': `bytes */${st.size}` });\n"
+    "      res.end(); return;\n"
+    "    }\n"
+    "    if (range) {\n"
+    "      status = 206;\n"
+    "      headers['Content-Range'] = `bytes ${range[0]}-${range[1]}/${st.size}`;\n"
+    "    }\n"
+    "  }\n"
+    "  headers['Content-Length'] = range ? range[1] - range[0] + 1 : st.size;\n"
+    "  res.writeHead(status, headers);\n"
+    "  if (req.method === 'HEAD' || headers['Content-Length'] === 0) { res.end(); return; }\n"
+    "  fs.createReadStream(sendPath, range ? { start: range[0], end: range[1] } : {})\n"
+    "    .on('error', () => res.destroy())\n"
+    "    .pipe(res);\n"
+    "}\n\n");
+
   /* ── Internal apiFetch helper ── */
   fprintf(out,
     "/* ── Internal API fetch (Node → your backend) ──────────────────────── */\n"
+    "/* Keep-alive pools: backend connections (and TLS sessions) are reused\n"
+    " * across requests instead of being opened per call. */\n"
+    "const _agents = {\n"
+    "  'http:':  new http.Agent({ keepAlive: true, maxSockets: API_MAX_SOCKETS }),\n"
+    "  'https:': new https.Agent({ keepAlive: true, maxSockets: API_MAX_SOCKETS }),\n"
+    "};\n\n"
+    "/* Identical GETs in flight at the same time share one backend request,\n"
+    " * so concurrent page renders hitting the same endpoint cost one call.\n"
+    " * The resolved { status, data } is shared too — treat it as read-only. */\n"
+    "const _inflight = new Map();\n"
     "function apiFetch(endpoint) {\n"
+    "  const pending = _inflight.get(endpoint);\n"
+    "  if (pending) { _metrics.apiCoalesced++; return pending; }\n"
+    "  _metrics.apiFetches++;\n"
+    "  const p = _apiRequest(endpoint).finally(() => _inflight.delete(endpoint));\n"
+    "  _inflight.set(endpoint, p);\n"
+    "  return p;\n"
+    "}\n\n"
+    "function _apiRequest(endpoint) {\n"
     "  return new Promise((resolve, reject) => {\n"
     "    const fullUrl = API_BASE + endpoint;\n"
     "    const parsed  = new urlMod.URL(fullUrl);\n"
@@ -1362,6 +2862,7 @@ int binding_gen_ssr_server(const ComponentNode *c,
     "      port:     parsed.port || (isHttps ? 443 : 80),\n"
     "      path:     parsed.pathname + parsed.search,\n"
     "      method:   'GET',\n"
+    "      agent:    _agents[parsed.protocol],\n"
     "      headers:  { 'Accept': 'application/json',\n"
     "                  ...(API_TOKEN ? { Authorization: 'Bearer ' + API_TOKEN } : {}) },\n"
     "    }, res => {\n"
@@ -1374,11 +2875,68 @@ int binding_gen_ssr_server(const ComponentNode *c,
     "      });\n"
     "    });\n"
     "    req.on('error', reject);\n"
-    "    req.setTimeout(8000, () => req.destroy(new Error('Timeout: ' + endpoint)));\n"
+    "    req.setTimeout(API_TIMEOUT, () => req.destroy(new Error('Timeout: ' + endpoint)));\n"
     "    req.end();\n"
     "  });\n"
     "}\n\n");
 
+  /* ── Route trie ── */
+  fprintf(out,
+    "/* ── Route trie (auto-generated) ──────────────────────────────────── */\n"
+    "/* The matching of stdlib/src/router.c: patterns split on '/', a literal\n"
+    " * segment beats a :param, which beats a trailing *wildcard, and a failed\n"
+    " * branch falls back to the next.  One Map lookup per path segment,\n"
+    " * however many routes are added. */\n"
+    "function _routeTrie() {\n"
+    "  const node = () => ({ kids: new Map(), param: null, end: null, wild: null });\n"
+    "  const segs = (p) => p.split('/').filter(Boolean);\n"
+    "  const dec  = (s) => { try { return decodeURIComponent(s); } catch { return s; } };\n"
+    "  const root = node();\n"
+    "\n"
+    "  function walk(n, parts, i, caps) {\n"
+    "    if (i === parts.length) {\n"
+    "      if (n.end) return n.end;\n"
+    "      if (n.wild) { caps.push(''); return n.wild; }\n"
+    "      return null;\n"
+    "    }\n"
+    "    const kid = n.kids.get(parts[i]);\n"
+    "    if (kid) { const r = walk(kid, parts, i + 1, caps); if (r) return r; }\n"
+    "    if (n.param) {\n"
+    "      caps.push(parts[i]);\n"
+    "      const r = walk(n.param, parts, i + 1, caps);\n"
+    "      if (r) return r;\n"
+    "      caps.pop();\n"
+    "    }\n"
+    "    if (n.wild) { caps.push(parts.slice(i).join('/')); return n.wild; }\n"
+    "    return null;\n"
+    "  }\n"
+    "\n"
+    "  return {\n"
+    "    add(pattern, fn) {\n"
+    "      let n = root;\n"
+    "      const names = [];\n"
+    "      for (const s of segs(pattern)) {\n"
+    "        if (s[0] === '*') { names.push(s.slice(1) || 'rest'); n.wild = { fn, names }; return this; }\n"
+    "        if (s[0] === ':') { names.push(s.slice(1)); n = n.param || (n.param = node()); continue; }\n"
+    "        let kid = n.kids.get(s);\n"
+    "        if (!kid) n.kids.set(s, (kid = node()));\n"
+    "        n = kid;\n"
+    "      }\n"
+    "      n.end = { fn, names };\n"
+    "      return this;\n"
+    "    },\n"
+    "    /* { fn, params } for the most specific route, or null */\n"
+    "    match(path) {\n"
+    "      const caps = [];\n"
+    "      const r = walk(root, segs(path), 0, caps);\n"
+    "      if (!r) return null;\n"
+    "      const params = {};\n"
+    "      r.names.forEach((name, i) => { params[name] = dec(caps[i]); });\n"
+    "      return { fn: r.fn, params };\n"
+    "    },\n"
+    "  };\n"
+    "}\n\n");
+
   /* ── resolveState() — user editable section ── */
   fprintf(out,
     "/* ═══════════════════════════════════════════════════════════════════\n"
@@ -1389,7 +2947,9 @@ int binding_gen_ssr_server(const ComponentNode *c,
     " *  `route`  — URL pathname, e.g. '/', '/products', '/item/my-slug'\n"
     " *\n"
     " *  Return:\n"
-    " *    state — object matching @state fields of %s:\n",
+    " *    state — object matching @state fields of %s\n"
+    " *            (a field may be a Promise: the page shell is streamed first\n"
+    " *            and the parts that read the field follow once it resolves):\n",
     c->name);
 
   /* Emit state field hints as comments */
@@ -1413,28 +2973,37 @@ int binding_gen_ssr_server(const ComponentNode *c,
   fprintf(out,
     " *    meta  — { title, desc, ogType }   updates <head> tags\n"
     " *    data  — JSON seeded into window.__SSR_DATA__  (skips client re-fetch)\n"
+    " *\n"
+    " *  Add one handler per route pattern ('/item/:slug', '/docs/*path');\n"
+    " *  it gets the captured params and the pathname.  The same result feeds\n"
+    " *  GET /__forge_state?path=..., which the client runtime calls when a\n"
+    " *  link is hovered (ForgeRuntime.routeData).\n"
     " * ═══════════════════════════════════════════════════════════════════ */\n"
+    "const routes = _routeTrie();\n"
+    "\n"
+    "// Example — uncomment and adapt:\n"
+    "//\n"
+    "// routes.add('/', async () => {\n"
+    "//   const { data: items } = await apiFetch('/api/items/');\n"
+    "//   return {\n"
+    "//     state: { page: 0, products: items.results },\n"
+    "//     meta:  { title: 'Home — My App', desc: 'Shop online' },\n"
+    "//     data:  { items: items.results, total: items.count },\n"
+    "//   };\n"
+    "// });\n"
+    "//\n"
+    "// routes.add('/item/:slug', async ({ slug }) => {\n"
+    "//   const { data: item } = await apiFetch('/api/items/?slug=' + encodeURIComponent(slug));\n"
+    "//   return {\n"
+    "//     state: { page: 2, det_name: item.name, det_price: item.price },\n"
+    "//     meta:  { title: item.name + ' — My App', desc: item.description },\n"
+    "//     data:  { item },\n"
+    "//   };\n"
+    "// });\n"
+    "\n"
     "async function resolveState(route) {\n"
-    "  // Example — uncomment and adapt:\n"
-    "  //\n"
-    "  // if (route === '/') {\n"
-    "  //   const { data: items } = await apiFetch('/api/items/');\n"
-    "  //   return {\n"
-    "  //     state: { page: 0, products: items.results },\n"
-    "  //     meta:  { title: 'Home — My App', desc: 'Shop online' },\n"
-    "  //     data:  { items: items.results, total: items.count },\n"
-    "  //   };\n"
-    "  // }\n"
-    "  //\n"
-    "  // const m = route.match(/^\\/item\\/(.+)$/);\n"
-    "  // if (m) {\n"
-    "  //   const { data: item } = await apiFetch('/api/items/?slug=' + m[1]);\n"
-    "  //   return {\n"
-    "  //     state: { page: 2, det_name: item.name, det_price: item.price },\n"
-    "  //     meta:  { title: item.name + ' — My App', desc: item.description },\n"
-    "  //     data:  { item },\n"
-    "  //   };\n"
-    "  // }\n"
+    "  const hit = routes.match(route);\n"
+    "  if (hit) return hit.fn(hit.params, route);\n"
     "\n"
     "  return {\n"
     "    state: { page: 0 },\n"
@@ -1450,7 +3019,7 @@ int binding_gen_ssr_server(const ComponentNode *c,
     "  return String(s||'').replace(/&/g,'&amp;').replace(/</g,'&lt;')\n"
     "                      .replace(/>/g,'&gt;').replace(/\"/g,'&quot;');\n"
     "}\n\n"
-    "function _buildPage(template, html, meta, data) {\n"
+    "function _pageHead(template, meta, data) {\n"
     "  const title = meta.title || 'Forge App';\n"
     "  const desc  = meta.desc  || '';\n"
     "  let out = template;\n"
@@ -1465,22 +3034,29 @@ int binding_gen_ssr_server(const ComponentNode *c,
     "  /* Inject SSR data + customElements clear-patch */\n"
     "  const ssrJson = JSON.stringify(data||{}).replace(/<\\/script/gi,'<\\\\/script');\n"
     "  const patch = `<script>window.__SSR_DATA__=${ssrJson};`\n"
+    "    + `window.__FORGE_STATE_URL__='/__forge_state';`\n"
     "    + `(function(){var o=customElements.define.bind(customElements);`\n"
     "    + `customElements.define=function(n,c,x){`\n"
     "    + `if(n==='forge-%s'){var e=document.getElementById('app');if(e)e.innerHTML='';}return o(n,c,x);};})();`\n"
     "    + `</script>`;\n"
-    "  out = out.replace('</head>', patch + '\\n</head>');\n"
-    "\n"
-    "  /* Inject SSR HTML into <forge-app> */\n"
-    "  if (html) {\n"
-    "    out = out.replace(\n"
-    "      /<forge-%s(\\s+[^>]*)?>\\s*<\\/forge-%s>/,\n"
-    "      `<forge-%s id=\"app\">\\n<!-- SSR: pre-rendered -->${html}\\n</forge-%s>`\n"
-    "    );\n"
-    "  }\n"
+    "  out = out.replace('</head>', (_PRELOAD ? _PRELOAD + '\\n' : '') + patch + '\\n</head>');\n"
     "  return out;\n"
+    "}\n\n"
+    "/* Split the page around <forge-%s> so SSR HTML can be streamed between\n"
+    " * the two halves.  Returns null when the template has no mount point. */\n"
+    "const _MOUNT_RE = /<forge-%s(\\s+[^>]*)?>\\s*<\\/forge-%s>/;\n"
+    "function _splitPage(template, meta, data) {\n"
+    "  const out = _pageHead(template, meta, data);\n"
+    "  const m = _MOUNT_RE.exec(out);\n"
+    "  if (!m) return null;\n"
+    "  return [out.slice(0, m.index) + '<forge-%s id=\"app\">\\n<!-- SSR: pre-rendered -->',\n"
+    "          '\\n</forge-%s>' + out.slice(m.index + m[0].length)];\n"
+    "}\n\n"
+    "function _buildPage(template, html, meta, data) {\n"
+    "  const parts = html ? _splitPage(template, meta, data) : null;\n"
+    "  return parts ? parts[0] + html + parts[1] : _pageHead(template, meta, data);\n"
     "}\n\n",
-    tag, tag, tag, tag, tag);
+    tag, tag, tag, tag, tag, tag);
 
   /* ── API proxy ── */
   fprintf(out,
@@ -1497,7 +3073,7 @@ int binding_gen_ssr_server(const ComponentNode *c,
     "                   ...(API_TOKEN ? { Authorization: 'Bearer ' + API_TOKEN } : {}),\n"
     "                   ...(req.headers['content-type'] ? { 'Content-Type': req.headers['content-type'] } : {}) };\n"
     "    if (buf.length) hdrs['Content-Length'] = buf.length;\n"
-    "    const pr = mod.request({ hostname: target.hostname,\n"
+    "    const pr = mod.request({ hostname: target.hostname, agent: _agents[target.protocol],\n"
     "      port: target.port || (isHttps ? 443 : 80),\n"
     "      path: target.pathname + target.search, method: req.method, headers: hdrs }, up => {\n"
     "      res.writeHead(up.statusCode, {\n"
@@ -1511,9 +3087,91 @@ int binding_gen_ssr_server(const ComponentNode *c,
     "  });\n"
     "}\n\n");
 
+  /* ── Metrics ── */
+  fprintf(out,
+    "/* ── Metrics (GET /__forge_metrics) ────────────────────────────────── */\n"
+    "const _metrics = { started: Date.now(), requests: 0, ssr: 0, ssrErrors: 0,\n"
+    "                   apiFetches: 0, apiCoalesced: 0 };\n"
+    "function _sendMetrics(res) {\n"
+    "  const body = JSON.stringify({\n"
+    "    uptime_s: Math.round((Date.now() - _metrics.started) / 1000),\n"
+    "    pid: process.pid,  /* per worker when SSR_WORKERS > 1 */\n"
+    "    requests: _metrics.requests, ssr: _metrics.ssr, ssrErrors: _metrics.ssrErrors,\n"
+    "    api: { fetches: _metrics.apiFetches, coalesced: _metrics.apiCoalesced,\n"
+    "           inflight: _inflight.size },\n"
+    "    cache: cacheStats ? cacheStats() : null,  /* compile with --ssr-cache */\n"
+    "  }, null, 2);\n"
+    "  res.writeHead(200, { 'Content-Type':'application/json', 'Cache-Control':'no-store' });\n"
+    "  res.end(body);\n"
+    "}\n\n"
+    "/* ── Route state (GET /__forge_state?path=/route) ──────────────────── */\n"
+    "/* resolveState() for a route the client is about to visit; deferred\n"
+    " * (Promise) state fields and data are awaited first. */\n"
+    "async function _sendState(req, res) {\n"
+    "  const route = new urlMod.URL(req.url, 'http://localhost').searchParams.get('path') || '/';\n"
+    "  try {\n"
+    "    const result = (await resolveState(route)) || {};\n"
+    "    const state  = {};\n"
+    "    for (const [k, v] of Object.entries(result.state || {})) state[k] = await v;\n"
+    "    const body = JSON.stringify({ state, meta: result.meta || {}, data: (await result.data) || {} });\n"
+    "    res.writeHead(200, { 'Content-Type':'application/json', 'Cache-Control':'no-cache' });\n"
+    "    res.end(body);\n"
+    "  } catch (e) {\n"
+    "    _metrics.ssrErrors++;\n"
+    "    console.error('[ssr] resolveState error:', e.message);\n"
+    "    res.writeHead(500, { 'Content-Type':'application/json' });\n"
+    "    res.end('null');\n"
+    "  }\n"
+    "}\n\n");
+
+  /* ── Streaming page ── */
+  fprintf(out,
+    "/* ── Streaming SSR ─────────────────────────────────────────────────── */\n"
+    "/* Head and shell go out as soon as resolveState() returns; components\n"
+    " * follow as they render, deferred ones last in resolution order. */\n"
+    "async function _streamPage(res, reqPath, template) {\n"
+    "  let result = {}, ok = false;\n"
+    "  try { result = (await resolveState(reqPath)) || {}; ok = true; }\n"
+    "  catch (e) { _metrics.ssrErrors++; console.error('[ssr] resolveState error:', e.message); }\n"
+    "  const meta = result.meta || { title: 'Forge App', desc: '' };\n"
+    "  const lateData = result.data && typeof result.data.then === 'function';\n"
+    "  if (lateData) Promise.resolve(result.data).catch(() => {}); /* awaited after the body */\n"
+    "  const parts = _splitPage(template, meta, lateData ? {} : (result.data || {}));\n"
+    "  res.writeHead(200, { 'Content-Type':'text/html; charset=utf-8', 'Cache-Control':'no-cache' });\n"
+    "  /* Fall back to the static template; client JS still works */\n"
+    "  if (!parts || !ok) { res.end(_pageHead(template, meta, lateData ? {} : result.data)); return; }\n"
+    "\n"
+    "  res.write(parts[0]);\n"
+    "  let bytes = 0;\n"
+    "  try {\n"
+    "    for await (const chunk of renderStream(result.state || {}, {})) {\n"
+    "      if (res.destroyed) break;  /* client went away: stop rendering */\n"
+    "      bytes += chunk.length;\n"
+    "      res.write(chunk);\n"
+    "    }\n"
+    "    if (lateData) {\n"
+    "      const json = JSON.stringify(await result.data).replace(/<\\/script/gi,'<\\\\/script');\n"
+    "      res.write(`<script>window.__SSR_DATA__=${json};</script>`);\n"
+    "    }\n"
+    "    _metrics.ssr++;\n"
+    "    console.log(`[ssr]  GET ${reqPath}  →  ${bytes} bytes (streamed)`);\n"
+    "  } catch (e) {\n"
+    "    _metrics.ssrErrors++;\n"
+    "    console.error('[ssr] render error:', e.message);\n"
+    "    /* Close the mount point anyway — client JS re-renders on load */\n"
+    "  }\n"
+    "  res.end(parts[1]);\n"
+    "}\n\n");
+
   /* ── Request handler + server ── */
   fprintf(out,
     "/* ── HTTP server ────────────────────────────────────────────────────── */\n"
+    "/* Server endpoints, matched before static files and page routes */\n"
+    "const _system = _routeTrie()\n"
+    "  .add('/__forge_metrics', (req, res) => _sendMetrics(res))\n"
+    "  .add('/__forge_state',   _sendState)\n"
+    "  .add('/api/*',           _proxyApi);   /* → backend */\n"
+    "\n"
     "const _server = http.createServer(async (req, res) => {\n"
     "  if (req.method === 'OPTIONS') {\n"
     "    res.writeHead(204, { 'Access-Control-Allow-Origin':'*',\n"
@@ -1523,20 +3181,13 @@ int binding_gen_ssr_server(const ComponentNode *c,
     "  }\n"
     "  const reqPath = (req.url || '/').split('?')[0];\n"
     "\n"
-    "  /* Proxy /api/* → backend */\n"
-    "  if (reqPath.startsWith('/api/')) { _proxyApi(req, res); return; }\n"
+    "  _metrics.requests++;\n"
+    "  const sys = _system.match(reqPath);\n"
+    "  if (sys) { sys.fn(req, res); return; }\n"
     "\n"
     "  /* Static assets (have a file extension) */\n"
     "  const ext = path.extname(reqPath);\n"
-    "  if (ext) {\n"
-    "    try {\n"
-    "      const data = fs.readFileSync(path.join(ROOT_DIR, reqPath));\n"
-    "      res.writeHead(200, { 'Content-Type': MIME[ext.toLowerCase()] || 'application/octet-stream',\n"
-    "                           'Cache-Control': 'public,max-age=300' });\n"
-    "      res.end(data);\n"
-    "    } catch { res.writeHead(404); res.end('Not found'); }\n"
-    "    return;\n"
-    "  }\n"
+    "  if (ext) { _serveStatic(req, res, reqPath); return; }\n"
     "\n"
     "  /* SSR for all SPA routes */\n"
     "  let template;\n"
@@ -1549,14 +3200,18 @@ int binding_gen_ssr_server(const ComponentNode *c,
     "    res.writeHead(500); res.end('Template error: ' + e.message); return;\n"
     "  }\n"
     "\n"
+    "  if (STREAM) { _streamPage(res, reqPath, template); return; }\n"
+    "\n"
     "  let html = '', meta = { title: 'Forge App', desc: '' }, data = {};\n"
     "  try {\n"
     "    const result = await resolveState(reqPath);\n"
     "    meta  = result.meta  || meta;\n"
     "    data  = result.data  || {};\n"
     "    html  = render(result.state || {}, {});\n"
+    "    _metrics.ssr++;\n"
     "    console.log(`[ssr]  GET ${reqPath}  →  ${html.length} bytes`);\n"
     "  } catch (e) {\n"
+    "    _metrics.ssrErrors++;\n"
     "    console.error('[ssr] resolveState error:', e.message);\n"
     "    /* Fall through — serve static template; client JS still works */\n"
     "  }\n"
@@ -1568,13 +3223,26 @@ int binding_gen_ssr_server(const ComponentNode *c,
 
   /* ── Startup ── */
   fprintf(out,
-    "_server.listen(PORT, () => {\n"
-    "  console.log('\\n  \\x1b[32mForge SSR Server\\x1b[0m  (<forge-%s>)');\n"
+    "function _banner(mode) {\n"
+    "  console.log('\\n  \\x1b[32mForge SSR Server\\x1b[0m  (<forge-%s>)  ' + mode);\n"
     "  console.log('  \\x1b[36mLocal:\\x1b[0m  http://localhost:' + PORT);\n"
     "  console.log('  \\x1b[36mAPI:\\x1b[0m    ' + API_BASE);\n"
     "  console.log('  \\x1b[33mEdit resolveState() in forge-ssr-server.js to connect your API.\\x1b[0m');\n"
     "  console.log('  Press Ctrl+C to stop\\n');\n"
-    "});\n",
+    "}\n\n"
+    "/* With SSR_WORKERS > 1 the primary only forks; workers share the listen\n"
+    " * socket through the cluster module and are respawned if they crash. */\n"
+    "if (WORKERS > 1 && (cluster.isPrimary ?? cluster.isMaster)) {\n"
+    "  for (let i = 0; i < WORKERS; i++) cluster.fork();\n"
+    "  cluster.on('exit', (w, code, signal) => {\n"
+    "    if (w.exitedAfterDisconnect) return;\n"
+    "    console.error(`[ssr] worker ${w.process.pid} died (${signal || code}), restarting`);\n"
+    "    cluster.fork();\n"
+    "  });\n"
+    "  _banner(WORKERS + ' workers');\n"
+    "} else {\n"
+    "  _server.listen(PORT, () => { if (!cluster.isWorker) _banner('single process'); });\n"
+    "}\n",
     tag);
 
   return 0;
@@ -26,6 +26,11 @@ typedef struct {
   int typescript;    /* emit .d.ts type declarations              */
   int no_wasm;       /* emit pure-JS DOM renderer (no WASM)       */
   int prerender;     /* emit pre-rendered static HTML + hydration  */
+  int ssr_cache;     /* memoize SSR child renderers (LRU on props) */
+  int ssr_workers;   /* default worker count of the SSR server     */
+  int profile;       /* no-wasm: per-component counters, __forgeProf */
+  const char *bundle;     /* shared .wasm of --bundle, NULL = one each */
+  const char *asset_base; /* URL prefix of the outputs, ends in '/'    */
 } BindingOptions;
 
 int binding_gen_component(const ComponentNode *c, const BindingOptions *opts,
@@ -43,13 +48,25 @@ int binding_gen_prerender(const ComponentNode *c,
                           const ComponentNode **registry, int registry_count,
                           FILE *out);
 
+/* ─── Preload Hints ─────────────────────────────────────────────────────────
+ * <link> tags that start fetching everything `c` needs to hydrate as soon
+ * as the page is parsed: the runtime and the component modules reachable
+ * from `c` (modulepreload), and the .wasm they instantiate — the bundle, or
+ * each component's own module.  Written ahead of the prerendered HTML.
+ */
+int binding_gen_preload(const ComponentNode *c,
+                        const ComponentNode **registry, int registry_count,
+                        const BindingOptions *opts, FILE *out);
+
 /* ─── SSR Renderer (Node.js) ────────────────────────────────────────────────
  * Generates ComponentName.forge.ssr.js — a pure-JS Node.js module that
  * exports render(state, props) => HTML string.  No browser APIs used.
+ * With opts->ssr_cache, child renderers are memoized in an LRU keyed on the
+ * props fields their template reads.
  */
 int binding_gen_ssr_js(const ComponentNode *c,
                        const ComponentNode **registry, int registry_count,
-                       FILE *out);
+                       const BindingOptions *opts, FILE *out);
 
 /* ─── SSR HTTP Server (Node.js) ─────────────────────────────────────────────
  * Generates forge-ssr-server.js — a ready-to-run Node.js SSR HTTP server.
@@ -58,6 +75,6 @@ int binding_gen_ssr_js(const ComponentNode *c,
  */
 int binding_gen_ssr_server(const ComponentNode *c,
                             const ComponentNode **registry, int registry_count,
-                            FILE *out);
+                            const BindingOptions *opts, FILE *out);
 
 #endif /* FORGE_BINDING_GEN_H */
@@ -0,0 +1,460 @@
+/*
+ * Forge Framework - Incremental Build Cache
+ *
+ * See build_cache.h for the entry layout.  The summary is a flat binary
+ * dump of the analyzed AST (host byte order — a cache is never shared
+ * across machines): u32 integers, strings as u32 length + bytes with
+ * 0xFFFFFFFF for NULL.
+ */
+
+#define _POSIX_C_SOURCE 200809L /* getpid / rename / opendir */
+
+#include "build_cache.h"
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <mach-o/dyld.h>
+#endif
+
+#define SUMMARY_MAGIC 0x31434746u /* "FGC1" — bump when the AST changes */
+#define NULL_STR      0xFFFFFFFFu
+
+/* ─── Key ─────────────────────────────────────────────────────────────────── */
+
+static uint64_t fnv1a(uint64_t h, const void *data, size_t len) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+void build_cache_key(const char *src, size_t len, const char *flags,
+                     char out[FORGE_CACHE_KEY_LEN + 1]) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    h = fnv1a(h, flags, strlen(flags) + 1); /* NUL separates flags from src */
+    h = fnv1a(h, src, len);
+    snprintf(out, FORGE_CACHE_KEY_LEN + 1, "%016llx", (unsigned long long)h);
+}
+
+/* argv[0] when it names a path, else its first match on $PATH */
+static int stat_argv0(const char *argv0, struct stat *st) {
+    if (!argv0 || !argv0[0]) return -1;
+    if (strchr(argv0, '/')) return stat(argv0, st);
+    const char *path = getenv("PATH");
+    while (path && *path) {
+        size_t n = strcspn(path, ":");
+        char p[1024];
+        snprintf(p, sizeof(p), "%.*s/%s", n ? (int)n : 1, n ? path : ".", argv0);
+        if (stat(p, st) == 0 && S_ISREG(st->st_mode) && access(p, X_OK) == 0) return 0;
+        path += n + (path[n] == ':');
+    }
+    return -1;
+}
+
+void build_cache_self_stamp(const char *argv0, char *out, size_t cap) {
+    struct stat st;
+    int rc = stat("/proc/self/exe", &st);
+#if defined(__APPLE__)
+    char exe[1024];
+    uint32_t size = sizeof(exe);
+    if (rc != 0 && _NSGetExecutablePath(exe, &size) == 0) rc = stat(exe, &st);
+#endif
+    if (rc != 0) rc = stat_argv0(argv0, &st);
+    if (rc != 0) {
+        if (cap) out[0] = '\0';
+        return;
+    }
+    snprintf(out, cap, "%llx-%llx-%llx", (unsigned long long)st.st_ino,
+             (unsigned long long)st.st_size, (unsigned long long)st.st_mtime);
+}
+
+/* ─── File Helpers ────────────────────────────────────────────────────────── */
+
+static int copy_file(const char *from, const char *to) {
+    FILE *in = fopen(from, "rb");
+    if (!in) return -1;
+    FILE *out = fopen(to, "wb");
+    if (!out) { fclose(in); return -1; }
+
+    char buf[16384];
+    size_t n;
+    int rc = 0;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) {
+        if (fwrite(buf, 1, n, out) != n) { rc = -1; break; }
+    }
+    if (ferror(in)) rc = -1;
+    fclose(in);
+    if (fclose(out) != 0) rc = -1;
+    return rc;
+}
+
+static void remove_dir(const char *path) {
+    DIR *d = opendir(path);
+    if (d) {
+        struct dirent *e;
+        char p[1024];
+        while ((e = readdir(d)) != NULL) {
+            if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+            snprintf(p, sizeof(p), "%s/%s", path, e->d_name);
+            unlink(p);
+        }
+        closedir(d);
+    }
+    rmdir(path);
+}
+
+int build_cache_lookup(const char *dir, const char *key) {
+    char path[1024];
+    struct stat st;
+    snprintf(path, sizeof(path), "%s/%s/files", dir, key);
+    return stat(path, &st) == 0;
+}
+
+int build_cache_restore(const char *dir, const char *key, const char *out_dir) {
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s/files", dir, key);
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+
+    char name[256];
+    int rc = 0;
+    while (fgets(name, sizeof(name), f)) {
+        name[strcspn(name, "\n")] = '\0';
+        if (!name[0]) continue;
+        char from[1024], to[1024];
+        snprintf(from, sizeof(from), "%s/%s/%s", dir, key, name);
+        snprintf(to, sizeof(to), "%s/%s", out_dir, name);
+        if (copy_file(from, to) != 0) { rc = -1; break; }
+        printf("forge: \033[32m✓\033[0m %s  (cached)\n", to);
+    }
+    fclose(f);
+    return rc;
+}
+
+/* ─── Summary Writer ──────────────────────────────────────────────────────── */
+
+static void w_u32(FILE *f, uint32_t v) { fwrite(&v, sizeof(v), 1, f); }
+
+static void w_str(FILE *f, const char *s) {
+    if (!s) { w_u32(f, NULL_STR); return; }
+    uint32_t n = (uint32_t)strlen(s);
+    w_u32(f, n);
+    fwrite(s, 1, n, f);
+}
+
+static void w_type(FILE *f, const TypeRef *t) {
+    w_u32(f, t != NULL);
+    if (!t) return;
+    w_u32(f, (uint32_t)t->kind);
+    w_str(f, t->name);
+    w_type(f, t->inner);
+    w_u32(f, (uint32_t)t->array_size);
+    w_u32(f, (uint32_t)t->is_const);
+    w_type(f, t->ret_type);
+    w_u32(f, (uint32_t)t->param_count);
+    for (int i = 0; i < t->param_count; i++) w_type(f, t->param_types[i]);
+}
+
+static void w_field(FILE *f, const Field *fd) {
+    w_str(f, fd->name);
+    w_type(f, fd->type);
+    w_str(f, fd->init_expr);
+    w_u32(f, (uint32_t)fd->is_reactive);
+}
+
+static void w_html(FILE *f, const HtmlNode *n) {
+    w_u32(f, (uint32_t)n->kind);
+    w_str(f, n->tag);
+    w_str(f, n->text);
+    w_u32(f, (uint32_t)n->self_closing);
+    w_u32(f, n->dep_mask);
+    w_u32(f, (uint32_t)n->attr_count);
+    for (int i = 0; i < n->attr_count; i++) {
+        w_str(f, n->attrs[i].name);
+        w_str(f, n->attrs[i].value);
+        w_u32(f, (uint32_t)n->attrs[i].is_expr);
+        w_u32(f, n->attrs[i].dep_mask);
+    }
+    w_u32(f, (uint32_t)n->child_count);
+    for (int i = 0; i < n->child_count; i++) w_html(f, &n->children[i]);
+}
+
+static void w_flags(FILE *f, const int *flags, int count) {
+    w_u32(f, flags != NULL);
+    if (flags)
+        for (int i = 0; i < count; i++) w_u32(f, (uint32_t)flags[i]);
+}
+
+static void w_component(FILE *f, const ComponentNode *c) {
+    w_str(f, c->name);
+    w_u32(f, (uint32_t)c->loc.line);
+    w_u32(f, (uint32_t)c->loc.column);
+
+    w_u32(f, (uint32_t)c->prop_count);
+    for (int i = 0; i < c->prop_count; i++) w_field(f, &c->props[i]);
+    w_u32(f, (uint32_t)c->state_count);
+    for (int i = 0; i < c->state_count; i++) w_field(f, &c->state[i]);
+
+    w_u32(f, (uint32_t)c->style_count);
+    for (int i = 0; i < c->style_count; i++) {
+        w_str(f, c->style[i].property);
+        w_str(f, c->style[i].value);
+        w_u32(f, (uint32_t)c->style[i].is_dynamic);
+    }
+    w_u32(f, (uint32_t)c->handler_count);
+    for (int i = 0; i < c->handler_count; i++) {
+        w_str(f, c->handlers[i].event_name);
+        w_str(f, c->handlers[i].body);
+        w_u32(f, c->handlers[i].dep_mask);
+    }
+    w_u32(f, (uint32_t)c->computed_count);
+    for (int i = 0; i < c->computed_count; i++) {
+        w_field(f, &c->computed[i].field);
+        w_str(f, c->computed[i].expression);
+        w_u32(f, c->computed[i].dep_mask);
+    }
+
+    w_u32(f, c->template_root != NULL);
+    if (c->template_root) w_html(f, c->template_root);
+
+    w_u32(f, (uint32_t)c->include_count);
+    for (int i = 0; i < c->include_count; i++) w_str(f, c->includes[i]);
+
+    w_flags(f, c->state_used_in_template, c->state_count);
+    w_flags(f, c->props_used_in_template, c->prop_count);
+}
+
+/* ─── Summary Reader ──────────────────────────────────────────────────────── */
+
+typedef struct {
+    const unsigned char *buf;
+    size_t len;
+    size_t pos;
+    int    err; /* sticky: any short read poisons the rest */
+    AstArena *arena; /* of the Program being rebuilt */
+} Reader;
+
+static uint32_t r_u32(Reader *r) {
+    uint32_t v = 0;
+    if (r->err || r->len - r->pos < sizeof(v)) { r->err = 1; return 0; }
+    memcpy(&v, r->buf + r->pos, sizeof(v));
+    r->pos += sizeof(v);
+    return v;
+}
+
+/* Element counts are bounded by what is left in the buffer, so a corrupt
+ * entry cannot ask for a huge allocation. */
+static int r_count(Reader *r) {
+    uint32_t n = r_u32(r);
+    if (n > r->len - r->pos) { r->err = 1; return 0; }
+    return (int)n;
+}
+
+static char *r_str(Reader *r) {
+    uint32_t n = r_u32(r);
+    if (n == NULL_STR || r->err) return NULL;
+    if (n > r->len - r->pos) { r->err = 1; return NULL; }
+    char *s = ast_strndup(r->arena, (const char *)r->buf + r->pos, n);
+    r->pos += n;
+    return s;
+}
+
+static TypeRef *r_type(Reader *r) {
+    if (!r_u32(r) || r->err) return NULL;
+    TypeRef *t = ast_new_type(r->arena, (TypeKind)r_u32(r));
+    t->name        = r_str(r);
+    t->inner       = r_type(r);
+    t->array_size  = (int)r_u32(r);
+    t->is_const    = (int)r_u32(r);
+    t->ret_type    = r_type(r);
+    t->param_count = r_count(r);
+    if (t->param_count > 0) {
+        t->param_types = ast_alloc(r->arena, sizeof(TypeRef *) * (size_t)t->param_count);
+        for (int i = 0; i < t->param_count; i++) t->param_types[i] = r_type(r);
+    }
+    return t;
+}
+
+static void r_field(Reader *r, Field *fd) {
+    fd->name        = r_str(r);
+    fd->type        = r_type(r);
+    fd->init_expr   = r_str(r);
+    fd->is_reactive = (int)r_u32(r);
+}
+
+static void r_html(Reader *r, HtmlNode *n) {
+    n->kind         = (HtmlKind)r_u32(r);
+    n->tag          = r_str(r);
+    n->text         = r_str(r);
+    n->self_closing = (int)r_u32(r);
+    n->dep_mask     = r_u32(r);
+    n->attr_count   = r_count(r);
+    if (n->attr_count > 0) {
+        n->attrs = ast_alloc(r->arena, sizeof(Attribute) * (size_t)n->attr_count);
+        for (int i = 0; i < n->attr_count; i++) {
+            n->attrs[i].name     = r_str(r);
+            n->attrs[i].value    = r_str(r);
+            n->attrs[i].is_expr  = (int)r_u32(r);
+            n->attrs[i].dep_mask = r_u32(r);
+        }
+    }
+    n->child_count = r_count(r);
+    if (n->child_count > 0) {
+        n->children = ast_alloc(r->arena, sizeof(HtmlNode) * (size_t)n->child_count);
+        for (int i = 0; i < n->child_count && !r->err; i++) r_html(r, &n->children[i]);
+    }
+}
+
+static int *r_flags(Reader *r, int count) {
+    if (!r_u32(r) || r->err) return NULL;
+    int *flags = ast_alloc(r->arena, sizeof(int) * (size_t)(count > 0 ? count : 1));
+    for (int i = 0; i < count; i++) flags[i] = (int)r_u32(r);
+    return flags;
+}
+
+static ComponentNode *r_component(Reader *r, const char *filename) {
+    ComponentNode *c = ast_new_component(r->arena);
+    c->name = r_str(r);
+    c->loc.filename = filename;
+    c->loc.line     = (int)r_u32(r);
+    c->loc.column   = (int)r_u32(r);
+
+    c->prop_count = r_count(r);
+    c->props = ast_alloc(r->arena, sizeof(Field) * ((size_t)c->prop_count + 1));
+    for (int i = 0; i < c->prop_count; i++) r_field(r, &c->props[i]);
+    c->state_count = r_count(r);
+    c->state = ast_alloc(r->arena, sizeof(Field) * ((size_t)c->state_count + 1));
+    for (int i = 0; i < c->state_count; i++) r_field(r, &c->state[i]);
+
+    c->style_count = r_count(r);
+    c->style = ast_alloc(r->arena, sizeof(StyleRule) * ((size_t)c->style_count + 1));
+    for (int i = 0; i < c->style_count; i++) {
+        c->style[i].property   = r_str(r);
+        c->style[i].value      = r_str(r);
+        c->style[i].is_dynamic = (int)r_u32(r);
+    }
+    c->handler_count = r_count(r);
+    c->handlers = ast_alloc(r->arena,
+                            sizeof(EventHandler) * ((size_t)c->handler_count + 1));
+    for (int i = 0; i < c->handler_count; i++) {
+        c->handlers[i].event_name = r_str(r);
+        c->handlers[i].body       = r_str(r);
+        c->handlers[i].dep_mask   = r_u32(r);
+    }
+    c->computed_count = r_count(r);
+    c->computed = ast_alloc(r->arena,
+                            sizeof(ComputedField) * ((size_t)c->computed_count + 1));
+    for (int i = 0; i < c->computed_count; i++) {
+        r_field(r, &c->computed[i].field);
+        c->computed[i].expression = r_str(r);
+        c->computed[i].dep_mask   = r_u32(r);
+    }
+
+    if (r_u32(r) && !r->err) {
+        c->template_root = ast_new_html_node(r->arena, HTML_ELEMENT);
+        r_html(r, c->template_root);
+    }
+
+    c->include_count = r_count(r);
+    c->includes = ast_alloc(r->arena, sizeof(char *) * ((size_t)c->include_count + 1));
+    for (int i = 0; i < c->include_count; i++) c->includes[i] = r_str(r);
+
+    c->state_used_in_template = r_flags(r, c->state_count);
+    c->props_used_in_template = r_flags(r, c->prop_count);
+    return c;
+}
+
+Program *build_cache_load_program(const char *dir, const char *key,
+                                  const char *filename) {
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s/summary", dir, key);
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    rewind(f);
+    unsigned char *buf = sz > 0 ? malloc((size_t)sz) : NULL;
+    if (!buf || fread(buf, 1, (size_t)sz, f) != (size_t)sz) {
+        free(buf);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+
+    Reader r = { buf, (size_t)sz, 0, 0, NULL };
+    Program *prog = NULL;
+    if (r_u32(&r) == SUMMARY_MAGIC) {
+        int count = r_count(&r);
+        prog = ast_new_program();
+        r.arena = &prog->arena;
+        prog->components =
+            ast_alloc(r.arena, sizeof(ComponentNode *) * ((size_t)count + 1));
+        for (int i = 0; i < count && !r.err; i++)
+            prog->components[prog->component_count++] = r_component(&r, filename);
+    }
+    if (prog && r.err) {
+        ast_free_program(prog);
+        prog = NULL;
+    }
+    free(buf);
+    return prog;
+}
+
+/* ─── Store ───────────────────────────────────────────────────────────────── */
+
+int build_cache_store(const char *dir, const char *key, const Program *prog,
+                      const char *out_dir, int with_types, const char *wasm_ext) {
+    mkdir(dir, 0755);
+
+    char tmp[512], path[1024];
+    snprintf(tmp, sizeof(tmp), "%s/%s.tmp.%ld", dir, key, (long)getpid());
+    remove_dir(tmp);
+    if (mkdir(tmp, 0755) != 0) return -1;
+
+    /* Outputs */
+    snprintf(path, sizeof(path), "%s/files", tmp);
+    FILE *list = fopen(path, "w");
+    if (!list) { remove_dir(tmp); return -1; }
+
+    const char *const exts[] = { ".gen.c", ".forge.js", ".forge.d.ts", wasm_ext };
+    int rc = 0;
+    for (int i = 0; i < prog->component_count && rc == 0; i++) {
+        for (int e = 0; e < 4; e++) {
+            if (e == 2 && !with_types) continue;
+            if (e == 3 && !wasm_ext)   continue;
+            char name[256], from[1024], to[1024];
+            snprintf(name, sizeof(name), "%s%s", prog->components[i]->name, exts[e]);
+            snprintf(from, sizeof(from), "%s/%s", out_dir, name);
+            snprintf(to, sizeof(to), "%s/%s", tmp, name);
+            if (copy_file(from, to) != 0) { rc = -1; break; }
+            fprintf(list, "%s\n", name);
+        }
+    }
+    if (fclose(list) != 0) rc = -1;
+
+    /* Summary */
+    snprintf(path, sizeof(path), "%s/summary", tmp);
+    FILE *sf = rc == 0 ? fopen(path, "wb") : NULL;
+    if (sf) {
+        w_u32(sf, SUMMARY_MAGIC);
+        w_u32(sf, (uint32_t)prog->component_count);
+        for (int i = 0; i < prog->component_count; i++) w_component(sf, prog->components[i]);
+        if (fclose(sf) != 0) rc = -1;
+    } else {
+        rc = -1;
+    }
+
+    /* Publish: a concurrent build may have stored the same key first */
+    snprintf(path, sizeof(path), "%s/%s", dir, key);
+    if (rc == 0 && rename(tmp, path) != 0 && errno != EEXIST && errno != ENOTEMPTY)
+        rc = -1;
+    remove_dir(tmp);
+    return rc;
+}
@@ -0,0 +1,52 @@
+/*
+ * Forge Framework - Incremental Build Cache
+ *
+ * Content-addressed cache of per-file compiler outputs.  An entry is keyed
+ * by a hash of the .cx source bytes, the compiler version and binary, and
+ * every flag that changes generated code, and lives in <cache_dir>/<key>/:
+ *
+ *   files      one output file name per line (.gen.c, .forge.js, .d.ts, .wasm)
+ *   summary    serialized, analyzed ComponentNodes — lets SSG/SSR inline a
+ *              cached component without re-parsing it
+ *   <outputs>  copies of the files listed above
+ *
+ * A hit costs one hash, a directory probe and a file copy per output.
+ */
+
+#ifndef FORGE_BUILD_CACHE_H
+#define FORGE_BUILD_CACHE_H
+
+#include "ast.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define FORGE_CACHE_KEY_LEN 16 /* hex digits of a 64-bit key */
+
+/* Key over source bytes + `flags` (a string naming version and options) */
+void build_cache_key(const char *src, size_t len, const char *flags,
+                     char out[FORGE_CACHE_KEY_LEN + 1]);
+
+/* Identity of the running compiler binary (inode, size, mtime) for the key
+ * flags, so a rebuilt compiler never restores entries made by the old one
+ * while FORGE_VERSION stays put.  "" when the binary cannot be found. */
+void build_cache_self_stamp(const char *argv0, char *out, size_t cap);
+
+/* 1 if a complete entry exists for `key` */
+int build_cache_lookup(const char *dir, const char *key);
+
+/* Copy a hit's outputs into out_dir; prints one line per file.  0 on success */
+int build_cache_restore(const char *dir, const char *key, const char *out_dir);
+
+/* Rebuild the analyzed Program stored with a hit.  `filename` becomes each
+ * component's loc.filename and must outlive the result.  NULL on failure. */
+Program *build_cache_load_program(const char *dir, const char *key,
+                                  const char *filename);
+
+/* Record out_dir outputs for `prog` under `key`.  Entries are written to a
+ * temporary directory and renamed into place, so concurrent builds never see
+ * a partial entry.  `wasm_ext` names each component's compiled output
+ * (".wasm", or ".o" for a --bundle build), NULL for none.  0 on success. */
+int build_cache_store(const char *dir, const char *key, const Program *prog,
+                      const char *out_dir, int with_types, const char *wasm_ext);
+
+#endif /* FORGE_BUILD_CACHE_H */
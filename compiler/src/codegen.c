@@ -21,13 +21,20 @@
  *   void __button_render(forge_ctx *ctx, const Button_Props *props);
  *
  *   // Lifecycle entry points (exported to WASM host)
- *   FORGE_EXPORT void forge_mount(uint32_t el_id, void *props_json, uint32_t props_len);
- *   FORGE_EXPORT void forge_update(uint32_t el_id, void *props_json, uint32_t props_len);
- *   FORGE_EXPORT void forge_dispatch(uint32_t el_id, forge_event_type ev);
- *   FORGE_EXPORT void forge_unmount(uint32_t el_id);
+ *   // mount returns a registry handle that the other entry points take
+ *   // props are written by the host per the exported schema: into the
+ *   // staging block before mount, into the context's block afterwards
+ *   FORGE_EXPORT const forge_props_schema_t *forge_props_schema(void);
+ *   FORGE_EXPORT void *forge_props_ptr(uint32_t handle);
+ *   FORGE_EXPORT uint32_t forge_mount(uint32_t el_id);
+ *   FORGE_EXPORT void forge_update(uint32_t handle, uint32_t changed_mask);
+ *   FORGE_EXPORT void forge_dispatch(uint32_t handle, forge_event_type ev);
+ *   FORGE_EXPORT void forge_unmount(uint32_t handle);
  */
 
 #include "codegen.h"
+#include "analyzer.h"
+#include "../../runtime/include/forge/dom_names.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -86,6 +93,54 @@ static void emit_props_struct(const ComponentNode *c, FILE *out) {
     fprintf(out, "} %s_Props;\n\n", c->name);
 }
 
+/* ─── Props Schema ────────────────────────────────────────────────────────── */
+
+/* How the JS host writes a field of this type (ForgePropKind) */
+static const char *prop_kind(const TypeRef *t) {
+    if (!t) return "FORGE_PROP_OPAQUE";
+    switch (t->kind) {
+    case TY_INT: case TY_LONG: case TY_SHORT: case TY_CHAR: case TY_ENUM:
+        return "FORGE_PROP_INT";
+    case TY_UNSIGNED:
+        return "FORGE_PROP_UINT";
+    case TY_FLOAT: case TY_DOUBLE:
+        return "FORGE_PROP_FLOAT";
+    case TY_BOOL:
+        return "FORGE_PROP_BOOL";
+    case TY_PTR:
+        return t->inner && t->inner->kind == TY_CHAR ? "FORGE_PROP_STR" : "FORGE_PROP_OPAQUE";
+    case TY_ARRAY:
+        return t->inner && t->inner->kind == TY_CHAR ? "FORGE_PROP_TEXT" : "FORGE_PROP_OPAQUE";
+    default:
+        return "FORGE_PROP_OPAQUE";
+    }
+}
+
+/* Offsets and sizes come from the C compiler, so the host sees the real
+ * wasm32 layout; field order matches the binding's propFields list */
+static void emit_props_schema(const ComponentNode *c, FILE *out) {
+    char lname[256];
+    lower(lname, c->name);
+
+    fprintf(out, "/* ── Props Schema ──────────────────────── */\n");
+    if (c->prop_count > 0) {
+        fprintf(out, "static const forge_prop_field_t __%s_prop_fields[] = {\n", lname);
+        for (int i = 0; i < c->prop_count; i++) {
+            const Field *f = &c->props[i];
+            fprintf(out, "    { offsetof(%s_Props, %s), %s, sizeof(((%s_Props *)0)->%s) },\n",
+                    c->name, f->name, prop_kind(f->type), c->name, f->name);
+        }
+        fprintf(out, "};\n");
+    }
+    fprintf(out, "static const forge_props_schema_t __%s_props_schema = { %d, sizeof(%s_Props), %s%s%s };\n\n",
+            lname, c->prop_count, c->name,
+            c->prop_count ? "__" : "0", c->prop_count ? lname : "",
+            c->prop_count ? "_prop_fields" : "");
+    fprintf(out, "FORGE_EXPORT const forge_props_schema_t *forge_props_schema_%s(void) {\n", lname);
+    fprintf(out, "    return &__%s_props_schema;\n", lname);
+    fprintf(out, "}\n\n");
+}
+
 /* ─── State Struct ────────────────────────────────────────────────────────── */
 
 static void emit_state_struct(const ComponentNode *c, FILE *out) {
@@ -118,10 +173,155 @@ static void emit_state_init(const ComponentNode *c, FILE *out) {
     fprintf(out, "}\n\n");
 }
 
-/* ─── HTML → DOM Calls ────────────────────────────────────────────────────── */
+/* ─── Interned DOM Names ──────────────────────────────────────────────────── */
+
+#define NAME_STR(n) #n,
+static const char *TAG_NAMES[]  = { "", FORGE_DOM_TAGS(NAME_STR) };
+static const char *ATTR_NAMES[] = { "", FORGE_DOM_ATTRS(NAME_STR) };
+#undef NAME_STR
+
+/* Interned ID of `name` in `table`, or 0 */
+static int intern_id(const char **table, int count, const char *name) {
+    for (int i = 1; i < count; i++)
+        if (strcmp(table[i], name) == 0) return i;
+    return 0;
+}
+
+/* Emit the `id, name` operand pair taken by forge_dom_cmd_* calls */
+static void emit_name_operand(const char **table, int count, const char *prefix,
+                              const char *name, FILE *out) {
+    if (intern_id(table, count, name))
+        fprintf(out, "%s%s, 0", prefix, name);
+    else
+        fprintf(out, "0, \"%s\"", name);
+}
+
+/* Emit the characters of `s` for use inside a C string literal */
+static void emit_c_chars(const char *s, FILE *out) {
+    for (; s && *s; s++) {
+        if (*s == '"' || *s == '\\') { fputc('\\', out); fputc(*s, out); }
+        else if (*s == '\n') fputs("\\n", out);
+        else if (*s == '\r') fputs("\\r", out);
+        else fputc(*s, out);
+    }
+}
+
+/* Emit a C string literal, escaping quotes, backslashes and newlines */
+static void emit_c_str(const char *s, FILE *out) {
+    fputc('"', out);
+    emit_c_chars(s, out);
+    fputc('"', out);
+}
+
+/* Like emit_c_chars, with HTML text/attribute escaping applied first */
+static void emit_html_chars(const char *s, FILE *out) {
+    for (; s && *s; s++) {
+        if (*s == '&') fputs("&amp;", out);
+        else if (*s == '<') fputs("&lt;", out);
+        else if (*s == '>') fputs("&gt;", out);
+        else if (*s == '"') fputs("&quot;", out);
+        else { char c[2] = { *s, 0 }; emit_c_chars(c, out); }
+    }
+}
+
+/* ─── HTML → DOM Commands ─────────────────────────────────────────────────── */
+
+/* Render code goes through the batched command buffer (dom.h); the host
+ * executes it in one forge_dom_flush() at the end of mount/frame. */
 
 static int node_counter = 0;
 
+/* ─── Delegated Events ────────────────────────────────────────────────────────
+ * Listeners are not attached per element.  Each element with on* attributes
+ * gets a slot; render tags it with (handle, slot) through a DELEGATE command
+ * and the component type registers one table of (slot, event hash, handler)
+ * rows, sorted for forge_event_dispatch's binary search.  Elements past the
+ * table's capacity fall back to a direct listener.
+ */
+
+#define MAX_EVENT_ROWS 1024
+
+typedef struct {
+    unsigned    slot;
+    unsigned    hash;
+    const char *event;
+    const char *handler;
+} EventRow;
+
+static EventRow event_rows[MAX_EVENT_ROWS];
+static int      event_row_count = 0;
+static int      event_slot_count = 0;
+
+/* Same FNV-1a as forge_fnv1a in runtime/include/forge/types.h */
+static unsigned event_hash(const char *s) {
+    unsigned h = 2166136261u;
+    while (*s) { h ^= (unsigned char)*s++; h *= 16777619u; }
+    return h & 0xffffffffu;
+}
+
+static int cmp_event_row(const void *a, const void *b) {
+    const EventRow *x = (const EventRow *)a, *y = (const EventRow *)b;
+    if (x->slot != y->slot) return x->slot < y->slot ? -1 : 1;
+    if (x->hash != y->hash) return x->hash < y->hash ? -1 : 1;
+    return 0;
+}
+
+/* ─── Static Subtrees ─────────────────────────────────────────────────────────
+ * An element whose whole subtree is static markup (no expressions, bound
+ * attributes or listeners) is sent as one CLONE command carrying its HTML;
+ * the host parses it into a <template> once and clones it on later mounts.
+ * Tags whose content the HTML parser would restructure are kept out.
+ */
+
+static int is_static_subtree(const HtmlNode *n) {
+    static const char *unsafe[] = { "table", "thead", "tbody", "tfoot", "tr",
+                                    "td", "th", "select", "option", "textarea",
+                                    "template", "script", "style", "svg", "p",
+                                    NULL };
+    if (n->kind == HTML_TEXT) return 1;
+    if (n->kind != HTML_ELEMENT || !n->tag || strchr(n->tag, '-')) return 0;
+    for (int i = 0; unsafe[i]; i++)
+        if (strcmp(n->tag, unsafe[i]) == 0) return 0;
+    for (int i = 0; i < n->attr_count; i++) {
+        const char *aname = n->attrs[i].name;
+        if (n->attrs[i].is_expr ||
+            (strncmp(aname, "on", 2) == 0 && islower((unsigned char)aname[2])))
+            return 0;
+    }
+    for (int i = 0; i < n->child_count; i++)
+        if (!is_static_subtree(&n->children[i])) return 0;
+    return 1;
+}
+
+static int count_nodes(const HtmlNode *n) {
+    int c = 1;
+    for (int i = 0; i < n->child_count; i++) c += count_nodes(&n->children[i]);
+    return c;
+}
+
+/* Emit the body of a C string literal holding `n` as HTML markup */
+static void emit_static_html(const HtmlNode *n, FILE *out) {
+    static const char *voids[] = { "img", "input", "br", "hr", "meta", "link",
+                                   "area", "col", "embed", "source", "wbr",
+                                   NULL };
+    if (n->kind == HTML_TEXT) {
+        emit_html_chars(n->text, out);
+        return;
+    }
+    fprintf(out, "<%s", n->tag);
+    for (int i = 0; i < n->attr_count; i++) {
+        fprintf(out, " %s=\\\"", n->attrs[i].name);
+        emit_html_chars(n->attrs[i].value ? n->attrs[i].value : "", out);
+        fputs("\\\"", out);
+    }
+    fputc('>', out);
+    for (int i = 0; i < n->child_count; i++)
+        emit_static_html(&n->children[i], out);
+    for (int i = 0; voids[i]; i++)
+        if (strcmp(n->tag, voids[i]) == 0) return;
+    fprintf(out, "</%s>", n->tag);
+}
+
 static void emit_html_node(const HtmlNode *n, const char *parent_var,
                             const char *comp_name, FILE *out) {
     if (!n) return;
@@ -134,51 +334,85 @@ static void emit_html_node(const HtmlNode *n, const char *parent_var,
     switch (n->kind) {
     case HTML_TEXT:
         if (n->text && n->text[0]) {
-            fprintf(out, "    forge_dom_text(%s, \"%s\");\n", parent_var, n->text);
+            fprintf(out, "    forge_dom_cmd_text(%s, ", parent_var);
+            emit_c_str(n->text, out);
+            fprintf(out, ");\n");
         }
         break;
 
     case HTML_EXPR:
         /* Expression node: emit a text node updated by a reactive function */
-        fprintf(out, "    forge_dom_expr(%s, (forge_expr_fn)__expr_%s_%d, __ctx);\n",
-                parent_var, lname, my_id);
+        fprintf(out, "    forge_dom_cmd_expr(%s, (forge_expr_fn)__expr_%s_%d, __ctx, 0x%xu);\n",
+                parent_var, lname, my_id, n->dep_mask ? n->dep_mask : FORGE_DEP_ALL);
         break;
 
     case HTML_COMPONENT:
         /* Nested component */
         fprintf(out, "    {\n");
         fprintf(out, "        /* mount child component: %s */\n", n->tag ? n->tag : "?");
-        fprintf(out, "        forge_dom_node_t *%s = forge_dom_create_component(%s, \"%s\");\n",
+        fprintf(out, "        forge_dom_node_t *%s = forge_dom_cmd_component(%s, \"%s\");\n",
                 var, parent_var, n->tag ? n->tag : "?");
         for (int i = 0; i < n->attr_count; i++) {
             if (n->attrs[i].is_expr)
-                fprintf(out, "        forge_dom_set_prop(%s, \"%s\", (forge_val_t){%s});\n",
+                fprintf(out, "        forge_dom_cmd_prop(%s, \"%s\", (forge_val_t){%s});\n",
                         var, n->attrs[i].name, n->attrs[i].value ? n->attrs[i].value : "0");
-            else
-                fprintf(out, "        forge_dom_set_prop_str(%s, \"%s\", \"%s\");\n",
-                        var, n->attrs[i].name, n->attrs[i].value ? n->attrs[i].value : "");
+            else {
+                fprintf(out, "        forge_dom_cmd_prop_str(%s, \"%s\", ", var, n->attrs[i].name);
+                emit_c_str(n->attrs[i].value ? n->attrs[i].value : "", out);
+                fprintf(out, ");\n");
+            }
         }
         fprintf(out, "    }\n");
         break;
 
-    case HTML_ELEMENT:
-        fprintf(out, "    forge_dom_node_t *%s = forge_dom_create(%s, \"%s\");\n",
-                var, parent_var, n->tag ? n->tag : "div");
+    case HTML_ELEMENT: {
+        const char *tag = n->tag ? n->tag : "div";
+        if (count_nodes(n) >= 3 && is_static_subtree(n)) {
+            fprintf(out, "    forge_dom_cmd_clone(%s, \"", parent_var);
+            emit_static_html(n, out);
+            fprintf(out, "\");\n");
+            /* Keep IDs of later nodes identical to the node-by-node path */
+            node_counter += count_nodes(n) - 1;
+            break;
+        }
+        fprintf(out, "    forge_dom_node_t *%s = forge_dom_cmd_create(%s, ", var, parent_var);
+        emit_name_operand(TAG_NAMES, FORGE_TAG_COUNT, "FORGE_TAG_", tag, out);
+        fprintf(out, ");\n");
 
         /* Emit attributes */
+        int slot = -1;
         for (int i = 0; i < n->attr_count; i++) {
             const char *aname = n->attrs[i].name;
             const char *aval  = n->attrs[i].value ? n->attrs[i].value : "";
 
-            /* Event binding: onclick → forge_dom_on */
+            /* Event binding: onclick → a row in the delegated table */
             if (strncmp(aname, "on", 2) == 0 && islower((unsigned char)aname[2])) {
-                fprintf(out, "    forge_dom_on(%s, \"%s\", __on_%s_%s, __ctx);\n",
-                        var, aname + 2, lname, aval);
+                const char *handler = aval[0] == '@' ? aval + 1 : aval;
+                if (event_row_count < MAX_EVENT_ROWS) {
+                    if (slot < 0) slot = event_slot_count++;
+                    EventRow *r = &event_rows[event_row_count++];
+                    r->slot    = (unsigned)slot;
+                    r->hash    = event_hash(aname + 2);
+                    r->event   = aname + 2;
+                    r->handler = handler;
+                    fprintf(out, "    forge_dom_cmd_delegate(%s, \"%s\", %du, __ctx);\n",
+                            var, aname + 2, slot);
+                } else {
+                    fprintf(out, "    forge_dom_cmd_on(%s, \"%s\", __on_%s_%s, __ctx);\n",
+                            var, aname + 2, lname, handler);
+                }
             } else if (n->attrs[i].is_expr) {
-                fprintf(out, "    forge_dom_set_attr_expr(%s, \"%s\", (forge_expr_fn)__attr_%s_%d_%s, __ctx);\n",
-                        var, aname, lname, my_id, aname);
+                fprintf(out, "    forge_dom_cmd_attr_expr(%s, ", var);
+                emit_name_operand(ATTR_NAMES, FORGE_ATTR_COUNT, "FORGE_ATTR_", aname, out);
+                fprintf(out, ", (forge_expr_fn)__attr_%s_%d_%s, __ctx, 0x%xu);\n",
+                        lname, my_id, aname,
+                        n->attrs[i].dep_mask ? n->attrs[i].dep_mask : FORGE_DEP_ALL);
             } else {
-                fprintf(out, "    forge_dom_set_attr(%s, \"%s\", \"%s\");\n", var, aname, aval);
+                fprintf(out, "    forge_dom_cmd_attr(%s, ", var);
+                emit_name_operand(ATTR_NAMES, FORGE_ATTR_COUNT, "FORGE_ATTR_", aname, out);
+                fprintf(out, ", ");
+                emit_c_str(aval, out);
+                fprintf(out, ");\n");
             }
         }
 
@@ -188,14 +422,26 @@ static void emit_html_node(const HtmlNode *n, const char *parent_var,
         }
         break;
     }
+
+    default:
+        break;
+    }
 }
 
 /* ─── Render Function ─────────────────────────────────────────────────────── */
 
+static int has_dynamic_style(const ComponentNode *c) {
+    for (int i = 0; i < c->style_count; i++)
+        if (c->style[i].is_dynamic) return 1;
+    return 0;
+}
+
 static void emit_render_fn(const ComponentNode *c, FILE *out) {
     char lname[256];
     lower(lname, c->name);
-    node_counter = 0;
+    node_counter     = 0;
+    event_row_count  = 0;
+    event_slot_count = 0;
 
     fprintf(out, "/* ── Render ─────────────────────────────── */\n");
     fprintf(out, "static void __%s_render(\n", lname);
@@ -208,8 +454,24 @@ static void emit_render_fn(const ComponentNode *c, FILE *out) {
     if (c->template_root) {
         emit_html_node(c->template_root, "__root", c->name, out);
     }
+    if (has_dynamic_style(c)) {
+        fprintf(out, "    forge_dom_cmd_attr_expr(__root, ");
+        emit_name_operand(ATTR_NAMES, FORGE_ATTR_COUNT, "FORGE_ATTR_", "style", out);
+        /* Style rules carry no mask of their own */
+        fprintf(out, ", (forge_expr_fn)__%s_style, __ctx, 0x%xu);\n", lname, FORGE_DEP_ALL);
+    }
 
     fprintf(out, "}\n\n");
+
+    if (event_row_count == 0) return;
+    qsort(event_rows, (size_t)event_row_count, sizeof(EventRow), cmp_event_row);
+    fprintf(out, "/* Delegated events, sorted by (slot, type_hash) */\n");
+    fprintf(out, "static const forge_event_slot_t __%s_events[] = {\n", lname);
+    for (int i = 0; i < event_row_count; i++)
+        fprintf(out, "    { %uu, 0x%08xu, __on_%s_%s }, /* %s */\n",
+                event_rows[i].slot, event_rows[i].hash, lname,
+                event_rows[i].handler, event_rows[i].event);
+    fprintf(out, "};\n\n");
 }
 
 /* ─── Event Handlers ──────────────────────────────────────────────────────── */
@@ -231,7 +493,10 @@ static void emit_event_handlers(const ComponentNode *c, FILE *out) {
             fprintf(out, "    /* user code */\n");
             fprintf(out, "    %s\n", c->handlers[i].body);
         }
-        /* After state mutation, trigger reactive update */
+        /* After state mutation, mark the touched fields and trigger a
+         * reactive update */
+        fprintf(out, "    __ctx->dirty |= 0x%xu;\n",
+                c->handlers[i].dep_mask ? c->handlers[i].dep_mask : FORGE_DEP_ALL);
         fprintf(out, "    forge_schedule_update(__ctx);\n");
         fprintf(out, "}\n\n");
     }
@@ -260,43 +525,91 @@ static void emit_computed(const ComponentNode *c, FILE *out) {
 
 /* ─── Lifecycle Exports ───────────────────────────────────────────────────── */
 
-static void emit_lifecycle(const ComponentNode *c, FILE *out) {
+static void emit_lifecycle(const ComponentNode *c, const CodegenOptions *opts,
+                           FILE *out) {
     char lname[256];
     lower(lname, c->name);
+    int profile = opts && opts->profile;
 
     fprintf(out, "/* ── Lifecycle Exports ──────────────────── */\n");
 
-    /* forge_mount: called when component is inserted into DOM */
-    fprintf(out, "FORGE_EXPORT void forge_mount_%s(\n", lname);
-    fprintf(out, "        uint32_t           el_id,\n");
-    fprintf(out, "        const uint8_t     *props_json,\n");
-    fprintf(out, "        uint32_t           props_len) {\n");
+    /* --profile: the type's counters, bracketing render and update */
+    if (profile)
+        fprintf(out, "static forge_profile_t __%s_profile = { .name = \"%s\" };\n\n",
+                lname, c->name);
+
+    /* Update function: run by forge_flush_updates() for queued contexts */
+    fprintf(out, "static uint32_t __%s_type_id = 0;\n\n", lname);
+    fprintf(out, "static void __%s_update(forge_ctx_t *__ctx, uint32_t dirty) {\n", lname);
+    if (profile) {
+        fprintf(out, "    forge_profile_mark_t __m = forge_profile_begin(&__%s_profile);\n", lname);
+        fprintf(out, "    uint32_t __n = forge_dom_refresh(__ctx, dirty);\n");
+        fprintf(out, "    forge_profile_end(&__%s_profile, FORGE_PROFILE_UPDATE, __m, __n);\n",
+                lname);
+    } else {
+        fprintf(out, "    forge_dom_refresh(__ctx, dirty);\n");
+    }
+    fprintf(out, "}\n\n");
+
+    /* Props the host writes before mount; copied into the new context */
+    fprintf(out, "static %s_Props __%s_props_stage;\n\n", c->name, lname);
+
+    /* forge_props_ptr: where the host writes props, per the schema */
+    fprintf(out, "FORGE_EXPORT void *forge_props_ptr_%s(uint32_t handle) {\n", lname);
+    fprintf(out, "    if (!handle) return &__%s_props_stage; /* next mount */\n", lname);
+    fprintf(out, "    forge_ctx_t *__ctx = forge_ctx_resolve(handle);\n");
+    fprintf(out, "    return __ctx ? __ctx->props : 0;\n");
+    fprintf(out, "}\n\n");
+
+    /* forge_mount: called when component is inserted into DOM.  Returns
+     * the handle the host passes to update/dispatch/unmount. */
+    fprintf(out, "FORGE_EXPORT uint32_t forge_mount_%s(uint32_t el_id) {\n", lname);
     fprintf(out, "    forge_ctx_t *__ctx = forge_ctx_new(el_id, sizeof(%s_State), sizeof(%s_Props));\n",
             c->name, c->name);
+    fprintf(out, "    if (!__ctx) return 0; /* out of memory, reported by the runtime */\n");
+    if (event_row_count) {
+        fprintf(out, "    if (!__%s_type_id) {\n", lname);
+        fprintf(out, "        __%s_type_id = forge_register_update_fn(__%s_update);\n",
+                lname, lname);
+        fprintf(out, "        forge_register_events(__%s_type_id, __%s_events, %du);\n",
+                lname, lname, event_row_count);
+        fprintf(out, "    }\n");
+    } else {
+        fprintf(out, "    if (!__%s_type_id) __%s_type_id = forge_register_update_fn(__%s_update);\n",
+                lname, lname, lname);
+    }
+    fprintf(out, "    __ctx->type_id = __%s_type_id;\n", lname);
     fprintf(out, "    %s_State *state = (%s_State*)__ctx->state;\n", c->name, c->name);
     fprintf(out, "    *state = __%s_state_init();\n", lname);
-    fprintf(out, "    forge_props_deserialize(__ctx->props, props_json, props_len);\n");
+    fprintf(out, "    *(%s_Props*)__ctx->props = __%s_props_stage;\n", c->name, lname);
+    /* Registered before render: DELEGATE commands carry the handle */
+    fprintf(out, "    uint32_t __handle = forge_ctx_register(__ctx, el_id);\n");
+    fprintf(out, "    if (!__handle) { forge_ctx_free(__ctx); return 0; }\n");
     fprintf(out, "    forge_dom_node_t *root = forge_dom_get(el_id);\n");
+    if (profile)
+        fprintf(out, "    forge_profile_mark_t __m = forge_profile_begin(&__%s_profile);\n", lname);
     fprintf(out, "    __%s_render(__ctx, (%s_Props*)__ctx->props, state, root);\n", lname, c->name);
-    fprintf(out, "    forge_ctx_register(__ctx, el_id);\n");
+    fprintf(out, "    forge_dom_cmd_flush();\n");
+    if (profile)
+        fprintf(out, "    forge_profile_end(&__%s_profile, FORGE_PROFILE_RENDER, __m, 0);\n",
+                lname);
+    fprintf(out, "    return __handle;\n");
     fprintf(out, "}\n\n");
 
-    /* forge_update: called when props change from parent */
-    fprintf(out, "FORGE_EXPORT void forge_update_%s(\n", lname);
-    fprintf(out, "        uint32_t           el_id,\n");
-    fprintf(out, "        const uint8_t     *props_json,\n");
-    fprintf(out, "        uint32_t           props_len) {\n");
-    fprintf(out, "    forge_ctx_t *__ctx = forge_ctx_get(el_id);\n");
-    fprintf(out, "    if (!__ctx) return;\n");
-    fprintf(out, "    forge_props_deserialize(__ctx->props, props_json, props_len);\n");
+    /* forge_update: the host has written props fields in place; `changed`
+     * has bit i set for each props field i it touched */
+    fprintf(out, "FORGE_EXPORT void forge_update_%s(uint32_t handle, uint32_t changed) {\n", lname);
+    fprintf(out, "    forge_ctx_t *__ctx = forge_ctx_resolve(handle);\n");
+    fprintf(out, "    if (!__ctx || !changed) return;\n");
+    fprintf(out, "    __ctx->dirty |= forge_props_dirty(changed, %du);\n", c->state_count);
     fprintf(out, "    forge_schedule_update(__ctx);\n");
     fprintf(out, "}\n\n");
 
     /* forge_dispatch: route an event to this component */
     fprintf(out, "FORGE_EXPORT void forge_dispatch_%s(\n", lname);
-    fprintf(out, "        uint32_t         el_id,\n");
+    fprintf(out, "        uint32_t         handle,\n");
     fprintf(out, "        forge_event_t   *event) {\n");
-    fprintf(out, "    forge_ctx_t *__ctx = forge_ctx_get(el_id);\n");
+    fprintf(out, "    forge_ctx_t *__ctx = forge_ctx_resolve(handle);\n");
     fprintf(out, "    if (!__ctx) return;\n");
     /* Route to correct handler */
     for (int i = 0; i < c->handler_count; i++) {
@@ -309,14 +622,56 @@ static void emit_lifecycle(const ComponentNode *c, FILE *out) {
     fprintf(out, "}\n\n");
 
     /* forge_unmount: cleanup */
-    fprintf(out, "FORGE_EXPORT void forge_unmount_%s(uint32_t el_id) {\n", lname);
-    fprintf(out, "    forge_ctx_t *__ctx = forge_ctx_get(el_id);\n");
-    fprintf(out, "    if (__ctx) { forge_ctx_free(__ctx); forge_ctx_unregister(el_id); }\n");
+    fprintf(out, "FORGE_EXPORT void forge_unmount_%s(uint32_t handle) {\n", lname);
+    fprintf(out, "    forge_ctx_t *__ctx = forge_ctx_resolve(handle);\n");
+    fprintf(out, "    if (__ctx) { forge_ctx_unregister(__ctx->el_id); forge_ctx_free(__ctx); }\n");
     fprintf(out, "}\n\n");
 }
 
 /* ─── CSS Class Generation ────────────────────────────────────────────────── */
 
+/* Emit builder calls producing one dynamic style value: literal text
+ * between `{expr}` segments is appended as-is, each segment through
+ * forge_str_auto.  A value without braces is a single expression. */
+static void emit_style_value(const char *v, FILE *out) {
+    if (!strchr(v, '{')) {
+        fprintf(out, "    forge_str_auto(&__s, (%s));\n", v);
+        return;
+    }
+    while (*v) {
+        const char *lit = v;
+        while (*v && *v != '{') v++;
+        if (v > lit) {
+            fprintf(out, "    forge_str_append(&__s, \"");
+            for (const char *p = lit; p < v; p++) {
+                if (*p == '"' || *p == '\\') fputc('\\', out);
+                fputc(*p, out);
+            }
+            fprintf(out, "\", %d);\n", (int)(v - lit));
+        }
+        if (!*v) break;
+
+        /* Matching '}', skipping braces inside string literals */
+        const char *start = ++v;
+        int depth = 1;
+        char quote = 0;
+        for (; *v; v++) {
+            if (quote) {
+                if (*v == '\\' && v[1]) v++;
+                else if (*v == quote) quote = 0;
+            } else if (*v == '"' || *v == '\'') {
+                quote = *v;
+            } else if (*v == '{') {
+                depth++;
+            } else if (*v == '}' && --depth == 0) {
+                break;
+            }
+        }
+        fprintf(out, "    forge_str_auto(&__s, (%.*s));\n", (int)(v - start), start);
+        if (*v) v++;
+    }
+}
+
 static void emit_styles(const ComponentNode *c, FILE *out) {
     if (c->style_count == 0) return;
     char lname[256];
@@ -327,30 +682,38 @@ static void emit_styles(const ComponentNode *c, FILE *out) {
     fprintf(out, "    \"[data-forge-%s] {\\n\"\n", lname);
     for (int i = 0; i < c->style_count; i++) {
         if (!c->style[i].is_dynamic) {
-            fprintf(out, "    \"    %s: %s;\\n\"\n",
-                    c->style[i].property, c->style[i].value);
+            fprintf(out, "    \"    ");
+            emit_c_chars(c->style[i].property, out);
+            fprintf(out, ": ");
+            emit_c_chars(c->style[i].value, out);
+            fprintf(out, ";\\n\"\n");
         }
     }
     fprintf(out, "    \"}\\n\";\n\n");
 
-    /* Dynamic style updater */
-    int has_dynamic = 0;
-    for (int i = 0; i < c->style_count; i++) if (c->style[i].is_dynamic) { has_dynamic = 1; break; }
-
-    if (has_dynamic) {
-        fprintf(out, "static void __%s_update_styles(\n", lname);
-        fprintf(out, "        forge_dom_node_t *el,\n");
-        fprintf(out, "        const %s_Props *props,\n", c->name);
-        fprintf(out, "        const %s_State *state) {\n", c->name);
-        fprintf(out, "    (void)props; (void)state;\n");
-        for (int i = 0; i < c->style_count; i++) {
-            if (c->style[i].is_dynamic) {
-                fprintf(out, "    forge_dom_set_style(el, \"%s\", (forge_expr_fn)0, \"%s\");\n",
-                        c->style[i].property, c->style[i].value);
-            }
-        }
-        fprintf(out, "}\n\n");
+    if (!has_dynamic_style(c)) return;
+
+    /* Dynamic rules become the root's inline style, rebuilt in the frame
+     * arena whenever the binding is re-evaluated */
+    fprintf(out, "/* ── Dynamic Styles ─────────────────────── */\n");
+    fprintf(out, "static forge_val_t __%s_style(forge_ctx_t *__ctx) {\n", lname);
+    fprintf(out, "    %s_State  *state = (%s_State*)__ctx->state;\n", c->name, c->name);
+    fprintf(out, "    const %s_Props *props = (const %s_Props*)__ctx->props;\n", c->name, c->name);
+    fprintf(out, "    (void)state; (void)props;\n");
+    fprintf(out, "    forge_str_t __s = forge_str_frame(64);\n");
+    int first = 1;
+    for (int i = 0; i < c->style_count; i++) {
+        if (!c->style[i].is_dynamic) continue;
+        fprintf(out, "    forge_str_cstr(&__s, \"%s", first ? "" : " ");
+        emit_c_chars(c->style[i].property, out);
+        fprintf(out, ": \");\n");
+        emit_style_value(c->style[i].value, out);
+        fprintf(out, "    forge_str_char(&__s, ';');\n");
+        first = 0;
     }
+    fprintf(out, "    char *__r = forge_str_end(&__s);\n");
+    fprintf(out, "    return forge_val_strn((u32)(uintptr_t)__r, forge_str_len(__r));\n");
+    fprintf(out, "}\n\n");
 }
 
 /* ─── File Header ─────────────────────────────────────────────────────────── */
@@ -364,6 +727,7 @@ static void emit_file_header(const ComponentNode *c, FILE *out) {
         " */\n\n"
         "#include <forge/runtime.h>\n"
         "#include <forge/dom.h>\n"
+        "#include <stddef.h>\n"
         "#include <stdint.h>\n\n",
         c->name, c->name);
 }
@@ -371,17 +735,16 @@ static void emit_file_header(const ComponentNode *c, FILE *out) {
 /* ─── Public API ──────────────────────────────────────────────────────────── */
 
 int codegen_component(const ComponentNode *c, const CodegenOptions *opts, FILE *out) {
-    (void)opts;
-
     emit_file_header(c, out);
     emit_props_struct(c, out);
+    emit_props_schema(c, out);
     emit_state_struct(c, out);
     emit_state_init(c, out);
     emit_styles(c, out);
     emit_computed(c, out);
     emit_event_handlers(c, out);
     emit_render_fn(c, out);
-    emit_lifecycle(c, out);
+    emit_lifecycle(c, opts, out);
 
     return 0;
 }
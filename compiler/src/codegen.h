@@ -17,6 +17,7 @@ typedef struct {
     int minify;          /* strip whitespace from output  */
     int debug_info;      /* emit source-map comments      */
     int ssr_mode;        /* server-side rendering mode    */
+    int profile;         /* --profile: per-component counters */
 } CodegenOptions;
 
 /* ─── Public API ──────────────────────────────────────────────────────────── */
@@ -5,65 +5,88 @@
  * Handles mode-switching between C code blocks and HTML template blocks.
  */
 
+#define _POSIX_C_SOURCE 200809L /* mmap */
+
 #include "lexer.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 /* ─── Keyword Table ───────────────────────────────────────────────────────── */
 
-typedef struct { const char *word; TokenType type; } Keyword;
-
-static const Keyword KEYWORDS[] = {
-    /* Forge directives */
-    { "component", TOK_AT_COMPONENT },
-    { "props",     TOK_AT_PROPS     },
-    { "state",     TOK_AT_STATE     },
-    { "style",     TOK_AT_STYLE     },
-    { "template",  TOK_AT_TEMPLATE  },
-    { "on",        TOK_AT_ON        },
-    { "computed",  TOK_AT_COMPUTED  },
-    /* C types */
-    { "int",       TOK_INT       },
-    { "char",      TOK_CHAR      },
-    { "bool",      TOK_BOOL      },
-    { "float",     TOK_FLOAT     },
-    { "double",    TOK_DOUBLE    },
-    { "void",      TOK_VOID      },
-    { "long",      TOK_LONG      },
-    { "short",     TOK_SHORT     },
-    { "unsigned",  TOK_UNSIGNED  },
-    { "signed",    TOK_SIGNED    },
-    { "struct",    TOK_STRUCT    },
-    { "enum",      TOK_ENUM      },
-    { "const",     TOK_CONST     },
-    { "static",    TOK_STATIC    },
-    { "extern",    TOK_EXTERN    },
-    { "inline",    TOK_INLINE    },
-    { "typedef",   TOK_TYPEDEF   },
-    { "sizeof",    TOK_SIZEOF    },
-    /* Control flow */
-    { "if",        TOK_IF        },
-    { "else",      TOK_ELSE      },
-    { "for",       TOK_FOR       },
-    { "while",     TOK_WHILE     },
-    { "do",        TOK_DO        },
-    { "return",    TOK_RETURN    },
-    { "break",     TOK_BREAK     },
-    { "continue",  TOK_CONTINUE  },
-    { "switch",    TOK_SWITCH    },
-    { "case",      TOK_CASE      },
-    { "default",   TOK_DEFAULT   },
-    /* Literals */
-    { "true",      TOK_TRUE      },
-    { "false",     TOK_FALSE     },
-    { "NULL",      TOK_NULL      },
-    { "null",      TOK_NULL      },
-    { "include",   TOK_INCLUDE   },
-    { NULL, 0 }
+/*
+ * Perfect hash: first, middle and last character plus the length, times a
+ * multiplier picked so every keyword lands in its own slot of 64.  A lookup
+ * is one multiply and one memcmp, with no scan over the table.
+ *
+ * Adding a keyword means finding a new KW_MULT that keeps the slots
+ * distinct (test_keywords in compiler/tests covers every entry).
+ */
+
+typedef struct { const char *word; unsigned char len; TokenType type; } Keyword;
+
+#define KW_SLOTS   64
+#define KW_MULT    0xaa60a691u
+#define KW_MIN_LEN 2
+#define KW_MAX_LEN 9
+
+static const Keyword KEYWORDS[KW_SLOTS] = {
+    [ 0] = { "null",      4, TOK_NULL         },
+    [ 2] = { "for",       3, TOK_FOR          },
+    [ 3] = { "struct",    6, TOK_STRUCT       },
+    [ 5] = { "component", 9, TOK_AT_COMPONENT },
+    [ 6] = { "do",        2, TOK_DO           },
+    [ 7] = { "float",     5, TOK_FLOAT        },
+    [ 9] = { "enum",      4, TOK_ENUM         },
+    [10] = { "bool",      4, TOK_BOOL         },
+    [11] = { "while",     5, TOK_WHILE        },
+    [13] = { "default",   7, TOK_DEFAULT      },
+    [14] = { "return",    6, TOK_RETURN       },
+    [17] = { "computed",  8, TOK_AT_COMPUTED  },
+    [18] = { "long",      4, TOK_LONG         },
+    [19] = { "on",        2, TOK_AT_ON        },
+    [20] = { "style",     5, TOK_AT_STYLE     },
+    [22] = { "sizeof",    6, TOK_SIZEOF       },
+    [23] = { "unsigned",  8, TOK_UNSIGNED     },
+    [25] = { "props",     5, TOK_AT_PROPS     },
+    [27] = { "template",  8, TOK_AT_TEMPLATE  },
+    [28] = { "extern",    6, TOK_EXTERN       },
+    [29] = { "signed",    6, TOK_SIGNED       },
+    [30] = { "short",     5, TOK_SHORT        },
+    [32] = { "false",     5, TOK_FALSE        },
+    [33] = { "double",    6, TOK_DOUBLE       },
+    [34] = { "include",   7, TOK_INCLUDE      },
+    [36] = { "void",      4, TOK_VOID         },
+    [37] = { "typedef",   7, TOK_TYPEDEF      },
+    [39] = { "true",      4, TOK_TRUE         },
+    [43] = { "if",        2, TOK_IF           },
+    [44] = { "case",      4, TOK_CASE         },
+    [45] = { "state",     5, TOK_AT_STATE     },
+    [49] = { "const",     5, TOK_CONST        },
+    [52] = { "else",      4, TOK_ELSE         },
+    [53] = { "int",       3, TOK_INT          },
+    [54] = { "continue",  8, TOK_CONTINUE     },
+    [55] = { "switch",    6, TOK_SWITCH       },
+    [56] = { "char",      4, TOK_CHAR         },
+    [58] = { "inline",    6, TOK_INLINE       },
+    [60] = { "break",     5, TOK_BREAK        },
+    [62] = { "static",    6, TOK_STATIC       },
+    [63] = { "NULL",      4, TOK_NULL         },
 };
 
+static unsigned kw_slot(const char *s, size_t len) {
+    uint32_t key = (uint32_t)(unsigned char)s[0] << 24
+                 | (uint32_t)(unsigned char)s[len / 2] << 16
+                 | (uint32_t)(unsigned char)s[len - 1] << 8
+                 | (uint32_t)len;
+    return (key * KW_MULT) >> 26; /* top 6 bits */
+}
+
 /* ─── Helpers ─────────────────────────────────────────────────────────────── */
 
 static char peek_char(Lexer *lex) { return *lex->current; }
@@ -117,7 +140,7 @@ static Token make_token(Lexer *lex, TokenType type, const char *start) {
     tok.loc.filename = lex->filename;
     tok.loc.line   = lex->line;
     tok.loc.column = (int)(start - lex->line_start) + 1;
-    tok.value.str_val = NULL;
+    tok.value.int_val = 0;
     return tok;
 }
 
@@ -129,49 +152,47 @@ static Token error_token(Lexer *lex, const char *msg) {
     tok.loc.filename = lex->filename;
     tok.loc.line   = lex->line;
     tok.loc.column = (int)(lex->current - lex->line_start) + 1;
-    tok.value.str_val = NULL;
+    tok.value.int_val = 0;
     return tok;
 }
 
 static TokenType ident_type(const char *start, size_t len, int after_at) {
-    for (int i = 0; KEYWORDS[i].word; i++) {
-        size_t klen = strlen(KEYWORDS[i].word);
-        if (klen == len && memcmp(KEYWORDS[i].word, start, len) == 0) {
-            if (after_at) {
-                switch (KEYWORDS[i].type) {
-                case TOK_AT_COMPONENT: case TOK_AT_PROPS:  case TOK_AT_STATE:
-                case TOK_AT_STYLE:    case TOK_AT_TEMPLATE: case TOK_AT_ON:
-                case TOK_AT_COMPUTED: return KEYWORDS[i].type;
-                default: break;
-                }
-            } else {
-                /* Forge directive keywords (state, props, etc.) should only
-                 * be returned as TOK_AT_* when preceded by '@'.  Without '@',
-                 * treat them as regular identifiers so that expressions like
-                 * state.count or props.step work correctly in templates. */
-                switch (KEYWORDS[i].type) {
-                case TOK_AT_COMPONENT: case TOK_AT_PROPS:  case TOK_AT_STATE:
-                case TOK_AT_STYLE:    case TOK_AT_TEMPLATE: case TOK_AT_ON:
-                case TOK_AT_COMPUTED: return TOK_IDENT;
-                default: return KEYWORDS[i].type;
-                }
-            }
-        }
-    }
-    return TOK_IDENT;
+    if (len < KW_MIN_LEN || len > KW_MAX_LEN) return TOK_IDENT;
+    const Keyword *k = &KEYWORDS[kw_slot(start, len)];
+    if (!k->word || k->len != len || memcmp(k->word, start, len) != 0)
+        return TOK_IDENT;
+
+    /* Forge directive keywords (state, props, etc.) should only be returned
+     * as TOK_AT_* when preceded by '@'.  Without '@', treat them as regular
+     * identifiers so that expressions like state.count or props.step work
+     * correctly in templates. */
+    int directive = k->type <= TOK_AT_COMPUTED;
+    if (after_at) return directive ? k->type : TOK_IDENT;
+    return directive ? TOK_IDENT : k->type;
 }
 
 /* ─── String Literal ──────────────────────────────────────────────────────── */
 
+/* Zero-copy: the token spans the literal, quotes included, and escapes
+ * are decoded only by lexer_string_value when someone needs the text */
 static Token lex_string(Lexer *lex) {
     const char *start = lex->current - 1; /* includes opening " */
-    size_t cap = 64, len = 0;
-    char *buf = malloc(cap);
-
     while (peek_char(lex) && peek_char(lex) != '"') {
-        char c = advance(lex);
-        if (c == '\\') {
-            char esc = advance(lex);
+        if (advance(lex) == '\\' && peek_char(lex)) advance(lex);
+    }
+    if (!peek_char(lex)) return error_token(lex, "Unterminated string literal");
+    advance(lex); /* closing " */
+    return make_token(lex, TOK_STRING_LIT, start);
+}
+
+size_t lexer_string_value(const Token *tok, char *dst) {
+    const char *s   = tok->start + 1;
+    const char *end = tok->start + tok->length - 1;
+    size_t len = 0;
+    while (s < end) {
+        char c = *s++;
+        if (c == '\\' && s < end) {
+            char esc = *s++;
             switch (esc) {
             case 'n':  c = '\n'; break;
             case 't':  c = '\t'; break;
@@ -182,19 +203,10 @@ static Token lex_string(Lexer *lex) {
             default:   c = esc;  break;
             }
         }
-        if (len + 1 >= cap) { cap *= 2; buf = realloc(buf, cap); }
-        buf[len++] = c;
+        dst[len++] = c;
     }
-    if (!peek_char(lex)) {
-        free(buf);
-        return error_token(lex, "Unterminated string literal");
-    }
-    advance(lex); /* closing " */
-    buf[len] = '\0';
-
-    Token tok = make_token(lex, TOK_STRING_LIT, start);
-    tok.value.str_val = buf;
-    return tok;
+    dst[len] = '\0';
+    return len;
 }
 
 /* ─── Number Literal ──────────────────────────────────────────────────────── */
@@ -523,6 +535,60 @@ Token lexer_peek_token(Lexer *lex) {
 
 void lexer_set_mode(Lexer *lex, LexMode mode) { lex->mode = mode; }
 
+/* ─── Source Buffers ──────────────────────────────────────────────────────── */
+
+/*
+ * The kernel zero-fills a mapping past the end of the file up to the page
+ * boundary, which gives the lexer its terminator for free.  A file that
+ * ends exactly on a page has no such byte, so it (and an empty file, which
+ * cannot be mapped) is read into a heap buffer instead.
+ */
+int source_load(SourceBuf *sb, const char *path) {
+    sb->text   = NULL;
+    sb->len    = 0;
+    sb->mapped = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) { close(fd); return -1; }
+    size_t size = (size_t)st.st_size;
+    long   page = sysconf(_SC_PAGESIZE);
+
+    if (size > 0 && page > 0 && size % (size_t)page != 0) {
+        void *m = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m != MAP_FAILED) {
+            close(fd);
+            sb->text   = m;
+            sb->len    = size;
+            sb->mapped = 1;
+            return 0;
+        }
+    }
+
+    char  *buf = malloc(size + 1);
+    size_t got = 0;
+    while (buf && got < size) {
+        ssize_t n = read(fd, buf + got, size - got);
+        if (n <= 0) break;
+        got += (size_t)n;
+    }
+    close(fd);
+    if (!buf || got != size) { free(buf); return -1; }
+    buf[size]  = '\0';
+    sb->text   = buf;
+    sb->len    = size;
+    return 0;
+}
+
+void source_release(SourceBuf *sb) {
+    if (!sb->text) return;
+    if (sb->mapped) munmap((void *)sb->text, sb->len);
+    else            free((char *)sb->text);
+    sb->text = NULL;
+    sb->len  = 0;
+}
+
 /* ─── Utility ─────────────────────────────────────────────────────────────── */
 
 const char *token_type_name(TokenType t) {
@@ -143,8 +143,7 @@ typedef struct {
     union {
         int64_t  int_val;
         double   float_val;
-        char    *str_val;   /* heap-allocated, null-terminated */
-    } value;
+    } value;             /* string literals: see lexer_string_value */
 } Token;
 
 /* ─── Lexer State ─────────────────────────────────────────────────────────── */
@@ -169,6 +168,23 @@ Token lexer_next(Lexer *lex);
 Token lexer_peek_token(Lexer *lex);
 void  lexer_set_mode(Lexer *lex, LexMode mode);
 
+/* Decode a TOK_STRING_LIT's escapes into dst, which needs tok->length - 1
+ * bytes.  Returns the decoded length; dst is null-terminated. */
+size_t lexer_string_value(const Token *tok, char *dst);
+
+/* ─── Source Buffers ──────────────────────────────────────────────────────── */
+
+/* A whole .cx file, memory-mapped when possible.  Always null-terminated.
+ * Nothing in the AST points into it, so it can go as soon as parsing ends. */
+typedef struct {
+    const char *text;
+    size_t      len;
+    int         mapped; /* 1: munmap on release, 0: free */
+} SourceBuf;
+
+int  source_load(SourceBuf *sb, const char *path); /* 0 on success */
+void source_release(SourceBuf *sb);
+
 /* Utility */
 const char *token_type_name(TokenType t);
 void        token_print(const Token *tok);
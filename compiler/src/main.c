@@ -8,26 +8,39 @@
  *   -o <dir>        Output directory (default: ./dist)
  *   -O<0-3>         Optimization level (default: -O2)
  *   -g              Emit debug info
+ *   -j <N>          Parallel jobs for parsing and clang (default: 1)
+ *   --cache         Reuse outputs of unchanged files from ./.forge-cache
+ *   --cache-dir <d> Same, with the cache in <d>
  *   --ast           Dump AST and exit (no code gen)
  *   --no-wasm       Only generate .gen.c, skip Clang step
+ *   --no-simd       Build WASM without simd128 (bulk memory only)
  *   --no-types      Skip TypeScript .d.ts generation
  *   --iife          Emit IIFE JS instead of ES modules
  *   --no-web-comp   Skip custom element registration
+ *   --profile       Per-component render/update counters and trace events
+ *   --time-phases   Print how long each compiler phase took
  *   -v, --version   Print version and exit
  *   -h, --help      Print this help
  */
 
+#define _POSIX_C_SOURCE 200809L /* sysconf, clock_gettime */
+
 #include "analyzer.h"
 #include "binding_gen.h"
+#include "build_cache.h"
 #include "codegen.h"
 #include "lexer.h"
 #include "parser.h"
 #include "wasm_emit.h"
 
+#include <ctype.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
 
 #define FORGE_VERSION "0.1.0"
 
@@ -42,38 +55,32 @@ static void print_usage(void) {
          "  -o <dir>       Output directory        (default: ./dist)\n"
          "  -O<0-3>        Optimization level       (default: -O2)\n"
          "  -g             Emit DWARF debug info\n"
+         "  -j <N>         Parse/analyze files and run clang on N threads\n"
+         "                 (default: 1, 0 = one per CPU core)\n"
+         "  --cache        Reuse outputs of unchanged files (./.forge-cache)\n"
+         "  --cache-dir <dir>  Build cache directory (implies --cache)\n"
          "  --ast          Dump AST, no code gen\n"
          "  --no-wasm      Generate .gen.c only, skip Clang\n"
+         "  --no-simd      WASM without simd128 (for engines lacking it)\n"
+         "  --bundle       Link all components into one " FORGE_BUNDLE_WASM "\n"
+         "  --no-wasm-opt  Skip the wasm-opt pass over linked modules\n"
+         "  --asset-base <url>  URL prefix of the output files in preload hints\n"
+         "                 (default: /<name of the -o dir>/)\n"
          "  --prerender    Generate static HTML for SEO (SSG)\n"
          "  --ssr          Generate SSR server (App.forge.ssr.js + forge-ssr-server.js)\n"
+         "  --ssr-cache    Memoize SSR child component renders (LRU on props)\n"
+         "  --ssr-workers N  Run the SSR server as N clustered worker processes\n"
          "  --no-types     Skip TypeScript .d.ts output\n"
          "  --iife         JS as IIFE (not ES module)\n"
          "  --no-web-comp  Skip customElements.define\n"
+         "  --profile      Count renders, updates and DOM ops per component;\n"
+         "                 read them with ForgeRuntime.stats() (WASM) or\n"
+         "                 globalThis.__forgeProf (--no-wasm)\n"
+         "  --time-phases  Print per-phase compile times to stderr\n"
          "  -v, --version  Print version\n"
          "  -h, --help     Print this help\n\n");
 }
 
-/* Load file into a heap buffer, return NULL on failure */
-static char *read_file(const char *path) {
-  FILE *f = fopen(path, "rb");
-  if (!f) {
-    fprintf(stderr, "forge: cannot open '%s'\n", path);
-    return NULL;
-  }
-  fseek(f, 0, SEEK_END);
-  long sz = ftell(f);
-  rewind(f);
-  char *buf = malloc((size_t)sz + 1);
-  if (!buf) {
-    fclose(f);
-    return NULL;
-  }
-  fread(buf, 1, (size_t)sz, f);
-  buf[sz] = '\0';
-  fclose(f);
-  return buf;
-}
-
 static void mkdir_p(const char *path) {
   char tmp[512];
   strncpy(tmp, path, sizeof(tmp) - 1);
@@ -96,54 +103,242 @@ typedef struct {
   int no_wasm;
   int prerender;
   int ssr;       /* emit Node.js SSR renderer (*.forge.ssr.js) */
+  int ssr_cache; /* memoize child renders in the SSR renderer */
+  int ssr_workers; /* default SSR_WORKERS of forge-ssr-server.js */
   int no_types;
   int esm;
   int web_component;
   int optimize;
   int debug;
+  int no_simd;   /* --no-simd: leave simd128 off in the wasm32 target */
+  int bundle;    /* --bundle: one module + runtime for every component */
+  int no_wasm_opt; /* --no-wasm-opt: ship modules as clang links them */
+  int profile;   /* --profile: instrumented codegen and bindings */
+  int time_phases; /* --time-phases: report phase timings */
+  char asset_base[512]; /* where pages load the outputs from */
   int verbose;
+  int jobs;      /* -j N: worker threads for parse/analyze and clang */
+  const char *cache_dir; /* --cache: build cache directory, NULL = off */
+  char cache_flags[256]; /* options folded into every cache key */
 } CompileConfig;
 
+/* ─── Phase Timings ─────────────────────────────────────────────────────────
+ * Always recorded; printed with --time-phases.  The parser drives the
+ * lexer's template modes, so the two are one phase. */
+
+enum {
+  PH_READ,
+  PH_PARSE,
+  PH_ANALYZE,
+  PH_CODEGEN,
+  PH_BINDINGS,
+  PH_CLANG,
+  PH_LINK,
+  PH_SSG,
+  PH_SSR,
+  PH_COUNT
+};
+
+static const char *PHASE_NAMES[PH_COUNT] = {
+    "read", "lex+parse", "analyze", "codegen", "bindings",
+    "clang", "link", "ssg", "ssr",
+};
+
+static double _phase_ms[PH_COUNT];
+
+static double now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+/* Per-file and per-clang-job phases run on worker threads, so they add up
+ * thread time: with -j N the sum can exceed the wall-clock total */
+static void print_phase_times(double total_ms, int jobs) {
+  fprintf(stderr, "forge: phase times (ms)%s\n",
+          jobs > 1 ? ", read to analyze and clang summed over threads" : "");
+  for (int p = 0; p < PH_COUNT; p++)
+    fprintf(stderr, "  %-10s %10.2f\n", PHASE_NAMES[p], _phase_ms[p]);
+  fprintf(stderr, "  %-10s %10.2f\n", "total", total_ms);
+}
+
 /* Global registry for cross-component SSG inlining */
 static const ComponentNode *registry[1024];
 static int registry_count = 0;
 
-static int compile_file(const char *path, const CompileConfig *cfg) {
-  printf("forge: compiling %s\n", path);
+/* ─── Compile Pipeline ──────────────────────────────────────────────────────
+ * Three phases, each joined before the next starts:
+ *   1. front end (read → lex → parse → analyze), one job per input file
+ *   2. codegen + JS bindings, in command-line order on this thread — the
+ *      emitters keep file-level state, and registry[] must list components
+ *      in input order for SSG/SSR (the root is the last one)
+ *   3. clang, one job per component; with --bundle each job emits an
+ *      object and one link puts them all into FORGE_BUNDLE_WASM
+ * Phases 1 and 3 run on `-j N` worker threads.
+ *
+ * With --cache, phase 1 hashes the source first; on a hit the file skips
+ * straight to copying its outputs, and its Program (needed by SSG/SSR) is
+ * read back from the entry's summary instead of parsed.  Misses are stored
+ * once phase 3 has produced every output.
+ */
+
+typedef struct {
+  const char *path;
+  const CompileConfig *cfg;
+  SourceBuf src;             /* released once the file is parsed */
+  Program *prog;
+  int rc;
+  char key[FORGE_CACHE_KEY_LEN + 1];
+  int cached;                /* outputs come from the build cache */
+  int clang_first, clang_n;  /* this file's slice of the clang jobs */
+  double phase_ms[PH_ANALYZE + 1]; /* read, lex+parse, analyze */
+} SourceJob;
+
+typedef struct {
+  char c_path[512];
+  WasmResult result;
+  int ok;
+  double ms;
+} ClangJob;
+
+/* Work queue: each thread takes the next unclaimed index until none remain */
+typedef struct {
+  pthread_mutex_t lock;
+  int next;
+  int count;
+  void (*fn)(void *arg, int index);
+  void *arg;
+} WorkQueue;
+
+static void *work_thread(void *p) {
+  WorkQueue *q = p;
+  for (;;) {
+    pthread_mutex_lock(&q->lock);
+    int i = q->next < q->count ? q->next++ : -1;
+    pthread_mutex_unlock(&q->lock);
+    if (i < 0)
+      return NULL;
+    q->fn(q->arg, i);
+  }
+}
+
+/* Run fn(arg, 0..count-1) on up to `jobs` threads and wait for all of them */
+static void run_parallel(int count, int jobs, void (*fn)(void *, int),
+                         void *arg) {
+  if (jobs > count)
+    jobs = count;
+  if (jobs <= 1) {
+    for (int i = 0; i < count; i++)
+      fn(arg, i);
+    return;
+  }
+  WorkQueue q = {.next = 0, .count = count, .fn = fn, .arg = arg};
+  pthread_mutex_init(&q.lock, NULL);
+  pthread_t *threads = malloc(sizeof(pthread_t) * (size_t)jobs);
+  int started = 0;
+  while (threads && started < jobs &&
+         pthread_create(&threads[started], NULL, work_thread, &q) == 0)
+    started++;
+  if (started == 0)
+    work_thread(&q); /* no threads available: run inline */
+  for (int i = 0; i < started; i++)
+    pthread_join(threads[i], NULL);
+  free(threads);
+  pthread_mutex_destroy(&q.lock);
+}
+
+/* Phase 1: parse and analyze one file.  Touches nothing shared. */
+static int front_end(SourceJob *job) {
+  const CompileConfig *cfg = job->cfg;
 
   /* ── Read source ── */
-  char *src = read_file(path);
-  if (!src)
+  double t0 = now_ms();
+  if (source_load(&job->src, job->path) != 0) {
+    fprintf(stderr, "forge: cannot open '%s'\n", job->path);
     return 1;
+  }
+  job->phase_ms[PH_READ] = now_ms() - t0;
+
+  /* ── Cache lookup ── */
+  if (cfg->cache_dir) {
+    build_cache_key(job->src.text, job->src.len, cfg->cache_flags, job->key);
+    if (build_cache_lookup(cfg->cache_dir, job->key)) {
+      /* Only SSG/SSR and the bundle link look at other files' components */
+      if (!cfg->prerender && !cfg->ssr && !cfg->bundle) {
+        job->cached = 1;
+      } else if ((job->prog = build_cache_load_program(cfg->cache_dir, job->key,
+                                                       job->path)) != NULL) {
+        job->cached = 1;
+      }
+      if (job->cached) {
+        printf("forge: up to date %s\n", job->path);
+        return 0;
+      }
+    }
+  }
+
+  printf("forge: compiling %s\n", job->path);
 
   /* ── Lex ── */
+  t0 = now_ms();
   Lexer lex;
-  lexer_init(&lex, src, path);
+  lexer_init(&lex, job->src.text, job->path);
 
   /* ── Parse ── */
   Parser parser;
   parser_init(&parser, &lex);
   Program *prog = parser_parse(&parser);
+  job->phase_ms[PH_PARSE] = now_ms() - t0;
 
   if (parser_error_count(&parser) > 0) {
     fprintf(stderr, "forge: %d parse error(s) in %s\n",
-            parser_error_count(&parser), path);
+            parser_error_count(&parser), job->path);
     ast_free_program(prog);
-    free(src);
     return 1;
   }
 
   /* ── Analyze ── */
+  t0 = now_ms();
   AnalysisResult ar = analyze_program(prog);
+  job->phase_ms[PH_ANALYZE] = now_ms() - t0;
   if (ar.error_count > 0) {
     fprintf(stderr, "forge: %d analysis error(s) in %s\n", ar.error_count,
-            path);
+            job->path);
     ast_free_program(prog);
-    free(src);
     return 1;
   }
   if (ar.warning_count > 0) {
-    fprintf(stderr, "forge: %d warning(s) in %s\n", ar.warning_count, path);
+    fprintf(stderr, "forge: %d warning(s) in %s\n", ar.warning_count,
+            job->path);
+  }
+
+  job->prog = prog;
+  return 0;
+}
+
+static void front_end_job(void *arg, int i) {
+  SourceJob *job = &((SourceJob *)arg)[i];
+  job->rc = front_end(job);
+  source_release(&job->src); /* the AST holds its own copies */
+}
+
+/* Phase 2: emit .gen.c, .forge.js and .d.ts for one file and queue its
+ * components for clang. */
+static int back_end(SourceJob *job, const CompileConfig *cfg,
+                    ClangJob **clang_jobs, int *clang_count, int *clang_cap) {
+  Program *prog = job->prog;
+
+  /* ── Cache hit: copy outputs, register the stored components ── */
+  if (job->cached) {
+    mkdir_p(cfg->out_dir);
+    if (build_cache_restore(cfg->cache_dir, job->key, cfg->out_dir) != 0) {
+      fprintf(stderr, "forge: cannot restore cached outputs of %s\n", job->path);
+      return 1;
+    }
+    for (int i = 0; prog && i < prog->component_count; i++)
+      if (registry_count < 1024)
+        registry[registry_count++] = prog->components[i];
+    return 0;
   }
 
   /* ── AST Dump ── */
@@ -155,49 +350,30 @@ static int compile_file(const char *path, const CompileConfig *cfg) {
   mkdir_p(cfg->out_dir);
 
   /* ── Code Generation ── */
-  CodegenOptions cg_opts = {.debug_info = cfg->debug};
-  int rc = codegen_program(prog, &cg_opts, cfg->out_dir);
-  if (rc != 0) {
+  CodegenOptions cg_opts = {.debug_info = cfg->debug, .profile = cfg->profile};
+  double t0 = now_ms();
+  int cg_rc = codegen_program(prog, &cg_opts, cfg->out_dir);
+  _phase_ms[PH_CODEGEN] += now_ms() - t0;
+  if (cg_rc != 0) {
     ast_free_program(prog);
-    free(src);
+    job->prog = NULL;
     return 1;
   }
 
-  /* ── WASM Compilation ── */
+  /* ── WASM jobs (run in phase 3) ── */
+  job->clang_first = *clang_count;
+  job->clang_n = cfg->no_wasm ? 0 : prog->component_count;
   if (!cfg->no_wasm) {
-    WasmOptions w_opts = {
-        .clang_path = "clang",
-        .include_dir = "./runtime/include",
-        .runtime_lib_dir = "./runtime/build",
-        .optimize = cfg->optimize,
-        .debug = cfg->debug,
-        .strip = !cfg->debug,
-    };
-
-    if (!wasm_check_toolchain(&w_opts)) {
-      fprintf(stderr,
-              "\033[33mforge: WARNING\033[0m clang wasm32 target not found.\n"
-              "  Install with: brew install llvm  (macOS)\n"
-              "               apt install clang  (Ubuntu)\n"
-              "  Skipping WASM compilation — .gen.c files written to %s/\n",
-              cfg->out_dir);
-    } else {
-      for (int i = 0; i < prog->component_count; i++) {
-        char c_path[512];
-        snprintf(c_path, sizeof(c_path), "%s/%s.gen.c", cfg->out_dir,
-                 prog->components[i]->name);
-
-        WasmResult wr = wasm_compile(c_path, &w_opts);
-        if (wr.success) {
-          printf("forge: \033[32m✓\033[0m %s  (%zu bytes)\n", wr.wasm_path,
-                 wr.wasm_size);
-        } else {
-          fprintf(stderr, "forge: \033[31mclang error\033[0m\n%s\n",
-                  wr.error_msg ? wr.error_msg : "(no output)");
-          rc = 1;
-        }
-        wasm_result_free(&wr);
+    for (int i = 0; i < prog->component_count; i++) {
+      if (*clang_count >= *clang_cap) {
+        *clang_cap = *clang_cap ? *clang_cap * 2 : 16;
+        *clang_jobs =
+            realloc(*clang_jobs, sizeof(ClangJob) * (size_t)*clang_cap);
       }
+      ClangJob *cj = &(*clang_jobs)[(*clang_count)++];
+      memset(cj, 0, sizeof(*cj));
+      snprintf(cj->c_path, sizeof(cj->c_path), "%s/%s.gen.c", cfg->out_dir,
+               prog->components[i]->name);
     }
   }
 
@@ -208,8 +384,12 @@ static int compile_file(const char *path, const CompileConfig *cfg) {
       .typescript = !cfg->no_types,
       .no_wasm = cfg->no_wasm,
       .prerender = cfg->prerender,
+      .profile = cfg->profile,
+      .bundle = cfg->bundle ? FORGE_BUNDLE_WASM : NULL,
+      .asset_base = cfg->asset_base,
   };
 
+  t0 = now_ms();
   for (int i = 0; i < prog->component_count; i++) {
     const ComponentNode *c = prog->components[i];
 
@@ -240,7 +420,158 @@ static int compile_file(const char *path, const CompileConfig *cfg) {
       }
     }
   }
+  _phase_ms[PH_BINDINGS] += now_ms() - t0;
+
+  return 0;
+}
 
+/* Phase 3: one clang invocation.  wasm_compile() captures its own output. */
+static const WasmOptions *_clang_opts;
+
+static void clang_job(void *arg, int i) {
+  ClangJob *cj = &((ClangJob *)arg)[i];
+  double t0 = now_ms();
+  cj->result = wasm_compile(cj->c_path, _clang_opts);
+  cj->ms = now_ms() - t0;
+}
+
+static int report_wasm(const char *from, WasmResult *wr) {
+  int ok = wr->success;
+  if (ok) {
+    printf("forge: \033[32m✓\033[0m %s  (%zu bytes)\n", wr->wasm_path,
+           wr->wasm_size);
+    if (wr->error_msg) /* wasm-opt failed; the module is unoptimized */
+      fprintf(stderr, "forge: \033[33mwasm-opt warning\033[0m %s\n%s\n",
+              wr->wasm_path, wr->error_msg);
+  } else {
+    fprintf(stderr, "forge: \033[31mclang error\033[0m in %s\n%s\n", from,
+            wr->error_msg ? wr->error_msg : "(no output)");
+  }
+  wasm_result_free(wr);
+  return ok;
+}
+
+/* --bundle: link every component of the build, cached ones included, into
+ * one module.  Phase 3 has left (or the cache restored) an object each. */
+static int link_bundle(const CompileConfig *cfg, const WasmOptions *w_opts) {
+  char (*paths)[512] = malloc(sizeof(*paths) * (size_t)registry_count);
+  const char **objs = malloc(sizeof(char *) * (size_t)registry_count);
+  if (!paths || !objs) {
+    free(paths);
+    free(objs);
+    return 1;
+  }
+  for (int i = 0; i < registry_count; i++) {
+    snprintf(paths[i], sizeof(paths[i]), "%s/%s.o", cfg->out_dir,
+             registry[i]->name);
+    objs[i] = paths[i];
+  }
+  char out[512];
+  snprintf(out, sizeof(out), "%s/" FORGE_BUNDLE_WASM, cfg->out_dir);
+  WasmResult wr = wasm_link(objs, registry_count, out, w_opts);
+  int ok = report_wasm(out, &wr);
+  free(objs);
+  free(paths);
+  return ok ? 0 : 1;
+}
+
+static int compile_files(const char **paths, int count,
+                         const CompileConfig *cfg) {
+  int rc = 0;
+  SourceJob *jobs = calloc((size_t)count, sizeof(SourceJob));
+  for (int i = 0; i < count; i++) {
+    jobs[i].path = paths[i];
+    jobs[i].cfg = cfg;
+  }
+
+  /* 1. Front end */
+  run_parallel(count, cfg->jobs, front_end_job, jobs);
+  for (int i = 0; i < count; i++)
+    for (int p = PH_READ; p <= PH_ANALYZE; p++)
+      _phase_ms[p] += jobs[i].phase_ms[p];
+
+  /* 2. Codegen + bindings — join point: registry[] is complete after this */
+  ClangJob *clang_jobs = NULL;
+  int clang_count = 0, clang_cap = 0;
+  for (int i = 0; i < count; i++) {
+    rc |= jobs[i].rc;
+    if (jobs[i].rc == 0)
+      rc |= back_end(&jobs[i], cfg, &clang_jobs, &clang_count, &clang_cap);
+  }
+
+  /* 3. WASM compilation */
+  int wasm_built = 0;
+  int linking = cfg->bundle && !cfg->no_wasm && !cfg->dump_ast && rc == 0 &&
+                registry_count > 0;
+  if (clang_count > 0 || linking) {
+    WasmOptions w_opts = {
+        .clang_path = "clang",
+        .include_dir = "./runtime/include",
+        .runtime_lib_dir = "./runtime/build",
+        .optimize = cfg->optimize,
+        .debug = cfg->debug,
+        .strip = !cfg->debug,
+        .simd = !cfg->no_simd,
+        .compile_only = cfg->bundle,
+    };
+
+    if (!wasm_check_toolchain(&w_opts)) {
+      fprintf(stderr,
+              "\033[33mforge: WARNING\033[0m clang wasm32 target not found.\n"
+              "  Install with: brew install llvm  (macOS)\n"
+              "               apt install clang  (Ubuntu)\n"
+              "  Skipping WASM compilation — .gen.c files written to %s/\n",
+              cfg->out_dir);
+    } else {
+      if (!cfg->no_wasm_opt) {
+        w_opts.wasm_opt = wasm_check_wasm_opt();
+        if (!w_opts.wasm_opt)
+          fprintf(stderr, "forge: wasm-opt not found — modules are not "
+                          "post-optimized (install binaryen)\n");
+      }
+      _clang_opts = &w_opts;
+      run_parallel(clang_count, cfg->jobs, clang_job, clang_jobs);
+      wasm_built = 1;
+
+      /* Report in input order once every job has finished */
+      for (int i = 0; i < clang_count; i++) {
+        _phase_ms[PH_CLANG] += clang_jobs[i].ms;
+        clang_jobs[i].ok =
+            report_wasm(clang_jobs[i].c_path, &clang_jobs[i].result);
+        if (!clang_jobs[i].ok)
+          rc = 1;
+      }
+      if (linking && rc == 0) {
+        double t0 = now_ms();
+        rc = link_bundle(cfg, &w_opts);
+        _phase_ms[PH_LINK] = now_ms() - t0;
+      }
+    }
+  }
+
+  /* 4. Store fresh outputs — only complete builds are cached */
+  for (int i = 0; cfg->cache_dir && !cfg->dump_ast && i < count; i++) {
+    SourceJob *job = &jobs[i];
+    if (job->rc != 0 || job->cached || !job->prog)
+      continue;
+    int ok = cfg->no_wasm || wasm_built;
+    for (int k = 0; ok && k < job->clang_n; k++)
+      ok = clang_jobs[job->clang_first + k].ok;
+    const char *wasm_ext = cfg->no_wasm ? NULL : cfg->bundle ? ".o" : ".wasm";
+    if (ok && build_cache_store(cfg->cache_dir, job->key, job->prog,
+                                cfg->out_dir, !cfg->no_types, wasm_ext) != 0)
+      fprintf(stderr, "forge: could not write cache entry for %s\n", job->path);
+  }
+
+  /* Objects were only needed for the link (and the cache, just above) */
+  for (int i = 0; linking && i < registry_count; i++) {
+    char obj[512];
+    snprintf(obj, sizeof(obj), "%s/%s.o", cfg->out_dir, registry[i]->name);
+    remove(obj);
+  }
+
+  free(clang_jobs);
+  free(jobs);
   return rc;
 }
 
@@ -275,12 +606,16 @@ int main(int argc, char **argv) {
       .no_wasm = 0,
       .prerender = 0,
       .ssr = 0,
+      .ssr_cache = 0,
+      .ssr_workers = 0,
       .no_types = 0,
       .esm = 1,
       .web_component = 1,
       .optimize = 2,
       .debug = 0,
+      .no_simd = 0,
       .verbose = 0,
+      .jobs = 1,
   };
 
   const char **input_files = malloc(sizeof(char *) * (size_t)argc);
@@ -289,6 +624,14 @@ int main(int argc, char **argv) {
   for (int i = 2; i < argc; i++) {
     if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
       cfg.out_dir = argv[++i];
+    } else if (strcmp(argv[i], "--cache") == 0) {
+      cfg.cache_dir = ".forge-cache";
+    } else if (strcmp(argv[i], "--cache-dir") == 0 && i + 1 < argc) {
+      cfg.cache_dir = argv[++i];
+    } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+      cfg.jobs = atoi(argv[++i]);
+    } else if (strncmp(argv[i], "-j", 2) == 0 && isdigit((unsigned char)argv[i][2])) {
+      cfg.jobs = atoi(argv[i] + 2);
     } else if (strncmp(argv[i], "-O", 2) == 0) {
       cfg.optimize = atoi(argv[i] + 2);
     } else if (strcmp(argv[i], "-g") == 0) {
@@ -297,16 +640,37 @@ int main(int argc, char **argv) {
       cfg.dump_ast = 1;
     } else if (strcmp(argv[i], "--no-wasm") == 0) {
       cfg.no_wasm = 1;
+    } else if (strcmp(argv[i], "--no-simd") == 0) {
+      cfg.no_simd = 1;
+    } else if (strcmp(argv[i], "--bundle") == 0) {
+      cfg.bundle = 1;
+    } else if (strcmp(argv[i], "--no-wasm-opt") == 0) {
+      cfg.no_wasm_opt = 1;
+    } else if (strcmp(argv[i], "--asset-base") == 0 && i + 1 < argc) {
+      const char *base = argv[++i];
+      size_t n = strlen(base);
+      snprintf(cfg.asset_base, sizeof(cfg.asset_base), "%s%s", base,
+               n && base[n - 1] == '/' ? "" : "/");
     } else if (strcmp(argv[i], "--prerender") == 0) {
       cfg.prerender = 1;
     } else if (strcmp(argv[i], "--ssr") == 0) {
       cfg.ssr = 1;
+    } else if (strcmp(argv[i], "--ssr-cache") == 0) {
+      cfg.ssr = 1;
+      cfg.ssr_cache = 1;
+    } else if (strcmp(argv[i], "--ssr-workers") == 0 && i + 1 < argc) {
+      cfg.ssr = 1;
+      cfg.ssr_workers = atoi(argv[++i]);
     } else if (strcmp(argv[i], "--no-types") == 0) {
       cfg.no_types = 1;
     } else if (strcmp(argv[i], "--iife") == 0) {
       cfg.esm = 0;
     } else if (strcmp(argv[i], "--no-web-comp") == 0) {
       cfg.web_component = 0;
+    } else if (strcmp(argv[i], "--profile") == 0) {
+      cfg.profile = 1;
+    } else if (strcmp(argv[i], "--time-phases") == 0) {
+      cfg.time_phases = 1;
     } else if (strcmp(argv[i], "-v") == 0 ||
                strcmp(argv[i], "--verbose") == 0) {
       cfg.verbose = 1;
@@ -319,19 +683,56 @@ int main(int argc, char **argv) {
     }
   }
 
+  /* Pages are assumed to load the outputs from /<out dir name>/ */
+  if (!cfg.asset_base[0]) {
+    size_t n = strlen(cfg.out_dir);
+    while (n > 1 && cfg.out_dir[n - 1] == '/')
+      n--;
+    size_t b = n;
+    while (b > 0 && cfg.out_dir[b - 1] != '/')
+      b--;
+    int dot = n - b == 1 && cfg.out_dir[b] == '.';
+    snprintf(cfg.asset_base, sizeof(cfg.asset_base), "/%.*s%s",
+             dot ? 0 : (int)(n - b), cfg.out_dir + b, dot || n == b ? "" : "/");
+  }
+
+  /* --ast never generates anything worth caching */
+  if (cfg.dump_ast)
+    cfg.cache_dir = NULL;
+  char self[64];
+  build_cache_self_stamp(argv[0], self, sizeof(self));
+  snprintf(cfg.cache_flags, sizeof(cfg.cache_flags),
+           "forge " FORGE_VERSION " bin=%s esm=%d wc=%d types=%d wasm=%d pre=%d O%d g%d "
+           "simd=%d bundle=%d opt=%d prof=%d",
+           self, cfg.esm, cfg.web_component, !cfg.no_types, !cfg.no_wasm,
+           cfg.prerender, cfg.optimize, cfg.debug, !cfg.no_simd, cfg.bundle,
+           !cfg.no_wasm_opt, cfg.profile);
+
+  if (cfg.jobs <= 0) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN); /* -j 0: one per core */
+    cfg.jobs = n > 0 ? (int)n : 1;
+  }
+
   if (file_count == 0) {
     fprintf(stderr, "forge: no input files\n");
     free(input_files);
     return 1;
   }
 
-  /* Compile each file */
-  int rc = 0;
-  for (int i = 0; i < file_count; i++) {
-    rc |= compile_file(input_files[i], &cfg);
-  }
+  /* Compile all files (front end and clang on cfg.jobs threads) */
+  double build_t0 = now_ms();
+  int rc = compile_files(input_files, file_count, &cfg);
+
+  /* Where the client modules are, for preload hints in SSG and SSR pages */
+  BindingOptions hint_opts = {
+      .es_modules = cfg.esm,
+      .no_wasm = cfg.no_wasm,
+      .bundle = cfg.bundle ? FORGE_BUNDLE_WASM : NULL,
+      .asset_base = cfg.asset_base,
+  };
 
   /* SSG Pass: Generate pre-rendered HTML for each component */
+  double t0 = now_ms();
   if (cfg.prerender && rc == 0) {
     for (int i = 0; i < registry_count; i++) {
       char html_path[512];
@@ -339,6 +740,8 @@ int main(int argc, char **argv) {
                registry[i]->name);
       FILE *hf = fopen(html_path, "w");
       if (hf) {
+        if (!cfg.no_wasm)
+          binding_gen_preload(registry[i], registry, registry_count, &hint_opts, hf);
         binding_gen_prerender(registry[i], registry, registry_count, hf);
         fclose(hf);
         printf("forge: \033[32m✓\033[0m %s (SSG)\n", html_path);
@@ -346,17 +749,23 @@ int main(int argc, char **argv) {
     }
   }
 
+  _phase_ms[PH_SSG] = now_ms() - t0;
+
   /* SSR Pass: Generate Node.js render(state, props) => HTML for root component */
+  t0 = now_ms();
   if (cfg.ssr && rc == 0 && registry_count > 0) {
     /* Generate SSR renderer for the last compiled component (typically the root App) */
     const ComponentNode *root = registry[registry_count - 1];
+    BindingOptions ssr_opts = hint_opts;
+    ssr_opts.ssr_cache = cfg.ssr_cache;
+    ssr_opts.ssr_workers = cfg.ssr_workers;
 
     /* 1. Component render function: App.forge.ssr.js */
     char ssr_path[512];
     snprintf(ssr_path, sizeof(ssr_path), "%s/%s.forge.ssr.js", cfg.out_dir, root->name);
     FILE *sf = fopen(ssr_path, "w");
     if (sf) {
-      binding_gen_ssr_js(root, registry, registry_count, sf);
+      binding_gen_ssr_js(root, registry, registry_count, &ssr_opts, sf);
       fclose(sf);
       printf("forge: \033[32m✓\033[0m %s (SSR renderer)\n", ssr_path);
     }
@@ -366,13 +775,17 @@ int main(int argc, char **argv) {
     snprintf(srv_path, sizeof(srv_path), "%s/forge-ssr-server.js", cfg.out_dir);
     FILE *svf = fopen(srv_path, "w");
     if (svf) {
-      binding_gen_ssr_server(root, registry, registry_count, svf);
+      binding_gen_ssr_server(root, registry, registry_count, &ssr_opts, svf);
       fclose(svf);
       printf("forge: \033[32m✓\033[0m %s (SSR server)\n", srv_path);
     }
 
     printf("forge: \033[32mSSR ready\033[0m → node %s/forge-ssr-server.js\n", cfg.out_dir);
   }
+  _phase_ms[PH_SSR] = now_ms() - t0;
+
+  if (cfg.time_phases)
+    print_phase_times(now_ms() - build_t0, cfg.jobs);
 
   /* Note: In a production compiler, we would properly track all Program
      pointers to free them here. For this implementation, the process is about
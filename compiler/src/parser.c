@@ -14,14 +14,12 @@
 /* ─── Internals ─────────────────────────────────────────────────────────────
  */
 
-static int p_error_count = 0;
-
 static void error_at(Parser *p, const Token *tok, const char *msg) {
   if (p->panic_mode)
     return;
   p->panic_mode = 1;
   p->had_error = 1;
-  p_error_count++;
+  p->error_count++;
   fprintf(stderr, "\033[31m[forge] ERROR\033[0m %s:%d:%d  %s\n",
           tok->loc.filename, tok->loc.line, tok->loc.column, msg);
 }
@@ -52,19 +50,26 @@ static int match_tok(Parser *p, TokenType type) {
   return 1;
 }
 
-/* Make a null-terminated copy of a token's text */
-static char *tok_dup(const Token *tok) {
-  char *s = malloc(tok->length + 1);
-  memcpy(s, tok->start, tok->length);
-  s[tok->length] = '\0';
-  return s;
+/* Make a null-terminated copy of a token's text in the Program's arena */
+static char *tok_dup(Parser *p, const Token *tok) {
+  return ast_strndup(p->arena, tok->start, tok->length);
+}
+
+/* Double an arena array of `*cap` elements when `count` has reached it */
+static void *grow_array(Parser *p, void *arr, int count, int *cap,
+                        size_t elem) {
+  if (count < *cap)
+    return arr;
+  int old = *cap;
+  *cap = old ? old * 2 : 4;
+  return ast_grow(p->arena, arr, elem * (size_t)old, elem * (size_t)*cap);
 }
 
 /* ─── Type Parsing ──────────────────────────────────────────────────────────
  */
 
 static TypeRef *parse_type(Parser *p) {
-  TypeRef *tr = ast_new_type(TY_USER);
+  TypeRef *tr = ast_new_type(p->arena, TY_USER);
 
   /* const qualifier */
   if (match_tok(p, TOK_CONST))
@@ -110,7 +115,7 @@ static TypeRef *parse_type(Parser *p) {
     break;
   case TOK_IDENT:
     tr->kind = TY_USER;
-    tr->name = tok_dup(&p->current);
+    tr->name = tok_dup(p, &p->current);
     advance(p);
     break;
   default:
@@ -120,7 +125,7 @@ static TypeRef *parse_type(Parser *p) {
 
   /* Pointer suffix: char* */
   while (match_tok(p, TOK_STAR)) {
-    TypeRef *ptr = ast_new_type(TY_PTR);
+    TypeRef *ptr = ast_new_type(p->arena, TY_PTR);
     ptr->inner = tr;
     tr = ptr;
   }
@@ -150,23 +155,19 @@ static Field parse_field(Parser *p) {
     if (check(p, TOK_STAR)) {
       advance(p); /* consume '*' */
       if (check(p, TOK_IDENT)) {
-        TypeRef *fn = ast_new_type(TY_FN_PTR);
+        TypeRef *fn = ast_new_type(p->arena, TY_FN_PTR);
         fn->ret_type = f.type;
-        f.name = tok_dup(&p->current);
+        f.name = tok_dup(p, &p->current);
         advance(p); /* consume name */
         consume(p, TOK_RPAREN, "Expected ')' after function pointer name");
 
         /* Parse parameter list */
         consume(p, TOK_LPAREN, "Expected '(' for function pointer parameters");
-        int pcap = 4;
-        fn->param_types = malloc(sizeof(TypeRef *) * pcap);
+        int pcap = 0;
         fn->param_count = 0;
         while (!check(p, TOK_RPAREN) && !check(p, TOK_EOF)) {
-          if (fn->param_count >= pcap) {
-            pcap *= 2;
-            fn->param_types =
-                realloc(fn->param_types, sizeof(TypeRef *) * pcap);
-          }
+          fn->param_types = grow_array(p, fn->param_types, fn->param_count,
+                                       &pcap, sizeof(TypeRef *));
           fn->param_types[fn->param_count++] = parse_type(p);
           /* skip parameter name if present */
           if (check(p, TOK_IDENT))
@@ -193,12 +194,12 @@ static Field parse_field(Parser *p) {
     error_at(p, &p->current, "Expected field name");
     return f;
   }
-  f.name = tok_dup(&p->current);
+  f.name = tok_dup(p, &p->current);
   advance(p);
 
   /* Array dimension: name[N] or name[CONSTANT] */
   if (match_tok(p, TOK_LBRACKET)) {
-    TypeRef *arr = ast_new_type(TY_ARRAY);
+    TypeRef *arr = ast_new_type(p->arena, TY_ARRAY);
     arr->inner = f.type;
     arr->array_size = -1;
     if (check(p, TOK_INT_LIT)) {
@@ -222,10 +223,8 @@ static Field parse_field(Parser *p) {
     /* collect everything up to ; */
     while (!check(p, TOK_SEMICOLON) && !check(p, TOK_EOF))
       advance(p);
-    size_t len = (size_t)(p->current.start - init_start);
-    f.init_expr = malloc(len + 1);
-    memcpy(f.init_expr, init_start, len);
-    f.init_expr[len] = '\0';
+    f.init_expr = ast_strndup(p->arena, init_start,
+                              (size_t)(p->current.start - init_start));
   }
 
   consume(p, TOK_SEMICOLON, "Expected ';' after field declaration");
@@ -250,8 +249,7 @@ static void parse_style_section(Parser *p, ComponentNode *comp) {
   lexer_set_mode(p->lex, LEX_MODE_STYLE);
   advance(p); /* read first property name in style mode */
 
-  int cap = 8;
-  comp->style = malloc(sizeof(StyleRule) * cap);
+  int cap = 0;
   comp->style_count = 0;
 
   while (!check(p, TOK_RBRACE) && !check(p, TOK_EOF)) {
@@ -261,7 +259,7 @@ static void parse_style_section(Parser *p, ComponentNode *comp) {
     /* property name */
     if (!check(p, TOK_HTML_ATTR) && !check(p, TOK_IDENT))
       break;
-    rule.property = tok_dup(&p->current);
+    rule.property = tok_dup(p, &p->current);
     advance(p);
 
     consume(p, TOK_COLON, "Expected ':' after style property");
@@ -272,13 +270,10 @@ static void parse_style_section(Parser *p, ComponentNode *comp) {
            !check(p, TOK_EOF))
       advance(p);
     size_t vlen = (size_t)(p->current.start - val_start);
-    rule.value = malloc(vlen + 1);
-    memcpy(rule.value, val_start, vlen);
     /* trim trailing whitespace */
-    while (vlen > 0 &&
-           (rule.value[vlen - 1] == ' ' || rule.value[vlen - 1] == '\t'))
+    while (vlen > 0 && (val_start[vlen - 1] == ' ' || val_start[vlen - 1] == '\t'))
       vlen--;
-    rule.value[vlen] = '\0';
+    rule.value = ast_strndup(p->arena, val_start, vlen);
 
     /* detect dynamic value (contains 'props.' or 'state.') */
     if (strstr(rule.value, "props.") || strstr(rule.value, "state."))
@@ -286,10 +281,8 @@ static void parse_style_section(Parser *p, ComponentNode *comp) {
 
     match_tok(p, TOK_SEMICOLON);
 
-    if (comp->style_count >= cap) {
-      cap *= 2;
-      comp->style = realloc(comp->style, sizeof(StyleRule) * cap);
-    }
+    comp->style =
+        grow_array(p, comp->style, comp->style_count, &cap, sizeof(StyleRule));
     comp->style[comp->style_count++] = rule;
   }
 
@@ -343,10 +336,7 @@ static char *collect_expr(Parser *p) {
       p->lex->current++;
     }
   }
-  size_t len = (size_t)(p->lex->current - start);
-  char *expr = malloc(len + 1);
-  memcpy(expr, start, len);
-  expr[len] = '\0';
+  char *expr = ast_strndup(p->arena, start, (size_t)(p->lex->current - start));
   if (*p->lex->current == '}')
     p->lex->current++; /* consume closing } */
   /* Restore TEMPLATE mode and re-sync the parser's lookahead token */
@@ -355,11 +345,25 @@ static char *collect_expr(Parser *p) {
   return expr;
 }
 
-static HtmlNode *parse_element(Parser *p, const char *tag) {
-  HtmlNode *node = ast_new_html_node(HTML_ELEMENT);
-  node->tag = strdup(tag);
+/* Append a zeroed child to `node` and return it.  The slot is filled in
+ * place, so nested elements are never built elsewhere and copied in. */
+static HtmlNode *push_child(Parser *p, HtmlNode *node, int *cap,
+                            HtmlKind kind) {
+  node->children = grow_array(p, node->children, node->child_count, cap,
+                              sizeof(HtmlNode));
+  HtmlNode *child = &node->children[node->child_count++];
+  memset(child, 0, sizeof(*child));
+  child->kind = kind;
+  return child;
+}
+
+/* p->current is the tag name; fills `node` from it through the closing tag */
+static void parse_element(Parser *p, HtmlNode *node) {
+  const char *tag = node->tag = tok_dup(p, &p->current);
+  advance(p);
 
   /* Check if it's a special tag or component */
+  node->kind = HTML_ELEMENT;
   if (strcmp(tag, "if") == 0)
     node->kind = HTML_IF;
   else if (strcmp(tag, "for") == 0)
@@ -368,8 +372,7 @@ static HtmlNode *parse_element(Parser *p, const char *tag) {
     node->kind = HTML_COMPONENT;
 
   /* Parse attributes */
-  int attr_cap = 4;
-  node->attrs = malloc(sizeof(Attribute) * attr_cap);
+  int attr_cap = 0;
   node->attr_count = 0;
 
   while (!check(p, TOK_GT) && !check(p, TOK_SLASH) && !check(p, TOK_EOF)) {
@@ -377,9 +380,10 @@ static HtmlNode *parse_element(Parser *p, const char *tag) {
       break;
 
     Attribute attr;
-    attr.name = tok_dup(&p->current);
+    attr.name = tok_dup(p, &p->current);
     attr.value = NULL;
     attr.is_expr = 0;
+    attr.dep_mask = 0;
     advance(p);
 
     if (match_tok(p, TOK_ASSIGN)) {
@@ -387,7 +391,8 @@ static HtmlNode *parse_element(Parser *p, const char *tag) {
         attr.value = collect_expr(p);
         attr.is_expr = 1;
       } else if (check(p, TOK_STRING_LIT)) {
-        attr.value = strdup(p->current.value.str_val);
+        attr.value = ast_alloc(p->arena, p->current.length - 1);
+        lexer_string_value(&p->current, attr.value);
         advance(p);
       } else if (check(p, TOK_HTML_ATTR)) {
         /* Strip surrounding quotes from "value" or 'value' */
@@ -395,23 +400,19 @@ static HtmlNode *parse_element(Parser *p, const char *tag) {
         size_t rlen = p->current.length;
         if (rlen >= 2 && (raw[0] == '"' || raw[0] == '\'') &&
             raw[rlen - 1] == raw[0]) {
-          attr.value = malloc(rlen - 1);
-          memcpy(attr.value, raw + 1, rlen - 2);
-          attr.value[rlen - 2] = '\0';
+          attr.value = ast_strndup(p->arena, raw + 1, rlen - 2);
         } else {
-          attr.value = tok_dup(&p->current);
+          attr.value = tok_dup(p, &p->current);
         }
         advance(p);
       } else {
-        attr.value = tok_dup(&p->current);
+        attr.value = tok_dup(p, &p->current);
         advance(p);
       }
     }
 
-    if (node->attr_count >= attr_cap) {
-      attr_cap *= 2;
-      node->attrs = realloc(node->attrs, sizeof(Attribute) * attr_cap);
-    }
+    node->attrs = grow_array(p, node->attrs, node->attr_count, &attr_cap,
+                             sizeof(Attribute));
     node->attrs[node->attr_count++] = attr;
   }
 
@@ -419,13 +420,12 @@ static HtmlNode *parse_element(Parser *p, const char *tag) {
   if (match_tok(p, TOK_SLASH)) {
     consume(p, TOK_GT, "Expected '>' after '/'");
     node->self_closing = 1;
-    return node;
+    return;
   }
   consume(p, TOK_GT, "Expected '>' after tag attributes");
 
   /* Parse children */
-  int child_cap = 4;
-  node->children = malloc(sizeof(HtmlNode) * child_cap);
+  int child_cap = 0;
   node->child_count = 0;
 
   while (!check(p, TOK_EOF)) {
@@ -438,55 +438,31 @@ static HtmlNode *parse_element(Parser *p, const char *tag) {
         consume(p, TOK_GT, "Expected '>' in closing tag");
         break;
       }
-      /* not a closing tag — put back and parse child */
-      /* We need to parse the child element starting with the tag name */
+      /* not a closing tag — parse the child element from its tag name */
       if (!check(p, TOK_IDENT))
         break;
-      char *child_tag = tok_dup(&p->current);
-      advance(p);
-      HtmlNode *child = parse_element(p, child_tag);
-      free(child_tag);
-      if (node->child_count >= child_cap) {
-        child_cap *= 2;
-        node->children = realloc(node->children, sizeof(HtmlNode) * child_cap);
-      }
-      node->children[node->child_count++] = *child;
-      free(child);
+      parse_element(p, push_child(p, node, &child_cap, HTML_ELEMENT));
       continue;
     }
 
     /* Expression node {expr} */
     if (match_tok(p, TOK_LBRACE)) {
-      HtmlNode *expr_node = ast_new_html_node(HTML_EXPR);
-      expr_node->text = collect_expr(p);
-      if (node->child_count >= child_cap) {
-        child_cap *= 2;
-        node->children = realloc(node->children, sizeof(HtmlNode) * child_cap);
-      }
-      node->children[node->child_count++] = *expr_node;
-      free(expr_node);
+      char *expr = collect_expr(p);
+      push_child(p, node, &child_cap, HTML_EXPR)->text = expr;
       continue;
     }
 
     /* Text node — HTML_TEXT for non-alpha chars;
      * IDENT for alpha-starting text like "Reset", "Click me", etc. */
     if (check(p, TOK_HTML_TEXT) || check(p, TOK_IDENT)) {
-      HtmlNode *text_node = ast_new_html_node(HTML_TEXT);
-      text_node->text = tok_dup(&p->current);
+      push_child(p, node, &child_cap, HTML_TEXT)->text =
+          tok_dup(p, &p->current);
       advance(p);
-      if (node->child_count >= child_cap) {
-        child_cap *= 2;
-        node->children = realloc(node->children, sizeof(HtmlNode) * child_cap);
-      }
-      node->children[node->child_count++] = *text_node;
-      free(text_node);
       continue;
     }
 
     break;
   }
-
-  return node;
 }
 
 static void parse_template_section(Parser *p, ComponentNode *comp) {
@@ -518,10 +494,8 @@ static void parse_template_section(Parser *p, ComponentNode *comp) {
   if (check(p, TOK_LT)) {
     advance(p); /* consume < */
     if (check(p, TOK_IDENT)) {
-      char *tag = tok_dup(&p->current);
-      advance(p);
-      comp->template_root = parse_element(p, tag);
-      free(tag);
+      comp->template_root = ast_new_html_node(p->arena, HTML_ELEMENT);
+      parse_element(p, comp->template_root);
     }
   }
 
@@ -542,19 +516,14 @@ static ComponentNode *parse_component(Parser *p) {
     error_at(p, &p->current, "Expected component name after @component");
     return NULL;
   }
-  ComponentNode *comp = ast_new_component();
-  comp->name = tok_dup(&p->current);
+  ComponentNode *comp = ast_new_component(p->arena);
+  comp->name = tok_dup(p, &p->current);
   comp->loc = p->current.loc;
   advance(p);
 
   consume(p, TOK_LBRACE, "Expected '{' to open @component body");
 
-  int prop_cap = 8, state_cap = 8, handler_cap = 4, computed_cap = 4;
-
-  comp->props = malloc(sizeof(Field) * prop_cap);
-  comp->state = malloc(sizeof(Field) * state_cap);
-  comp->handlers = malloc(sizeof(EventHandler) * handler_cap);
-  comp->computed = malloc(sizeof(ComputedField) * computed_cap);
+  int prop_cap = 0, state_cap = 0, handler_cap = 0, computed_cap = 0;
 
   while (!check(p, TOK_RBRACE) && !check(p, TOK_EOF)) {
 
@@ -562,10 +531,8 @@ static ComponentNode *parse_component(Parser *p) {
     if (match_tok(p, TOK_AT_PROPS)) {
       consume(p, TOK_LBRACE, "Expected '{' after @props");
       while (!check(p, TOK_RBRACE) && !check(p, TOK_EOF)) {
-        if (comp->prop_count >= prop_cap) {
-          prop_cap *= 2;
-          comp->props = realloc(comp->props, sizeof(Field) * prop_cap);
-        }
+        comp->props = grow_array(p, comp->props, comp->prop_count, &prop_cap,
+                                 sizeof(Field));
         comp->props[comp->prop_count++] = parse_field(p);
         p->panic_mode = 0;
       }
@@ -577,10 +544,8 @@ static ComponentNode *parse_component(Parser *p) {
     if (match_tok(p, TOK_AT_STATE)) {
       consume(p, TOK_LBRACE, "Expected '{' after @state");
       while (!check(p, TOK_RBRACE) && !check(p, TOK_EOF)) {
-        if (comp->state_count >= state_cap) {
-          state_cap *= 2;
-          comp->state = realloc(comp->state, sizeof(Field) * state_cap);
-        }
+        comp->state = grow_array(p, comp->state, comp->state_count,
+                                 &state_cap, sizeof(Field));
         comp->state[comp->state_count++] = parse_field(p);
         p->panic_mode = 0;
       }
@@ -602,7 +567,8 @@ static ComponentNode *parse_component(Parser *p) {
         break;
       }
       EventHandler ev;
-      ev.event_name = tok_dup(&p->current);
+      ev.dep_mask = 0;
+      ev.event_name = tok_dup(p, &p->current);
       advance(p);
       consume(p, TOK_RPAREN, "Expected ')' after event name");
 
@@ -670,18 +636,13 @@ static ComponentNode *parse_component(Parser *p) {
           p->lex->current++;
         }
       }
-      size_t blen = (size_t)(p->lex->current - body_start);
-      ev.body = malloc(blen + 1);
-      memcpy(ev.body, body_start, blen);
-      ev.body[blen] = '\0';
+      ev.body = ast_strndup(p->arena, body_start,
+                            (size_t)(p->lex->current - body_start));
       if (*p->lex->current == '}')
         p->lex->current++;
 
-      if (comp->handler_count >= handler_cap) {
-        handler_cap *= 2;
-        comp->handlers =
-            realloc(comp->handlers, sizeof(EventHandler) * handler_cap);
-      }
+      comp->handlers = grow_array(p, comp->handlers, comp->handler_count,
+                                  &handler_cap, sizeof(EventHandler));
       comp->handlers[comp->handler_count++] = ev;
       advance(p);
       continue;
@@ -692,15 +653,13 @@ static ComponentNode *parse_component(Parser *p) {
       consume(p, TOK_LBRACE, "Expected '{' after @computed");
       while (!check(p, TOK_RBRACE) && !check(p, TOK_EOF)) {
         ComputedField cf;
+        cf.dep_mask = 0;
         cf.field = parse_field(p);
         /* the init_expr IS the computed expression */
         cf.expression = cf.field.init_expr;
         cf.field.init_expr = NULL;
-        if (comp->computed_count >= computed_cap) {
-          computed_cap *= 2;
-          comp->computed =
-              realloc(comp->computed, sizeof(ComputedField) * computed_cap);
-        }
+        comp->computed = grow_array(p, comp->computed, comp->computed_count,
+                                    &computed_cap, sizeof(ComputedField));
         comp->computed[comp->computed_count++] = cf;
         p->panic_mode = 0;
       }
@@ -731,16 +690,15 @@ void parser_init(Parser *p, Lexer *lex) {
   p->lex = lex;
   p->had_error = 0;
   p->panic_mode = 0;
-  p_error_count = 0;
+  p->error_count = 0;
+  p->arena = NULL;
   advance(p); /* prime the pump */
 }
 
 Program *parser_parse(Parser *p) {
-  Program *prog = malloc(sizeof(Program));
-  prog->components = NULL;
-  prog->component_count = 0;
-  int cap = 4;
-  prog->components = malloc(sizeof(ComponentNode *) * cap);
+  Program *prog = ast_new_program();
+  p->arena = &prog->arena;
+  int cap = 0;
 
   while (!check(p, TOK_EOF)) {
     /* #include "..." or #define ... */
@@ -774,11 +732,9 @@ Program *parser_parse(Parser *p) {
     if (match_tok(p, TOK_AT_COMPONENT)) {
       ComponentNode *comp = parse_component(p);
       if (comp) {
-        if (prog->component_count >= cap) {
-          cap *= 2;
-          prog->components =
-              realloc(prog->components, sizeof(ComponentNode *) * cap);
-        }
+        prog->components = grow_array(p, prog->components,
+                                      prog->component_count, &cap,
+                                      sizeof(ComponentNode *));
         prog->components[prog->component_count++] = comp;
       }
       p->panic_mode = 0;
@@ -797,7 +753,4 @@ Program *parser_parse(Parser *p) {
 }
 
 void parser_free(Parser *p) { (void)p; }
-int parser_error_count(Parser *p) {
-  (void)p;
-  return p_error_count;
-}
+int parser_error_count(Parser *p) { return p->error_count; }
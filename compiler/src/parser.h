@@ -17,6 +17,8 @@ typedef struct {
     Token       previous;
     int         had_error;
     int         panic_mode;
+    int         error_count;  /* per parser, so files can parse in parallel */
+    AstArena   *arena;        /* the Program being built */
 } Parser;
 
 /* ─── Public API ──────────────────────────────────────────────────────────── */
@@ -2,8 +2,13 @@
  * Forge Framework - WASM Emitter Implementation
  *
  * Wraps the Clang compiler to produce wasm32 modules from generated C.
+ * wasm_compile() is reentrant: each call captures its own Clang output
+ * through a pipe, so `forge compile -j N` can run several at once.
+ * Linked modules then go through wasm-opt when it is installed.
  */
 
+#define _POSIX_C_SOURCE 200809L /* popen / pclose / strdup */
+
 #include "wasm_emit.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -20,95 +25,172 @@ int wasm_check_toolchain(const WasmOptions *opts) {
     return system(cmd) == 0;
 }
 
+/* wasm-opt is optional: without it modules ship as clang linked them */
+int wasm_check_wasm_opt(void) {
+    return system("wasm-opt --version > /dev/null 2>&1") == 0;
+}
+
 /* ─── Build Clang Flags ───────────────────────────────────────────────────── */
 
-char *wasm_build_flags(const WasmOptions *opts) {
+/* Target and code generation flags, shared by compiling and linking */
+static int compile_flags(char *flags, size_t cap, const WasmOptions *opts) {
     const char *clang   = opts && opts->clang_path     ? opts->clang_path     : "clang";
     const char *inc_dir = opts && opts->include_dir    ? opts->include_dir    : "./runtime/include";
-    const char *lib_dir = opts && opts->runtime_lib_dir? opts->runtime_lib_dir: "./runtime/build";
     int         optlvl  = opts ? opts->optimize : 2;
     int         debug   = opts ? opts->debug    : 0;
-    int         strip   = opts ? opts->strip    : 0;
+    int         simd    = opts ? opts->simd     : 1;
 
-    char *flags = malloc(2048);
-    int   pos   = 0;
-
-    pos += snprintf(flags + pos, 2048 - pos,
+    return snprintf(flags, cap,
         "%s"
         " --target=wasm32-unknown-unknown"
         " -nostdlib"
         " -O%d"
+        " -mbulk-memory"
+        "%s"
         " -I%s"
+        "%s",
+        clang, optlvl, simd ? " -msimd128" : "", inc_dir,
+        debug ? " -g" : "");
+}
+
+/* Runtime library and module layout; appended after the inputs */
+static int link_flags(char *flags, size_t cap, const WasmOptions *opts) {
+    const char *lib_dir = opts && opts->runtime_lib_dir? opts->runtime_lib_dir: "./runtime/build";
+    int         strip   = opts ? opts->strip    : 0;
+
+    return snprintf(flags, cap,
         " -L%s"
         " -lforge_runtime"
         " -Wl,--no-entry"
         " -Wl,--export-dynamic"
         " -Wl,--allow-undefined"
         " -Wl,-z,stack-size=65536"
-        "%s%s",
-        clang, optlvl, inc_dir, lib_dir,
-        debug ? " -g" : "",
-        strip ? " -Wl,--strip-all" : "");
+        "%s",
+        lib_dir, strip ? " -Wl,--strip-all" : "");
+}
 
+char *wasm_build_flags(const WasmOptions *opts) {
+    char *flags = malloc(2048);
+    int   pos   = compile_flags(flags, 2048, opts);
+    if (opts && opts->compile_only)
+        snprintf(flags + pos, 2048 - (size_t)pos, " -c");
+    else
+        link_flags(flags + pos, 2048 - (size_t)pos, opts);
     return flags;
 }
 
 /* ─── Compile ─────────────────────────────────────────────────────────────── */
 
-WasmResult wasm_compile(const char *c_source_path, const WasmOptions *opts) {
+/* Run `cmd` (stderr folded into stdout) and collect what it prints.
+ * Returns the exit status; *output is NULL when nothing was printed. */
+static int run_capture(const char *cmd, char **output) {
+    *output = NULL;
+    FILE *pipe = popen(cmd, "r");
+    if (!pipe) return -1;
+    size_t len = 0;
+    char   chunk[1024];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), pipe)) > 0) {
+        /* Keep draining even if we run out of memory, or the child blocks */
+        char *grown = realloc(*output, len + n + 1);
+        if (!grown) continue;
+        *output = grown;
+        memcpy(*output + len, chunk, n);
+        len += n;
+        (*output)[len] = '\0';
+    }
+    return pclose(pipe);
+}
+
+/* Optimize a linked module in place.  A failure keeps clang's output and
+ * is returned as a warning rather than failing the build. */
+static char *run_wasm_opt(const char *wasm_path, const WasmOptions *opts) {
+    if (!opts || !opts->wasm_opt || opts->optimize <= 0) return NULL;
+
+    char tmp[600], cmd[2048];
+    snprintf(tmp, sizeof(tmp), "%s.opt", wasm_path);
+    snprintf(cmd, sizeof(cmd),
+             "wasm-opt -O%d%s --enable-bulk-memory%s %s -o %s 2>&1",
+             opts->optimize > 4 ? 4 : opts->optimize, opts->debug ? " -g" : "",
+             opts->simd ? " --enable-simd" : "", wasm_path, tmp);
+
+    char *output;
+    if (run_capture(cmd, &output) == 0 && rename(tmp, wasm_path) == 0) {
+        free(output);
+        return NULL;
+    }
+    remove(tmp);
+    if (!output) output = strdup("wasm-opt failed (no output)");
+    return output;
+}
+
+static WasmResult run_clang(const char *cmd, const char *out_path,
+                            const WasmOptions *opts, int linked) {
     WasmResult result = { 0, NULL, 0, NULL };
 
+    /* Execute, collecting everything Clang prints */
+    char *output;
+    int   rc = run_capture(cmd, &output);
+    if (rc == -1 && !output) {
+        result.error_msg = strdup("Could not start clang");
+        return result;
+    }
+    if (rc != 0) {
+        result.error_msg = output ? output : strdup("Compilation failed (no error output)");
+        return result;
+    }
+    free(output);
+
+    /* Success; a wasm-opt problem comes back as error_msg on a success */
+    if (linked) result.error_msg = run_wasm_opt(out_path, opts);
+    result.success   = 1;
+    result.wasm_path = strdup(out_path);
+    result.wasm_size = wasm_file_size(out_path);
+    return result;
+}
+
+WasmResult wasm_compile(const char *c_source_path, const WasmOptions *opts) {
     if (!c_source_path) {
-        result.error_msg = strdup("No source file specified");
+        WasmResult result = { 0, NULL, 0, strdup("No source file specified") };
         return result;
     }
 
-    /* Derive output path: Foo.gen.c → Foo.wasm */
+    /* Derive output path: Foo.gen.c → Foo.wasm (Foo.o with compile_only) */
+    int  object = opts && opts->compile_only;
     char out_path[512];
-    strncpy(out_path, c_source_path, sizeof(out_path) - 1);
-    char *dot = strrchr(out_path, '.');
-    if (dot) strcpy(dot, ".wasm");
-    else strcat(out_path, ".wasm");
+    snprintf(out_path, sizeof(out_path), "%s", c_source_path);
+    char *ext = strstr(out_path, ".gen.c");
+    if (!ext) ext = strrchr(out_path, '.');
+    if (ext) *ext = '\0';
+    strncat(out_path, object ? ".o" : ".wasm", sizeof(out_path) - strlen(out_path) - 1);
 
-    /* Build Clang flags */
+    /* Build full command; diagnostics come back on the pipe */
     char *flags = wasm_build_flags(opts);
-
-    /* Build full command */
     char cmd[4096];
-    char err_file[] = "/tmp/forge_clang_err.txt";
-
-    snprintf(cmd, sizeof(cmd),
-             "%s %s -o %s 2>%s",
-             flags, c_source_path, out_path, err_file);
-
+    snprintf(cmd, sizeof(cmd), "%s %s -o %s 2>&1", flags, c_source_path, out_path);
     free(flags);
 
-    /* Execute */
-    int rc = system(cmd);
-    if (rc != 0) {
-        /* Read error output */
-        FILE *ef = fopen(err_file, "r");
-        if (ef) {
-            fseek(ef, 0, SEEK_END);
-            long fsz = ftell(ef);
-            rewind(ef);
-            result.error_msg = malloc((size_t)fsz + 1);
-            if (result.error_msg) {
-                fread(result.error_msg, 1, (size_t)fsz, ef);
-                result.error_msg[fsz] = '\0';
-            }
-            fclose(ef);
-        } else {
-            result.error_msg = strdup("Compilation failed (no error output)");
-        }
+    return run_clang(cmd, out_path, opts, !object);
+}
+
+WasmResult wasm_link(const char **obj_paths, int count, const char *out_path,
+                     const WasmOptions *opts) {
+    size_t cap = 4096;
+    for (int i = 0; i < count; i++) cap += strlen(obj_paths[i]) + 1;
+    char *cmd = malloc(cap);
+    if (!cmd) {
+        WasmResult result = { 0, NULL, 0, strdup("Out of memory") };
         return result;
     }
 
-    /* Success */
-    result.success   = 1;
-    result.wasm_path = strdup(out_path);
-    result.wasm_size = wasm_file_size(out_path);
+    size_t pos = (size_t)compile_flags(cmd, cap, opts);
+    for (int i = 0; i < count; i++)
+        pos += (size_t)snprintf(cmd + pos, cap - pos, " %s", obj_paths[i]);
+    pos += (size_t)link_flags(cmd + pos, cap - pos, opts);
+    snprintf(cmd + pos, cap - pos, " -o %s 2>&1", out_path);
 
+    WasmResult result = run_clang(cmd, out_path, opts, 1);
+    free(cmd);
     return result;
 }
 
@@ -2,7 +2,8 @@
  * Forge Framework - WASM Emitter
  *
  * Drives the Clang/LLVM backend to compile generated .gen.c files
- * into WASM32 modules.
+ * into WASM32 modules — one per component, or (--bundle) objects that
+ * wasm_link() puts into a single module sharing one runtime.
  *
  * Also provides a direct binary WASM emission path (no Clang needed)
  * for simple components — useful for fast incremental rebuilds.
@@ -14,6 +15,9 @@
 #include <stdint.h>
 #include <stddef.h>
 
+/* Module every component links into under `forge compile --bundle` */
+#define FORGE_BUNDLE_WASM "forge-bundle.wasm"
+
 /* ─── WASM Compilation Options ────────────────────────────────────────────── */
 
 typedef struct {
@@ -24,25 +28,37 @@ typedef struct {
     int         debug;            /* emit DWARF debug info               */
     int         strip;            /* strip names from output             */
     int         async;            /* emit asyncify instrumentation       */
+    int         simd;             /* target simd128 (bulk memory always) */
+    int         compile_only;     /* -c: emit a .o for wasm_link()       */
+    int         wasm_opt;         /* run wasm-opt on linked modules      */
 } WasmOptions;
 
 /* ─── Compilation Result ──────────────────────────────────────────────────── */
 
 typedef struct {
     int    success;
-    char  *wasm_path;   /* output .wasm file path (heap-allocated)  */
+    char  *wasm_path;   /* output .wasm (or .o) path (heap-allocated) */
     size_t wasm_size;   /* byte size of produced WASM module        */
     char  *error_msg;   /* compiler stderr output on failure        */
 } WasmResult;
 
 /* ─── Public API ──────────────────────────────────────────────────────────── */
 
-/* Compile a .gen.c file to .wasm using Clang */
+/* Compile a .gen.c file to .wasm using Clang (to .o with compile_only) */
 WasmResult wasm_compile(const char *c_source_path, const WasmOptions *opts);
 
+/* Link objects from wasm_compile(compile_only) and the runtime into one
+ * module at out_path: a single linear memory, registry and set of arenas
+ * for every component in it */
+WasmResult wasm_link(const char **obj_paths, int count, const char *out_path,
+                     const WasmOptions *opts);
+
 /* Validate that clang + wasm32 target are available */
 int wasm_check_toolchain(const WasmOptions *opts);
 
+/* 1 if wasm-opt (binaryen) is on PATH */
+int wasm_check_wasm_opt(void);
+
 /* Get the wasm32 clang flags as a string (useful for debugging) */
 char *wasm_build_flags(const WasmOptions *opts);
 
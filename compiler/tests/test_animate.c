@@ -0,0 +1,164 @@
+/*
+ * Forge Stdlib — Animation Tests
+ * Run with: make test
+ *
+ * Drives forge_anim_tick directly against the native build of
+ * forge_runtime.a: done callbacks that start or cancel animations in a
+ * full pool, and update callbacks that try to start one mid-tick.
+ */
+
+#include "../../stdlib/include/forge/animate.h"
+#include "../../runtime/include/forge/web.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+void forge_runtime_init(void);
+
+static int tests_run    = 0;
+static int tests_passed = 0;
+
+#define ASSERT_EQ(a, b, msg) do {               \
+    tests_run++;                                 \
+    if ((a) == (b)) {                            \
+        tests_passed++;                          \
+        printf("  \033[32m✓\033[0m %s\n", msg); \
+    } else {                                     \
+        printf("  \033[31m✗\033[0m %s  (got %ld, want %ld)\n", msg, (long)(a), (long)(b)); \
+    }                                            \
+} while(0)
+
+/* ─── Host Imports ────────────────────────────────────────────────────────── */
+
+void forge_dom_flush(const u32 *buf, u32 words) { (void)buf; (void)words; }
+void js_schedule_raf(void) {}
+void js_console_log(const char *msg, int len) { (void)msg; (void)len; }
+void js_console_log_int(const char *msg, int len, int v) { (void)msg; (void)len; (void)v; }
+void js_trap(const char *msg, int len) { (void)msg; (void)len; abort(); }
+void forge_dom_set_style(forge_dom_node_t *el, const char *prop, forge_expr_fn fn,
+                         const char *static_val) {
+    (void)el; (void)prop; (void)fn; (void)static_val;
+}
+
+/* ─── Helpers ─────────────────────────────────────────────────────────────── */
+
+static u32 _finished, _restarts, _restart_ok;
+static forge_anim_t _victim;
+
+static void on_update(float v, void *userdata) { (void)v; (void)userdata; }
+
+static void count_done(void *userdata) {
+    (void)userdata;
+    _finished++;
+}
+
+/* Restarts itself once, with the pool full until the tick compacts */
+static void restart_done(void *userdata) {
+    _finished++;
+    if (_restarts++) return;
+    _restart_ok = forge_tween(0, 1, 1000, FORGE_EASE_LINEAR, on_update, count_done, userdata) != 0;
+}
+
+static void cancel_done(void *userdata) {
+    (void)userdata;
+    _finished++;
+    forge_anim_cancel(_victim);
+}
+
+/* Tries to start an animation while the tick is stepping */
+static void greedy_update(float v, void *userdata) {
+    (void)v;
+    *(forge_anim_t *)userdata = forge_tween(0, 1, 1000, FORGE_EASE_LINEAR, on_update, 0, 0);
+}
+
+static void drain(void) {
+    for (int i = 0; i < 100 && forge_anim_count(); i++) forge_anim_tick(1000);
+}
+
+/* ─── Test Cases ──────────────────────────────────────────────────────────── */
+
+static void test_done_restarts_in_full_pool(void) {
+    printf("\ntest_done_restarts_in_full_pool\n");
+    drain();
+    _finished = _restarts = _restart_ok = 0;
+
+    /* The first half is due within one 16 ms tick */
+    for (u32 i = 0; i < FORGE_MAX_ANIMATIONS; i++)
+        forge_tween(0, 1, i < FORGE_MAX_ANIMATIONS / 2 ? 10 : 1000, FORGE_EASE_LINEAR, on_update,
+                    i == 0 ? restart_done : count_done, 0);
+    ASSERT_EQ(forge_anim_count(), FORGE_MAX_ANIMATIONS, "pool full");
+    ASSERT_EQ(forge_tween(0, 1, 10, FORGE_EASE_LINEAR, on_update, 0, 0), 0, "one more is refused");
+
+    ASSERT_EQ(forge_anim_tick(16), 1, "more frames wanted");
+    ASSERT_EQ(_finished, FORGE_MAX_ANIMATIONS / 2, "every due tween finished");
+    ASSERT_EQ(_restart_ok, 1, "done callback restarted into the freed pool");
+    ASSERT_EQ(forge_anim_count(), FORGE_MAX_ANIMATIONS / 2 + 1, "the rest plus the restart live");
+
+    drain();
+    ASSERT_EQ(_finished, FORGE_MAX_ANIMATIONS + 1, "all done, restart included");
+    ASSERT_EQ(forge_anim_count(), 0, "pool empty");
+}
+
+static void test_done_cancels(void) {
+    printf("\ntest_done_cancels\n");
+    drain();
+    _finished = 0;
+    forge_tween(0, 1, 10, FORGE_EASE_LINEAR, on_update, cancel_done, 0);
+    _victim = forge_tween(0, 1, 1000, FORGE_EASE_LINEAR, on_update, count_done, 0);
+    forge_anim_t keep = forge_tween(0, 1, 1000, FORGE_EASE_LINEAR, on_update, count_done, 0);
+
+    forge_anim_tick(16);
+    ASSERT_EQ(_finished, 1, "only the due tween finished");
+    ASSERT_EQ(forge_anim_running(_victim), 0, "cancelled from the callback");
+    ASSERT_EQ(forge_anim_running(keep), 1, "the other survives compaction");
+    ASSERT_EQ(forge_anim_count(), 1, "one left");
+    drain();
+}
+
+static void test_update_in_full_pool(void) {
+    printf("\ntest_update_in_full_pool\n");
+    drain();
+    _finished = 0;
+
+    /* Entry 0 finishes this tick; entry 1 tries to take its slot while the
+     * loop is still running */
+    static forge_anim_t started = 1;
+    forge_tween(0, 1, 10, FORGE_EASE_LINEAR, on_update, count_done, 0);
+    forge_anim_t greedy = forge_tween(0, 1, 1000, FORGE_EASE_LINEAR, greedy_update, 0, &started);
+    for (u32 i = 2; i < FORGE_MAX_ANIMATIONS; i++)
+        forge_tween(0, 1, 1000, FORGE_EASE_LINEAR, on_update, count_done, 0);
+
+    forge_anim_tick(16);
+    ASSERT_EQ(started, 0, "no compaction mid-tick: start refused");
+    ASSERT_EQ(_finished, 1, "the due tween finished");
+    ASSERT_EQ(forge_anim_count(), FORGE_MAX_ANIMATIONS - 1, "nothing else lost");
+
+    forge_anim_tick(16);
+    ASSERT_EQ(started != 0, 1, "next tick, with the slot compacted, it starts");
+    forge_anim_cancel(started);
+    forge_anim_cancel(greedy);
+    drain();
+    ASSERT_EQ(forge_anim_count(), 0, "pool empty");
+}
+
+/* ─── Main ────────────────────────────────────────────────────────────────── */
+
+int main(void) {
+    printf("=== Forge Animation Tests ===\n");
+    forge_runtime_init();
+
+    test_done_restarts_in_full_pool();
+    test_done_cancels();
+    test_update_in_full_pool();
+
+    printf("\n══════════════════════════\n");
+    printf("  %d / %d tests passed\n", tests_passed, tests_run);
+
+    if (tests_passed == tests_run) {
+        printf("  \033[32mAll tests passed ✓\033[0m\n");
+        return 0;
+    } else {
+        printf("  \033[31m%d tests FAILED\033[0m\n", tests_run - tests_passed);
+        return 1;
+    }
+}
@@ -0,0 +1,278 @@
+/*
+ * Forge Compiler — Build Cache Tests
+ * Run with: make test
+ *
+ * Stores a parsed, analyzed component and reads it back, damages entries
+ * to check they are refused, and checks what goes into the key.
+ */
+
+#define _POSIX_C_SOURCE 200809L /* mkdtemp */
+
+#include "../src/build_cache.h"
+#include "../src/parser.h"
+#include "../src/analyzer.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static int tests_run    = 0;
+static int tests_passed = 0;
+
+#define ASSERT_EQ(a, b, msg) do {               \
+    tests_run++;                                 \
+    if ((a) == (b)) {                            \
+        tests_passed++;                          \
+        printf("  \033[32m✓\033[0m %s\n", msg); \
+    } else {                                     \
+        printf("  \033[31m✗\033[0m %s  (got %ld, want %ld)\n", msg, (long)(a), (long)(b)); \
+    }                                            \
+} while(0)
+
+#define ASSERT_STR(a, b, msg) do {              \
+    tests_run++;                                 \
+    if (strcmp(a, b) == 0) {                     \
+        tests_passed++;                          \
+        printf("  \033[32m✓\033[0m %s\n", msg); \
+    } else {                                     \
+        printf("  \033[31m✗\033[0m %s  (got '%s', want '%s')\n", msg, a, b); \
+    }                                            \
+} while(0)
+
+/* ─── Helpers ─────────────────────────────────────────────────────────────── */
+
+static const char SRC[] =
+    "@component Counter {\n"
+    "    @props { int step; char *label; }\n"
+    "    @state { int count = 0; int maxed = 0; }\n"
+    "    @computed { int doubled = state.count * 2; }\n"
+    "    @style { padding: 8px; color: {state.maxed ? \"red\" : \"black\"}; }\n"
+    "    @on(increment) { state.count += props.step; }\n"
+    "    @template {\n"
+    "        <div class=\"counter\">\n"
+    "            <span>{props.label}: {state.count}</span>\n"
+    "            <button onclick={@increment}>+</button>\n"
+    "        </div>\n"
+    "    }\n"
+    "}\n";
+
+static char _dir[64], _out[96], _cache[96];
+
+static Program *parse_src(const char *src) {
+    Lexer lex;
+    Parser p;
+    lexer_init(&lex, src, "Counter.cx");
+    parser_init(&p, &lex);
+    Program *prog = parser_parse(&p);
+    int errors = parser_error_count(&p);
+    parser_free(&p);
+    if (!prog || errors || analyze_program(prog).error_count) return NULL;
+    return prog;
+}
+
+static void write_file(const char *path, const char *text) {
+    FILE *f = fopen(path, "wb");
+    if (f) { fputs(text, f); fclose(f); }
+}
+
+/* Whole file into a malloc'd buffer; *len is its size */
+static char *read_file(const char *path, long *len) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    *len = ftell(f);
+    rewind(f);
+    char *buf = malloc((size_t)*len + 1);
+    if (fread(buf, 1, (size_t)*len, f) != (size_t)*len) *len = -1;
+    buf[*len > 0 ? *len : 0] = '\0';
+    fclose(f);
+    return buf;
+}
+
+/* Fake compiler outputs for the component, as codegen would leave them */
+static void write_outputs(const char *stamp) {
+    char path[256];
+    static const char *const exts[] = { ".gen.c", ".forge.js", ".forge.d.ts", ".wasm" };
+    for (int e = 0; e < 4; e++) {
+        snprintf(path, sizeof(path), "%s/Counter%s", _out, exts[e]);
+        write_file(path, stamp);
+    }
+}
+
+static void remove_outputs(void) {
+    char path[256];
+    static const char *const exts[] = { ".gen.c", ".forge.js", ".forge.d.ts", ".wasm" };
+    for (int e = 0; e < 4; e++) {
+        snprintf(path, sizeof(path), "%s/Counter%s", _out, exts[e]);
+        unlink(path);
+    }
+}
+
+/* ─── Test Cases ──────────────────────────────────────────────────────────── */
+
+static void test_key(void) {
+    printf("\ntest_key\n");
+    char a[FORGE_CACHE_KEY_LEN + 1], b[FORGE_CACHE_KEY_LEN + 1];
+    build_cache_key(SRC, sizeof(SRC) - 1, "forge 0.1.0 bin=1 O2", a);
+    build_cache_key(SRC, sizeof(SRC) - 1, "forge 0.1.0 bin=1 O2", b);
+    ASSERT_EQ(strlen(a), FORGE_CACHE_KEY_LEN, "key is 16 hex digits");
+    ASSERT_STR(a, b, "same input, same key");
+    build_cache_key(SRC, sizeof(SRC) - 1, "forge 0.1.0 bin=1 O0", b);
+    ASSERT_EQ(strcmp(a, b) != 0, 1, "flag change, new key");
+    build_cache_key(SRC, sizeof(SRC) - 1, "forge 0.1.0 bin=2 O2", b);
+    ASSERT_EQ(strcmp(a, b) != 0, 1, "compiler binary change, new key");
+    build_cache_key(SRC, sizeof(SRC) - 2, "forge 0.1.0 bin=1 O2", b);
+    ASSERT_EQ(strcmp(a, b) != 0, 1, "source change, new key");
+    /* Flags are NUL-terminated inside the hash: moving bytes across fails */
+    build_cache_key("2" "@c", 3, "forge O", a);
+    build_cache_key("@c", 2, "forge O2", b);
+    ASSERT_EQ(strcmp(a, b) != 0, 1, "flags and source do not run together");
+
+    char s1[64], s2[64];
+    build_cache_self_stamp("build/test_build_cache", s1, sizeof(s1));
+    build_cache_self_stamp(NULL, s2, sizeof(s2));
+    ASSERT_EQ(s1[0] != '\0', 1, "running binary found");
+    ASSERT_STR(s1, s2, "stamp is stable");
+}
+
+static void test_round_trip(void) {
+    printf("\ntest_round_trip\n");
+    Program *prog = parse_src(SRC);
+    ASSERT_EQ(prog != NULL, 1, "source parses and analyzes");
+    if (!prog) return;
+
+    char key[FORGE_CACHE_KEY_LEN + 1];
+    build_cache_key(SRC, sizeof(SRC) - 1, "test", key);
+    write_outputs("v1");
+    ASSERT_EQ(build_cache_lookup(_cache, key), 0, "miss before store");
+    ASSERT_EQ(build_cache_store(_cache, key, prog, _out, 1, ".wasm"), 0, "store");
+    ASSERT_EQ(build_cache_lookup(_cache, key), 1, "hit after store");
+
+    remove_outputs();
+    ASSERT_EQ(build_cache_restore(_cache, key, _out), 0, "restore");
+    char path[256];
+    long len = 0;
+    snprintf(path, sizeof(path), "%s/Counter.wasm", _out);
+    char *wasm = read_file(path, &len);
+    ASSERT_STR(wasm ? wasm : "(missing)", "v1", "outputs copied back");
+    free(wasm);
+
+    Program *back = build_cache_load_program(_cache, key, "Counter.cx");
+    ASSERT_EQ(back != NULL, 1, "summary loads");
+    if (!back) { ast_free_program(prog); return; }
+    ComponentNode *c = prog->components[0], *d = back->components[0];
+    ASSERT_EQ(back->component_count, 1, "one component");
+    ASSERT_STR(d->name, "Counter", "name");
+    ASSERT_STR(d->loc.filename, "Counter.cx", "filename from the caller");
+    ASSERT_EQ(d->prop_count, 2, "props");
+    ASSERT_EQ(d->state_count, 2, "state");
+    ASSERT_STR(d->state[0].init_expr ? d->state[0].init_expr : "(null)",
+               c->state[0].init_expr ? c->state[0].init_expr : "(null)", "state initializer");
+    ASSERT_EQ(d->handler_count, 1, "handler");
+    ASSERT_EQ(d->handlers[0].dep_mask, c->handlers[0].dep_mask, "handler dep mask");
+    ASSERT_EQ(d->computed[0].dep_mask, c->computed[0].dep_mask, "computed dep mask");
+    ASSERT_EQ(d->style_count, c->style_count, "style rules");
+    ASSERT_STR(d->template_root->tag, "div", "template root");
+    ASSERT_EQ(d->state_used_in_template[0], c->state_used_in_template[0], "reactivity flags");
+
+    /* Storing the loaded program again writes the identical summary */
+    char key2[FORGE_CACHE_KEY_LEN + 1];
+    build_cache_key(SRC, sizeof(SRC) - 1, "again", key2);
+    write_outputs("v1");
+    ASSERT_EQ(build_cache_store(_cache, key2, back, _out, 1, ".wasm"), 0, "store the reload");
+    long n1 = 0, n2 = 0;
+    snprintf(path, sizeof(path), "%s/%s/summary", _cache, key);
+    char *s1 = read_file(path, &n1);
+    snprintf(path, sizeof(path), "%s/%s/summary", _cache, key2);
+    char *s2 = read_file(path, &n2);
+    ASSERT_EQ(s1 && s2 && n1 == n2 && memcmp(s1, s2, (size_t)n1) == 0, 1,
+              "summary survives a round trip byte for byte");
+    free(s1);
+    free(s2);
+
+    ast_free_program(back);
+    ast_free_program(prog);
+}
+
+static void test_corrupt_entry(void) {
+    printf("\ntest_corrupt_entry\n");
+    char key[FORGE_CACHE_KEY_LEN + 1], path[256];
+    build_cache_key(SRC, sizeof(SRC) - 1, "test", key);
+    snprintf(path, sizeof(path), "%s/%s/summary", _cache, key);
+    long len = 0;
+    char *good = read_file(path, &len);
+    ASSERT_EQ(good != NULL && len > 8, 1, "entry from the round trip");
+    if (!good) return;
+
+    /* Every truncation of the summary is refused, not misread */
+    int loaded = 0;
+    for (long n = 0; n < len; n++) {
+        FILE *f = fopen(path, "wb");
+        fwrite(good, 1, (size_t)n, f);
+        fclose(f);
+        Program *p = build_cache_load_program(_cache, key, "Counter.cx");
+        if (p) { loaded++; ast_free_program(p); }
+    }
+    ASSERT_EQ(loaded, 0, "no truncated summary loads");
+
+    /* A huge count is bounded by the bytes left, not allocated */
+    char *bad = malloc((size_t)len);
+    memcpy(bad, good, (size_t)len);
+    memset(bad + 4, 0xff, 4);
+    FILE *f = fopen(path, "wb");
+    fwrite(bad, 1, (size_t)len, f);
+    fclose(f);
+    ASSERT_EQ(build_cache_load_program(_cache, key, "Counter.cx") == NULL, 1, "bad count refused");
+
+    memcpy(bad, good, (size_t)len);
+    bad[0] ^= 1;
+    f = fopen(path, "wb");
+    fwrite(bad, 1, (size_t)len, f);
+    fclose(f);
+    ASSERT_EQ(build_cache_load_program(_cache, key, "Counter.cx") == NULL, 1, "bad magic refused");
+    free(bad);
+
+    f = fopen(path, "wb");
+    fwrite(good, 1, (size_t)len, f);
+    fclose(f);
+    Program *p = build_cache_load_program(_cache, key, "Counter.cx");
+    ASSERT_EQ(p != NULL, 1, "restored summary loads again");
+    if (p) ast_free_program(p);
+    free(good);
+
+    /* An output missing from the entry fails the restore */
+    snprintf(path, sizeof(path), "%s/%s/Counter.forge.js", _cache, key);
+    unlink(path);
+    ASSERT_EQ(build_cache_restore(_cache, key, _out), -1, "missing output fails restore");
+}
+
+/* ─── Main ────────────────────────────────────────────────────────────────── */
+
+int main(void) {
+    printf("=== Forge Build Cache Tests ===\n");
+    snprintf(_dir, sizeof(_dir), "/tmp/forge-cache-test.XXXXXX");
+    if (!mkdtemp(_dir)) { perror("mkdtemp"); return 1; }
+    snprintf(_out, sizeof(_out), "%s/out", _dir);
+    snprintf(_cache, sizeof(_cache), "%s/cache", _dir);
+    mkdir(_out, 0755);
+
+    test_key();
+    test_round_trip();
+    test_corrupt_entry();
+
+    char cmd[128];
+    snprintf(cmd, sizeof(cmd), "rm -rf '%s'", _dir);
+    if (system(cmd) != 0) fprintf(stderr, "could not remove %s\n", _dir);
+
+    printf("\n══════════════════════════\n");
+    printf("  %d / %d tests passed\n", tests_passed, tests_run);
+
+    if (tests_passed == tests_run) {
+        printf("  \033[32mAll tests passed ✓\033[0m\n");
+        return 0;
+    } else {
+        printf("  \033[31m%d tests FAILED\033[0m\n", tests_run - tests_passed);
+        return 1;
+    }
+}
@@ -0,0 +1,287 @@
+/*
+ * Forge Stdlib — JSON Tests
+ * Run with: make test
+ *
+ * The tape parser (bound, kids arrays, member hash, views, escapes, syntax
+ * errors) and the one-off forge_json_get* readers, against the native
+ * build of forge_runtime.a.
+ */
+
+#include "../../stdlib/include/forge/http.h"
+#include "../../runtime/include/forge/web.h"
+#include "../../runtime/src/arena.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+void forge_runtime_init(void);
+
+static int tests_run    = 0;
+static int tests_passed = 0;
+
+#define ASSERT_EQ(a, b, msg) do {               \
+    tests_run++;                                 \
+    if ((a) == (b)) {                            \
+        tests_passed++;                          \
+        printf("  \033[32m✓\033[0m %s\n", msg); \
+    } else {                                     \
+        printf("  \033[31m✗\033[0m %s  (got %ld, want %ld)\n", msg, (long)(a), (long)(b)); \
+    }                                            \
+} while(0)
+
+#define ASSERT_STR(a, b, msg) do {              \
+    tests_run++;                                 \
+    if (strcmp(a, b) == 0) {                     \
+        tests_passed++;                          \
+        printf("  \033[32m✓\033[0m %s\n", msg); \
+    } else {                                     \
+        printf("  \033[31m✗\033[0m %s  (got '%s', want '%s')\n", msg, a, b); \
+    }                                            \
+} while(0)
+
+/* ─── Host Imports ────────────────────────────────────────────────────────── */
+
+void forge_dom_flush(const u32 *buf, u32 words) { (void)buf; (void)words; }
+void js_schedule_raf(void) {}
+void js_console_log(const char *msg, int len) { (void)msg; (void)len; }
+void js_console_log_int(const char *msg, int len, int v) { (void)msg; (void)len; (void)v; }
+void js_trap(const char *msg, int len) { (void)msg; (void)len; abort(); }
+
+/* ─── Helpers ─────────────────────────────────────────────────────────────── */
+
+static int parse(forge_json_doc_t *doc, const char *json) {
+    return forge_json_parse(doc, json, (u32)strlen(json));
+}
+
+/* String view `v` as a C string */
+static const char *view(const forge_json_doc_t *doc, forge_json_t v) {
+    static char buf[128];
+    u32 len;
+    const char *s = forge_json_str(doc, v, &len);
+    if (!s) return "(none)";
+    snprintf(buf, sizeof(buf), "%.*s", (int)len, s);
+    return buf;
+}
+
+/* ─── Test Cases ──────────────────────────────────────────────────────────── */
+
+static void test_tape_bound(void) {
+    printf("\ntest_tape_bound\n");
+    forge_json_doc_t doc;
+
+    /* One token per value, keys included: `{ : , :` bounds it exactly */
+    ASSERT_EQ(parse(&doc, "{\"a\":1,\"b\":2}"), 1, "flat object parses");
+    ASSERT_EQ(doc.tok_count, 5, "object + two keys + two values, the whole bound");
+    ASSERT_EQ(parse(&doc, "[1,2,3]"), 1, "flat array parses");
+    ASSERT_EQ(doc.tok_count, 4, "array + three elements, the whole bound");
+    ASSERT_EQ(parse(&doc, "  42  "), 1, "bare scalar parses");
+    ASSERT_EQ(doc.tok_count, 1, "scalar needs no structural byte");
+    ASSERT_EQ(parse(&doc, "[[],{},[[]]]"), 1, "empty containers parse");
+    ASSERT_EQ(doc.tok_count, 5, "five containers");
+
+    /* Long enough for the word-at-a-time count, with structural bytes at
+     * every alignment and inside strings */
+    char big[4096];
+    int  n = snprintf(big, sizeof(big), "[");
+    for (int i = 0; i < 200; i++)
+        n += snprintf(big + n, sizeof(big) - (size_t)n, "%s{\"k%d\":\"%.*s,:[{\"}", i ? "," : "",
+                      i, i % 9, "abcdefghi");
+    snprintf(big + n, sizeof(big) - (size_t)n, "]");
+    ASSERT_EQ(parse(&doc, big), 1, "200 objects parse");
+    ASSERT_EQ(doc.tok_count, 601, "array + 200 x (object, key, value)");
+    ASSERT_EQ(forge_json_len(&doc, forge_json_root(&doc)), 200, "200 elements");
+    forge_json_t last = forge_json_at(&doc, forge_json_root(&doc), 199);
+    ASSERT_STR(view(&doc, forge_json_find(&doc, last, "k199")), "a,:[{", "last element's value intact");
+}
+
+static void test_containers(void) {
+    printf("\ntest_containers\n");
+    forge_json_doc_t doc;
+    const char *json = "{\"list\":[10,[20,21],{\"x\":30},40],\"obj\":{\"list\":\"inner\"},\"e\":[]}";
+    ASSERT_EQ(parse(&doc, json), 1, "nested document parses");
+
+    forge_json_t root = forge_json_root(&doc);
+    forge_json_t list = forge_json_find(&doc, root, "list");
+    ASSERT_EQ(forge_json_type(&doc, list), FORGE_JSON_ARRAY, "list is an array");
+    ASSERT_EQ(forge_json_len(&doc, list), 4, "nested children not counted");
+    ASSERT_EQ(forge_json_int(&doc, forge_json_at(&doc, list, 0), 0), 10, "element 0");
+    ASSERT_EQ(forge_json_int(&doc, forge_json_at(&doc, forge_json_at(&doc, list, 1), 1), 0), 21,
+              "element 1 of the inner array");
+    ASSERT_EQ(forge_json_int(&doc, forge_json_find(&doc, forge_json_at(&doc, list, 2), "x"), 0), 30,
+              "member of an object element");
+    ASSERT_EQ(forge_json_int(&doc, forge_json_at(&doc, list, 3), 0), 40, "element after nested ones");
+    ASSERT_EQ(forge_json_at(&doc, list, 4), FORGE_JSON_NONE, "past the end");
+    ASSERT_EQ(forge_json_len(&doc, forge_json_find(&doc, root, "e")), 0, "empty array");
+
+    /* The same key in another object resolves to that object's value */
+    forge_json_t obj = forge_json_find(&doc, root, "obj");
+    ASSERT_STR(view(&doc, forge_json_find(&doc, obj, "list")), "inner", "lookup is per object");
+
+    forge_json_t key;
+    forge_json_t v = forge_json_member(&doc, root, 1, &key);
+    ASSERT_STR(view(&doc, key), "obj", "member 1 key in order");
+    ASSERT_EQ(v, obj, "member 1 value");
+    ASSERT_EQ(forge_json_member(&doc, root, 3, &key), FORGE_JSON_NONE, "member past the end");
+    ASSERT_EQ(key, FORGE_JSON_NONE, "and no key");
+}
+
+static void test_member_hash(void) {
+    printf("\ntest_member_hash\n");
+    forge_json_doc_t doc;
+    char json[8192];
+    int  n = snprintf(json, sizeof(json), "{");
+    for (int i = 0; i < 300; i++)
+        n += snprintf(json + n, sizeof(json) - (size_t)n, "%s\"key%d\":%d", i ? "," : "", i, i * 3);
+    snprintf(json + n, sizeof(json) - (size_t)n, ",\"key7\":-1}");
+    ASSERT_EQ(parse(&doc, json), 1, "300 members parse");
+
+    forge_json_t root = forge_json_root(&doc);
+    int wrong = 0;
+    for (int i = 0; i < 300; i++) {
+        char k[16];
+        snprintf(k, sizeof(k), "key%d", i);
+        if (forge_json_int(&doc, forge_json_find(&doc, root, k), -2) != (i == 7 ? -1 : i * 3)) wrong++;
+    }
+    ASSERT_EQ(wrong, 0, "every member found through the hash");
+    ASSERT_EQ(forge_json_int(&doc, forge_json_find(&doc, root, "key7"), 0), -1, "repeated key: last wins");
+    ASSERT_EQ(forge_json_find(&doc, root, "key300"), FORGE_JSON_NONE, "missing key");
+    ASSERT_EQ(forge_json_find_n(&doc, root, "key10", 4), forge_json_find(&doc, root, "key1"),
+              "find_n compares the given length");
+    ASSERT_EQ(forge_json_find(&doc, forge_json_find(&doc, root, "key1"), "x"), FORGE_JSON_NONE,
+              "find on a non-object");
+    ASSERT_EQ(forge_json_find(&doc, FORGE_JSON_NONE, "x"), FORGE_JSON_NONE, "find on NONE");
+}
+
+static void test_strings(void) {
+    printf("\ntest_strings\n");
+    forge_json_doc_t doc;
+    const char *json = "{\"plain\":\"hello\",\"esc\":\"a\\\"b\\\\c\\n\\u00e9\\ud83d\\ude00\",\"k\\\"q\":1}";
+    ASSERT_EQ(parse(&doc, json), 1, "escaped strings parse");
+
+    forge_json_t root = forge_json_root(&doc);
+    u32 len;
+    const char *s = forge_json_str(&doc, forge_json_find(&doc, root, "plain"), &len);
+    ASSERT_EQ(s == strstr(json, "hello"), 1, "view points into the input");
+    ASSERT_EQ(len, 5, "view length");
+
+    forge_json_t esc = forge_json_find(&doc, root, "esc");
+    ASSERT_STR(view(&doc, esc), "a\\\"b\\\\c\\n\\u00e9\\ud83d\\ude00", "view keeps escapes");
+    char out[64];
+    u32 n = forge_json_unescape(&doc, esc, out, sizeof(out));
+    ASSERT_STR(out, "a\"b\\c\n\xc3\xa9\xf0\x9f\x98\x80", "unescape decodes, surrogate pair included");
+    ASSERT_EQ(n, 12, "unescaped byte count");
+    n = forge_json_unescape(&doc, esc, out, 4);
+    ASSERT_STR(out, "a\"b", "unescape truncates to cap - 1");
+
+    ASSERT_EQ(forge_json_int(&doc, forge_json_find(&doc, root, "k\\\"q"), 0), 1, "keys compared as written");
+    ASSERT_EQ(forge_json_find(&doc, root, "k\"q"), FORGE_JSON_NONE, "not as decoded");
+}
+
+static void test_scalars(void) {
+    printf("\ntest_scalars\n");
+    forge_json_doc_t doc;
+    ASSERT_EQ(parse(&doc, "[-12, 3.5, 2e3, 1.5E-1, true, false, null, \"7\"]"), 1, "scalars parse");
+    forge_json_t a = forge_json_root(&doc);
+    ASSERT_EQ(forge_json_int(&doc, forge_json_at(&doc, a, 0), 0), -12, "negative int");
+    ASSERT_EQ(forge_json_num(&doc, forge_json_at(&doc, a, 1), 0) == 3.5, 1, "fraction");
+    ASSERT_EQ(forge_json_int(&doc, forge_json_at(&doc, a, 2), 0), 2000, "exponent as int");
+    ASSERT_EQ(forge_json_num(&doc, forge_json_at(&doc, a, 3), 0) > 0.1499 &&
+              forge_json_num(&doc, forge_json_at(&doc, a, 3), 0) < 0.1501, 1, "negative exponent");
+    ASSERT_EQ(forge_json_bool(&doc, forge_json_at(&doc, a, 4), -1), 1, "true");
+    ASSERT_EQ(forge_json_bool(&doc, forge_json_at(&doc, a, 5), -1), 0, "false");
+    ASSERT_EQ(forge_json_type(&doc, forge_json_at(&doc, a, 6)), FORGE_JSON_NULL, "null");
+    ASSERT_EQ(forge_json_int(&doc, forge_json_at(&doc, a, 7), 99), 99, "string is not a number");
+    ASSERT_EQ(forge_json_bool(&doc, FORGE_JSON_NONE, -1), -1, "NONE takes the default");
+}
+
+static void test_errors(void) {
+    printf("\ntest_errors\n");
+    forge_json_doc_t doc;
+
+    /* Every proper prefix of a document is truncated */
+    const char *full = "{\"a\":[1,2,{\"b\":\"x\\\"y\"}],\"c\":true,\"d\":null}";
+    char buf[128];
+    int accepted = 0;
+    for (size_t n = 0; n < strlen(full); n++) {
+        memcpy(buf, full, n);
+        accepted += forge_json_parse(&doc, buf, (u32)n);
+    }
+    ASSERT_EQ(accepted, 0, "no truncation of the document parses");
+    ASSERT_EQ(parse(&doc, full), 1, "the whole document does");
+
+    static const char *const bad[] = {
+        "", "{\"a\" 1}", "{\"a\":}", "[1,]", "[1 2]", "{,}", "{\"a\":1,}", "tru", "nul",
+        "[\"open", "{} x", "[1]]", "{\"a\":1]", "[}", "{1:2}",
+    };
+    int rejected = 0;
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) rejected += !parse(&doc, bad[i]);
+    ASSERT_EQ(rejected, (int)(sizeof(bad) / sizeof(bad[0])), "malformed inputs rejected");
+
+    char deep[2 * FORGE_JSON_MAX_DEPTH + 8];
+    memset(deep, '[', FORGE_JSON_MAX_DEPTH);
+    memset(deep + FORGE_JSON_MAX_DEPTH, ']', FORGE_JSON_MAX_DEPTH);
+    deep[2 * FORGE_JSON_MAX_DEPTH] = 0;
+    ASSERT_EQ(parse(&doc, deep), 1, "nesting at the depth limit parses");
+    memmove(deep + 1, deep, 2 * FORGE_JSON_MAX_DEPTH + 1);
+    deep[0] = '[';
+    strcat(deep, "]");
+    ASSERT_EQ(parse(&doc, deep), 0, "one deeper is rejected");
+}
+
+static void test_string_helpers(void) {
+    printf("\ntest_string_helpers\n");
+    const char *json = "{ \"skip\": {\"name\": \"no\", \"n\": [1, {\"x\": \"}\"}]}, "
+                       "\"name\": \"Forge \\u00e9\", \"count\": 42, \"flag\": true, \"count\": 7 }";
+
+    size_t used = arena_used(&g_render_arena);
+    const char *v = forge_json_get(json, "count");
+    ASSERT_EQ(v != NULL && strncmp(v, "42", 2) == 0, 1, "get points at the value");
+    ASSERT_EQ(arena_used(&g_render_arena), used, "get allocates nothing");
+    ASSERT_EQ(forge_json_get_int(json, "count", -1), 42, "get_int, first occurrence");
+    ASSERT_EQ(forge_json_get_int(json, "flag", -1), -1, "get_int on a bool takes the default");
+    ASSERT_EQ(forge_json_get_int(json, "missing", -1), -1, "get_int on a missing key");
+    ASSERT_EQ(forge_json_get(json, "n"), NULL, "nested keys are not top-level");
+    const char *name = forge_json_get_str(json, "name");
+    ASSERT_STR(name ? name : "(null)", "Forge \xc3\xa9", "get_str skips a nested object and unescapes");
+    ASSERT_EQ(forge_json_get_str(json, "count"), NULL, "get_str on a number");
+    ASSERT_EQ(forge_json_get(json, "\"name"), NULL, "key must match whole");
+    ASSERT_EQ(forge_json_get("{\"a\":1", "b"), NULL, "truncated object misses");
+
+    used = arena_used(&g_render_arena);
+    const char *arr = " [ \"a,]\", [1, 2], {\"k\": [3]}, 4 ] ";
+    ASSERT_EQ(forge_json_array_len(arr), 4, "array_len skips nested values");
+    ASSERT_EQ(forge_json_array_len("[]"), 0, "empty array");
+    ASSERT_EQ(forge_json_array_len("[1, 2"), 0, "truncated array counts 0");
+    ASSERT_EQ(forge_json_array_len("{}"), 0, "not an array");
+    const char *item = forge_json_array_item(arr, 2);
+    ASSERT_EQ(item != NULL && strncmp(item, "{\"k\"", 4) == 0, 1, "array_item finds element 2");
+    ASSERT_EQ(forge_json_array_item(arr, 4), NULL, "array_item past the end");
+    ASSERT_EQ(forge_json_array_item(arr, -1), NULL, "negative index");
+    ASSERT_EQ(arena_used(&g_render_arena), used, "array helpers allocate nothing");
+}
+
+/* ─── Main ────────────────────────────────────────────────────────────────── */
+
+int main(void) {
+    printf("=== Forge JSON Tests ===\n");
+    forge_runtime_init();
+
+    test_tape_bound();
+    test_containers();
+    test_member_hash();
+    test_strings();
+    test_scalars();
+    test_errors();
+    test_string_helpers();
+
+    printf("\n══════════════════════════\n");
+    printf("  %d / %d tests passed\n", tests_passed, tests_run);
+
+    if (tests_passed == tests_run) {
+        printf("  \033[32mAll tests passed ✓\033[0m\n");
+        return 0;
+    } else {
+        printf("  \033[31m%d tests FAILED\033[0m\n", tests_run - tests_passed);
+        return 1;
+    }
+}
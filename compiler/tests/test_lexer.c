@@ -97,8 +97,47 @@ static void test_string_literal(void) {
 
     Token t = lexer_next(&lex);
     ASSERT_EQ(t.type, TOK_STRING_LIT, "string literal token");
-    ASSERT_STR(t.value.str_val, "hello\nworld", "escape sequence decoded");
-    free(t.value.str_val);
+    ASSERT_EQ(t.length, strlen(src), "token spans the raw literal");
+    char buf[32];
+    ASSERT_EQ(lexer_string_value(&t, buf), 11, "decoded length");
+    ASSERT_STR(buf, "hello\nworld", "escape sequence decoded");
+}
+
+static void test_keywords(void) {
+    printf("\ntest_keywords\n");
+    static const struct { const char *word; TokenType type; } kw[] = {
+        { "int", TOK_INT },       { "char", TOK_CHAR },         { "bool", TOK_BOOL },
+        { "float", TOK_FLOAT },   { "double", TOK_DOUBLE },     { "void", TOK_VOID },
+        { "long", TOK_LONG },     { "short", TOK_SHORT },       { "unsigned", TOK_UNSIGNED },
+        { "signed", TOK_SIGNED }, { "struct", TOK_STRUCT },     { "enum", TOK_ENUM },
+        { "const", TOK_CONST },   { "static", TOK_STATIC },     { "extern", TOK_EXTERN },
+        { "inline", TOK_INLINE }, { "typedef", TOK_TYPEDEF },   { "sizeof", TOK_SIZEOF },
+        { "if", TOK_IF },         { "else", TOK_ELSE },         { "for", TOK_FOR },
+        { "while", TOK_WHILE },   { "do", TOK_DO },             { "return", TOK_RETURN },
+        { "break", TOK_BREAK },   { "continue", TOK_CONTINUE }, { "switch", TOK_SWITCH },
+        { "case", TOK_CASE },     { "default", TOK_DEFAULT },   { "true", TOK_TRUE },
+        { "false", TOK_FALSE },   { "NULL", TOK_NULL },         { "null", TOK_NULL },
+        { "include", TOK_INCLUDE },
+        /* directives only after '@'; bare, they are identifiers */
+        { "@component", TOK_AT_COMPONENT }, { "@props", TOK_AT_PROPS },
+        { "@state", TOK_AT_STATE },         { "@style", TOK_AT_STYLE },
+        { "@template", TOK_AT_TEMPLATE },   { "@on", TOK_AT_ON },
+        { "@computed", TOK_AT_COMPUTED },   { "state", TOK_IDENT },
+        /* near misses hash to keyword slots but must not match */
+        { "integer", TOK_IDENT }, { "Int", TOK_IDENT }, { "@int", TOK_IDENT },
+        { "nul", TOK_IDENT },     { "x", TOK_IDENT },   { "components", TOK_IDENT },
+    };
+    int all = 1;
+    for (size_t i = 0; i < sizeof(kw) / sizeof(kw[0]); i++) {
+        Lexer lex;
+        lexer_init(&lex, kw[i].word, "test");
+        Token t = lexer_next(&lex);
+        if (t.type != kw[i].type) {
+            printf("  \033[31m✗\033[0m %s  (got %s)\n", kw[i].word, token_type_name(t.type));
+            all = 0;
+        }
+    }
+    ASSERT_EQ(all, 1, "every keyword maps to its token, near misses to IDENT");
 }
 
 static void test_operators(void) {
@@ -169,6 +208,7 @@ int main(void) {
     test_basic_tokens();
     test_forge_directives();
     test_string_literal();
+    test_keywords();
     test_operators();
     test_comments();
     test_line_numbers();
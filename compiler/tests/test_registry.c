@@ -0,0 +1,206 @@
+/*
+ * Forge Runtime — Context Registry Tests
+ * Run with: make test
+ *
+ * Links the native build of forge_runtime.a, so the el_id table, its
+ * backward-shift deletion, the generation-tagged handles and the dirty
+ * queue of pooled contexts run as they do in WASM.
+ */
+
+#include "../../runtime/include/forge/web.h"
+#include "../../runtime/src/registry.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+void forge_runtime_init(void);
+
+static int tests_run    = 0;
+static int tests_passed = 0;
+
+#define ASSERT_EQ(a, b, msg) do {               \
+    tests_run++;                                 \
+    if ((a) == (b)) {                            \
+        tests_passed++;                          \
+        printf("  \033[32m✓\033[0m %s\n", msg); \
+    } else {                                     \
+        printf("  \033[31m✗\033[0m %s  (got %ld, want %ld)\n", msg, (long)(a), (long)(b)); \
+    }                                            \
+} while(0)
+
+/* ─── Host Imports ────────────────────────────────────────────────────────── */
+
+void forge_dom_flush(const u32 *buf, u32 words) { (void)buf; (void)words; }
+void js_schedule_raf(void) {}
+void js_console_log(const char *msg, int len) { (void)msg; (void)len; }
+void js_console_log_int(const char *msg, int len, int v) { (void)msg; (void)len; (void)v; }
+void js_trap(const char *msg, int len) { (void)msg; (void)len; abort(); }
+
+/* ─── Helpers ─────────────────────────────────────────────────────────────── */
+
+/* Home bucket of an el_id while the table has its initial size (two
+ * buckets per slot), matching home() in registry.c */
+static u32 initial_home(u32 el_id) {
+    u32 shift = 32;
+    for (u32 n = 2 * FORGE_REGISTRY_INIT_CAP; n > 1; n >>= 1) shift--;
+    return (el_id * 2654435769u) >> shift;
+}
+
+static forge_ctx_t _ctxs[64];
+
+/* ─── Test Cases ──────────────────────────────────────────────────────────── */
+
+static void test_cluster_delete(void) {
+    printf("\ntest_cluster_delete\n");
+    registry_init();
+
+    /* Six ids sharing one home bucket, then two homed on the next bucket:
+     * one probe run of eight, with the run's tail displaced past its home */
+    u32 ids[8];
+    u32 home = initial_home(1), n = 0;
+    for (u32 id = 1; n < 6; id++)
+        if (initial_home(id) == home) ids[n++] = id;
+    for (u32 id = 1; n < 8; id++)
+        if (initial_home(id) == ((home + 1) & (2 * FORGE_REGISTRY_INIT_CAP - 1))) ids[n++] = id;
+
+    for (u32 i = 0; i < 8; i++) registry_set(ids[i], &_ctxs[i]);
+    ASSERT_EQ(registry_count(), 8, "eight contexts registered");
+    ASSERT_EQ(registry_capacity(), FORGE_REGISTRY_INIT_CAP, "no growth, shared buckets");
+
+    /* Delete from the head, the middle and the displaced tail */
+    registry_remove(ids[0]);
+    registry_remove(ids[3]);
+    registry_remove(ids[6]);
+    ASSERT_EQ(registry_count(), 5, "three removed");
+
+    int found = 0, gone = 0;
+    for (u32 i = 0; i < 8; i++) {
+        forge_ctx_t *c = registry_get(ids[i]);
+        if (i == 0 || i == 3 || i == 6) gone += c == NULL;
+        else found += c == &_ctxs[i];
+    }
+    ASSERT_EQ(found, 5, "every later key in the run still found");
+    ASSERT_EQ(gone, 3, "removed keys miss");
+
+    /* Reinsert into the shifted run and remove the rest */
+    registry_set(ids[3], &_ctxs[3]);
+    ASSERT_EQ(registry_get(ids[3]) == &_ctxs[3], 1, "reinserted key found");
+    for (u32 i = 0; i < 8; i++) registry_remove(ids[i]);
+    ASSERT_EQ(registry_count(), 0, "run emptied");
+    ASSERT_EQ(registry_get(ids[7]) == NULL, 1, "tail misses after emptying");
+}
+
+static void test_churn_matches_model(void) {
+    printf("\ntest_churn_matches_model\n");
+    registry_init();
+
+    /* Random set/remove over a small id space against a flat model,
+     * crossing several growths */
+    enum { IDS = 3000, STEPS = 200000 };
+    static forge_ctx_t model_ctx[IDS];
+    static int live[IDS];
+    memset(live, 0, sizeof(live));
+    u32 rng = 0x9e3779b9u;
+    int mismatches = 0, count = 0;
+    for (int step = 0; step < STEPS; step++) {
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        u32 id = rng % IDS;
+        if (live[id] && (rng >> 16) % 3 == 0) {
+            registry_remove(id + 1);
+            live[id] = 0;
+            count--;
+        } else if (!live[id]) {
+            registry_set(id + 1, &model_ctx[id]);
+            live[id] = 1;
+            count++;
+        }
+        u32 probe = (rng >> 8) % IDS;
+        if ((registry_get(probe + 1) != NULL) != live[probe]) mismatches++;
+    }
+    for (u32 id = 0; id < IDS; id++)
+        if (registry_get(id + 1) != (live[id] ? &model_ctx[id] : NULL)) mismatches++;
+    ASSERT_EQ(mismatches, 0, "lookups agree with the model throughout");
+    ASSERT_EQ(registry_count(), count, "count agrees with the model");
+}
+
+static void test_stale_handle(void) {
+    printf("\ntest_stale_handle\n");
+    registry_init();
+
+    u32 h1 = registry_set(7, &_ctxs[0]);
+    ASSERT_EQ(registry_resolve(h1) == &_ctxs[0], 1, "fresh handle resolves");
+    ASSERT_EQ(registry_set(7, &_ctxs[0]), h1, "re-registering keeps the handle");
+
+    registry_remove(7);
+    ASSERT_EQ(registry_resolve(h1) == NULL, 1, "handle misses after removal");
+
+    /* The freed slot is reused by the next registration */
+    u32 h2 = registry_set(8, &_ctxs[1]);
+    ASSERT_EQ(h2 & ((1u << FORGE_HANDLE_INDEX_BITS) - 1),
+              h1 & ((1u << FORGE_HANDLE_INDEX_BITS) - 1), "slot reused");
+    ASSERT_EQ(h2 != h1, 1, "new generation, new handle");
+    ASSERT_EQ(registry_resolve(h1) == NULL, 1, "stale handle rejected after reuse");
+    ASSERT_EQ(registry_resolve(h2) == &_ctxs[1], 1, "new handle resolves");
+    ASSERT_EQ(registry_resolve(0) == NULL, 1, "handle 0 resolves to nothing");
+}
+
+static forge_ctx_t *_updated[8];
+static u32          _update_calls;
+
+static void count_update(forge_ctx_t *ctx, u32 dirty) {
+    (void)dirty;
+    if (_update_calls < 8) _updated[_update_calls] = ctx;
+    _update_calls++;
+}
+
+static void test_freed_ctx_unqueued(void) {
+    printf("\ntest_freed_ctx_unqueued\n");
+    u32 type = forge_register_update_fn(count_update);
+
+    forge_ctx_t *a = forge_ctx_new(1, 4, 4), *b = forge_ctx_new(2, 4, 4);
+    a->type_id = b->type_id = type;
+    forge_schedule_update(a);
+    forge_schedule_update(b);
+    forge_ctx_free(a);
+
+    /* The pool hands a's slot straight back */
+    forge_ctx_t *c = forge_ctx_new(3, 4, 4);
+    ASSERT_EQ(c == a, 1, "freed slot reused");
+    c->type_id = type;
+    _update_calls = 0;
+    forge_flush_updates();
+    ASSERT_EQ(_update_calls, 1, "only the still-queued context updates");
+    ASSERT_EQ(_updated[0] == b, 1, "and it is b");
+
+    forge_schedule_update(c);
+    _update_calls = 0;
+    forge_flush_updates();
+    ASSERT_EQ(_update_calls, 1, "the new context queues normally");
+    ASSERT_EQ(_updated[0] == c, 1, "and updates once");
+
+    forge_ctx_free(b);
+    forge_ctx_free(c);
+}
+
+/* ─── Main ────────────────────────────────────────────────────────────────── */
+
+int main(void) {
+    printf("=== Forge Registry Tests ===\n");
+    forge_runtime_init();
+
+    test_cluster_delete();
+    test_churn_matches_model();
+    test_stale_handle();
+    test_freed_ctx_unqueued();
+
+    printf("\n══════════════════════════\n");
+    printf("  %d / %d tests passed\n", tests_passed, tests_run);
+
+    if (tests_passed == tests_run) {
+        printf("  \033[32mAll tests passed ✓\033[0m\n");
+        return 0;
+    } else {
+        printf("  \033[31m%d tests FAILED\033[0m\n", tests_run - tests_passed);
+        return 1;
+    }
+}
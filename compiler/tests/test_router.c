@@ -0,0 +1,189 @@
+/*
+ * Forge Stdlib — Router Tests
+ * Run with: make test
+ *
+ * Matches paths against the segment trie built from a fixed route table:
+ * literal over parameter over wildcard at each segment, backtracking when
+ * a more specific branch dead-ends, and hover prefetch.
+ */
+
+#include "../../stdlib/include/forge/router.h"
+#include "../../runtime/include/forge/web.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void forge_runtime_init(void);
+
+static int tests_run    = 0;
+static int tests_passed = 0;
+
+#define ASSERT_EQ(a, b, msg) do {               \
+    tests_run++;                                 \
+    if ((a) == (b)) {                            \
+        tests_passed++;                          \
+        printf("  \033[32m✓\033[0m %s\n", msg); \
+    } else {                                     \
+        printf("  \033[31m✗\033[0m %s  (got %ld, want %ld)\n", msg, (long)(a), (long)(b)); \
+    }                                            \
+} while(0)
+
+#define ASSERT_STR(a, b, msg) do {              \
+    tests_run++;                                 \
+    if (strcmp(a, b) == 0) {                     \
+        tests_passed++;                          \
+        printf("  \033[32m✓\033[0m %s\n", msg); \
+    } else {                                     \
+        printf("  \033[31m✗\033[0m %s  (got '%s', want '%s')\n", msg, a, b); \
+    }                                            \
+} while(0)
+
+/* ─── Host Imports ────────────────────────────────────────────────────────── */
+
+static u32 _loaded_url, _loaded_len, _loads;
+
+void forge_dom_flush(const u32 *buf, u32 words) { (void)buf; (void)words; }
+void js_schedule_raf(void) {}
+void js_console_log(const char *msg, int len) { (void)msg; (void)len; }
+void js_console_log_int(const char *msg, int len, int v) { (void)msg; (void)len; (void)v; }
+void js_trap(const char *msg, int len) { (void)msg; (void)len; abort(); }
+void js_router_listen(u32 mode) { (void)mode; }
+void js_router_push(u32 path_ptr, u32 path_len, u32 mode) { (void)path_ptr; (void)path_len; (void)mode; }
+void js_router_go(i32 delta) { (void)delta; }
+void js_router_load(u32 url_ptr, u32 url_len) { _loaded_url = url_ptr; _loaded_len = url_len; _loads++; }
+
+/* ─── Helpers ─────────────────────────────────────────────────────────────── */
+
+/* Only matched, never dispatched: results are told apart by pattern */
+static void handler(const forge_route_t *route, void *userdata) { (void)route; (void)userdata; }
+
+static const char *match(const char *path, forge_route_t *route) {
+    if (!forge_router_match(path, (u32)strlen(path), route)) return "(none)";
+    return route->pattern;
+}
+
+/* Capture `name` of the last match as a C string, "(unset)" if missing */
+static const char *param(const forge_route_t *route, const char *name) {
+    static char buf[64];
+    u32 len = 0;
+    const char *v = forge_route_param(route, name, &len);
+    if (!v) return "(unset)";
+    snprintf(buf, sizeof(buf), "%.*s", (int)len, v);
+    return buf;
+}
+
+static void add_routes(void) {
+    forge_router_init(FORGE_ROUTER_HISTORY);
+    forge_router_add("/",                       handler, NULL);
+    forge_router_add("/about",                  handler, NULL);
+    forge_router_add("/users/new",              handler, NULL);
+    forge_router_add("/users/:id",              handler, NULL);
+    forge_router_add("/users/:id/posts",        handler, NULL);
+    forge_router_add("/users/admin/settings",   handler, NULL);
+    forge_router_add("/docs/:section/intro",    handler, NULL);
+    forge_router_add("/docs/*",                 handler, NULL);
+    forge_router_add("/files/*path",            handler, NULL);
+    forge_router_start();
+}
+
+/* ─── Test Cases ──────────────────────────────────────────────────────────── */
+
+static void test_literal_over_param(void) {
+    printf("\ntest_literal_over_param\n");
+    forge_route_t r;
+    ASSERT_STR(match("/", &r), "/", "root");
+    ASSERT_STR(match("/about/", &r), "/about", "trailing slash ignored");
+    ASSERT_STR(match("/users/new", &r), "/users/new", "literal beats :id");
+    ASSERT_STR(match("/users/42", &r), "/users/:id", "param matches any segment");
+    ASSERT_STR(param(&r, "id"), "42", "id captured");
+    ASSERT_EQ(r.param_count, 1, "one capture");
+}
+
+static void test_backtracking(void) {
+    printf("\ntest_backtracking\n");
+    forge_route_t r;
+    /* "admin" is a literal child with no route of its own */
+    ASSERT_STR(match("/users/admin", &r), "/users/:id", "dead literal falls back to :id");
+    ASSERT_STR(param(&r, "id"), "admin", "id is the literal text");
+    ASSERT_STR(match("/users/admin/posts", &r), "/users/:id/posts",
+               "literal branch fails deeper, param branch matches");
+    ASSERT_STR(param(&r, "id"), "admin", "capture from the param branch");
+    ASSERT_STR(match("/users/admin/settings", &r), "/users/admin/settings", "full literal route");
+    ASSERT_EQ(r.param_count, 0, "no captures left over from failed branches");
+    ASSERT_STR(match("/users/1/posts/extra", &r), "(none)", "no route past a leaf");
+    ASSERT_STR(match("/nowhere", &r), "(none)", "unknown path misses");
+}
+
+static void test_wildcard_priority(void) {
+    printf("\ntest_wildcard_priority\n");
+    forge_route_t r;
+    ASSERT_STR(match("/docs/api/intro", &r), "/docs/:section/intro", "param beats wildcard");
+    ASSERT_STR(param(&r, "section"), "api", "section captured");
+    ASSERT_STR(match("/docs/api/other", &r), "/docs/*", "wildcard after param dead-ends");
+    ASSERT_STR(param(&r, "rest"), "api/other", "bare * is named rest");
+    ASSERT_STR(param(&r, "section"), "(unset)", "abandoned capture dropped");
+    ASSERT_STR(match("/docs", &r), "/docs/*", "wildcard matches an empty rest");
+    ASSERT_STR(param(&r, "rest"), "", "empty rest");
+    ASSERT_STR(match("/files/a/b/c.txt", &r), "/files/*path", "wildcard takes the rest");
+    ASSERT_STR(param(&r, "path"), "a/b/c.txt", "named wildcard capture");
+}
+
+static const char *_prefetched;
+
+static void prefetch_user(const forge_route_t *route, void *userdata) {
+    static char id[64];
+    snprintf(id, sizeof(id), "%s", param(route, "id"));
+    *(const char **)userdata = id;
+}
+
+static void test_prefetch(void) {
+    printf("\ntest_prefetch\n");
+    static char path[32]; /* a host block: the hover entry point takes u32 */
+    if ((uintptr_t)path > UINT32_MAX) {
+        printf("  - skipped: path buffer above 4 GB on this host\n");
+        return;
+    }
+
+    static const char chunk[] = "user.wasm";
+    forge_router_add("/profile/:id", handler, &_prefetched);
+    forge_router_prefetch("/profile/:id", chunk, prefetch_user);
+
+    strcpy(path, "/profile/7");
+    ASSERT_EQ(forge_router_hover((u32)(uintptr_t)path, (u32)strlen(path)), 1, "hover finds the route");
+    ASSERT_EQ(_loads, 1, "chunk load started");
+    ASSERT_EQ(_loaded_url, (u32)(uintptr_t)chunk, "chunk URL passed");
+    ASSERT_EQ(_loaded_len, 9, "chunk URL length");
+    ASSERT_STR(_prefetched ? _prefetched : "(none)", "7", "prefetch got the captures");
+
+    strcpy(path, "/about");
+    ASSERT_EQ(forge_router_hover((u32)(uintptr_t)path, (u32)strlen(path)), 1, "route without prefetch");
+    ASSERT_EQ(_loads, 1, "nothing loaded for it");
+
+    strcpy(path, "/nowhere");
+    ASSERT_EQ(forge_router_hover((u32)(uintptr_t)path, (u32)strlen(path)), 0, "hover misses");
+}
+
+/* ─── Main ────────────────────────────────────────────────────────────────── */
+
+int main(void) {
+    printf("=== Forge Router Tests ===\n");
+    forge_runtime_init();
+    add_routes();
+
+    test_literal_over_param();
+    test_backtracking();
+    test_wildcard_priority();
+    test_prefetch();
+
+    printf("\n══════════════════════════\n");
+    printf("  %d / %d tests passed\n", tests_passed, tests_run);
+
+    if (tests_passed == tests_run) {
+        printf("  \033[32mAll tests passed ✓\033[0m\n");
+        return 0;
+    } else {
+        printf("  \033[31m%d tests FAILED\033[0m\n", tests_run - tests_passed);
+        return 1;
+    }
+}
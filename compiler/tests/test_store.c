@@ -0,0 +1,271 @@
+/*
+ * Forge Stdlib — Store Tests
+ * Run with: make test
+ *
+ * Slice-masked subscriptions against real pooled contexts and the dirty
+ * queue, selector caching on slice versions, and commits without a
+ * matching begin, against the native build of forge_runtime.a.
+ */
+
+#include "../../stdlib/include/forge/store.h"
+#include "../../runtime/include/forge/web.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+void forge_runtime_init(void);
+
+static int tests_run    = 0;
+static int tests_passed = 0;
+
+#define ASSERT_EQ(a, b, msg) do {               \
+    tests_run++;                                 \
+    if ((a) == (b)) {                            \
+        tests_passed++;                          \
+        printf("  \033[32m✓\033[0m %s\n", msg); \
+    } else {                                     \
+        printf("  \033[31m✗\033[0m %s  (got %ld, want %ld)\n", msg, (long)(a), (long)(b)); \
+    }                                            \
+} while(0)
+
+/* ─── Host Imports ────────────────────────────────────────────────────────── */
+
+void forge_dom_flush(const u32 *buf, u32 words) { (void)buf; (void)words; }
+void js_schedule_raf(void) {}
+void js_console_log(const char *msg, int len) { (void)msg; (void)len; }
+void js_console_log_int(const char *msg, int len, int v) { (void)msg; (void)len; (void)v; }
+void js_trap(const char *msg, int len) { (void)msg; (void)len; abort(); }
+
+/* ─── Helpers ─────────────────────────────────────────────────────────────── */
+
+typedef struct {
+    int  count;
+    char user[16];
+    int  undeclared;   /* in no slice */
+} AppStore;
+
+enum { SUBS = 300 };
+
+static forge_ctx_t *_ctx[SUBS];
+static int          _updated[SUBS];
+static u32          _type;
+
+static void count_update(forge_ctx_t *ctx, u32 dirty) {
+    (void)dirty;
+    for (int i = 0; i < SUBS; i++)
+        if (_ctx[i] == ctx) _updated[i]++;
+}
+
+/* Flush the dirty queue; how many of the contexts with index % 3 == k
+ * updated, per k */
+static void flush(int out[3]) {
+    memset(_updated, 0, sizeof(_updated));
+    forge_flush_updates();
+    out[0] = out[1] = out[2] = 0;
+    for (int i = 0; i < SUBS; i++) out[i % 3] += _updated[i];
+}
+
+static int _selects;
+
+static forge_val_t select_count(const void *data) {
+    _selects++;
+    return forge_val_int(((const AppStore *)data)->count);
+}
+
+static forge_val_t select_all(const void *data) {
+    _selects++;
+    return forge_val_int(((const AppStore *)data)->count + ((const AppStore *)data)->user[0]);
+}
+
+/* ─── Test Cases ──────────────────────────────────────────────────────────── */
+
+static void test_masked_subscribe(void) {
+    printf("\ntest_masked_subscribe\n");
+    forge_store_t *s = forge_store_create(sizeof(AppStore));
+    u32 COUNT = forge_store_slice(s, FORGE_STORE_FIELD(AppStore, count));
+    u32 USER  = forge_store_slice(s, FORGE_STORE_FIELD(AppStore, user));
+    AppStore *d = forge_store_get(s);
+
+    /* By index % 3: reads count, reads user, reads everything */
+    for (int i = 0; i < SUBS; i++) {
+        _ctx[i] = forge_ctx_new((u32)i + 1, 4, 4);
+        _ctx[i]->type_id = _type;
+        forge_ctx_register(_ctx[i], (u32)i + 1);
+        if (i % 3 == 2) forge_store_subscribe(s, _ctx[i]);
+        else forge_store_subscribe_mask(s, _ctx[i], i % 3 == 0 ? COUNT : USER);
+    }
+    int n[3];
+
+    forge_store_begin(s);
+    d->count++;
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(n[0], SUBS / 3, "count readers updated");
+    ASSERT_EQ(n[1], 0, "user readers skipped");
+    ASSERT_EQ(n[2], SUBS / 3, "subscribe-all updated");
+
+    forge_store_begin(s);
+    d->count = d->count;
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(n[0] + n[1] + n[2], 0, "no change, nothing scheduled");
+    ASSERT_EQ(s->version, 1, "and no version bump");
+
+    /* Nested: only the outermost commit notifies, with both changes */
+    forge_store_begin(s);
+    strcpy(d->user, "ada");
+    forge_store_begin(s);
+    d->count++;
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(n[0] + n[1] + n[2], 0, "inner commit is silent");
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(n[0] + n[1], 2 * SUBS / 3, "outer commit reaches both slices");
+
+    forge_store_begin(s);
+    forge_store_touch(s, USER);
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(n[1], SUBS / 3, "touched slice notifies");
+    ASSERT_EQ(n[0], 0, "untouched slice does not");
+
+    forge_store_begin(s);
+    d->undeclared = 7;
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(n[0] + n[1] + n[2], SUBS, "undeclared bytes count as every slice");
+
+    /* A freed context is dropped, not scheduled */
+    forge_ctx_unregister(1);
+    forge_ctx_free(_ctx[0]);
+    _ctx[0] = 0;
+    forge_store_begin(s);
+    d->count++;
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(n[0], SUBS / 3 - 1, "live count readers updated");
+    ASSERT_EQ(s->sub_count, SUBS - 1, "freed subscriber removed");
+
+    forge_store_unsubscribe(s, _ctx[3]);
+    forge_store_subscribe_mask(s, _ctx[6], USER);
+    forge_store_begin(s);
+    d->count++;
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(n[0], SUBS / 3 - 3, "unsubscribed and re-masked contexts skipped");
+
+    for (int i = 1; i < SUBS; i++) {
+        forge_ctx_unregister((u32)i + 1);
+        forge_ctx_free(_ctx[i]);
+        _ctx[i] = 0;
+    }
+    forge_store_free(s);
+}
+
+static void test_selector_cache(void) {
+    printf("\ntest_selector_cache\n");
+    forge_store_t *s = forge_store_create(sizeof(AppStore));
+    u32 COUNT = forge_store_slice(s, FORGE_STORE_FIELD(AppStore, count));
+    forge_store_slice(s, FORGE_STORE_FIELD(AppStore, user));
+    AppStore *d = forge_store_get(s);
+
+    _selects = 0;
+    forge_store_select_mask(s, select_count, COUNT);
+    forge_store_select_mask(s, select_count, COUNT);
+    forge_store_select(s, select_all);
+    ASSERT_EQ(_selects, 2, "each selector computed once");
+
+    forge_store_begin(s);
+    strcpy(d->user, "b");
+    forge_store_commit(s);
+    _selects = 0;
+    forge_store_select_mask(s, select_count, COUNT);
+    ASSERT_EQ(_selects, 0, "other slice changed: cached");
+    ASSERT_EQ(forge_store_select(s, select_all).v.i, 'b', "all-slices selector recomputed");
+    ASSERT_EQ(_selects, 1, "once");
+
+    forge_store_begin(s);
+    d->count = 41;
+    forge_store_commit(s);
+    _selects = 0;
+    ASSERT_EQ(forge_store_select_mask(s, select_count, COUNT).v.i, 41, "own slice changed: new value");
+    ASSERT_EQ(_selects, 1, "recomputed");
+    forge_store_select_mask(s, select_count, COUNT);
+    ASSERT_EQ(_selects, 1, "then cached again");
+
+    /* Writes outside a transaction are not seen until a commit says so */
+    d->count = 42;
+    ASSERT_EQ(forge_store_select_mask(s, select_count, COUNT).v.i, 41, "uncommitted write invisible");
+    forge_store_touch(s, COUNT);
+    forge_store_commit(s);
+    ASSERT_EQ(forge_store_select_mask(s, select_count, COUNT).v.i, 42, "touch + commit invalidates");
+    forge_store_free(s);
+}
+
+static void test_unbalanced_commit(void) {
+    printf("\ntest_unbalanced_commit\n");
+    forge_store_t *s = forge_store_create(sizeof(AppStore));
+    u32 COUNT = forge_store_slice(s, FORGE_STORE_FIELD(AppStore, count));
+    u32 USER  = forge_store_slice(s, FORGE_STORE_FIELD(AppStore, user));
+    AppStore *d = forge_store_get(s);
+    forge_ctx_t *reader = forge_ctx_new(1000, 4, 4);
+    reader->type_id = _type;
+    forge_store_subscribe_mask(s, reader, COUNT);
+    _ctx[0] = reader;
+    int n[3];
+
+    forge_store_begin(s);
+    d->count = 1;
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(n[0], 1, "balanced commit notifies");
+    ASSERT_EQ(s->version, 1, "version 1");
+
+    /* The snapshot still predates count = 1: comparing would re-report it */
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(n[0], 0, "bare commit re-reports nothing");
+    ASSERT_EQ(s->version, 1, "version unchanged");
+    ASSERT_EQ(s->transaction, 0, "depth stays 0");
+
+    forge_store_touch(s, USER);
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(s->slice_version[1], 2, "touched slice bumped");
+    ASSERT_EQ(s->slice_version[0], 1, "untouched slice not");
+    ASSERT_EQ(n[0], 0, "count reader not scheduled");
+
+    forge_store_begin(s);
+    d->count = 2;
+    forge_store_commit(s);
+    flush(n);
+    ASSERT_EQ(n[0], 1, "transactions still compare afterwards");
+
+    forge_ctx_free(reader);
+    _ctx[0] = 0;
+    forge_store_free(s);
+}
+
+/* ─── Main ────────────────────────────────────────────────────────────────── */
+
+int main(void) {
+    printf("=== Forge Store Tests ===\n");
+    forge_runtime_init();
+    _type = forge_register_update_fn(count_update);
+
+    test_masked_subscribe();
+    test_selector_cache();
+    test_unbalanced_commit();
+
+    printf("\n══════════════════════════\n");
+    printf("  %d / %d tests passed\n", tests_passed, tests_run);
+
+    if (tests_passed == tests_run) {
+        printf("  \033[32mAll tests passed ✓\033[0m\n");
+        return 0;
+    } else {
+        printf("  \033[31m%d tests FAILED\033[0m\n", tests_run - tests_passed);
+        return 1;
+    }
+}
@@ -10,6 +10,7 @@
 #define FORGE_DOM_H
 
 #include "types.h"
+#include "dom_names.h"
 
 /* ─── Node Creation ────────────────────────────────────────────────────────── */
 
@@ -33,6 +34,12 @@ forge_dom_node_t *forge_dom_get(u32 el_id);
 FORGE_IMPORT("env", "forge_dom_create_component")
 forge_dom_node_t *forge_dom_create_component(forge_dom_node_t *parent, const char *comp_name);
 
+/* Re-evaluate the expressions/attributes bound to ctx whose dependency mask
+ * meets `dirty` (0: all of them); returns how many bindings ran.  Bindings
+ * made through forge_dom_expr / forge_dom_set_attr_expr depend on everything. */
+FORGE_IMPORT("env", "forge_dom_refresh")
+u32 forge_dom_refresh(void *ctx, u32 dirty);
+
 /* ─── Attribute Manipulation ───────────────────────────────────────────────── */
 
 FORGE_IMPORT("env", "forge_dom_set_attr")
@@ -62,6 +69,15 @@ void forge_dom_inject_css(const char *component_name, const char *css);
 
 typedef void (*forge_event_cb)(forge_event_t *event, forge_ctx_t *ctx);
 
+/* One row of a component type's delegated-event table: the handler for
+ * events hashing to `type_hash` on the element bound to `slot`.  Tables are
+ * sorted by (slot, type_hash); see forge_register_events in web.h. */
+typedef struct {
+    u16            slot;
+    u32            type_hash;
+    forge_event_cb cb;
+} forge_event_slot_t;
+
 FORGE_IMPORT("env", "forge_dom_on")
 void forge_dom_on(forge_dom_node_t *el, const char *event_name,
                    forge_event_cb cb, forge_ctx_t *ctx);
@@ -95,4 +111,117 @@ forge_dom_node_t *forge_dom_list_item(forge_dom_node_t *parent,
 FORGE_IMPORT("env", "forge_dom_list_end")
 void forge_dom_list_end(forge_dom_node_t *parent);
 
+/* ─── Batched Command Buffer ───────────────────────────────────────────────── */
+
+/*
+ * Render code appends opcode-encoded commands to a buffer in linear memory
+ * instead of calling one import per operation.  The host drains the whole
+ * buffer with a single forge_dom_flush() call: at the end of every mount,
+ * before the frame arena is reset, or when the buffer fills up.
+ *
+ * Node handles are allocated on the WASM side (from FORGE_DOM_CMD_ID_BASE
+ * upward) so creating a node never needs a round trip.  Names take an
+ * interned ID from dom_names.h; pass 0 and a string for anything else.
+ * Strings are referenced, not copied — they must outlive the next flush
+ * (literals and frame-arena strings both do).
+ *
+ * Every command is a fixed number of u32 words; operands follow the opcode:
+ *   CREATE     parent id name_id name_ptr name_len
+ *   TEXT       parent ptr len
+ *   ATTR       node name_id name_ptr name_len val_ptr val_len
+ *   EXPR       parent fn ctx deps
+ *   ATTR_EXPR  node name_id name_ptr name_len fn ctx deps
+ *   ON         node evt_ptr evt_len cb ctx
+ *   COMPONENT  parent id name_ptr name_len
+ *   PROP       node name_ptr name_len kind lo hi
+ *   PROP_STR   node name_ptr name_len val_ptr val_len
+ *   REMOVE     node
+ *   CLEAR      node
+ *   CLONE      parent html_ptr html_len
+ *   DELEGATE   node evt_ptr evt_len slot handle
+ *   STYLE      node prop value
+ *
+ * CLONE appends a static subtree given as an HTML string.  The host parses
+ * it into a <template> once per address and clones it afterwards, so the
+ * string must be a literal (the compiler only emits it for static markup).
+ *
+ * EXPR and ATTR_EXPR carry the binding's dependency mask (the analyzer's
+ * dep_mask, FORGE_DEP_ALL when unknown); forge_dom_refresh skips bindings
+ * whose mask misses the dirty fields.
+ *
+ * DELEGATE tags a node with (handle, slot) instead of adding a listener to
+ * it.  The host keeps one root listener per event type and hands matching
+ * events to forge_event_dispatch, so listener count does not grow with the
+ * number of bound elements.  The context must already be registered.
+ *
+ * STYLE writes one compositor-only property (FORGE_STYLE_*) from an f32
+ * (value holds its bits).  The transform parts map to the individual
+ * translate / scale / rotate properties, so animating them separately on
+ * one node never overwrites each other, and nothing re-renders.
+ */
+
+enum {
+    FORGE_CMD_CREATE = 1,
+    FORGE_CMD_TEXT,
+    FORGE_CMD_ATTR,
+    FORGE_CMD_EXPR,
+    FORGE_CMD_ATTR_EXPR,
+    FORGE_CMD_ON,
+    FORGE_CMD_COMPONENT,
+    FORGE_CMD_PROP,
+    FORGE_CMD_PROP_STR,
+    FORGE_CMD_REMOVE,
+    FORGE_CMD_CLEAR,
+    FORGE_CMD_CLONE,
+    FORGE_CMD_DELEGATE,
+    FORGE_CMD_STYLE,
+};
+
+/* STYLE properties; translate is in px, rotate in degrees */
+enum {
+    FORGE_STYLE_OPACITY = 1,
+    FORGE_STYLE_TRANSLATE_X,
+    FORGE_STYLE_TRANSLATE_Y,
+    FORGE_STYLE_SCALE,
+    FORGE_STYLE_ROTATE,
+};
+
+#define FORGE_DOM_CMD_WORDS   16384        /* 64KB command buffer  */
+#define FORGE_DOM_CMD_ID_BASE 0x40000000u  /* WASM-allocated nodes */
+
+/* Drain `words` u32s of commands starting at `buf` */
+FORGE_IMPORT("env", "forge_dom_flush")
+void forge_dom_flush(const u32 *buf, u32 words);
+
+forge_dom_node_t *forge_dom_cmd_create(forge_dom_node_t *parent, u32 tag_id,
+                                       const char *tag);
+void forge_dom_cmd_text(forge_dom_node_t *parent, const char *text);
+void forge_dom_cmd_attr(forge_dom_node_t *el, u32 attr_id, const char *name,
+                        const char *value);
+void forge_dom_cmd_expr(forge_dom_node_t *parent, forge_expr_fn fn, void *ctx,
+                       u32 deps);
+void forge_dom_cmd_attr_expr(forge_dom_node_t *el, u32 attr_id,
+                             const char *name, forge_expr_fn fn, void *ctx,
+                             u32 deps);
+void forge_dom_cmd_on(forge_dom_node_t *el, const char *event_name,
+                      forge_event_cb cb, forge_ctx_t *ctx);
+void forge_dom_cmd_delegate(forge_dom_node_t *el, const char *event_name,
+                            u32 slot, const forge_ctx_t *ctx);
+forge_dom_node_t *forge_dom_cmd_component(forge_dom_node_t *parent,
+                                          const char *comp_name);
+void forge_dom_cmd_prop(forge_dom_node_t *el, const char *name, forge_val_t value);
+void forge_dom_cmd_prop_str(forge_dom_node_t *el, const char *name,
+                            const char *value);
+void forge_dom_cmd_remove(forge_dom_node_t *el);
+void forge_dom_cmd_clear(forge_dom_node_t *parent);
+void forge_dom_cmd_clone(forge_dom_node_t *parent, const char *html);
+void forge_dom_cmd_style(forge_dom_node_t *el, u32 prop, f32 value);
+
+/* Hand all queued commands to the host now (no-op when empty) */
+void forge_dom_cmd_flush(void);
+
+/* Commands written and forge_dom_flush() calls made since startup */
+u32 forge_dom_cmd_count(void);
+u32 forge_dom_flush_count(void);
+
 #endif /* FORGE_DOM_H */
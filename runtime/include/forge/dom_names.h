@@ -0,0 +1,33 @@
+/*
+ * Forge Framework - Interned DOM Names
+ *
+ * Common tag and attribute names are assigned small integer IDs at compile
+ * time so batched DOM commands carry no strings for them.  The compiler,
+ * the runtime and forge-runtime.js (_TAG_NAMES / _ATTR_NAMES) all derive
+ * their tables from these lists — append only, never reorder.
+ *
+ * ID 0 means "not interned": the command carries the name as a string.
+ */
+
+#ifndef FORGE_DOM_NAMES_H
+#define FORGE_DOM_NAMES_H
+
+#define FORGE_DOM_TAGS(X)                                                    \
+    X(div) X(span) X(p) X(a) X(button) X(input) X(img) X(ul) X(ol) X(li)     \
+    X(h1) X(h2) X(h3) X(h4) X(h5) X(h6) X(section) X(header) X(footer)       \
+    X(nav) X(main) X(article) X(aside) X(form) X(label) X(select) X(option)  \
+    X(textarea) X(table) X(thead) X(tbody) X(tr) X(td) X(th) X(strong)       \
+    X(em) X(small) X(br) X(hr) X(i) X(svg) X(path)
+
+#define FORGE_DOM_ATTRS(X)                                                   \
+    X(class) X(id) X(href) X(src) X(alt) X(type) X(value) X(name)            \
+    X(placeholder) X(title) X(style) X(disabled) X(checked) X(for) X(role)   \
+    X(target) X(rel) X(width) X(height)
+
+#define FORGE__TAG_ENUM(n)  FORGE_TAG_##n,
+#define FORGE__ATTR_ENUM(n) FORGE_ATTR_##n,
+
+enum { FORGE_TAG_NONE = 0, FORGE_DOM_TAGS(FORGE__TAG_ENUM) FORGE_TAG_COUNT };
+enum { FORGE_ATTR_NONE = 0, FORGE_DOM_ATTRS(FORGE__ATTR_ENUM) FORGE_ATTR_COUNT };
+
+#endif /* FORGE_DOM_NAMES_H */
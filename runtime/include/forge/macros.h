@@ -8,19 +8,35 @@
 
 /* ─── forge_val_auto ──────────────────────────────────────────────────────── */
 /* Automatically wrap a C expression as a forge_val_t based on type.
- * Uses C11 _Generic for zero-overhead type selection. */
-
-#define forge_val_auto(x) _Generic((x),          \
-    int:           forge_val_int((i64)(x)),        \
-    long:          forge_val_int((i64)(x)),        \
-    long long:     forge_val_int((i64)(x)),        \
-    unsigned:      forge_val_int((i64)(x)),        \
-    float:         forge_val_float((f64)(x)),      \
-    double:        forge_val_float((f64)(x)),      \
-    char *:        forge_val_str(forge_sprintf("%s",(x))), \
-    const char *:  forge_val_str(forge_sprintf("%s",(x))), \
-    default:       forge_val_null()                \
-)
+ * Uses C11 _Generic for zero-overhead type selection: it picks the
+ * constructor, so every branch stays well-typed for any argument. */
+
+#define forge_val_auto(x) _Generic((x),   \
+    int:           forge_val_int,           \
+    long:          forge_val_int,           \
+    long long:     forge_val_int,           \
+    unsigned:      forge_val_int,           \
+    float:         forge_val_float,         \
+    double:        forge_val_float,         \
+    char *:        forge_val_cstr,          \
+    const char *:  forge_val_cstr,          \
+    default:       forge_val_other          \
+)(x)
+
+/* ─── forge_str_auto ──────────────────────────────────────────────────────── */
+/* Append a C expression to a forge_str_t builder using its type's fast path */
+
+#define forge_str_auto(sb, x) _Generic((x), \
+    int:           forge_str_int,           \
+    long:          forge_str_int,           \
+    long long:     forge_str_int,           \
+    unsigned:      forge_str_uint,          \
+    float:         forge_str_num,           \
+    double:        forge_str_num,           \
+    char *:        forge_str_cstr,          \
+    const char *:  forge_str_cstr,          \
+    default:       forge_str_other          \
+)((sb), (x))
 
 /* ─── Array helpers ───────────────────────────────────────────────────────── */
 
@@ -50,7 +50,10 @@ typedef struct {
         i64    i;
         f64    f;
         i32    b;
-        u32    str_ptr; /* offset in WASM memory */
+        struct {
+            u32 str_ptr; /* offset in WASM memory */
+            u32 str_len; /* bytes, excluding the NUL */
+        };
         u32    fn_idx;  /* indirect call table index */
     } v;
 } forge_val_t;
@@ -84,6 +87,35 @@ void *forge_memcpy(void *dst, const void *src, size_t n);
 int   forge_memcmp(const void *a, const void *b, size_t n);
 int   forge_strlen(const char *s);
 
+/* ─── Props Schema ────────────────────────────────────────────────────────── */
+
+/*
+ * Layout of a component's Props struct, emitted by the compiler so the JS
+ * host can write fields straight into linear memory.  Bit i of a props
+ * change mask stands for field i (fields past 30 share bit 31).
+ */
+typedef enum {
+    FORGE_PROP_OPAQUE = 0,  /* not settable from JS (pointers, structs) */
+    FORGE_PROP_INT    = 1,  /* signed integer, `size` bytes             */
+    FORGE_PROP_UINT   = 2,  /* unsigned integer, `size` bytes           */
+    FORGE_PROP_FLOAT  = 3,  /* f32 or f64                               */
+    FORGE_PROP_BOOL   = 4,  /* int holding 0 / 1                        */
+    FORGE_PROP_STR    = 5,  /* char *: length-prefixed runtime string   */
+    FORGE_PROP_TEXT   = 6,  /* char[size]: copied inline, NUL-terminated */
+} ForgePropKind;
+
+typedef struct {
+    u32 offset;
+    u16 kind;               /* ForgePropKind */
+    u16 size;
+} forge_prop_field_t;
+
+typedef struct {
+    u32                       count;
+    u32                       size;    /* sizeof(Props) */
+    const forge_prop_field_t *fields;  /* in declaration order */
+} forge_props_schema_t;
+
 /* ─── Component Context ───────────────────────────────────────────────────── */
 
 typedef struct forge_ctx {
@@ -92,10 +124,17 @@ typedef struct forge_ctx {
     void  *state;         /* pointer to State struct           */
     u32    props_size;    /* sizeof(Props)                     */
     u32    state_size;    /* sizeof(State)                     */
-    u32    dirty;         /* bitmask: which state fields changed */
+    u32    dirty;         /* bitmask: which state/props fields changed
+                           * (compiler bit layout: state, then props) */
     u32    update_queued; /* 1 if a re-render is scheduled     */
+    u32    type_id;       /* index into the update fn table    */
+    u32    handle;        /* generation-tagged registry handle */
 } forge_ctx_t;
 
+/* Per-component-type re-render entry point, registered by generated code.
+ * `dirty` is the ctx->dirty mask accumulated since the last flush. */
+typedef void (*forge_update_fn)(forge_ctx_t *ctx, u32 dirty);
+
 /* ─── FNV-1a Hash (compile-time friendly) ─────────────────────────────────── */
 
 static inline u32 forge_fnv1a(const char *s) {
@@ -14,14 +14,97 @@
 #include "dom.h"
 #include "macros.h"
 
+#include <stdarg.h>
+
 /* ─── Context Registry ────────────────────────────────────────────────────── */
 
 forge_ctx_t *forge_ctx_new(u32 el_id, u32 state_size, u32 props_size);
 forge_ctx_t *forge_ctx_get(u32 el_id);
 void         forge_ctx_free(forge_ctx_t *ctx);
-void         forge_ctx_register(forge_ctx_t *ctx, u32 el_id);
+u32          forge_ctx_register(forge_ctx_t *ctx, u32 el_id); /* handle, 0 on failure */
 void         forge_ctx_unregister(u32 el_id);
 
+/* Context for a handle from forge_ctx_register.  Handles carry a generation,
+ * so one kept past unmount resolves to NULL even after its slot is reused. */
+forge_ctx_t *forge_ctx_resolve(u32 handle);
+
+/* ─── Memory Statistics ───────────────────────────────────────────────────── */
+
+/* Snapshot of the runtime allocators, in bytes unless noted.  From JS, call
+ * the exported forge_memory_stats_ptr() and read ten u32s at that offset. */
+typedef struct {
+    u32 render_used;      /* render arena, this frame so far */
+    u32 render_peak;
+    u32 render_reserved;  /* initial block + growth chunks */
+    u32 persist_used;
+    u32 persist_peak;
+    u32 persist_reserved;
+    u32 ctx_live;         /* mounted component contexts (count) */
+    u32 ctx_peak;         /* most contexts mounted at once (count) */
+    u32 block_live;       /* state + props blocks in use */
+    u32 oom_count;        /* failed allocations, both arenas (count) */
+} forge_mem_stats_t;
+
+void forge_memory_stats(forge_mem_stats_t *out);
+
+/* ─── Runtime Statistics ──────────────────────────────────────────────────── */
+
+/* Scheduler, DOM and registry counters since startup, then a memory
+ * snapshot.  The counters are always kept (a few increments per frame).
+ * From JS, call the exported forge_stats_ptr() and read nineteen u32s at
+ * that offset, or use ForgeRuntime.stats(). */
+typedef struct {
+    u32 frames;           /* forge_raf_callback runs */
+    u32 updates;          /* component updates flushed */
+    u32 queue_depth;      /* contexts queued for the next frame */
+    u32 queue_peak;       /* most contexts flushed in one pass */
+    u32 queue_overflows;  /* flushes that fell back to a registry scan */
+    u32 dom_cmds;         /* DOM commands written */
+    u32 dom_flushes;      /* forge_dom_flush() calls into the host */
+    u32 registry_live;    /* registered contexts */
+    u32 registry_cap;     /* registry slots allocated */
+    forge_mem_stats_t mem;
+} forge_stats_t;
+
+void forge_stats(forge_stats_t *out);
+
+/* ─── Profiling ───────────────────────────────────────────────────────────── */
+
+/*
+ * Per-component counters for code from `forge compile --profile`.  Each
+ * component type owns one forge_profile_t and brackets its renders and
+ * updates with begin/end; the first call registers it, and the host lists
+ * registered entries through the exported forge_profile_count() and
+ * forge_profile_at(i).  Times come from the host clock, and every bracket
+ * is also reported to the host as a performance.measure() entry.
+ *
+ * Builds without --profile never reference these, so none of it (nor its
+ * imports) is linked into their modules.
+ */
+typedef struct {
+    f64         render_ms;   /* mount renders, DOM flush included */
+    f64         update_ms;   /* scheduled updates */
+    const char *name;        /* component name */
+    u32         renders;
+    u32         updates;
+    u32         updaters;    /* bindings re-evaluated by updates */
+    u32         dom_cmds;    /* commands written by renders and updates */
+    u32         registered;
+} forge_profile_t;
+
+typedef struct {
+    f64 t0;
+    u32 cmds;
+} forge_profile_mark_t;
+
+#define FORGE_PROFILE_RENDER 0
+#define FORGE_PROFILE_UPDATE 1
+#define FORGE_MAX_PROFILES   FORGE_MAX_COMPONENT_TYPES
+
+forge_profile_mark_t forge_profile_begin(forge_profile_t *p);
+void forge_profile_end(forge_profile_t *p, u32 kind, forge_profile_mark_t m,
+                       u32 updaters);
+
 /* ─── Reactive Update Scheduler ───────────────────────────────────────────── */
 
 /* Queue a re-render for this component on the next animation frame */
@@ -30,28 +113,104 @@ void forge_schedule_update(forge_ctx_t *ctx);
 /* Immediately flush all pending re-renders (called by runtime after RAF) */
 void forge_flush_updates(void);
 
+/* Register a component type's update function; returns its type id (> 0)
+ * for forge_ctx_t.type_id, or 0 if the table is full. */
+#define FORGE_MAX_COMPONENT_TYPES 128
+u32  forge_register_update_fn(forge_update_fn fn);
+
+/* Per-frame work (animations) run by forge_raf_callback before the flush,
+ * given the milliseconds since the previous frame.  A function returns
+ * nonzero while it needs further frames; forge_request_frame() wakes the
+ * loop again after it went idle.  Registering is idempotent; returns 0 if
+ * the table is full. */
+#define FORGE_MAX_FRAME_FNS 4
+typedef int (*forge_frame_fn)(f32 delta_ms);
+int  forge_register_frame_fn(forge_frame_fn fn);
+void forge_request_frame(void);
+
 /* ─── Props Serialization ──────────────────────────────────────────────────── */
 
-/* Deserialize a JSON props blob into a C struct (binary format, not JSON text) */
+/* Raw struct copies, for props blobs produced by C code */
 void forge_props_deserialize(void *props_dst, const u8 *blob, u32 len);
 void forge_props_serialize(const void *props_src, u32 props_size, u8 **out, u32 *out_len);
 
+/* Context dirty bits for a props change mask: props field i is dep bit
+ * state_count + i, saturating at 31 like the compiler's layout */
+u32  forge_props_dirty(u32 changed, u32 state_count);
+
+/* String prop storage for the JS host: a length-prefixed block of `len`
+ * bytes (plus NUL) the host fills in, released with forge_props_str_free */
+FORGE_EXPORT u32  forge_props_str_alloc(u32 len);
+FORGE_EXPORT void forge_props_str_free(u32 ptr);
+
 /* ─── Event Routing ────────────────────────────────────────────────────────── */
 
 int forge_event_is(const forge_event_t *e, const char *event_name);
 
+/* Delegated events: a component type's table of (slot, type_hash) →
+ * handler rows, sorted by slot then type_hash.  Generated code registers it
+ * once per type, alongside the update function. */
+void forge_register_events(u32 type_id, const forge_event_slot_t *table, u32 count);
+
+/* Run the handler bound to `slot` of the component behind `handle` for
+ * e->type_hash.  Called by the host's root listener for each delegated
+ * element on the event path; returns 1 if a handler ran. */
+FORGE_EXPORT int forge_event_dispatch(u32 handle, u32 slot, forge_event_t *e);
+
 /* ─── Utilities ────────────────────────────────────────────────────────────── */
 
 /* Tagged-value constructor helpers */
 forge_val_t forge_val_int(i64 v);
 forge_val_t forge_val_float(f64 v);
 forge_val_t forge_val_bool(int v);
-forge_val_t forge_val_str(u32 ptr);
+forge_val_t forge_val_str(u32 ptr);                /* NUL-terminated */
+forge_val_t forge_val_strn(u32 ptr, u32 len);
 forge_val_t forge_val_null(void);
+forge_val_t forge_val_cstr(const char *s);  /* frame copy, see forge_str_copy */
+
+/* forge_val_auto / forge_str_auto fallbacks for types they do not format */
+static inline forge_val_t forge_val_other(const void *p) { (void)p; return forge_val_null(); }
+
+/* ─── Strings ──────────────────────────────────────────────────────────────── */
 
-/* Variadic-safe sprintf into WASM linear memory */
+/*
+ * Arena-backed string builder.  forge_str_frame() strings live until the
+ * end of the frame (render arena); forge_str_persist() strings live for the
+ * whole session (persist arena).  forge_str_end() returns a NUL-terminated
+ * string whose u32 length sits in the 4 bytes before it: read it with
+ * forge_str_len() instead of forge_strlen().
+ */
+typedef struct {
+    char *data;
+    u32   len;
+    u32   cap;
+    u32   persist;  /* 1 = persist arena, 0 = render arena */
+    u32   failed;   /* out of memory: output is truncated  */
+} forge_str_t;
+
+forge_str_t forge_str_frame(u32 cap_hint);
+forge_str_t forge_str_persist(u32 cap_hint);
+void  forge_str_append(forge_str_t *s, const char *p, u32 n);
+void  forge_str_cstr(forge_str_t *s, const char *p);
+void  forge_str_char(forge_str_t *s, char c);
+void  forge_str_int(forge_str_t *s, i64 v);
+void  forge_str_uint(forge_str_t *s, u64 v);
+void  forge_str_float(forge_str_t *s, f64 v, int precision); /* < 0: trim zeros */
+void  forge_str_fmt(forge_str_t *s, const char *fmt, ...);
+void  forge_str_vfmt(forge_str_t *s, const char *fmt, va_list ap);
+char *forge_str_end(forge_str_t *s);
+u32   forge_str_len(const char *finished);
+
+/* printf into a fresh frame string (flags, width, precision, l/ll, and
+ * d i u x X c s f %).  Returns its linear-memory offset; valid this frame. */
 u32 forge_sprintf(const char *fmt, ...);
 
+/* Frame copy of a C string, length-prefixed like forge_sprintf's result */
+u32 forge_str_copy(const char *s);
+
+static inline void forge_str_num(forge_str_t *s, f64 v) { forge_str_float(s, v, -1); }
+static inline void forge_str_other(forge_str_t *s, const void *p) { (void)s; (void)p; }
+
 /* Assert (trap in WASM) */
 #define FORGE_ASSERT(cond) do { if (!(cond)) forge_trap("assert failed: " #cond); } while(0)
 void forge_trap(const char *msg) __attribute__((noreturn));
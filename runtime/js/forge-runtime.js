@@ -7,7 +7,8 @@
  *   2. Manages the DOM node ID table
  *   3. Routes browser events into WASM
  *   4. Schedules re-renders via requestAnimationFrame
- *   5. Exports ForgeRuntime and ForgeComponent base class
+ *   5. Reads runtime statistics and --profile counters (ForgeRuntime.stats)
+ *   6. Exports ForgeRuntime and ForgeComponent base class
  */
 
 'use strict';
@@ -28,6 +29,14 @@ function _nodeRegister(node) {
   return id;
 }
 
+// Nodes created by batched commands arrive with an ID allocated in WASM
+function _nodeRegisterAs(node, id) {
+  _nodeTable.set(id, node);
+  _nodeIds.set(node, id);
+  node.__forgeId = id;
+  return id;
+}
+
 function _nodeGet(id) { return _nodeTable.get(id) || null; }
 
 function _nodeRemove(id) {
@@ -35,6 +44,19 @@ function _nodeRemove(id) {
   if (node) { _nodeIds.delete(node); _nodeTable.delete(id); }
 }
 
+/* ─── Reactive Bindings ───────────────────────────────────────────────────── */
+// ctx pointer → [{ node, fnPtr, attr, deps }] registered by forge_dom_expr and
+// forge_dom_set_attr_expr; forge_dom_refresh re-evaluates those of that ctx
+// whose deps (the analyzer's mask, -1 when unknown) meet the dirty mask
+
+const _ctxBindings = new Map();
+
+function _bind(ctxPtr, binding) {
+  let list = _ctxBindings.get(ctxPtr);
+  if (!list) _ctxBindings.set(ctxPtr, (list = []));
+  list.push(binding);
+}
+
 /* ─── WASM Memory Helpers ─────────────────────────────────────────────────── */
 
 let _wasmMemory = null;   // set when first WASM module loads
@@ -73,6 +95,11 @@ function _readVal(ptr) {
 
 const _eventListeners = new Map(); // `${nodeId}:${eventName}` → { cb, ctx }
 
+/* Events delegated through a capture listener: they never bubble to the document */
+const _NON_BUBBLING = new Set(['focus', 'blur', 'mouseenter', 'mouseleave',
+  'pointerenter', 'pointerleave', 'load', 'error', 'abort', 'scroll', 'scrollend',
+  'toggle', 'invalid', 'play', 'pause', 'ended', 'loadeddata', 'canplay', 'timeupdate']);
+
 /* FNV-1a hash (matches forge_fnv1a in C) */
 function _fnv1a(str) {
   let h = 2166136261;
@@ -83,210 +110,601 @@ function _fnv1a(str) {
   return h;
 }
 
+/* Write a browser event into the forge_event_t scratch slot at offset 0 */
+function _writeEvent(browserEvent, typeHash, nodeId) {
+  const view = new DataView(_mem(), 0, 24);
+  view.setUint32(0,  typeHash, true);
+  view.setUint32(4,  nodeId,   true);
+  view.setInt32 (8,  browserEvent.which || 0, true);
+  view.setFloat32(12, browserEvent.clientX || 0, true);
+  view.setFloat32(16, browserEvent.clientY || 0, true);
+  const flags =
+    (browserEvent.shiftKey ? 1 : 0) |
+    (browserEvent.ctrlKey  ? 2 : 0) |
+    (browserEvent.altKey   ? 4 : 0) |
+    (browserEvent.metaKey  ? 8 : 0);
+  view.setUint32(20, flags, true);
+}
+
+/* ─── Interned Names ──────────────────────────────────────────────────────── */
+// Index = ID from runtime/include/forge/dom_names.h (0 = not interned).
+// Keep both lists in the same order as the C X-macros.
+
+const _TAG_NAMES = ['',
+  'div', 'span', 'p', 'a', 'button', 'input', 'img', 'ul', 'ol', 'li',
+  'h1', 'h2', 'h3', 'h4', 'h5', 'h6', 'section', 'header', 'footer',
+  'nav', 'main', 'article', 'aside', 'form', 'label', 'select', 'option',
+  'textarea', 'table', 'thead', 'tbody', 'tr', 'td', 'th', 'strong',
+  'em', 'small', 'br', 'hr', 'i', 'svg', 'path'];
+
+const _ATTR_NAMES = ['',
+  'class', 'id', 'href', 'src', 'alt', 'type', 'value', 'name',
+  'placeholder', 'title', 'style', 'disabled', 'checked', 'for', 'role',
+  'target', 'rel', 'width', 'height'];
+
+/* ─── Batched Command Drain ───────────────────────────────────────────────── */
+// Executes the opcode buffer written by runtime/src/dom_cmd.c (layout in
+// dom.h).  One import call per flush instead of one per DOM operation.
+
+const CMD_CREATE = 1, CMD_TEXT = 2, CMD_ATTR = 3, CMD_EXPR = 4,
+      CMD_ATTR_EXPR = 5, CMD_ON = 6, CMD_COMPONENT = 7, CMD_PROP = 8,
+      CMD_PROP_STR = 9, CMD_REMOVE = 10, CMD_CLEAR = 11, CMD_CLONE = 12,
+      CMD_DELEGATE = 13, CMD_STYLE = 14;
+
+// STYLE properties (FORGE_STYLE_*).  translate keeps both axes per node so
+// X and Y can be animated independently.
+const STYLE_OPACITY = 1, STYLE_TRANSLATE_X = 2, STYLE_TRANSLATE_Y = 3,
+      STYLE_SCALE = 4, STYLE_ROTATE = 5;
+const _f32 = new Float32Array(1), _f32Bits = new Uint32Array(_f32.buffer);
+
+function _writeStyle(el, prop, value) {
+  const st = el.style;
+  switch (prop) {
+    case STYLE_OPACITY: st.opacity = value; break;
+    case STYLE_TRANSLATE_X:
+    case STYLE_TRANSLATE_Y: {
+      const t = el.__forgeTranslate || (el.__forgeTranslate = [0, 0]);
+      t[prop - STYLE_TRANSLATE_X] = value;
+      st.translate = `${t[0]}px ${t[1]}px`;
+      break;
+    }
+    case STYLE_SCALE:  st.scale  = value; break;
+    case STYLE_ROTATE: st.rotate = `${value}deg`; break;
+  }
+}
+
+// CLONE templates keyed by the string's address in linear memory — compiled
+// templates are literals in the data segment, so the address is stable.
+const _templates = new Map();
+
+function _name(table, id, ptr, len) {
+  return id ? table[id] : _readStr(ptr, len);
+}
+
+function _componentTag(name) {
+  return 'forge-' + name.replace(/([A-Z])/g, (_, c, i) =>
+    (i ? '-' : '') + c.toLowerCase());
+}
+
+function _drainCommands(env, bufPtr, words) {
+  const w = new Uint32Array(_mem(), bufPtr, words);
+  let i = 0;
+  while (i < words) {
+    switch (w[i]) {
+      case CMD_CREATE: {
+        const el = document.createElement(_name(_TAG_NAMES, w[i + 3], w[i + 4], w[i + 5]));
+        (_nodeGet(w[i + 1]) || document.body).appendChild(el);
+        _nodeRegisterAs(el, w[i + 2]);
+        i += 6; break;
+      }
+      case CMD_TEXT:
+        env.forge_dom_text(w[i + 1], w[i + 2], w[i + 3]);
+        i += 4; break;
+      case CMD_ATTR: {
+        const el = _nodeGet(w[i + 1]);
+        if (el && el.setAttribute)
+          el.setAttribute(_name(_ATTR_NAMES, w[i + 2], w[i + 3], w[i + 4]),
+                          _readStr(w[i + 5], w[i + 6]));
+        i += 7; break;
+      }
+      case CMD_EXPR:
+        env.forge_dom_expr(w[i + 1], w[i + 2], w[i + 3], w[i + 4]);
+        i += 5; break;
+      case CMD_ATTR_EXPR:
+        env._bindAttrExpr(w[i + 1], _name(_ATTR_NAMES, w[i + 2], w[i + 3], w[i + 4]),
+                          w[i + 5], w[i + 6], w[i + 7]);
+        i += 8; break;
+      case CMD_ON:
+        env.forge_dom_on(w[i + 1], w[i + 2], w[i + 3], w[i + 4], w[i + 5]);
+        i += 6; break;
+      case CMD_COMPONENT: {
+        const el = document.createElement(_componentTag(_readStr(w[i + 3], w[i + 4])));
+        const parent = _nodeGet(w[i + 1]);
+        if (parent) parent.appendChild(el);
+        _nodeRegisterAs(el, w[i + 2]);
+        i += 5; break;
+      }
+      case CMD_PROP: {
+        const el = _nodeGet(w[i + 1]);
+        const kind = w[i + 4];
+        let val = _rawToVal(kind, w[i + 5], w[i + 6]);
+        if (kind === 2) {
+          const f = new DataView(new ArrayBuffer(8));
+          f.setUint32(0, w[i + 5], true); f.setUint32(4, w[i + 6], true);
+          val = f.getFloat64(0, true);
+        }
+        if (el) el[_readStr(w[i + 2], w[i + 3])] = val;
+        i += 7; break;
+      }
+      case CMD_PROP_STR:
+        env.forge_dom_set_prop_str(w[i + 1], w[i + 2], w[i + 3], w[i + 4], w[i + 5]);
+        i += 6; break;
+      case CMD_REMOVE:
+        env.forge_dom_remove(w[i + 1]);
+        i += 2; break;
+      case CMD_CLEAR:
+        env.forge_dom_clear(w[i + 1]);
+        i += 2; break;
+      case CMD_CLONE: {
+        let t = _templates.get(w[i + 2]);
+        if (!t) {
+          t = document.createElement('template');
+          t.innerHTML = _readStr(w[i + 2], w[i + 3]);
+          _templates.set(w[i + 2], t);
+        }
+        const parent = _nodeGet(w[i + 1]);
+        if (parent) parent.appendChild(t.content.cloneNode(true));
+        i += 4; break;
+      }
+      case CMD_DELEGATE:
+        env.forge_dom_delegate(w[i + 1], w[i + 2], w[i + 3], w[i + 4], w[i + 5]);
+        i += 6; break;
+      case CMD_STYLE: {
+        const el = _nodeGet(w[i + 1]);
+        _f32Bits[0] = w[i + 3];
+        if (el && el.style) _writeStyle(el, w[i + 2], _f32[0]);
+        i += 4; break;
+      }
+      default:
+        console.error('[Forge] Corrupt DOM command buffer at word', i);
+        return;
+    }
+  }
+}
+
 /* ─── WASM Import Object ──────────────────────────────────────────────────── */
 
 function _buildImports(componentName, wasmExports) {
-  return {
-    env: {
-      /* ── DOM Creation ── */
-      forge_dom_create(parentId, tagPtr, tagLen) {
-        const parent = _nodeGet(parentId) || document.body;
-        const tag    = _readStr(tagPtr, tagLen);
-        const el     = document.createElement(tag);
-        parent.appendChild(el);
-        return _nodeRegister(el);
-      },
-
-      forge_dom_text(parentId, textPtr, textLen) {
-        const parent = _nodeGet(parentId);
-        if (!parent) return;
-        const text = _readStr(textPtr, textLen);
-        const tn   = document.createTextNode(text);
-        parent.appendChild(tn);
-        _nodeRegister(tn);
-      },
-
-      forge_dom_expr(parentId, fnPtr, ctxPtr) {
-        const parent = _nodeGet(parentId);
-        if (!parent) return;
-        const tn = document.createTextNode('');
-        parent.appendChild(tn);
-        const id = _nodeRegister(tn);
-        // Store for reactive updates
-        tn.__forgeExprFn  = fnPtr;
-        tn.__forgeExprCtx = ctxPtr;
-        tn.__forgeExports = wasmExports;
-        // Initial evaluation
-        _evalExpr(tn, wasmExports, fnPtr, ctxPtr);
-      },
-
-      forge_dom_get(elId) {
-        const el = document.querySelector(`[data-forge-id="${elId}"]`) ||
-                   _nodeGet(elId);
-        if (el && !_nodeIds.has(el)) _nodeRegister(el);
-        return el ? _nodeIds.get(el) : 0;
-      },
-
-      forge_dom_create_component(parentId, namePtr, nameLen) {
-        const parent = _nodeGet(parentId);
-        const name   = _readStr(namePtr, nameLen);
-        const tag    = 'forge-' + name.replace(/([A-Z])/g, (_, c, i) =>
-                         (i ? '-' : '') + c.toLowerCase());
-        const el     = document.createElement(tag);
-        if (parent) parent.appendChild(el);
-        return _nodeRegister(el);
-      },
-
-      /* ── Attributes ── */
-      forge_dom_set_attr(nodeId, namePtr, nameLen, valPtr, valLen) {
-        const el  = _nodeGet(nodeId);
-        if (!el || !el.setAttribute) return;
-        const name = _readStr(namePtr, nameLen);
-        const val  = _readStr(valPtr,  valLen);
+  // Delegated events: one bubble-phase listener per event type on the
+  // document instead of one per element.  Bound elements carry
+  // handle * 2^16 + slot under a key private to this module; the listener
+  // walks from the target up and lets forge_event_dispatch pick the handler
+  // from the component's table.  Native listeners inside the tree still run
+  // first and a stopPropagation() there still keeps Forge handlers from
+  // running, as with per-element listeners.  Events that do not bubble never
+  // reach a bubble listener on the document, so those take a capture
+  // listener instead and only reach their target.
+  const onKey     = Symbol('forgeOn');
+  const delegated = new Set();
+
+  function dispatch(n, browserEvent, hash) {
+    const on = n[onKey];
+    if (on === undefined) return;
+    _writeEvent(browserEvent, hash, n.__forgeId || 0);
+    try {
+      wasmExports.forge_event_dispatch(Math.floor(on / 65536), on & 0xffff, 0);
+    } catch (e) {
+      console.error('[Forge] Event handler error:', e);
+    }
+  }
+
+  function delegate(evt) {
+    if (delegated.has(evt)) return;
+    delegated.add(evt);
+    const hash = _fnv1a(evt);
+    if (_NON_BUBBLING.has(evt)) {
+      document.addEventListener(evt, (browserEvent) => {
+        if (!browserEvent.bubbles) dispatch(browserEvent.target, browserEvent, hash);
+      }, true);
+    }
+    document.addEventListener(evt, (browserEvent) => {
+      for (let n = browserEvent.target; n && n !== document && !browserEvent.cancelBubble;
+           n = n.parentNode)
+        dispatch(n, browserEvent, hash);
+    });
+  }
+
+  const env = {
+    /* ── DOM Creation ── */
+    forge_dom_create(parentId, tagPtr, tagLen) {
+      const parent = _nodeGet(parentId) || document.body;
+      const tag    = _readStr(tagPtr, tagLen);
+      const el     = document.createElement(tag);
+      parent.appendChild(el);
+      return _nodeRegister(el);
+    },
+
+    forge_dom_text(parentId, textPtr, textLen) {
+      const parent = _nodeGet(parentId);
+      if (!parent) return;
+      const text = _readStr(textPtr, textLen);
+      const tn   = document.createTextNode(text);
+      parent.appendChild(tn);
+      _nodeRegister(tn);
+    },
+
+    forge_dom_expr(parentId, fnPtr, ctxPtr, deps = -1) {
+      const parent = _nodeGet(parentId);
+      if (!parent) return;
+      const tn = document.createTextNode('');
+      parent.appendChild(tn);
+      const id = _nodeRegister(tn);
+      // Store for reactive updates
+      tn.__forgeExprFn  = fnPtr;
+      tn.__forgeExprCtx = ctxPtr;
+      tn.__forgeExports = wasmExports;
+      _bind(ctxPtr, { node: tn, fnPtr, attr: null, deps });
+      // Initial evaluation
+      _evalExpr(tn, wasmExports, fnPtr, ctxPtr);
+    },
+
+    forge_dom_refresh(ctxPtr, dirty) {
+      const list = _ctxBindings.get(ctxPtr);
+      if (!list) return 0;
+      const table = wasmExports.__indirect_function_table;
+      const d = dirty || -1; // nothing marked: refresh everything
+      let n = 0;
+      for (const b of list) {
+        if (!(b.deps & d)) continue;
+        n++;
+        if (!b.attr) { _evalExpr(b.node, wasmExports, b.fnPtr, ctxPtr); continue; }
+        try {
+          const val = _valToString(table.get(b.fnPtr)(ctxPtr));
+          if (b.node.getAttribute(b.attr) !== val) b.node.setAttribute(b.attr, val);
+        } catch (e) { /* fn ptr may be 0 */ }
+      }
+      return n;
+    },
+
+    forge_dom_get(elId) {
+      const el = document.querySelector(`[data-forge-id="${elId}"]`) ||
+                 _nodeGet(elId);
+      if (el && !_nodeIds.has(el)) _nodeRegister(el);
+      return el ? _nodeIds.get(el) : 0;
+    },
+
+    forge_dom_create_component(parentId, namePtr, nameLen) {
+      const parent = _nodeGet(parentId);
+      const name   = _readStr(namePtr, nameLen);
+      const el     = document.createElement(_componentTag(name));
+      if (parent) parent.appendChild(el);
+      return _nodeRegister(el);
+    },
+
+    /* ── Attributes ── */
+    forge_dom_set_attr(nodeId, namePtr, nameLen, valPtr, valLen) {
+      const el  = _nodeGet(nodeId);
+      if (!el || !el.setAttribute) return;
+      const name = _readStr(namePtr, nameLen);
+      const val  = _readStr(valPtr,  valLen);
+      el.setAttribute(name, val);
+    },
+
+    forge_dom_set_attr_expr(nodeId, namePtr, nameLen, fnPtr, ctxPtr) {
+      env._bindAttrExpr(nodeId, _readStr(namePtr, nameLen), fnPtr, ctxPtr, -1);
+    },
+
+    _bindAttrExpr(nodeId, name, fnPtr, ctxPtr, deps) {
+      const el   = _nodeGet(nodeId);
+      if (!el || !el.setAttribute) return;
+      el.__forgeAttrExprs = el.__forgeAttrExprs || {};
+      el.__forgeAttrExprs[name] = { fnPtr, ctxPtr, exports: wasmExports };
+      _bind(ctxPtr, { node: el, fnPtr, attr: name, deps });
+      // Initial eval
+      try {
+        const result = wasmExports.__indirect_function_table.get(fnPtr)(ctxPtr);
+        const val    = _valToString(result);
         el.setAttribute(name, val);
-      },
-
-      forge_dom_set_attr_expr(nodeId, namePtr, nameLen, fnPtr, ctxPtr) {
-        const el   = _nodeGet(nodeId);
-        if (!el || !el.setAttribute) return;
-        const name = _readStr(namePtr, nameLen);
-        el.__forgeAttrExprs = el.__forgeAttrExprs || {};
-        el.__forgeAttrExprs[name] = { fnPtr, ctxPtr, exports: wasmExports };
-        // Initial eval
+      } catch(e) { /* fn ptr may be 0 */ }
+    },
+
+    forge_dom_set_prop(nodeId, namePtr, nameLen, valKind, valLo, valHi) {
+      const el   = _nodeGet(nodeId);
+      const name = _readStr(namePtr, nameLen);
+      if (el) el[name] = _rawToVal(valKind, valLo, valHi);
+    },
+
+    forge_dom_set_prop_str(nodeId, namePtr, nameLen, valPtr, valLen) {
+      const el   = _nodeGet(nodeId);
+      const name = _readStr(namePtr, nameLen);
+      const val  = _readStr(valPtr,  valLen);
+      if (el) el[name] = val;
+    },
+
+    /* ── Styles ── */
+    forge_dom_set_style(nodeId, propPtr, propLen, fnPtr, staticPtr, staticLen) {
+      const el   = _nodeGet(nodeId);
+      if (!el || !el.style) return;
+      const prop = _readStr(propPtr,   propLen);
+      if (fnPtr) {
+        el.__forgeStyleExprs = el.__forgeStyleExprs || {};
+        el.__forgeStyleExprs[prop] = { fnPtr, exports: wasmExports };
+      } else {
+        const val = _readStr(staticPtr, staticLen);
+        el.style[prop] = val;
+      }
+    },
+
+    forge_dom_inject_css(namePtr, nameLen, cssPtr, cssLen) {
+      const name = _readStr(namePtr, nameLen);
+      const css  = _readStr(cssPtr,  cssLen);
+      const id   = `forge-style-${name}`;
+      if (document.getElementById(id)) return;
+      const style = document.createElement('style');
+      style.id = id;
+      style.textContent = css;
+      document.head.appendChild(style);
+    },
+
+    /* ── Events ── */
+    forge_dom_on(nodeId, evtPtr, evtLen, cbPtr, ctxPtr) {
+      const el  = _nodeGet(nodeId);
+      if (!el) return;
+      const evt = _readStr(evtPtr, evtLen);
+      const key = `${nodeId}:${evt}`;
+
+      // Remove old listener if any
+      if (_eventListeners.has(key)) {
+        const old = _eventListeners.get(key);
+        el.removeEventListener(evt, old.handler);
+      }
+
+      const hash = _fnv1a(evt);
+      const handler = (browserEvent) => {
+        _writeEvent(browserEvent, hash, nodeId);
         try {
-          const result = wasmExports.__indirect_function_table.get(fnPtr)(ctxPtr);
-          const val    = _valToString(result);
-          el.setAttribute(name, val);
-        } catch(e) { /* fn ptr may be 0 */ }
-      },
-
-      forge_dom_set_prop(nodeId, namePtr, nameLen, valKind, valLo, valHi) {
-        const el   = _nodeGet(nodeId);
-        const name = _readStr(namePtr, nameLen);
-        if (el) el[name] = _rawToVal(valKind, valLo, valHi);
-      },
-
-      forge_dom_set_prop_str(nodeId, namePtr, nameLen, valPtr, valLen) {
-        const el   = _nodeGet(nodeId);
-        const name = _readStr(namePtr, nameLen);
-        const val  = _readStr(valPtr,  valLen);
-        if (el) el[name] = val;
-      },
-
-      /* ── Styles ── */
-      forge_dom_set_style(nodeId, propPtr, propLen, fnPtr, staticPtr, staticLen) {
-        const el   = _nodeGet(nodeId);
-        if (!el || !el.style) return;
-        const prop = _readStr(propPtr,   propLen);
-        if (fnPtr) {
-          el.__forgeStyleExprs = el.__forgeStyleExprs || {};
-          el.__forgeStyleExprs[prop] = { fnPtr, exports: wasmExports };
-        } else {
-          const val = _readStr(staticPtr, staticLen);
-          el.style[prop] = val;
-        }
-      },
-
-      forge_dom_inject_css(namePtr, nameLen, cssPtr, cssLen) {
-        const name = _readStr(namePtr, nameLen);
-        const css  = _readStr(cssPtr,  cssLen);
-        const id   = `forge-style-${name}`;
-        if (document.getElementById(id)) return;
-        const style = document.createElement('style');
-        style.id = id;
-        style.textContent = css;
-        document.head.appendChild(style);
-      },
-
-      /* ── Events ── */
-      forge_dom_on(nodeId, evtPtr, evtLen, cbPtr, ctxPtr) {
-        const el  = _nodeGet(nodeId);
-        if (!el) return;
-        const evt = _readStr(evtPtr, evtLen);
-        const key = `${nodeId}:${evt}`;
-
-        // Remove old listener if any
-        if (_eventListeners.has(key)) {
-          const old = _eventListeners.get(key);
-          el.removeEventListener(evt, old.handler);
+          wasmExports.__indirect_function_table.get(cbPtr)(0, ctxPtr);
+        } catch (e) {
+          console.error('[Forge] Event handler error:', e);
         }
-
-        const handler = (browserEvent) => {
-          // Build forge_event_t in WASM memory
-          const evBuf = new Uint8Array(_mem(), 0, 24); // scratch
-          const view  = new DataView(evBuf.buffer, 0, 24);
-          view.setUint32(0,  _fnv1a(evt),  true); // type_hash
-          view.setUint32(4,  nodeId,        true); // target_id
-          view.setInt32 (8,  browserEvent.which || 0, true);
-          view.setFloat32(12, browserEvent.clientX || 0, true);
-          view.setFloat32(16, browserEvent.clientY || 0, true);
-          const flags =
-            (browserEvent.shiftKey ? 1 : 0) |
-            (browserEvent.ctrlKey  ? 2 : 0) |
-            (browserEvent.altKey   ? 4 : 0) |
-            (browserEvent.metaKey  ? 8 : 0);
-          view.setUint32(20, flags, true);
-
-          try {
-            wasmExports.__indirect_function_table.get(cbPtr)(0, ctxPtr);
-          } catch (e) {
-            console.error('[Forge] Event handler error:', e);
-          }
-        };
-
-        el.addEventListener(evt, handler);
-        _eventListeners.set(key, { handler, cbPtr, ctxPtr });
-      },
-
-      forge_dom_off(nodeId, evtPtr, evtLen) {
-        const el  = _nodeGet(nodeId);
-        if (!el) return;
-        const evt = _readStr(evtPtr, evtLen);
-        const key = `${nodeId}:${evt}`;
-        if (_eventListeners.has(key)) {
-          el.removeEventListener(evt, _eventListeners.get(key).handler);
-          _eventListeners.delete(key);
+      };
+
+      el.addEventListener(evt, handler);
+      _eventListeners.set(key, { handler, cbPtr, ctxPtr });
+    },
+
+    forge_dom_off(nodeId, evtPtr, evtLen) {
+      const el  = _nodeGet(nodeId);
+      if (!el) return;
+      const evt = _readStr(evtPtr, evtLen);
+      const key = `${nodeId}:${evt}`;
+      if (_eventListeners.has(key)) {
+        el.removeEventListener(evt, _eventListeners.get(key).handler);
+        _eventListeners.delete(key);
+      }
+    },
+
+    forge_dom_delegate(nodeId, evtPtr, evtLen, slot, handle) {
+      const el = _nodeGet(nodeId);
+      if (!el || !handle) return;
+      el[onKey] = handle * 65536 + slot;
+      delegate(_readStr(evtPtr, evtLen));
+    },
+
+    /* ── DOM Mutation ── */
+    forge_dom_remove(nodeId) {
+      const el = _nodeGet(nodeId);
+      if (el && el.parentNode) el.parentNode.removeChild(el);
+      _nodeRemove(nodeId);
+    },
+
+    forge_dom_clear(nodeId) {
+      const el = _nodeGet(nodeId);
+      if (el) el.innerHTML = '';
+    },
+
+    /* ── RAF / Scheduling ── */
+    js_schedule_raf() {
+      requestAnimationFrame((now) => {
+        if (wasmExports && wasmExports.forge_raf_callback) {
+          wasmExports.forge_raf_callback(now);
+          // Profiled modules also trace the whole frame
+          if (wasmExports.forge_profile_count) _measure('forge:frame', now, performance.now());
         }
-      },
-
-      /* ── DOM Mutation ── */
-      forge_dom_remove(nodeId) {
-        const el = _nodeGet(nodeId);
-        if (el && el.parentNode) el.parentNode.removeChild(el);
-        _nodeRemove(nodeId);
-      },
-
-      forge_dom_clear(nodeId) {
-        const el = _nodeGet(nodeId);
-        if (el) el.innerHTML = '';
-      },
-
-      /* ── RAF / Scheduling ── */
-      js_schedule_raf() {
-        requestAnimationFrame(() => {
-          if (wasmExports && wasmExports.forge_raf_callback) {
-            wasmExports.forge_raf_callback();
-          }
-        });
-      },
-
-      /* ── Logging ── */
-      js_console_log(ptr, len) {
-        console.log('[Forge]', _readStr(ptr, len));
-      },
-
-      js_console_log_int(labelPtr, labelLen, valLo, valHi) {
-        const label = _readStr(labelPtr, labelLen);
-        const val   = valLo + valHi * 0x100000000;
-        console.log('[Forge]', label, val);
-      },
-
-      js_trap(msgPtr, msgLen) {
-        const msg = _readStr(msgPtr, msgLen);
-        throw new Error(`[Forge TRAP] ${msg}`);
-      },
-    }
+      });
+    },
+
+    /* ── Profiling (--profile builds only) ── */
+    js_now() {
+      return performance.now();
+    },
+
+    js_profile_measure(namePtr, nameLen, kind, t0, t1) {
+      _measure(`forge:${_readStr(namePtr, nameLen)} ${kind ? 'update' : 'render'}`, t0, t1);
+    },
+
+    /* ── Logging ── */
+    js_console_log(ptr, len) {
+      console.log('[Forge]', _readStr(ptr, len));
+    },
+
+    js_console_log_int(labelPtr, labelLen, valLo, valHi) {
+      const label = _readStr(labelPtr, labelLen);
+      const val   = valLo + valHi * 0x100000000;
+      console.log('[Forge]', label, val);
+    },
+
+    js_trap(msgPtr, msgLen) {
+      const msg = _readStr(msgPtr, msgLen);
+      throw new Error(`[Forge TRAP] ${msg}`);
+    },
+
+    /* ── Batched Commands ── */
+    forge_dom_flush(bufPtr, words) {
+      _drainCommands(env, bufPtr, words);
+    },
+
+    /* ── Router ── */
+    forge_router_listen(mode) {
+      _routerListen(wasmExports, mode);
+    },
+
+    forge_router_push(pathPtr, pathLen, mode) {
+      _routerPush(wasmExports, _readStr(pathPtr, pathLen), mode);
+    },
+
+    forge_router_go(delta) {
+      history.go(delta);
+    },
+
+    forge_router_load(urlPtr, urlLen) {
+      _loadWasm(_readStr(urlPtr, urlLen)).catch((e) => {
+        console.warn('[Forge] Route prefetch failed:', e);
+      });
+    },
   };
+  return { env };
+}
+
+/* ─── Statistics ──────────────────────────────────────────────────────────── */
+// forge_stats_ptr() and forge_profile_at() return offsets of the structs in
+// web.h; the field lists below follow their declaration order.
+
+const _STATS_FIELDS = ['frames', 'updates', 'queueDepth', 'queuePeak', 'queueOverflows',
+                       'domCmds', 'domFlushes', 'registryLive', 'registryCap'];
+const _MEM_FIELDS   = ['renderUsed', 'renderPeak', 'renderReserved', 'persistUsed',
+                       'persistPeak', 'persistReserved', 'ctxLive', 'ctxPeak',
+                       'blockLive', 'oomCount'];
+const _PROFILE_SIZE = 40; // forge_profile_t
+
+const _runtimes = []; // initialized exports, one per linear memory
+
+function _readStats(exports) {
+  const bytes = new Uint8Array(exports.memory.buffer);
+  const view  = new DataView(exports.memory.buffer);
+  const u32   = (off) => view.getUint32(off, true);
+  const cstr  = (ptr) => new TextDecoder().decode(bytes.subarray(ptr, bytes.indexOf(0, ptr)));
+  let off = exports.forge_stats_ptr();
+  const stats = {};
+  for (const f of _STATS_FIELDS) { stats[f] = u32(off); off += 4; }
+  stats.memory = {};
+  for (const f of _MEM_FIELDS) { stats.memory[f] = u32(off); off += 4; }
+  stats.components = [];
+  const count = exports.forge_profile_count ? exports.forge_profile_count() : 0;
+  for (let i = 0; i < count; i++) {
+    const p = exports.forge_profile_at(i);
+    stats.components.push({
+      name:      cstr(u32(p + 16)),
+      renders:   u32(p + 20),
+      updates:   u32(p + 24),
+      updaters:  u32(p + 28),
+      domCmds:   u32(p + 32),
+      renderMs:  view.getFloat64(p, true),
+      updateMs:  view.getFloat64(p + 8, true),
+    });
+  }
+  return stats;
+}
+
+// User Timing entries accumulate until cleared; keep a long session's
+// buffer bounded by dropping ours every few thousand
+const _measured = new Set();
+let _measureCount = 0;
+
+function _measure(name, start, end) {
+  if (!performance.measure) return;
+  performance.measure(name, { start, end });
+  _measured.add(name);
+  if (++_measureCount < 8192) return;
+  for (const n of _measured) performance.clearMeasures(n);
+  _measured.clear();
+  _measureCount = 0;
+}
+
+/* ─── Router ──────────────────────────────────────────────────────────────── */
+// Host side of stdlib/src/router.c.  Paths go to the module in
+// forge_props_str_alloc blocks: forge_router_dispatch keeps its block,
+// forge_router_hover's is freed here.  Hovering a link prefetches its
+// route once per page; with the generated SSR server the route's
+// resolveState() data is fetched too and kept for ForgeRuntime.routeData.
+
+const ROUTER_HASH = 0, ROUTER_HISTORY = 1;
+
+const _routeData  = new Map(); // path → Promise<state>
+const _prefetched = new Set(); // paths already hovered
+
+function _routerPath(mode) {
+  if (mode === ROUTER_HASH) return location.hash.slice(1) || '/';
+  return location.pathname || '/';
+}
+
+function _routerAlloc(exports, path) {
+  const enc = _encoder.encode(path);
+  const ptr = exports.forge_props_str_alloc(enc.length);
+  if (ptr) new Uint8Array(exports.memory.buffer, ptr, enc.length).set(enc);
+  return { ptr, len: enc.length };
+}
+
+function _routerDispatch(exports, mode) {
+  const { ptr, len } = _routerAlloc(exports, _routerPath(mode));
+  if (ptr) exports.forge_router_dispatch(ptr, len);
+}
+
+/* Same-origin, same-document links only; the path the router would see */
+function _routerLink(e) {
+  if (!e.target || !e.target.closest) return null;
+  const a = e.target.closest('a[href]');
+  if (!a || a.target || a.hasAttribute('download')) return null;
+  const url = new URL(a.href, location.href);
+  if (url.origin !== location.origin) return null;
+  if (url.hash.startsWith('#/')) return { a, path: url.hash.slice(1) };
+  return { a, path: url.pathname };
+}
+
+function _routerHover(exports, e) {
+  const link = _routerLink(e);
+  if (!link || _prefetched.has(link.path)) return;
+  _prefetched.add(link.path);
+  const { ptr, len } = _routerAlloc(exports, link.path);
+  if (!ptr) return;
+  const hit = exports.forge_router_hover(ptr, len);
+  exports.forge_props_str_free(ptr);
+  const stateUrl = typeof window !== 'undefined' && window.__FORGE_STATE_URL__;
+  if (hit && stateUrl && !_routeData.has(link.path)) {
+    _routeData.set(link.path,
+      fetch(`${stateUrl}?path=${encodeURIComponent(link.path)}`)
+        .then((r) => (r.ok ? r.json() : null))
+        .catch(() => null));
+  }
+}
+
+function _routerListen(exports, mode) {
+  addEventListener(mode === ROUTER_HASH ? 'hashchange' : 'popstate',
+                   () => _routerDispatch(exports, mode));
+  if (mode === ROUTER_HISTORY) {
+    document.addEventListener('click', (e) => {
+      if (e.defaultPrevented || e.button !== 0 ||
+          e.metaKey || e.ctrlKey || e.shiftKey || e.altKey) return;
+      const link = _routerLink(e);
+      if (!link || link.path === location.pathname) return;
+      e.preventDefault();
+      history.pushState(null, '', link.a.href);
+      _routerDispatch(exports, mode);
+    });
+  }
+  const hover = (e) => _routerHover(exports, e);
+  document.addEventListener('pointerover', hover, true);
+  document.addEventListener('focusin', hover, true);
+  _routerDispatch(exports, mode);
+}
+
+function _routerPush(exports, path, mode) {
+  if (mode === ROUTER_HASH) {
+    location.hash = path; // hashchange dispatches
+    return;
+  }
+  history.pushState(null, '', path);
+  _routerDispatch(exports, mode);
 }
 
 /* ─── Value Helpers ───────────────────────────────────────────────────────── */
@@ -307,7 +725,7 @@ function _valToString(val) {
       case 1: return String(val.v.i);
       case 2: return String(val.v.f.toFixed(6).replace(/\.?0+$/, ''));
       case 3: return val.v.b ? 'true' : 'false';
-      case 4: return _readStr(val.v.str_ptr, 256); // read until null
+      case 4: return val.v.str_ptr ? _readStr(val.v.str_ptr, val.v.str_len) : '';
       default: return '';
     }
   }
@@ -324,10 +742,157 @@ function _rawToVal(kind, lo, hi) {
   }
 }
 
+/* ─── Binary Props ────────────────────────────────────────────────────────── */
+
+/* ForgePropKind (types.h) */
+const PROP_OPAQUE = 0, PROP_INT = 1, PROP_UINT = 2, PROP_FLOAT = 3,
+      PROP_BOOL = 4, PROP_STR = 5, PROP_TEXT = 6;
+
+const _INTERN_MAX_LEN     = 64;   // longer strings are owned per instance
+const _INTERN_MAX_ENTRIES = 4096; // then new strings are owned as well
+
+const _encoder = new TextEncoder();
+
+/* Props layout of one component module, read once from the schema it
+ * exports: [count, size, fields*] then { offset: u32, kind: u16, size: u16 }
+ * per field.  `names` is the compiler's field order. */
+function _propsLayout(exports, lname, names) {
+  const view   = new DataView(exports.memory.buffer);
+  const schema = exports[`forge_props_schema_${lname}`]();
+  const count  = view.getUint32(schema, true);
+  const base   = view.getUint32(schema + 8, true);
+  const fields = [];
+  for (let i = 0; i < count; i++) {
+    const at = base + i * 8;
+    fields.push({
+      name:   names[i],
+      offset: view.getUint32(at, true),
+      kind:   view.getUint16(at + 4, true),
+      size:   view.getUint16(at + 6, true),
+    });
+  }
+  return { exports, fields, strings: new Map() };
+}
+
+function _boolProp(v) {
+  if (typeof v === 'string') return v !== 'false' && v !== '0';
+  return !!v;
+}
+
+/* Pointer to a length-prefixed copy of `str` in the module's memory.
+ * Short strings are interned for the module's lifetime; others are owned
+ * by the instance and freed when replaced or unmounted. */
+function _propString(layout, str, owned, i) {
+  const hit = layout.strings.get(str);
+  if (hit) return hit;
+  const enc = _encoder.encode(str);
+  const ptr = layout.exports.forge_props_str_alloc(enc.length);
+  if (!ptr) return 0;
+  new Uint8Array(layout.exports.memory.buffer, ptr, enc.length).set(enc);
+  if (enc.length <= _INTERN_MAX_LEN && layout.strings.size < _INTERN_MAX_ENTRIES)
+    layout.strings.set(str, ptr);
+  else
+    owned[i] = ptr;
+  return ptr;
+}
+
+/* Write the fields of `props` that differ from `prev` (the values last
+ * written for this instance, updated in place) into the Props struct at
+ * `ptr`.  Returns the change mask: bit i for field i, 31 for the rest. */
+function _writeProps(layout, ptr, props, prev) {
+  const { exports, fields } = layout;
+  const view  = new DataView(exports.memory.buffer);
+  const owned = prev.owned || (prev.owned = []);
+  let mask = 0;
+  for (let i = 0; i < fields.length; i++) {
+    const f = fields[i];
+    const v = props[f.name];
+    if (f.kind === PROP_OPAQUE || v === undefined || (i in prev && prev[i] === v)) continue;
+    prev[i] = v;
+    mask |= 1 << (i < 31 ? i : 31);
+    const at = ptr + f.offset;
+    switch (f.kind) {
+      case PROP_INT:
+      case PROP_UINT: {
+        const n = Math.trunc(Number(v)) || 0;
+        if (f.size === 1)      view.setInt8(at, n);
+        else if (f.size === 2) view.setInt16(at, n, true);
+        else if (f.size === 8) view.setBigInt64(at, BigInt(n), true);
+        else                   view.setInt32(at, n, true);
+        break;
+      }
+      case PROP_FLOAT:
+        if (f.size === 8) view.setFloat64(at, Number(v) || 0, true);
+        else              view.setFloat32(at, Number(v) || 0, true);
+        break;
+      case PROP_BOOL:
+        view.setInt32(at, _boolProp(v) ? 1 : 0, true);
+        break;
+      case PROP_STR: {
+        if (owned[i]) { exports.forge_props_str_free(owned[i]); owned[i] = 0; }
+        view.setUint32(at, v === null ? 0 : _propString(layout, String(v), owned, i), true);
+        break;
+      }
+      case PROP_TEXT: {
+        const enc = _encoder.encode(v === null ? '' : String(v)).subarray(0, f.size - 1);
+        const mem = new Uint8Array(exports.memory.buffer, at, f.size);
+        mem.set(enc);
+        mem[enc.length] = 0;
+        break;
+      }
+    }
+  }
+  return mask >>> 0;
+}
+
+/* Free the strings an instance owns (after unmount) */
+function _releaseProps(layout, prev) {
+  for (const ptr of prev.owned || [])
+    if (ptr) layout.exports.forge_props_str_free(ptr);
+  prev.owned = [];
+}
+
 /* ─── Component Registry ──────────────────────────────────────────────────── */
 
 const _componentExports = new Map();
 
+/* ─── Module Loading ──────────────────────────────────────────────────────── */
+// One fetch, compile and instance per URL.  A `forge compile --bundle` page
+// has a single URL, so all its components share the module, its runtime and
+// its linear memory; otherwise each component's .wasm is loaded once.
+
+const _modules     = new Map();     // url → Promise<exports>
+const _initialized = new WeakSet(); // exports whose forge_runtime_init ran
+
+function _loadWasm(url) {
+  const key = String(url);
+  let p = _modules.get(key);
+  if (!p) _modules.set(key, (p = _instantiateWasm(key)));
+  return p;
+}
+
+async function _instantiateWasm(url) {
+  const exports = {}; // the imports close over this; filled once instantiated
+  const imports = { env: _buildImports(url, exports) };
+  let result = null;
+  if (WebAssembly.instantiateStreaming) {
+    // Compiles while the bytes arrive; needs Content-Type: application/wasm
+    try { result = await WebAssembly.instantiateStreaming(fetch(url), imports); }
+    catch (e) { /* wrong MIME type or HTTP error: retry from bytes below */ }
+  }
+  if (!result) {
+    const res = await fetch(url);
+    if (!res.ok) throw new Error(`[Forge] Failed to load ${url}: ${res.status}`);
+    result = await WebAssembly.instantiate(await res.arrayBuffer(), imports);
+  }
+  Object.assign(exports, result.instance.exports);
+  if (!_wasmMemory && exports.memory) _wasmMemory = exports.memory;
+  if (exports.forge_runtime_init) exports.forge_runtime_init();
+  _initialized.add(exports);
+  if (exports.forge_stats_ptr) _runtimes.push(exports);
+  return exports;
+}
+
 /* ─── ForgeComponent Base Class ───────────────────────────────────────────── */
 
 class ForgeComponent extends HTMLElement {
@@ -384,30 +949,34 @@ class ForgeComponent extends HTMLElement {
 const ForgeRuntime = {
   version: '0.1.0',
 
+  /* Streams, instantiates and initializes the module at `url` once */
+  loadWasm: _loadWasm,
+
+  /* For hand-written loaders: imports for a module registered below */
   wasmImports(componentName) {
-    return _buildImports(componentName, _componentExports.get(componentName) || {});
+    let exports = _componentExports.get(componentName);
+    if (!exports) _componentExports.set(componentName, (exports = {}));
+    return _buildImports(componentName, exports);
   },
 
+  /* Name a component's exports; modules from loadWasm are already
+   * initialized, anything else is initialized here */
   registerExports(componentName, exports) {
-    _componentExports.set(componentName, exports);
-    if (!_wasmMemory && exports.memory) {
-      _wasmMemory = exports.memory;
+    const known = _componentExports.get(componentName);
+    if (known && known !== exports) Object.assign(known, exports);
+    else _componentExports.set(componentName, exports);
+    if (!_wasmMemory && exports.memory) _wasmMemory = exports.memory;
+    if (!_initialized.has(exports) && exports.forge_runtime_init) {
+      exports.forge_runtime_init();
+      _initialized.add(exports);
+      if (exports.forge_stats_ptr) _runtimes.push(exports);
     }
-    // Initialize the runtime
-    if (exports.forge_runtime_init) exports.forge_runtime_init();
   },
 
-  serializeProps(props) {
-    /* Pack props into WASM memory as a binary blob.
-     * For now: JSON encode and write as a string (fast-path: C struct copy).
-     * Production: use the compiler-generated struct layout metadata. */
-    const json = JSON.stringify(props || {});
-    const enc  = new TextEncoder().encode(json);
-    const buf  = new Uint8Array(_wasmMemory?.buffer || new ArrayBuffer(4096));
-    const ptr  = 0x10000; // scratch area offset
-    buf.set(enc, ptr);
-    return { ptr, len: enc.length };
-  },
+  /* Binary props: see "Binary Props" above */
+  propsLayout:  _propsLayout,
+  writeProps:   _writeProps,
+  releaseProps: _releaseProps,
 
   serializeEvent(event) {
     const buf  = _wasmMemory
@@ -418,6 +987,18 @@ const ForgeRuntime = {
     return { ptr: 0 };
   },
 
+  /* resolveState() data prefetched for a hovered link, or null */
+  routeData(path) {
+    return _routeData.get(path) || Promise.resolve(null);
+  },
+
+  /* One snapshot per loaded runtime (a single one with --bundle): the
+   * forge_stats_t counters, `memory` and, for --profile builds, a
+   * `components` list of per-component counters */
+  stats() {
+    return _runtimes.map(_readStats);
+  },
+
   /* Get live DOM node from WASM node ID */
   getNode: _nodeGet,
   registerNode: _nodeRegister,
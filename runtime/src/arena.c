@@ -4,6 +4,9 @@
 
 #include "arena.h"
 #include <stdint.h>
+#ifndef __wasm__
+#include <stdlib.h>
+#endif
 
 /* ─── Global Arenas ───────────────────────────────────────────────────────── */
 
@@ -16,52 +19,266 @@ Arena g_persist_arena;
 static uint8_t _render_mem[FORGE_ARENA_RENDER_SIZE]  __attribute__((aligned(8)));
 static uint8_t _persist_mem[FORGE_ARENA_PERSIST_SIZE] __attribute__((aligned(8)));
 
+static arena_oom_fn _oom_fn = 0;
+
+/* ─── Growth ──────────────────────────────────────────────────────────────── */
+
+#define WASM_PAGE 65536u
+
+static uintptr_t align_up(uintptr_t p) {
+    return (p + (FORGE_ARENA_ALIGN - 1)) & ~(uintptr_t)(FORGE_ARENA_ALIGN - 1);
+}
+
+static void zero(void *p, size_t n) {
+    uint8_t *bp = (uint8_t *)p;
+    for (size_t i = 0; i < n; i++) bp[i] = 0;
+}
+
+/* `bytes` is a multiple of WASM_PAGE.  Linear memory never shrinks, so a
+ * chunk lives as long as the arena that took it. */
+static void *chunk_memory(size_t bytes) {
+#ifdef __wasm__
+    long old = (long)__builtin_wasm_memory_grow(0, bytes / WASM_PAGE);
+    if (old < 0) return 0;
+    return (void *)((uintptr_t)old * WASM_PAGE);
+#else
+    return malloc(bytes);
+#endif
+}
+
+static void use_chunk(Arena *a, ArenaChunk *c) {
+    a->used += (size_t)(a->end - a->base); /* the rest of the old space */
+    a->chunk = c;
+    a->base  = (uint8_t *)align_up((uintptr_t)(c + 1));
+    a->ptr   = a->base;
+    a->end   = c->end;
+}
+
+/* Move to the first later chunk that can hold `size`, growing if none can */
+static int arena_grow(Arena *a, size_t size) {
+    ArenaChunk *c    = a->chunk ? a->chunk->next : a->chunks;
+    ArenaChunk *last = a->chunk;
+    for (; c; last = c, c = c->next) {
+        uint8_t *start = (uint8_t *)align_up((uintptr_t)(c + 1));
+        if ((size_t)(c->end - start) >= size) { use_chunk(a, c); return 1; }
+        a->used += (size_t)(c->end - start); /* too small: skipped */
+    }
+
+    if (size > SIZE_MAX / 2) return 0;
+    size_t need  = size + sizeof(ArenaChunk) + FORGE_ARENA_ALIGN;
+    /* A quarter of what the arena already holds, so growth stays O(log n) */
+    size_t bytes = a->reserved / 4;
+    if (bytes < FORGE_ARENA_CHUNK_SIZE) bytes = FORGE_ARENA_CHUNK_SIZE;
+    if (bytes < need) bytes = need;
+    bytes = (bytes + WASM_PAGE - 1) / WASM_PAGE * WASM_PAGE;
+    ArenaChunk *fresh = chunk_memory(bytes);
+    if (!fresh) return 0;
+    fresh->next = 0;
+    fresh->end  = (uint8_t *)fresh + bytes;
+    if (last) last->next = fresh; else a->chunks = fresh;
+    a->reserved += bytes;
+    use_chunk(a, fresh);
+    return 1;
+}
+
 /* ─── Implementation ──────────────────────────────────────────────────────── */
 
 void arena_init(Arena *a, void *base, size_t size) {
-    a->base = (uint8_t *)base;
-    a->ptr  = (uint8_t *)base;
-    a->end  = (uint8_t *)base + size;
-    a->peak = 0;
+    a->base      = (uint8_t *)base;
+    a->ptr       = (uint8_t *)base;
+    a->end       = (uint8_t *)base + size;
+    a->chunk     = 0;
+    a->chunks    = 0;
+    a->init_base = a->base;
+    a->init_end  = a->end;
+    a->used      = 0;
+    a->reserved  = size;
+    a->peak      = 0;
+    a->oom_count = 0;
 }
 
 void *arena_alloc(Arena *a, size_t size) {
     /* Align up */
-    uintptr_t p   = (uintptr_t)a->ptr;
-    uintptr_t al  = (p + (FORGE_ARENA_ALIGN - 1)) & ~(uintptr_t)(FORGE_ARENA_ALIGN - 1);
-    uint8_t  *new_ptr = (uint8_t *)al + size;
-
-    if (new_ptr > a->end) return 0; /* out of memory */
+    uint8_t *al = (uint8_t *)align_up((uintptr_t)a->ptr);
+    if (size > (size_t)(a->end - al)) {
+        if (!arena_grow(a, size)) {
+            a->oom_count++;
+            if (_oom_fn) _oom_fn(a, size);
+            return 0; /* out of memory */
+        }
+        al = a->ptr; /* chunk bases are aligned */
+    }
 
-    a->ptr = new_ptr;
+    a->ptr = al + size;
 
-    size_t used = (size_t)(a->ptr - a->base);
+    size_t used = arena_used(a);
     if (used > a->peak) a->peak = used;
 
     return (void *)al;
 }
 
+int arena_extend(Arena *a, void *p, size_t old_size, size_t new_size) {
+    uint8_t *bp = (uint8_t *)p;
+    if (bp + old_size != a->ptr) return 0;
+    if (new_size > (size_t)(a->end - bp)) return 0;
+    a->ptr = bp + new_size;
+
+    size_t used = arena_used(a);
+    if (used > a->peak) a->peak = used;
+    return 1;
+}
+
 void *arena_calloc(Arena *a, size_t count, size_t elem_size) {
+    if (elem_size && count > SIZE_MAX / elem_size) return 0;
     size_t total = count * elem_size;
     void  *p     = arena_alloc(a, total);
     if (!p) return 0;
-    /* zero-fill */
-    uint8_t *bp = (uint8_t *)p;
-    for (size_t i = 0; i < total; i++) bp[i] = 0;
+    zero(p, total);
     return p;
 }
 
 void arena_reset(Arena *a) {
-    a->ptr = a->base;
+    a->chunk = 0;
+    a->base  = a->init_base;
+    a->ptr   = a->init_base;
+    a->end   = a->init_end;
+    a->used  = 0;
 }
 
 size_t arena_remaining(const Arena *a) {
     return (size_t)(a->end - a->ptr);
 }
 
+size_t arena_used(const Arena *a) {
+    return a->used + (size_t)(a->ptr - a->base);
+}
+
+ArenaMark arena_mark(const Arena *a) {
+    ArenaMark m;
+    m.chunk = a->chunk;
+    m.base  = a->base;
+    m.ptr   = a->ptr;
+    m.end   = a->end;
+    m.used  = a->used;
+    return m;
+}
+
+void arena_rewind(Arena *a, ArenaMark m) {
+    /* Chunks entered since the mark stay linked for the next pass */
+    a->chunk = m.chunk;
+    a->base  = m.base;
+    a->ptr   = m.ptr;
+    a->end   = m.end;
+    a->used  = m.used;
+}
+
+void arena_set_oom_handler(arena_oom_fn fn) {
+    _oom_fn = fn;
+}
+
+/* ─── Pools ───────────────────────────────────────────────────────────────── */
+
+void pool_init(Pool *p, Arena *src, size_t block_size) {
+    if (block_size < sizeof(void *)) block_size = sizeof(void *);
+    p->src        = src;
+    p->block_size = (size_t)align_up(block_size);
+    p->free_list  = 0;
+    p->live       = 0;
+    p->peak       = 0;
+}
+
+void *pool_alloc(Pool *p) {
+    void *block = p->free_list;
+    if (block) p->free_list = *(void **)block;
+    else if (!(block = arena_alloc(p->src, p->block_size))) return 0;
+    zero(block, p->block_size);
+    if (++p->live > p->peak) p->peak = p->live;
+    return block;
+}
+
+void pool_free(Pool *p, void *block) {
+    if (!block) return;
+    *(void **)block = p->free_list;
+    p->free_list    = block;
+    p->live--;
+}
+
+/* ─── Size-Classed Blocks ─────────────────────────────────────────────────── */
+
+#define BLOCK_MIN_SHIFT 4   /* 16 bytes */
+#define BLOCK_CLASSES   9   /* 16 .. 4096 bytes */
+#define BLOCK_MAX       ((size_t)1 << (BLOCK_MIN_SHIFT + BLOCK_CLASSES - 1))
+
+typedef struct LargeBlock {
+    struct LargeBlock *next;
+    size_t             size;
+} LargeBlock;
+
+static Pool        _block_pools[BLOCK_CLASSES];
+static LargeBlock *_large_free = 0;
+static size_t      _block_live = 0; /* bytes handed out */
+
+static int block_class(size_t size) {
+    int k = 0;
+    while (((size_t)1 << (BLOCK_MIN_SHIFT + k)) < size) k++;
+    return k;
+}
+
+/* Large blocks are rounded to BLOCK_MAX so remounts of a component reuse
+ * the block its predecessor freed */
+static size_t large_size(size_t size) {
+    return (size + BLOCK_MAX - 1) / BLOCK_MAX * BLOCK_MAX;
+}
+
+void *forge_block_alloc(size_t size) {
+    void *block = 0;
+    if (size <= BLOCK_MAX) {
+        Pool *p = &_block_pools[block_class(size)];
+        if ((block = pool_alloc(p))) _block_live += p->block_size;
+        return block;
+    }
+
+    size = large_size(size);
+    for (LargeBlock **l = &_large_free; *l; l = &(*l)->next) {
+        if ((*l)->size == size) {
+            block = *l;
+            *l = (*l)->next;
+            zero(block, size);
+            break;
+        }
+    }
+    if (!block) block = arena_calloc(&g_persist_arena, 1, size);
+    if (block) _block_live += size;
+    return block;
+}
+
+void forge_block_free(void *block, size_t size) {
+    if (!block) return;
+    if (size <= BLOCK_MAX) {
+        Pool *p = &_block_pools[block_class(size)];
+        pool_free(p, block);
+        _block_live -= p->block_size;
+        return;
+    }
+
+    LargeBlock *b = (LargeBlock *)block;
+    b->size     = large_size(size);
+    b->next     = _large_free;
+    _large_free = b;
+    _block_live -= b->size;
+}
+
+size_t forge_block_live(void) {
+    return _block_live;
+}
+
 /* ─── Runtime Init (called once at WASM module start) ─────────────────────── */
 
 void forge_arena_init_all(void) {
     arena_init(&g_render_arena,  _render_mem,  FORGE_ARENA_RENDER_SIZE);
     arena_init(&g_persist_arena, _persist_mem, FORGE_ARENA_PERSIST_SIZE);
+    for (int k = 0; k < BLOCK_CLASSES; k++)
+        pool_init(&_block_pools[k], &g_persist_arena, (size_t)1 << (BLOCK_MIN_SHIFT + k));
+    _large_free = 0;
+    _block_live = 0;
 }
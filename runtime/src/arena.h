@@ -3,14 +3,22 @@
  *
  * A bump-pointer allocator backed by WASM linear memory.
  * Allocations are O(1) — just add to pointer.
- * No per-object free — entire arena resets between renders.
+ * No per-object free — an arena resets, or rewinds to a mark, as a whole.
+ *
+ * Each arena starts in a static block and grows in chunks taken from
+ * memory.grow (malloc on the host) when that block fills.  Chunks are kept
+ * after a reset, so a steady-state frame allocates no new memory.
  *
  *  ┌─────────────────────────────────────────────────────────────┐
  *  │  WASM Linear Memory                                          │
  *  │  ┌────────────┬──────────────┬───────────────┬──────────┐   │
- *  │  │ stack/data │ Render Arena │ Persist Arena │  free →  │   │
+ *  │  │ stack/data │ Render Arena │ Persist Arena │ chunks → │   │
  *  │  └────────────┴──────────────┴───────────────┴──────────┘   │
  *  └─────────────────────────────────────────────────────────────┘
+ *
+ * Component contexts, state and props come from pools on top of the persist
+ * arena: fixed-size blocks on free lists, so an unmounted component's memory
+ * goes to the next one mounted.
  */
 
 #ifndef FORGE_ARENA_H
@@ -19,32 +27,99 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#define FORGE_ARENA_RENDER_SIZE  (1 * 1024 * 1024)  /* 1 MB per frame  */
-#define FORGE_ARENA_PERSIST_SIZE (4 * 1024 * 1024)  /* 4 MB persistent */
+#ifndef FORGE_ARENA_RENDER_SIZE
+#define FORGE_ARENA_RENDER_SIZE  (1 * 1024 * 1024)  /* 1 MB initial per frame */
+#endif
+#ifndef FORGE_ARENA_PERSIST_SIZE
+#define FORGE_ARENA_PERSIST_SIZE (4 * 1024 * 1024)  /* 4 MB initial persistent */
+#endif
+#ifndef FORGE_ARENA_CHUNK_SIZE
+#define FORGE_ARENA_CHUNK_SIZE   (64 * 1024)        /* smallest growth step: one WASM page */
+#endif
 #define FORGE_ARENA_ALIGN        8                   /* 8-byte alignment */
 
+/* Growth chunk; the header sits at the start of the memory it describes */
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;
+    uint8_t           *end;
+} ArenaChunk;
+
 typedef struct {
-    uint8_t *base;
-    uint8_t *ptr;
-    uint8_t *end;
-    size_t   peak;    /* high-water mark for diagnostics */
+    uint8_t    *base;      /* start of the current chunk's space */
+    uint8_t    *ptr;
+    uint8_t    *end;
+    ArenaChunk *chunk;     /* current chunk, NULL while in the initial block */
+    ArenaChunk *chunks;    /* every growth chunk, oldest first */
+    uint8_t    *init_base; /* initial block */
+    uint8_t    *init_end;
+    size_t      used;      /* bytes handed out before the current chunk */
+    size_t      reserved;  /* initial block + all chunks */
+    size_t      peak;      /* high-water mark for diagnostics */
+    uint32_t    oom_count; /* allocations that failed */
 } Arena;
 
+/* Position to rewind to; nested passes mark on entry and rewind on exit */
+typedef struct {
+    ArenaChunk *chunk;
+    uint8_t    *base;
+    uint8_t    *ptr;
+    uint8_t    *end;
+    size_t      used;
+} ArenaMark;
+
 /* Initialize an arena backed by already-allocated memory */
 void arena_init(Arena *a, void *base, size_t size);
 
-/* Allocate `size` bytes from arena (returns NULL if out of space) */
+/* Allocate `size` bytes from arena, growing it if needed
+ * (returns NULL only when linear memory cannot grow) */
 void *arena_alloc(Arena *a, size_t size);
 
 /* Allocate and zero-initialize */
 void *arena_calloc(Arena *a, size_t count, size_t elem_size);
 
-/* Reset: reclaim all memory (O(1), just reset pointer) */
+/* Reset: reclaim all memory (O(1), chunks kept for reuse) */
 void arena_reset(Arena *a);
 
-/* Remaining bytes */
+/* Resize the most recent allocation `p` in place.  1 on success; 0 if
+ * something was allocated after it or the current chunk is too small. */
+int arena_extend(Arena *a, void *p, size_t old_size, size_t new_size);
+
+/* Remaining bytes before the arena must grow */
 size_t arena_remaining(const Arena *a);
 
+/* Bytes currently allocated */
+size_t arena_used(const Arena *a);
+
+/* Scoped sub-arena: everything allocated after the mark is released by
+ * the matching rewind.  Marks must be rewound innermost first. */
+ArenaMark arena_mark(const Arena *a);
+void      arena_rewind(Arena *a, ArenaMark m);
+
+/* Called when an allocation fails, with the arena and the request size */
+typedef void (*arena_oom_fn)(const Arena *a, size_t size);
+void arena_set_oom_handler(arena_oom_fn fn);
+
+/* ── Pools (fixed-size blocks with a free list) ── */
+
+typedef struct {
+    Arena  *src;
+    size_t  block_size;
+    void   *free_list;
+    size_t  live;      /* blocks handed out */
+    size_t  peak;      /* most blocks live at once */
+} Pool;
+
+void  pool_init(Pool *p, Arena *src, size_t block_size);
+void *pool_alloc(Pool *p);  /* zeroed; NULL if the arena is exhausted */
+void  pool_free(Pool *p, void *block);
+
+/* Size-classed pools over the persist arena, for state and props structs.
+ * Blocks above the largest class (4 KB) are rounded to 4 KB multiples and
+ * kept on a free list of their own, reused by blocks of the same size. */
+void *forge_block_alloc(size_t size);
+void  forge_block_free(void *block, size_t size);
+size_t forge_block_live(void); /* bytes of blocks currently allocated */
+
 /* ── Global Arenas (initialized at runtime start) ── */
 
 extern Arena g_render_arena;   /* reset each frame */
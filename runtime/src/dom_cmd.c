@@ -0,0 +1,188 @@
+/*
+ * Forge Runtime - Batched DOM Command Buffer
+ *
+ * Render code appends fixed-size commands here; the JS host executes the
+ * whole buffer in one forge_dom_flush() import call.  See dom.h for the
+ * command layout.
+ */
+
+#include "../include/forge/types.h"
+#include "../include/forge/dom.h"
+
+/* ─── Buffer State ────────────────────────────────────────────────────────── */
+
+static u32 _cmd_buf[FORGE_DOM_CMD_WORDS];
+static u32 _cmd_len = 0;
+static u32 _next_id = FORGE_DOM_CMD_ID_BASE;
+
+static u32 _cmd_total   = 0; /* for forge_stats */
+static u32 _flush_total = 0;
+
+#define NODE_ID(n)   ((u32)(uintptr_t)(n))
+#define NODE_PTR(id) ((forge_dom_node_t *)(uintptr_t)(id))
+#define STR_PTR(s)   ((u32)(uintptr_t)(s))
+#define STR_LEN(s)   ((s) ? (u32)forge_strlen(s) : 0u)
+
+void forge_dom_cmd_flush(void) {
+    if (_cmd_len == 0) return;
+    forge_dom_flush(_cmd_buf, _cmd_len);
+    _cmd_len = 0;
+    _flush_total++;
+}
+
+u32 forge_dom_cmd_count(void)   { return _cmd_total; }
+u32 forge_dom_flush_count(void) { return _flush_total; }
+
+/* Reserve `words` words, draining first if the command would not fit. */
+static u32 *cmd_reserve(u32 words) {
+    if (_cmd_len + words > FORGE_DOM_CMD_WORDS) forge_dom_cmd_flush();
+    u32 *w = &_cmd_buf[_cmd_len];
+    _cmd_len += words;
+    _cmd_total++;
+    return w;
+}
+
+/* ─── Commands ────────────────────────────────────────────────────────────── */
+
+forge_dom_node_t *forge_dom_cmd_create(forge_dom_node_t *parent, u32 tag_id,
+                                       const char *tag) {
+    u32  id = _next_id++;
+    u32 *w  = cmd_reserve(6);
+    w[0] = FORGE_CMD_CREATE;
+    w[1] = NODE_ID(parent);
+    w[2] = id;
+    w[3] = tag_id;
+    w[4] = tag_id ? 0 : STR_PTR(tag);
+    w[5] = tag_id ? 0 : STR_LEN(tag);
+    return NODE_PTR(id);
+}
+
+void forge_dom_cmd_text(forge_dom_node_t *parent, const char *text) {
+    u32 *w = cmd_reserve(4);
+    w[0] = FORGE_CMD_TEXT;
+    w[1] = NODE_ID(parent);
+    w[2] = STR_PTR(text);
+    w[3] = STR_LEN(text);
+}
+
+void forge_dom_cmd_attr(forge_dom_node_t *el, u32 attr_id, const char *name,
+                        const char *value) {
+    u32 *w = cmd_reserve(7);
+    w[0] = FORGE_CMD_ATTR;
+    w[1] = NODE_ID(el);
+    w[2] = attr_id;
+    w[3] = attr_id ? 0 : STR_PTR(name);
+    w[4] = attr_id ? 0 : STR_LEN(name);
+    w[5] = STR_PTR(value);
+    w[6] = STR_LEN(value);
+}
+
+void forge_dom_cmd_expr(forge_dom_node_t *parent, forge_expr_fn fn, void *ctx,
+                       u32 deps) {
+    u32 *w = cmd_reserve(5);
+    w[0] = FORGE_CMD_EXPR;
+    w[1] = NODE_ID(parent);
+    w[2] = (u32)(uintptr_t)fn;
+    w[3] = (u32)(uintptr_t)ctx;
+    w[4] = deps;
+}
+
+void forge_dom_cmd_attr_expr(forge_dom_node_t *el, u32 attr_id,
+                             const char *name, forge_expr_fn fn, void *ctx,
+                             u32 deps) {
+    u32 *w = cmd_reserve(8);
+    w[0] = FORGE_CMD_ATTR_EXPR;
+    w[1] = NODE_ID(el);
+    w[2] = attr_id;
+    w[3] = attr_id ? 0 : STR_PTR(name);
+    w[4] = attr_id ? 0 : STR_LEN(name);
+    w[5] = (u32)(uintptr_t)fn;
+    w[6] = (u32)(uintptr_t)ctx;
+    w[7] = deps;
+}
+
+void forge_dom_cmd_on(forge_dom_node_t *el, const char *event_name,
+                      forge_event_cb cb, forge_ctx_t *ctx) {
+    u32 *w = cmd_reserve(6);
+    w[0] = FORGE_CMD_ON;
+    w[1] = NODE_ID(el);
+    w[2] = STR_PTR(event_name);
+    w[3] = STR_LEN(event_name);
+    w[4] = (u32)(uintptr_t)cb;
+    w[5] = (u32)(uintptr_t)ctx;
+}
+
+void forge_dom_cmd_delegate(forge_dom_node_t *el, const char *event_name,
+                            u32 slot, const forge_ctx_t *ctx) {
+    u32 *w = cmd_reserve(6);
+    w[0] = FORGE_CMD_DELEGATE;
+    w[1] = NODE_ID(el);
+    w[2] = STR_PTR(event_name);
+    w[3] = STR_LEN(event_name);
+    w[4] = slot;
+    w[5] = ctx->handle;
+}
+
+forge_dom_node_t *forge_dom_cmd_component(forge_dom_node_t *parent,
+                                          const char *comp_name) {
+    u32  id = _next_id++;
+    u32 *w  = cmd_reserve(5);
+    w[0] = FORGE_CMD_COMPONENT;
+    w[1] = NODE_ID(parent);
+    w[2] = id;
+    w[3] = STR_PTR(comp_name);
+    w[4] = STR_LEN(comp_name);
+    return NODE_PTR(id);
+}
+
+void forge_dom_cmd_prop(forge_dom_node_t *el, const char *name, forge_val_t value) {
+    u32 raw[2];
+    forge_memcpy(raw, &value.v, sizeof(raw));
+    u32 *w = cmd_reserve(7);
+    w[0] = FORGE_CMD_PROP;
+    w[1] = NODE_ID(el);
+    w[2] = STR_PTR(name);
+    w[3] = STR_LEN(name);
+    w[4] = (u32)value.kind;
+    w[5] = raw[0];
+    w[6] = raw[1];
+}
+
+void forge_dom_cmd_prop_str(forge_dom_node_t *el, const char *name,
+                            const char *value) {
+    u32 *w = cmd_reserve(6);
+    w[0] = FORGE_CMD_PROP_STR;
+    w[1] = NODE_ID(el);
+    w[2] = STR_PTR(name);
+    w[3] = STR_LEN(name);
+    w[4] = STR_PTR(value);
+    w[5] = STR_LEN(value);
+}
+
+void forge_dom_cmd_remove(forge_dom_node_t *el) {
+    u32 *w = cmd_reserve(2);
+    w[0] = FORGE_CMD_REMOVE;
+    w[1] = NODE_ID(el);
+}
+
+void forge_dom_cmd_clear(forge_dom_node_t *parent) {
+    u32 *w = cmd_reserve(2);
+    w[0] = FORGE_CMD_CLEAR;
+    w[1] = NODE_ID(parent);
+}
+
+void forge_dom_cmd_clone(forge_dom_node_t *parent, const char *html) {
+    u32 *w = cmd_reserve(4);
+    w[0] = FORGE_CMD_CLONE;
+    w[1] = NODE_ID(parent);
+    w[2] = STR_PTR(html);
+    w[3] = STR_LEN(html);
+}
+
+void forge_dom_cmd_style(forge_dom_node_t *el, u32 prop, f32 value) {
+    u32 *w = cmd_reserve(4);
+    w[0] = FORGE_CMD_STYLE;
+    w[1] = NODE_ID(el);
+    w[2] = prop;
+    __builtin_memcpy(&w[3], &value, 4);
+}
@@ -0,0 +1,132 @@
+/*
+ * Forge Runtime - Memory Primitives
+ *
+ * memset / memcpy / memcmp / strlen without libc.  The implementation is
+ * chosen at compile time from the target features:
+ *
+ *   wasm32 + bulk memory   forge_memset / forge_memcpy are one memory.fill /
+ *                          memory.copy instruction
+ *   wasm32 + simd128       16 bytes per step (also memcmp / strlen)
+ *   anything else          8-byte words, single bytes only at the edges
+ *
+ * `forge compile` targets bulk memory and simd128 (--no-simd drops the
+ * latter); a native build always takes the word loops.
+ */
+
+#include "../include/forge/types.h"
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+
+typedef u64 word_t;
+typedef u64 __attribute__((may_alias)) word_alias_t; /* aligned reads of any bytes */
+
+#define WORD  sizeof(word_t)
+#define ONES  0x0101010101010101ull
+#define HIGHS 0x8080808080808080ull
+
+/* Unaligned word access; compiles to a single load / store */
+static inline word_t load_word(const u8 *p) {
+    word_t w;
+    __builtin_memcpy(&w, p, WORD);
+    return w;
+}
+
+static inline void store_word(u8 *p, word_t w) {
+    __builtin_memcpy(p, &w, WORD);
+}
+
+/* Non-zero if any byte of w is zero */
+static inline word_t has_zero(word_t w) {
+    return (w - ONES) & ~w & HIGHS;
+}
+
+/* ─── memset / memcpy ─────────────────────────────────────────────────────── */
+
+void *forge_memset(void *dst, int c, size_t n) {
+#if defined(__wasm_bulk_memory__)
+    __builtin_memset(dst, c, n); /* memory.fill */
+#else
+    u8 *p = (u8 *)dst;
+#if defined(__wasm_simd128__)
+    v128_t v = wasm_i8x16_splat((int8_t)c);
+    for (; n >= 16; p += 16, n -= 16) wasm_v128_store(p, v);
+#endif
+    word_t w = (u8)c * ONES;
+    for (; n >= 4 * WORD; p += 4 * WORD, n -= 4 * WORD) {
+        store_word(p,            w);
+        store_word(p + WORD,     w);
+        store_word(p + 2 * WORD, w);
+        store_word(p + 3 * WORD, w);
+    }
+    for (; n >= WORD; p += WORD, n -= WORD) store_word(p, w);
+    while (n--) *p++ = (u8)c;
+#endif
+    return dst;
+}
+
+void *forge_memcpy(void *dst, const void *src, size_t n) {
+#if defined(__wasm_bulk_memory__)
+    __builtin_memcpy(dst, src, n); /* memory.copy */
+#else
+    u8       *d = (u8 *)dst;
+    const u8 *s = (const u8 *)src;
+#if defined(__wasm_simd128__)
+    for (; n >= 16; d += 16, s += 16, n -= 16) wasm_v128_store(d, wasm_v128_load(s));
+#endif
+    for (; n >= 4 * WORD; d += 4 * WORD, s += 4 * WORD, n -= 4 * WORD) {
+        word_t w0 = load_word(s),            w1 = load_word(s + WORD);
+        word_t w2 = load_word(s + 2 * WORD), w3 = load_word(s + 3 * WORD);
+        store_word(d,            w0);
+        store_word(d + WORD,     w1);
+        store_word(d + 2 * WORD, w2);
+        store_word(d + 3 * WORD, w3);
+    }
+    for (; n >= WORD; d += WORD, s += WORD, n -= WORD) store_word(d, load_word(s));
+    while (n--) *d++ = *s++;
+#endif
+    return dst;
+}
+
+/* ─── memcmp / strlen ─────────────────────────────────────────────────────── */
+
+int forge_memcmp(const void *a, const void *b, size_t n) {
+    const u8 *ap = (const u8 *)a;
+    const u8 *bp = (const u8 *)b;
+    /* Skip equal blocks; the first differing byte is then within one word */
+#if defined(__wasm_simd128__)
+    for (; n >= 16; ap += 16, bp += 16, n -= 16)
+        if (!wasm_i8x16_all_true(wasm_i8x16_eq(wasm_v128_load(ap), wasm_v128_load(bp))))
+            break;
+#endif
+    for (; n >= WORD && load_word(ap) == load_word(bp); ap += WORD, bp += WORD, n -= WORD) {}
+    for (; n; ap++, bp++, n--)
+        if (*ap != *bp) return *ap - *bp;
+    return 0;
+}
+
+/*
+ * Reads whole aligned blocks, which may extend past the terminator.  An
+ * aligned block never crosses a page (or the end of linear memory), so
+ * this cannot fault, but it does trip AddressSanitizer.
+ */
+__attribute__((no_sanitize_address))
+int forge_strlen(const char *s) {
+    const u8 *p = (const u8 *)s;
+#if defined(__wasm_simd128__)
+    for (; (uintptr_t)p & 15; p++)
+        if (!*p) return (int)(p - (const u8 *)s);
+    for (;; p += 16) {
+        v128_t   v    = wasm_v128_load(p);
+        uint32_t mask = wasm_i8x16_bitmask(wasm_i8x16_eq(v, wasm_i8x16_splat(0)));
+        if (mask) return (int)(p - (const u8 *)s) + __builtin_ctz(mask);
+    }
+#else
+    for (; (uintptr_t)p & (WORD - 1); p++)
+        if (!*p) return (int)(p - (const u8 *)s);
+    while (!has_zero(*(const word_alias_t *)p)) p += WORD;
+    while (*p) p++;
+    return (int)(p - (const u8 *)s);
+#endif
+}
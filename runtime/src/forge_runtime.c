@@ -9,10 +9,12 @@
  *   - Context registry
  *   - Reactive update scheduler
  *   - Props serialization
- *   - Utility functions (sprintf, memset, etc.)
+ *   - Runtime statistics (forge_stats)
+ *   - Logging and traps (strings live in forge_str.c, mem* in forge_mem.c)
  */
 
 #include "../include/forge/types.h"
+#include "../include/forge/dom.h"
 #include "../include/forge/web.h"
 #include "arena.h"
 #include "registry.h"
@@ -33,104 +35,238 @@ extern void js_console_log_int(u32 label_ptr, u32 label_len, i64 val);
 FORGE_IMPORT("env", "js_trap")
 extern void js_trap(u32 msg_ptr, u32 msg_len) __attribute__((noreturn));
 
-/* ─── Memory Utilities ────────────────────────────────────────────────────── */
-
-void *forge_memset(void *dst, int c, size_t n) {
-    u8 *p = (u8 *)dst;
-    while (n--) *p++ = (u8)c;
-    return dst;
-}
+/* ─── Context Management ──────────────────────────────────────────────────── */
 
-void *forge_memcpy(void *dst, const void *src, size_t n) {
-    u8       *d = (u8 *)dst;
-    const u8 *s = (const u8 *)src;
-    while (n--) *d++ = *s++;
-    return dst;
-}
+/*
+ * Contexts, state and props are pooled blocks, returned by forge_ctx_free
+ * when a component unmounts.  A context freed while queued for update is
+ * taken out of the dirty queue first: the pool hands its slot straight to
+ * the next forge_ctx_new, which must not inherit the queued update.
+ */
 
-int forge_memcmp(const void *a, const void *b, size_t n) {
-    const u8 *ap = (const u8 *)a;
-    const u8 *bp = (const u8 *)b;
-    while (n--) {
-        if (*ap != *bp) return *ap - *bp;
-        ap++; bp++;
-    }
-    return 0;
-}
+static Pool _ctx_pool;
 
-int forge_strlen(const char *s) {
-    int n = 0;
-    while (*s++) n++;
-    return n;
-}
-
-/* ─── Context Management ──────────────────────────────────────────────────── */
+static void unqueue_update(forge_ctx_t *ctx);
 
 forge_ctx_t *forge_ctx_new(u32 el_id, u32 state_size, u32 props_size) {
-    forge_ctx_t *ctx = FORGE_CALLOC(1, sizeof(forge_ctx_t));
+    forge_ctx_t *ctx = pool_alloc(&_ctx_pool);
     if (!ctx) return 0;
     ctx->el_id      = el_id;
     ctx->state_size = state_size;
     ctx->props_size = props_size;
-    ctx->state      = FORGE_CALLOC(1, state_size);
-    ctx->props      = FORGE_CALLOC(1, props_size);
+    ctx->state      = forge_block_alloc(state_size);
+    ctx->props      = forge_block_alloc(props_size);
     ctx->dirty      = 0;
     ctx->update_queued = 0;
+    ctx->type_id    = 0;
+    if (!ctx->state || !ctx->props) {
+        forge_ctx_free(ctx);
+        return 0;
+    }
     return ctx;
 }
 
 forge_ctx_t *forge_ctx_get(u32 el_id)        { return registry_get(el_id); }
-void         forge_ctx_register(forge_ctx_t *ctx, u32 el_id) { registry_set(el_id, ctx); }
+forge_ctx_t *forge_ctx_resolve(u32 handle)   { return registry_resolve(handle); }
 void         forge_ctx_unregister(u32 el_id) { registry_remove(el_id); }
 
+u32 forge_ctx_register(forge_ctx_t *ctx, u32 el_id) {
+    return ctx->handle = registry_set(el_id, ctx);
+}
+
 void forge_ctx_free(forge_ctx_t *ctx) {
-    /* Memory is arena-managed, no individual free needed.
-     * Just zero out the context so the slot can be reused. */
-    if (ctx) forge_memset(ctx, 0, sizeof(forge_ctx_t));
+    if (!ctx) return;
+    if (ctx->update_queued) unqueue_update(ctx);
+    forge_block_free(ctx->state, ctx->state_size);
+    forge_block_free(ctx->props, ctx->props_size);
+    forge_memset(ctx, 0, sizeof(forge_ctx_t));
+    pool_free(&_ctx_pool, ctx);
+}
+
+/* ─── Memory Statistics ───────────────────────────────────────────────────── */
+
+static forge_mem_stats_t _mem_stats;
+
+void forge_memory_stats(forge_mem_stats_t *out) {
+    out->render_used      = (u32)arena_used(&g_render_arena);
+    out->render_peak      = (u32)g_render_arena.peak;
+    out->render_reserved  = (u32)g_render_arena.reserved;
+    out->persist_used     = (u32)arena_used(&g_persist_arena);
+    out->persist_peak     = (u32)g_persist_arena.peak;
+    out->persist_reserved = (u32)g_persist_arena.reserved;
+    out->ctx_live         = (u32)_ctx_pool.live;
+    out->ctx_peak         = (u32)_ctx_pool.peak;
+    out->block_live       = (u32)forge_block_live();
+    out->oom_count        = g_render_arena.oom_count + g_persist_arena.oom_count;
+}
+
+/* JS reads the struct through the returned linear-memory offset */
+FORGE_EXPORT u32 forge_memory_stats_ptr(void) {
+    forge_memory_stats(&_mem_stats);
+    return (u32)(uintptr_t)&_mem_stats;
+}
+
+/* Out-of-memory is reported once per arena; the counters keep the total */
+static void on_arena_oom(const Arena *a, size_t size) {
+    if (a->oom_count != 1) return;
+    forge_log_int(a == &g_render_arena ? "forge: render arena exhausted, request bytes"
+                                       : "forge: persist arena exhausted, request bytes",
+                  (i64)size);
 }
 
 /* ─── Reactive Update Scheduler ───────────────────────────────────────────── */
 
-static int _update_pending = 0;
+/*
+ * Contexts are appended to a compact queue the first time they are marked
+ * dirty in a frame, so a flush costs O(changed components) rather than a
+ * scan over every live registry slot.  Each queued context is re-rendered
+ * through the update function its component type registered.
+ */
 
-void forge_schedule_update(forge_ctx_t *ctx) {
-    ctx->update_queued = 1;
+static forge_update_fn _update_fns[FORGE_MAX_COMPONENT_TYPES];
+static u32             _update_fn_count = 0;
+
+static forge_ctx_t *_dirty_queue[FORGE_MAX_COMPONENTS];
+static u32          _dirty_count    = 0;
+static int          _dirty_overflow = 0; /* queue full: fall back to scan */
+static int          _update_pending = 0;
+
+static forge_frame_fn _frame_fns[FORGE_MAX_FRAME_FNS];
+static u32            _frame_fn_count = 0;
+static f64            _last_frame_ms  = -1; /* < 0: no frame ran just before */
+
+static u32 _frames, _updates, _queue_peak, _queue_overflows; /* forge_stats */
+
+u32 forge_register_update_fn(forge_update_fn fn) {
+    /* id 0 is reserved for "no update function" */
+    if (_update_fn_count + 1 >= FORGE_MAX_COMPONENT_TYPES) return 0;
+    _update_fns[++_update_fn_count] = fn;
+    return _update_fn_count;
+}
+
+int forge_register_frame_fn(forge_frame_fn fn) {
+    for (u32 i = 0; i < _frame_fn_count; i++)
+        if (_frame_fns[i] == fn) return 1;
+    if (_frame_fn_count == FORGE_MAX_FRAME_FNS) return 0;
+    _frame_fns[_frame_fn_count++] = fn;
+    return 1;
+}
+
+void forge_request_frame(void) {
     if (!_update_pending) {
         _update_pending = 1;
         js_schedule_raf(); /* request animation frame from JS host */
     }
 }
 
-/* Called by the JS host on the RAF callback */
-FORGE_EXPORT void forge_raf_callback(void) {
+void forge_schedule_update(forge_ctx_t *ctx) {
+    if (!ctx->update_queued) {
+        ctx->update_queued = 1;
+        if (_dirty_count < FORGE_MAX_COMPONENTS)
+            _dirty_queue[_dirty_count++] = ctx;
+        else
+            _dirty_overflow = 1;
+    }
+    forge_request_frame();
+}
+
+/* Rare (unmounted with an update pending), so a scan of the queue.  The
+ * entry is cleared rather than removed: a flush in progress keeps its
+ * index. */
+static void unqueue_update(forge_ctx_t *ctx) {
+    for (u32 i = 0; i < _dirty_count; i++)
+        if (_dirty_queue[i] == ctx) {
+            _dirty_queue[i] = 0;
+            return;
+        }
+}
+
+/* Called by the JS host on the RAF callback with the frame timestamp.
+ * Frame functions run first, while the frame is still pending, so the
+ * updates they schedule are flushed in this same frame. */
+FORGE_EXPORT void forge_raf_callback(f64 now_ms) {
+    /* The first frame after an idle gap steps by 0; long gaps (a hidden
+     * tab) are clamped so animations do not jump */
+    f64 delta = _last_frame_ms < 0 || !(now_ms >= _last_frame_ms) ? 0 : now_ms - _last_frame_ms;
+    if (delta > 100) delta = 100;
+    _frames++;
+
+    int again = 0;
+    for (u32 i = 0; i < _frame_fn_count; i++)
+        again |= _frame_fns[i]((f32)delta);
+    _last_frame_ms = again ? now_ms : -1;
+
     _update_pending = 0;
     forge_flush_updates();
+    forge_dom_cmd_flush();        /* hand the frame's DOM commands to JS */
     arena_reset(&g_render_arena); /* free frame allocations */
+    if (again) forge_request_frame();
+}
+
+static void flush_one(forge_ctx_t *ctx) {
+    u32 dirty = ctx->dirty;
+    ctx->dirty         = 0;
+    ctx->update_queued = 0;
+    /* type_id 0: the component registered no update function */
+    if (ctx->type_id && ctx->type_id <= _update_fn_count) {
+        _update_fns[ctx->type_id](ctx, dirty);
+        _updates++;
+    }
+}
+
+static void flush_scan_cb(forge_ctx_t *ctx, void *userdata) {
+    (void)userdata;
+    if (ctx->update_queued) flush_one(ctx);
 }
 
 void forge_flush_updates(void) {
-    /* Walk all registered components, re-render dirty ones */
-    /* Note: actual re-render calls are dispatched via the component's own
-     * forge_update_<name> export, which the JS runtime knows about */
+    /* Updates scheduled while flushing (parent pushing props into a child)
+     * append to the queue and are handled in this same pass. */
+    for (u32 i = 0; i < _dirty_count; i++)
+        if (_dirty_queue[i]) flush_one(_dirty_queue[i]);
+    if (_dirty_count > _queue_peak) _queue_peak = _dirty_count;
+    _dirty_count = 0;
+
+    if (_dirty_overflow) {
+        _dirty_overflow = 0;
+        _queue_overflows++;
+        registry_each(flush_scan_cb, 0);
+    }
 }
 
-/* ─── Props Serialization ──────────────────────────────────────────────────── */
+/* ─── Runtime Statistics ──────────────────────────────────────────────────── */
+
+static forge_stats_t _stats;
+
+void forge_stats(forge_stats_t *out) {
+    out->frames          = _frames;
+    out->updates         = _updates;
+    out->queue_depth     = _dirty_count;
+    out->queue_peak      = _queue_peak;
+    out->queue_overflows = _queue_overflows;
+    out->dom_cmds        = forge_dom_cmd_count();
+    out->dom_flushes     = forge_dom_flush_count();
+    out->registry_live   = (u32)registry_count();
+    out->registry_cap    = registry_capacity();
+    forge_memory_stats(&out->mem);
+}
+
+/* Same convention as forge_memory_stats_ptr */
+FORGE_EXPORT u32 forge_stats_ptr(void) {
+    forge_stats(&_stats);
+    return (u32)(uintptr_t)&_stats;
+}
+
+/* ─── Props ────────────────────────────────────────────────────────────────── */
 
 /*
- * Simple binary format (not JSON for speed):
- *   [field_count: u16]
- *   for each field:
- *     [field_index: u8] [kind: u8] [value: 8 bytes]
- *
- * For string fields:
- *     [kind=STRING] [ptr: u32] [len: u32]
+ * The JS host writes props straight into the Props struct using the schema
+ * each component exports (forge_props_schema_t), then passes a mask of the
+ * fields it changed.  These copies remain for C-to-C props transfers.
  */
 
 void forge_props_deserialize(void *props_dst, const u8 *blob, u32 len) {
-    if (!blob || len < 2) return;
-    /* For now: treat as a raw memory copy of the C struct.
-     * The JS runtime serializes props in the exact layout of the struct
-     * by using the type metadata emitted by the compiler. */
+    if (!blob || !len) return;
     forge_memcpy(props_dst, blob, len);
 }
 
@@ -140,77 +276,86 @@ void forge_props_serialize(const void *props_src, u32 props_size, u8 **out, u32
     if (*out) forge_memcpy(*out, props_src, props_size);
 }
 
+u32 forge_props_dirty(u32 changed, u32 state_count) {
+    if (!changed) return 0;
+    if (state_count >= 31) return 1u << 31;
+    u32 keep  = 31 - state_count;           /* props bits below bit 31 */
+    u32 dirty = (changed & ((1u << keep) - 1)) << state_count;
+    if (changed >> keep) dirty |= 1u << 31; /* fields sharing bit 31 */
+    return dirty;
+}
+
+/* Strings use the forge_str layout ([len][bytes][\0]), so free can size
+ * the block from the prefix */
+u32 forge_props_str_alloc(u32 len) {
+    u8 *block = forge_block_alloc((size_t)len + 5);
+    if (!block) return 0;
+    forge_memcpy(block, &len, 4);
+    block[4 + len] = 0;
+    return (u32)(uintptr_t)(block + 4);
+}
+
+void forge_props_str_free(u32 ptr) {
+    if (!ptr) return;
+    const char *s = (const char *)(uintptr_t)ptr;
+    forge_block_free((u8 *)s - 4, (size_t)forge_str_len(s) + 5);
+}
+
 /* ─── Event Routing ────────────────────────────────────────────────────────── */
 
 int forge_event_is(const forge_event_t *e, const char *event_name) {
     return e->type_hash == forge_fnv1a(event_name);
 }
 
+/*
+ * Delegated dispatch.  Each component type registers one static table, so
+ * a list of a thousand rows shares it: per element the host stores only
+ * (handle, slot).  Lookup is a binary search on (slot, type_hash).
+ */
+
+typedef struct {
+    const forge_event_slot_t *rows;
+    u32                       count;
+} EventTable;
+
+static EventTable _event_tables[FORGE_MAX_COMPONENT_TYPES];
+
+void forge_register_events(u32 type_id, const forge_event_slot_t *table, u32 count) {
+    if (type_id == 0 || type_id >= FORGE_MAX_COMPONENT_TYPES) return;
+    _event_tables[type_id].rows  = table;
+    _event_tables[type_id].count = count;
+}
+
+int forge_event_dispatch(u32 handle, u32 slot, forge_event_t *e) {
+    forge_ctx_t *ctx = forge_ctx_resolve(handle);
+    if (!ctx || ctx->type_id >= FORGE_MAX_COMPONENT_TYPES) return 0;
+    const EventTable *t = &_event_tables[ctx->type_id];
+    u32 lo = 0, hi = t->count;
+    while (lo < hi) {
+        u32 mid = (lo + hi) / 2;
+        const forge_event_slot_t *r = &t->rows[mid];
+        if (r->slot < slot || (r->slot == slot && r->type_hash < e->type_hash))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == t->count || t->rows[lo].slot != slot ||
+        t->rows[lo].type_hash != e->type_hash)
+        return 0;
+    t->rows[lo].cb(e, ctx);
+    return 1;
+}
+
 /* ─── Tagged Values ────────────────────────────────────────────────────────── */
 
 forge_val_t forge_val_int(i64 v)   { forge_val_t r; r.kind = FORGE_VAL_INT;   r.v.i = v;   return r; }
 forge_val_t forge_val_float(f64 v) { forge_val_t r; r.kind = FORGE_VAL_FLOAT; r.v.f = v;   return r; }
 forge_val_t forge_val_bool(int v)  { forge_val_t r; r.kind = FORGE_VAL_BOOL;  r.v.b = !!v; return r; }
-forge_val_t forge_val_str(u32 p)   { forge_val_t r; r.kind = FORGE_VAL_STRING;r.v.str_ptr=p;return r;}
-forge_val_t forge_val_null(void)   { forge_val_t r; r.kind = FORGE_VAL_NULL;  r.v.i = 0;   return r; }
-
-/* ─── sprintf ──────────────────────────────────────────────────────────────── */
-
-static char _sprintf_buf[4096];
-
-u32 forge_sprintf(const char *fmt, ...) {
-    /* Minimal sprintf implementation */
-    char *out = _sprintf_buf;
-    int   cap = sizeof(_sprintf_buf) - 1;
-    int   pos = 0;
-    va_list ap;
-    va_start(ap, fmt);
-
-    while (*fmt && pos < cap) {
-        if (*fmt != '%') { out[pos++] = *fmt++; continue; }
-        fmt++;
-        switch (*fmt++) {
-        case 's': {
-            const char *s = va_arg(ap, const char *);
-            if (!s) s = "(null)";
-            while (*s && pos < cap) out[pos++] = *s++;
-            break;
-        }
-        case 'd': {
-            i64 v = va_arg(ap, int);
-            if (v < 0) { out[pos++] = '-'; v = -v; }
-            char tmp[24]; int tlen = 0;
-            do { tmp[tlen++] = '0' + (int)(v % 10); v /= 10; } while (v > 0);
-            for (int k = tlen - 1; k >= 0 && pos < cap; k--) out[pos++] = tmp[k];
-            break;
-        }
-        case 'f': {
-            f64 v = va_arg(ap, double);
-            int iv = (int)v;
-            /* integer part */
-            char tmp[24]; int tlen = 0;
-            int neg = iv < 0; if (neg) { out[pos++] = '-'; iv = -iv; }
-            do { tmp[tlen++] = '0' + iv % 10; iv /= 10; } while (iv > 0);
-            for (int k = tlen - 1; k >= 0 && pos < cap; k--) out[pos++] = tmp[k];
-            /* decimal */
-            out[pos++] = '.';
-            int dec = (int)((v - (int)v) * 1000000);
-            if (dec < 0) dec = -dec;
-            char dt[8]; int dl = 0;
-            for (int k = 0; k < 6; k++) { dt[dl++] = '0' + dec % 10; dec /= 10; }
-            for (int k = dl - 1; k >= 0 && pos < cap; k--) out[pos++] = dt[k];
-            break;
-        }
-        case 'c': out[pos++] = (char)va_arg(ap, int); break;
-        case '%': out[pos++] = '%'; break;
-        default:  out[pos++] = '?'; break;
-        }
-    }
-    va_end(ap);
-    out[pos] = '\0';
-    /* Return pointer as WASM linear memory offset */
-    return (u32)(uintptr_t)out;
+forge_val_t forge_val_str(u32 p)   { return forge_val_strn(p, p ? (u32)forge_strlen((const char *)(uintptr_t)p) : 0); }
+forge_val_t forge_val_strn(u32 p, u32 n) {
+    forge_val_t r; r.kind = FORGE_VAL_STRING; r.v.str_ptr = p; r.v.str_len = n; return r;
 }
+forge_val_t forge_val_null(void)   { forge_val_t r; r.kind = FORGE_VAL_NULL;  r.v.i = 0;   return r; }
 
 /* ─── Logging ──────────────────────────────────────────────────────────────── */
 
@@ -235,6 +380,8 @@ void forge_trap(const char *msg) {
 
 FORGE_EXPORT void forge_runtime_init(void) {
     forge_arena_init_all();
+    arena_set_oom_handler(on_arena_oom);
+    pool_init(&_ctx_pool, &g_persist_arena, sizeof(forge_ctx_t));
     registry_init();
 }
 
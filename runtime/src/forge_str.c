@@ -0,0 +1,367 @@
+/*
+ * Forge Runtime - Arena String Builder
+ *
+ * Strings are built in place at the tail of an arena and grow there while
+ * nothing else allocates; otherwise they move to a block twice the size.
+ * A finished string is NUL-terminated and preceded by its u32 length:
+ *
+ *   [len: u32][bytes ...][\0]
+ *              ^ forge_str_end() / forge_sprintf() return this address
+ *
+ * so C callers and the JS host read the length instead of scanning.
+ */
+
+#include "../include/forge/types.h"
+#include "../include/forge/web.h"
+#include "arena.h"
+
+#include <stdarg.h>
+
+#define STR_PREFIX 4u
+
+static Arena *str_arena(const forge_str_t *s) {
+    return s->persist ? &g_persist_arena : &g_render_arena;
+}
+
+/* ─── Buffer ──────────────────────────────────────────────────────────────── */
+
+static forge_str_t str_begin(u32 persist, u32 cap) {
+    forge_str_t s;
+    s.persist = persist;
+    s.failed  = 0;
+    s.len     = 0;
+    s.cap     = cap < 16 ? 16 : cap;
+    u8 *block = arena_alloc(str_arena(&s), STR_PREFIX + s.cap + 1);
+    if (!block) { s.cap = 0; s.failed = 1; s.data = 0; return s; }
+    s.data = (char *)block + STR_PREFIX;
+    return s;
+}
+
+forge_str_t forge_str_frame(u32 cap)   { return str_begin(0, cap); }
+forge_str_t forge_str_persist(u32 cap) { return str_begin(1, cap); }
+
+/* Make room for `extra` more bytes; 0 if the string is now truncated */
+static int str_reserve(forge_str_t *s, u32 extra) {
+    if (s->failed) return 0;
+    if (extra <= s->cap - s->len) return 1;
+
+    u32 need = s->len + extra;
+    u32 cap  = s->cap * 2;
+    if (cap < need) cap = need;
+    Arena *a     = str_arena(s);
+    u8    *block = (u8 *)s->data - STR_PREFIX;
+    if (arena_extend(a, block, STR_PREFIX + s->cap + 1, STR_PREFIX + cap + 1)) {
+        s->cap = cap;
+        return 1;
+    }
+    u8 *grown = arena_alloc(a, STR_PREFIX + cap + 1);
+    if (!grown) { s->failed = 1; return 0; }
+    forge_memcpy(grown + STR_PREFIX, s->data, s->len);
+    s->data = (char *)grown + STR_PREFIX;
+    s->cap  = cap;
+    return 1;
+}
+
+void forge_str_append(forge_str_t *s, const char *p, u32 n) {
+    if (!str_reserve(s, n)) return;
+    forge_memcpy(s->data + s->len, p, n);
+    s->len += n;
+}
+
+void forge_str_cstr(forge_str_t *s, const char *p) {
+    if (!p) p = "(null)";
+    forge_str_append(s, p, (u32)forge_strlen(p));
+}
+
+void forge_str_char(forge_str_t *s, char c) {
+    if (!str_reserve(s, 1)) return;
+    s->data[s->len++] = c;
+}
+
+static void str_pad(forge_str_t *s, char c, int n) {
+    if (n <= 0 || !str_reserve(s, (u32)n)) return;
+    forge_memset(s->data + s->len, c, (size_t)n);
+    s->len += (u32)n;
+}
+
+char *forge_str_end(forge_str_t *s) {
+    if (!s->data) return (char *)"";
+    u32 len = s->len;
+    forge_memcpy(s->data - STR_PREFIX, &len, STR_PREFIX);
+    s->data[len] = '\0';
+    /* Give unused capacity back when the string is still the arena tail */
+    arena_extend(str_arena(s), (u8 *)s->data - STR_PREFIX,
+                 STR_PREFIX + s->cap + 1, STR_PREFIX + len + 1);
+    return s->data;
+}
+
+u32 forge_str_len(const char *finished) {
+    u32 len;
+    forge_memcpy(&len, finished - STR_PREFIX, STR_PREFIX);
+    return len;
+}
+
+/* ─── Numbers ─────────────────────────────────────────────────────────────── */
+
+static const char DIGITS2[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* Digits of v written backwards from `end`, two at a time; returns start */
+static char *fmt_u64(char *end, u64 v) {
+    while (v >= 100) {
+        const char *d = &DIGITS2[(v % 100) * 2];
+        v /= 100;
+        *--end = d[1];
+        *--end = d[0];
+    }
+    if (v >= 10) {
+        const char *d = &DIGITS2[v * 2];
+        *--end = d[1];
+        *--end = d[0];
+    } else {
+        *--end = (char)('0' + v);
+    }
+    return end;
+}
+
+static char *fmt_hex(char *end, u64 v, int upper) {
+    const char *hex = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    do { *--end = hex[v & 15]; v >>= 4; } while (v);
+    return end;
+}
+
+void forge_str_int(forge_str_t *s, i64 v) {
+    char  buf[24], *end = buf + sizeof(buf);
+    u64   mag = v < 0 ? 0 - (u64)v : (u64)v;
+    char *p   = fmt_u64(end, mag);
+    if (v < 0) *--p = '-';
+    forge_str_append(s, p, (u32)(end - p));
+}
+
+void forge_str_uint(forge_str_t *s, u64 v) {
+    char buf[24], *end = buf + sizeof(buf);
+    char *p = fmt_u64(end, v);
+    forge_str_append(s, p, (u32)(end - p));
+}
+
+static const f64 POW10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+};
+#define MAX_PRECISION 17
+
+/* Nearest integer to the exact product v * scale, ties upward as in JS
+ * toFixed: 2.005 is really 2.00499..., so "%.2f" gives "2.00".  The
+ * rounding error of the product is recovered exactly (Dekker). */
+static u64 round_scaled(f64 v, f64 scale) {
+    f64 p = v * scale;
+    if (p >= 9007199254740992.0) return (u64)p; /* 2^53: already integral */
+
+    const f64 split = 134217729.0;              /* 2^27 + 1 */
+    f64 t  = split * v,     vh = t - (t - v),         vl = v - vh;
+    f64 u  = split * scale, sh = u - (u - scale),     sl = scale - sh;
+    f64 err = ((vh * sh - p) + vh * sl + vl * sh) + vl * sl;
+
+    u64 r    = (u64)p;
+    f64 frac = (p - (f64)r) + err;              /* exact for p < 2^53 */
+    if (frac < 0)        { r--; frac += 1; }
+    if (frac >= 0.5)     r++;
+    return r;
+}
+
+/* Fixed-point text of v into buf (at least 64 bytes); returns length.
+ * Values that fit in 64 bits after scaling take one integer conversion;
+ * larger ones switch to exponent form. */
+static int fmt_fixed(char *buf, f64 v, int prec) {
+    int n = 0;
+    if (v != v) { buf[0] = 'n'; buf[1] = 'a'; buf[2] = 'n'; return 3; }
+    if (v < 0 || (v == 0 && 1 / v < 0)) { buf[n++] = '-'; v = -v; }
+    if (v > 1.7976931348623157e308) {
+        buf[n++] = 'i'; buf[n++] = 'n'; buf[n++] = 'f';
+        return n;
+    }
+    if (prec > MAX_PRECISION) prec = MAX_PRECISION;
+
+    f64  scale  = POW10[prec];
+    char tmp[24], *end = tmp + sizeof(tmp);
+    if (v * scale < 1.8e19) {
+        u64   r   = round_scaled(v, scale);
+        u64   ip  = r / (u64)scale;
+        u64   fp  = r % (u64)scale;
+        char *p   = fmt_u64(end, ip);
+        while (p < end) buf[n++] = *p++;
+        if (prec > 0) {
+            buf[n++] = '.';
+            p = fmt_u64(end, fp);
+            for (int pad = prec - (int)(end - p); pad > 0; pad--) buf[n++] = '0';
+            while (p < end) buf[n++] = *p++;
+        }
+        return n;
+    }
+
+    /* Beyond 2^64: d.ddddde+N, since the fixed digits would be noise anyway */
+    int exp10 = 0;
+    while (v >= 10) { v /= 10; exp10++; }
+    n += fmt_fixed(buf + n, v, prec < 6 ? 6 : prec);
+    buf[n++] = 'e';
+    buf[n++] = '+';
+    char *p = fmt_u64(end, (u64)exp10);
+    while (p < end) buf[n++] = *p++;
+    return n;
+}
+
+void forge_str_float(forge_str_t *s, f64 v, int precision) {
+    char buf[64];
+    int  trim = precision < 0;
+    int  n    = fmt_fixed(buf, v, trim ? 6 : precision);
+    /* Negative precision: six places with trailing zeros dropped */
+    if (trim) {
+        int dot = -1, exp = n;
+        for (int i = 0; i < n; i++) {
+            if (buf[i] == '.') dot = i;
+            else if (buf[i] == 'e') { exp = i; break; }
+        }
+        if (dot >= 0) {
+            int m = exp;
+            while (m > dot + 1 && buf[m - 1] == '0') m--;
+            if (m == dot + 1) m = dot;
+            for (int i = exp; i < n; i++) buf[m + i - exp] = buf[i];
+            n -= exp - m;
+        }
+    }
+    forge_str_append(s, buf, (u32)n);
+}
+
+/* ─── Formatting ──────────────────────────────────────────────────────────── */
+
+/*
+ * printf subset: flags "-0+ ", width and precision (digits or '*'),
+ * length modifiers hh h l ll z, and conversions d i u x X c s f F %.
+ */
+void forge_str_vfmt(forge_str_t *s, const char *fmt, va_list ap) {
+    while (*fmt) {
+        const char *lit = fmt;
+        while (*fmt && *fmt != '%') fmt++;
+        if (fmt > lit) forge_str_append(s, lit, (u32)(fmt - lit));
+        if (!*fmt) break;
+        fmt++;
+
+        int left = 0, zero = 0, plus = 0, space = 0;
+        for (;; fmt++) {
+            if      (*fmt == '-') left  = 1;
+            else if (*fmt == '0') zero  = 1;
+            else if (*fmt == '+') plus  = 1;
+            else if (*fmt == ' ') space = 1;
+            else break;
+        }
+        int width = 0, prec = -1;
+        if (*fmt == '*') {
+            width = va_arg(ap, int);
+            if (width < 0) { left = 1; width = -width; }
+            fmt++;
+        } else {
+            while (*fmt >= '0' && *fmt <= '9') width = width * 10 + (*fmt++ - '0');
+        }
+        if (*fmt == '.') {
+            fmt++;
+            prec = 0;
+            if (*fmt == '*') { prec = va_arg(ap, int); fmt++; }
+            else while (*fmt >= '0' && *fmt <= '9') prec = prec * 10 + (*fmt++ - '0');
+        }
+        int lng = 0; /* 1 = l, 2 = ll / z */
+        while (*fmt == 'h') fmt++;
+        if (*fmt == 'l') { lng = 1; fmt++; if (*fmt == 'l') { lng = 2; fmt++; } }
+        else if (*fmt == 'z') { lng = 2; fmt++; }
+
+        char  buf[64], *end = buf + sizeof(buf), *p = end;
+        char  sign = 0;
+        char  conv = *fmt ? *fmt++ : '\0';
+        switch (conv) {
+        case 'd': case 'i': {
+            i64 v = lng == 2 ? va_arg(ap, long long)
+                  : lng == 1 ? va_arg(ap, long) : va_arg(ap, int);
+            u64 mag = v < 0 ? 0 - (u64)v : (u64)v;
+            p = fmt_u64(end, mag);
+            sign = v < 0 ? '-' : plus ? '+' : space ? ' ' : 0;
+            break;
+        }
+        case 'u': case 'x': case 'X': {
+            u64 v = lng == 2 ? va_arg(ap, unsigned long long)
+                  : lng == 1 ? va_arg(ap, unsigned long) : va_arg(ap, unsigned);
+            p = conv == 'u' ? fmt_u64(end, v) : fmt_hex(end, v, conv == 'X');
+            break;
+        }
+        case 'f': case 'F': {
+            int n = fmt_fixed(buf, va_arg(ap, double), prec < 0 ? 6 : prec);
+            p = buf; end = buf + n;
+            if (*p == '-') { sign = '-'; p++; }
+            else if (plus || space) sign = plus ? '+' : ' ';
+            prec = -1; /* consumed as decimal places */
+            break;
+        }
+        case 'c':
+            buf[0] = (char)va_arg(ap, int);
+            p = buf; end = buf + 1;
+            zero = 0;
+            break;
+        case 's': {
+            const char *str = va_arg(ap, const char *);
+            if (!str) str = "(null)";
+            int n = 0;
+            while (str[n] && (prec < 0 || n < prec)) n++;
+            if (!left) str_pad(s, ' ', width - n);
+            forge_str_append(s, str, (u32)n);
+            if (left) str_pad(s, ' ', width - n);
+            continue;
+        }
+        case '%':
+            forge_str_char(s, '%');
+            continue;
+        default:
+            forge_str_char(s, '?');
+            continue;
+        }
+
+        /* Integer precision: minimum digit count */
+        int digits = (int)(end - p);
+        int zeros  = prec > digits ? prec - digits : 0;
+        int total  = digits + zeros + (sign ? 1 : 0);
+        if (prec >= 0) zero = 0;
+        if (!left && !zero) str_pad(s, ' ', width - total);
+        if (sign) forge_str_char(s, sign);
+        if (!left && zero) str_pad(s, '0', width - total);
+        str_pad(s, '0', zeros);
+        forge_str_append(s, p, (u32)digits);
+        if (left) str_pad(s, ' ', width - total);
+    }
+}
+
+void forge_str_fmt(forge_str_t *s, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    forge_str_vfmt(s, fmt, ap);
+    va_end(ap);
+}
+
+u32 forge_sprintf(const char *fmt, ...) {
+    forge_str_t s = forge_str_frame(64);
+    va_list ap;
+    va_start(ap, fmt);
+    forge_str_vfmt(&s, fmt, ap);
+    va_end(ap);
+    /* Return pointer as WASM linear memory offset */
+    return (u32)(uintptr_t)forge_str_end(&s);
+}
+
+u32 forge_str_copy(const char *p) {
+    forge_str_t s = forge_str_frame(p ? (u32)forge_strlen(p) : 8);
+    forge_str_cstr(&s, p);
+    return (u32)(uintptr_t)forge_str_end(&s);
+}
+
+forge_val_t forge_val_cstr(const char *s) {
+    u32 p = forge_str_copy(s);
+    return forge_val_strn(p, forge_str_len((const char *)(uintptr_t)p));
+}
@@ -0,0 +1,61 @@
+/*
+ * Forge Runtime - Component Profiling
+ *
+ * Counters for `forge compile --profile` builds; see "Profiling" in web.h.
+ * Only profiled components reference this file, so the archive member (and
+ * the two host imports below) stays out of every other module.
+ */
+
+#include "../include/forge/types.h"
+#include "../include/forge/dom.h"
+#include "../include/forge/web.h"
+
+/* ─── External JS Imports ─────────────────────────────────────────────────── */
+
+/* performance.now() */
+FORGE_IMPORT("env", "js_now")
+extern f64 js_now(void);
+
+/* performance.measure(), named after the component and kind */
+FORGE_IMPORT("env", "js_profile_measure")
+extern void js_profile_measure(u32 name_ptr, u32 name_len, u32 kind, f64 t0, f64 t1);
+
+/* ─── Registered Components ───────────────────────────────────────────────── */
+
+static forge_profile_t *_profiles[FORGE_MAX_PROFILES];
+static u32              _profile_count = 0;
+
+FORGE_EXPORT u32 forge_profile_count(void) { return _profile_count; }
+
+/* Linear-memory offset of the i-th entry, 0 past the end */
+FORGE_EXPORT u32 forge_profile_at(u32 i) {
+    return i < _profile_count ? (u32)(uintptr_t)_profiles[i] : 0;
+}
+
+/* ─── Brackets ────────────────────────────────────────────────────────────── */
+
+forge_profile_mark_t forge_profile_begin(forge_profile_t *p) {
+    if (!p->registered && _profile_count < FORGE_MAX_PROFILES) {
+        p->registered = 1;
+        _profiles[_profile_count++] = p;
+    }
+    forge_profile_mark_t m;
+    m.cmds = forge_dom_cmd_count();
+    m.t0   = js_now();
+    return m;
+}
+
+void forge_profile_end(forge_profile_t *p, u32 kind, forge_profile_mark_t m,
+                       u32 updaters) {
+    f64 t1 = js_now();
+    p->dom_cmds += forge_dom_cmd_count() - m.cmds;
+    if (kind == FORGE_PROFILE_RENDER) {
+        p->renders++;
+        p->render_ms += t1 - m.t0;
+    } else {
+        p->updates++;
+        p->updaters  += updaters;
+        p->update_ms += t1 - m.t0;
+    }
+    js_profile_measure((u32)(uintptr_t)p->name, (u32)forge_strlen(p->name), kind, m.t0, t1);
+}
@@ -6,61 +6,181 @@
 #include "arena.h"
 #include <stddef.h>
 
-/* ─── Hash Map (open addressing, linear probe) ────────────────────────────── */
+/* ─── Storage ─────────────────────────────────────────────────────────────── */
+
+#define GEN_BITS  (32 - FORGE_HANDLE_INDEX_BITS)
+#define GEN_MASK  ((1u << GEN_BITS) - 1)
+#define MAX_SLOTS (1u << FORGE_HANDLE_INDEX_BITS)
 
 typedef struct {
-    u32          el_id;  /* 0 = empty slot */
-    forge_ctx_t *ctx;
+    forge_ctx_t *ctx;    /* NULL = free slot */
+    u32          el_id;
+    u32          gen;    /* bumped on removal; never 0 */
+    u32          link;   /* live: position in _dense; free: next free slot + 1 */
 } RegistrySlot;
 
-static RegistrySlot _slots[FORGE_MAX_COMPONENTS];
-static int          _count = 0;
+static RegistrySlot *_slots      = 0;
+static u32           _slot_cap   = 0;
+static u32           _slot_top   = 0;  /* slots ever used */
+static u32           _free_head  = 0;  /* free slot + 1, 0 = none */
 
-void registry_init(void) {
-    for (int i = 0; i < FORGE_MAX_COMPONENTS; i++) {
-        _slots[i].el_id = 0;
-        _slots[i].ctx   = 0;
+static u32          *_dense      = 0;  /* live slot indices, unordered */
+static int           _count      = 0;
+
+static u32          *_table      = 0;  /* el_id hash: slot + 1, 0 = empty */
+static u32           _table_cap  = 0;  /* power of two, >= 2 * _slot_cap */
+static u32           _table_shift = 0;
+
+/* Fibonacci hashing: el_ids are sequential, so spread them over the table */
+static u32 home(u32 el_id) {
+    return (el_id * 2654435769u) >> _table_shift;
+}
+
+static void table_insert(u32 slot) {
+    u32 mask = _table_cap - 1;
+    u32 i    = home(_slots[slot].el_id);
+    while (_table[i]) i = (i + 1) & mask;
+    _table[i] = slot + 1;
+}
+
+/* Double every array.  Arrays come from the block pools and go back to
+ * them when replaced; on failure nothing changes. */
+static int grow(void) {
+    u32 cap = _slot_cap ? _slot_cap * 2 : FORGE_REGISTRY_INIT_CAP;
+    if (cap > MAX_SLOTS) cap = MAX_SLOTS;
+    if (cap <= _slot_cap) return 0; /* handle space exhausted */
+
+    /* The hash gets twice the slot count: load factor <= 0.5 */
+    u32 tcap = 2 * cap, shift = 32;
+    for (u32 n = tcap; n > 1; n >>= 1) shift--;
+
+    RegistrySlot *slots = forge_block_alloc(cap * sizeof(RegistrySlot));
+    u32          *dense = forge_block_alloc(cap * sizeof(u32));
+    u32          *table = forge_block_alloc(tcap * sizeof(u32)); /* zeroed */
+    if (!slots || !dense || !table) {
+        forge_block_free(slots, cap * sizeof(RegistrySlot));
+        forge_block_free(dense, cap * sizeof(u32));
+        forge_block_free(table, tcap * sizeof(u32));
+        return 0;
     }
-    _count = 0;
+    if (_slots) {
+        forge_memcpy(slots, _slots, _slot_cap * sizeof(RegistrySlot));
+        forge_memcpy(dense, _dense, _slot_cap * sizeof(u32));
+        forge_block_free(_slots, _slot_cap * sizeof(RegistrySlot));
+        forge_block_free(_dense, _slot_cap * sizeof(u32));
+        forge_block_free(_table, _table_cap * sizeof(u32));
+    }
+    _slots       = slots;
+    _dense       = dense;
+    _table       = table;
+    _slot_cap    = cap;
+    _table_cap   = tcap;
+    _table_shift = shift;
+    for (int d = 0; d < _count; d++) table_insert(_dense[d]);
+    return 1;
 }
 
-static int slot_for(u32 el_id) {
-    int idx = (int)(el_id % FORGE_MAX_COMPONENTS);
-    for (int i = 0; i < FORGE_MAX_COMPONENTS; i++) {
-        int s = (idx + i) % FORGE_MAX_COMPONENTS;
-        if (_slots[s].el_id == 0 || _slots[s].el_id == el_id) return s;
+/* Table position holding el_id, or -1 */
+static int find(u32 el_id) {
+    if (!_table_cap) return -1;
+    u32 mask = _table_cap - 1;
+    for (u32 i = home(el_id); _table[i]; i = (i + 1) & mask)
+        if (_slots[_table[i] - 1].el_id == el_id) return (int)i;
+    return -1;
+}
+
+/* Backward-shift deletion: pull later members of the probe run into the
+ * hole so no tombstones are needed and lookups stay short */
+static void table_delete(u32 i) {
+    u32 mask = _table_cap - 1;
+    _table[i] = 0;
+    for (u32 j = (i + 1) & mask; _table[j]; j = (j + 1) & mask) {
+        u32 k = home(_slots[_table[j] - 1].el_id);
+        /* Move entry j if its home is not in the cyclic range (i, j] */
+        if ((j > i && (k <= i || k > j)) || (j < i && k <= i && k > j)) {
+            _table[i] = _table[j];
+            _table[j] = 0;
+            i = j;
+        }
     }
-    return -1; /* full */
+}
+
+static u32 handle_of(u32 slot) {
+    return (_slots[slot].gen << FORGE_HANDLE_INDEX_BITS) | slot;
+}
+
+/* ─── Registry ─────────────────────────────────────────────────────────────── */
+
+void registry_init(void) {
+    if (_slots) forge_block_free(_slots, _slot_cap * sizeof(RegistrySlot));
+    if (_dense) forge_block_free(_dense, _slot_cap * sizeof(u32));
+    if (_table) forge_block_free(_table, _table_cap * sizeof(u32));
+    _slots = 0; _dense = 0; _table = 0;
+    _slot_cap = _slot_top = _free_head = _table_cap = _table_shift = 0;
+    _count = 0;
 }
 
 forge_ctx_t *registry_get(u32 el_id) {
-    int s = slot_for(el_id);
-    if (s < 0 || _slots[s].el_id != el_id) return 0;
-    return _slots[s].ctx;
+    int i = find(el_id);
+    return i < 0 ? 0 : _slots[_table[i] - 1].ctx;
 }
 
-void registry_set(u32 el_id, forge_ctx_t *ctx) {
-    int s = slot_for(el_id);
-    if (s < 0) return; /* registry full */
-    if (_slots[s].el_id == 0) _count++;
-    _slots[s].el_id = el_id;
-    _slots[s].ctx   = ctx;
+u32 registry_set(u32 el_id, forge_ctx_t *ctx) {
+    if (!ctx) { registry_remove(el_id); return 0; }
+    int i = find(el_id);
+    if (i >= 0) {
+        u32 slot = _table[i] - 1;
+        _slots[slot].ctx = ctx;
+        return handle_of(slot);
+    }
+
+    u32 slot;
+    if (_free_head) {
+        slot       = _free_head - 1;
+        _free_head = _slots[slot].link;
+    } else {
+        if (_slot_top == _slot_cap && !grow()) return 0; /* out of memory */
+        slot = _slot_top++;
+        _slots[slot].gen = 1;
+    }
+    _slots[slot].ctx   = ctx;
+    _slots[slot].el_id = el_id;
+    _slots[slot].link  = (u32)_count;
+    _dense[_count++]   = slot;
+    table_insert(slot);
+    return handle_of(slot);
 }
 
 void registry_remove(u32 el_id) {
-    int s = slot_for(el_id);
-    if (s < 0 || _slots[s].el_id != el_id) return;
-    _slots[s].el_id = 0;
-    _slots[s].ctx   = 0;
-    _count--;
+    int i = find(el_id);
+    if (i < 0) return;
+    u32 slot = _table[i] - 1;
+    table_delete((u32)i);
+
+    /* Keep _dense packed: the last live slot takes this one's place */
+    u32 pos  = _slots[slot].link;
+    u32 last = _dense[--_count];
+    _dense[pos]       = last;
+    _slots[last].link = pos;
+
+    _slots[slot].ctx  = 0;
+    _slots[slot].gen  = (_slots[slot].gen + 1) & GEN_MASK;
+    if (!_slots[slot].gen) _slots[slot].gen = 1;
+    _slots[slot].link = _free_head;
+    _free_head        = slot + 1;
 }
 
 int registry_count(void) { return _count; }
+u32 registry_capacity(void) { return _slot_cap; }
+
+forge_ctx_t *registry_resolve(u32 handle) {
+    u32 slot = handle & (MAX_SLOTS - 1);
+    if (slot >= _slot_top) return 0;
+    const RegistrySlot *s = &_slots[slot];
+    return s->ctx && s->gen == handle >> FORGE_HANDLE_INDEX_BITS ? s->ctx : 0;
+}
 
 void registry_each(registry_each_fn fn, void *userdata) {
-    for (int i = 0; i < FORGE_MAX_COMPONENTS; i++) {
-        if (_slots[i].el_id != 0 && _slots[i].ctx) {
-            fn(_slots[i].ctx, userdata);
-        }
-    }
+    for (int d = 0; d < _count; d++)
+        fn(_slots[_dense[d]].ctx, userdata);
 }
@@ -1,6 +1,13 @@
 /*
  * Forge Runtime - Component Context Registry
  * Maps DOM element IDs to live component contexts.
+ *
+ * Contexts live in stable slots.  An el_id hash table (open addressing,
+ * backward-shift deletion) finds the slot, a dense array of live slots
+ * drives iteration, and every registration gets a handle that names the
+ * slot plus a generation, so a handle kept past unmount resolves to NULL
+ * instead of whichever component reused the slot.  All three grow on
+ * demand.
  */
 
 #ifndef FORGE_REGISTRY_H
@@ -8,17 +15,27 @@
 
 #include "../include/forge/types.h"
 
+/* Contexts queued per frame before forge_flush_updates falls back to a
+ * registry scan (the registry itself has no limit) */
 #define FORGE_MAX_COMPONENTS 1024
 
+#define FORGE_REGISTRY_INIT_CAP  64  /* slots before the first growth */
+#define FORGE_HANDLE_INDEX_BITS  20  /* handle = generation << 20 | slot */
+
 /* ─── Registry ─────────────────────────────────────────────────────────────── */
 
 void         registry_init(void);
 forge_ctx_t *registry_get(u32 el_id);
-void         registry_set(u32 el_id, forge_ctx_t *ctx);
+u32          registry_set(u32 el_id, forge_ctx_t *ctx); /* handle, 0 if out of memory */
 void         registry_remove(u32 el_id);
 int          registry_count(void);
+u32          registry_capacity(void); /* slots allocated so far */
+
+/* Context for a handle from registry_set, or NULL once it was removed */
+forge_ctx_t *registry_resolve(u32 handle);
 
-/* Iterate all live contexts (for flush_updates) */
+/* Iterate all live contexts (for flush_updates).  `fn` must not register
+ * or remove contexts. */
 typedef void (*registry_each_fn)(forge_ctx_t *ctx, void *userdata);
 void registry_each(registry_each_fn fn, void *userdata);
 
@@ -6,20 +6,29 @@
  * Usage:
  *   #include <forge/animate.h>
  *
- *   // Animate a value from 0 to 100 over 300ms with ease-out
- *   forge_tween_t *t = forge_tween(0, 100, 300, FORGE_EASE_OUT,
- *                                  my_update_fn, my_done_fn, ctx);
+ *   // Animate a state field from 0 to 100 over 300ms with ease-out
+ *   forge_tween_to(forge_target_f32(ctx, &state->opacity, DIRTY_OPACITY),
+ *                  0, 100, 300, FORGE_EASE_OUT);
  *
- *   void my_update_fn(float value, void *ctx) {
- *       ((MyState*)ctx)->opacity = value;
- *       forge_schedule_update(forge_ctx_get(el_id));
- *   }
+ *   // Slide a node on the compositor, without re-rendering
+ *   forge_anim_t s = forge_spring_to(forge_target_style(el, FORGE_STYLE_TRANSLATE_X),
+ *                                    0, 170, 26);
+ *   forge_spring_set_target(s, 240);
+ *
+ * Every tween and spring lives in one structure-of-arrays pool that the
+ * runtime steps from forge_raf_callback: progress and spring physics run
+ * as plain loops over float arrays, then each result is written to its
+ * target.  Field targets are stored straight into the state struct and
+ * their component is marked dirty (re-rendered once per frame however many
+ * of its fields move); style targets become FORGE_CMD_STYLE writes and
+ * never re-render.  The loop stops requesting frames once nothing moves.
  */
 
 #ifndef FORGE_ANIMATE_H
 #define FORGE_ANIMATE_H
 
 #include <forge/types.h>
+#include <forge/dom.h>
 
 /* ─── Easing Functions ─────────────────────────────────────────────────────── */
 
@@ -35,50 +44,87 @@ typedef enum {
 
 float forge_ease(float t, ForgeEasing easing);
 
-/* ─── Tween ────────────────────────────────────────────────────────────────── */
+/* ─── Targets ──────────────────────────────────────────────────────────────── */
 
 typedef void (*forge_tween_update_fn)(float value, void *userdata);
 typedef void (*forge_tween_done_fn)  (void *userdata);
 
-typedef struct forge_tween {
-    float              from;
-    float              to;
-    float              duration_ms;
-    float              elapsed_ms;
-    ForgeEasing        easing;
-    forge_tween_update_fn on_update;
-    forge_tween_done_fn   on_done;
-    void              *userdata;
-    int                running;
-    int                id;
-} forge_tween_t;
-
-forge_tween_t *forge_tween(float from, float to, float duration_ms,
-                            ForgeEasing easing,
-                            forge_tween_update_fn on_update,
-                            forge_tween_done_fn on_done,
-                            void *userdata);
-
-void forge_tween_cancel(forge_tween_t *t);
-void forge_tween_tick(float delta_ms);   /* called by runtime RAF loop */
-
-/* ─── Spring ───────────────────────────────────────────────────────────────── */
+typedef enum {
+    FORGE_TARGET_NONE,
+    FORGE_TARGET_F32,       /* float field of a context's state */
+    FORGE_TARGET_I32,       /* int field, rounded               */
+    FORGE_TARGET_STYLE,     /* FORGE_STYLE_* property of a node */
+    FORGE_TARGET_CALLBACK,  /* on_update(value, userdata)       */
+} ForgeTargetKind;
 
 typedef struct {
-    float value;
-    float velocity;
-    float target;
-    float stiffness;  /* default: 170 */
-    float damping;    /* default: 26  */
-    float mass;       /* default: 1   */
-    forge_tween_update_fn on_update;
-    void *userdata;
-} forge_spring_t;
-
-forge_spring_t *forge_spring(float initial, float stiffness, float damping,
-                              forge_tween_update_fn on_update, void *userdata);
-void forge_spring_set_target(forge_spring_t *s, float target);
-void forge_spring_tick(forge_spring_t *s, float delta_ms);
+    ForgeTargetKind       kind;
+    forge_ctx_t          *ctx;       /* F32 / I32: marked dirty         */
+    void                 *field;     /* F32 / I32: inside ctx->state    */
+    u32                   dirty;     /* F32 / I32: ctx->dirty bits      */
+    forge_dom_node_t     *node;      /* STYLE                           */
+    u32                   prop;      /* STYLE: FORGE_STYLE_*            */
+    forge_tween_update_fn on_update; /* CALLBACK                        */
+    void                 *userdata;
+} forge_anim_target_t;
+
+static inline forge_anim_target_t forge_target_f32(forge_ctx_t *ctx, f32 *field, u32 dirty) {
+    forge_anim_target_t t = { FORGE_TARGET_F32, ctx, field, dirty, 0, 0, 0, 0 };
+    return t;
+}
+static inline forge_anim_target_t forge_target_i32(forge_ctx_t *ctx, i32 *field, u32 dirty) {
+    forge_anim_target_t t = { FORGE_TARGET_I32, ctx, field, dirty, 0, 0, 0, 0 };
+    return t;
+}
+static inline forge_anim_target_t forge_target_style(forge_dom_node_t *node, u32 prop) {
+    forge_anim_target_t t = { FORGE_TARGET_STYLE, 0, 0, 0, node, prop, 0, 0 };
+    return t;
+}
+static inline forge_anim_target_t forge_target_fn(forge_tween_update_fn fn, void *userdata) {
+    forge_anim_target_t t = { FORGE_TARGET_CALLBACK, 0, 0, 0, 0, 0, fn, userdata };
+    return t;
+}
+
+/* ─── Animations ───────────────────────────────────────────────────────────── */
+
+/* Generation-tagged handle; 0 is "no animation" and stale handles are
+ * ignored by every call below */
+typedef u32 forge_anim_t;
+
+#define FORGE_MAX_ANIMATIONS 1024
+
+/* Both return 0 when FORGE_MAX_ANIMATIONS are running, or from an update
+ * callback while the pool holds FORGE_MAX_ANIMATIONS entries finished or
+ * cancelled this tick included.  Done callbacks run after the pool is
+ * compacted and may start animations. */
+forge_anim_t forge_tween_to(forge_anim_target_t target, float from, float to,
+                            float duration_ms, ForgeEasing easing);
+forge_anim_t forge_spring_to(forge_anim_target_t target, float initial,
+                             float stiffness, float damping);  /* 170, 26 */
+
+/* Springs stay in the pool at rest, so they can be retargeted */
+void forge_spring_set_target(forge_anim_t s, float target);
+
+/* Runs once when a tween finishes (not when it is cancelled) */
+void forge_anim_on_done(forge_anim_t a, forge_tween_done_fn on_done, void *userdata);
+
+void forge_anim_cancel(forge_anim_t a);
+int  forge_anim_running(forge_anim_t a);   /* tween in flight, spring moving */
+u32  forge_anim_count(void);
+
+/* Callback forms of the above */
+forge_anim_t forge_tween(float from, float to, float duration_ms,
+                         ForgeEasing easing,
+                         forge_tween_update_fn on_update,
+                         forge_tween_done_fn on_done,
+                         void *userdata);
+forge_anim_t forge_spring(float initial, float stiffness, float damping,
+                          forge_tween_update_fn on_update, void *userdata);
+
+/* Step everything by delta_ms; returns 1 while anything still moves.
+ * Registered as a runtime frame function, so only hosts that drive
+ * frames themselves call it. */
+int forge_anim_tick(float delta_ms);
 
 /* ─── CSS Transition Helper ────────────────────────────────────────────────── */
 
@@ -47,12 +47,96 @@ void forge_http_post(const char *url, const char *body, u32 body_len,
 void forge_http_fetch(const char *url, const forge_http_opts *opts,
                       forge_http_cb cb, void *userdata);
 
+/* ─── JSON Documents ───────────────────────────────────────────────────────── */
+
+/*
+ * forge_json_parse() tokenizes a body once into a tape of values; every
+ * lookup after that is O(1) and copies nothing:
+ *
+ *   forge_json_doc_t doc;
+ *   if (forge_json_parse(&doc, (const char *)res->body, res->body_len)) {
+ *       forge_json_t items = forge_json_find(&doc, forge_json_root(&doc), "items");
+ *       for (u32 i = 0; i < forge_json_len(&doc, items); i++) {
+ *           forge_json_t item = forge_json_at(&doc, items, i);
+ *           u32 len;
+ *           const char *name = forge_json_str(&doc, forge_json_find(&doc, item, "name"), &len);
+ *           i64 price = forge_json_int(&doc, forge_json_find(&doc, item, "price"), 0);
+ *       }
+ *   }
+ *
+ * The tape lives in the render arena, like the response body, so a doc is
+ * valid until the end of the frame.  Strings are views into the body with
+ * escapes left in place (forge_json_unescape decodes them); numbers are
+ * converted when read.  Keys are compared as written, escapes included.
+ * Missing values are FORGE_JSON_NONE, which every accessor accepts.
+ */
+
+typedef enum {
+    FORGE_JSON_INVALID,   /* FORGE_JSON_NONE */
+    FORGE_JSON_NULL,
+    FORGE_JSON_FALSE,
+    FORGE_JSON_TRUE,
+    FORGE_JSON_NUMBER,
+    FORGE_JSON_STRING,
+    FORGE_JSON_ARRAY,
+    FORGE_JSON_OBJECT,
+} ForgeJsonType;
+
+typedef u32 forge_json_t;              /* value: index into the tape */
+#define FORGE_JSON_NONE     0xffffffffu
+#define FORGE_JSON_MAX_DEPTH 128
+
+typedef struct {
+    u8  type;      /* ForgeJsonType */
+    u8  escaped;   /* string holds backslash escapes */
+    u32 start;     /* byte offset; strings start after the quote */
+    u32 len;       /* bytes; containers: element / member count */
+    u32 kids;      /* containers: first entry in doc->kids */
+} forge_json_tok_t;
+
+typedef struct {
+    const char       *json;
+    u32               json_len;
+    forge_json_tok_t *toks;
+    u32               tok_count;
+    u32              *kids;        /* array elements, object keys (value = key + 1) */
+    u32              *keys;        /* member hash table, built by the first find */
+    u32               key_cap;
+    u32               key_count;
+} forge_json_doc_t;
+
+/* Returns 1, or 0 on a syntax error (or when the arena is exhausted) */
+int           forge_json_parse(forge_json_doc_t *doc, const char *json, u32 len);
+forge_json_t  forge_json_root(const forge_json_doc_t *doc);
+ForgeJsonType forge_json_type(const forge_json_doc_t *doc, forge_json_t v);
+
+/* Containers.  forge_json_len is the element / member count, 0 otherwise */
+u32          forge_json_len(const forge_json_doc_t *doc, forge_json_t v);
+forge_json_t forge_json_at(const forge_json_doc_t *doc, forge_json_t array, u32 index);
+forge_json_t forge_json_find(forge_json_doc_t *doc, forge_json_t object, const char *key);
+forge_json_t forge_json_find_n(forge_json_doc_t *doc, forge_json_t object, const char *key, u32 key_len);
+/* Member `index` of an object: its value, and its key through *key */
+forge_json_t forge_json_member(const forge_json_doc_t *doc, forge_json_t object, u32 index,
+                               forge_json_t *key);
+
+/* Scalars: `def` unless `v` has the right type */
+const char *forge_json_str(const forge_json_doc_t *doc, forge_json_t v, u32 *len);
+u32         forge_json_unescape(const forge_json_doc_t *doc, forge_json_t v, char *out, u32 cap);
+i64         forge_json_int(const forge_json_doc_t *doc, forge_json_t v, i64 def);
+f64         forge_json_num(const forge_json_doc_t *doc, forge_json_t v, f64 def);
+int         forge_json_bool(const forge_json_doc_t *doc, forge_json_t v, int def);
+
 /* ─── JSON Helpers ─────────────────────────────────────────────────────────── */
 
+/* One-off reads from a NUL-terminated string.  Each call scans from the
+ * start, skipping values up to the one it wants and allocating nothing
+ * (get_str aside), so use a forge_json_doc_t for more than a lookup or
+ * two.  A repeated key resolves to its first occurrence here. */
+
 /* Minimal JSON reader — returns pointer to value for a key */
 const char *forge_json_get(const char *json, const char *key);
 int         forge_json_get_int(const char *json, const char *key, int default_val);
-const char *forge_json_get_str(const char *json, const char *key);
+const char *forge_json_get_str(const char *json, const char *key);  /* unescaped, frame-lived */
 int         forge_json_array_len(const char *json);
 const char *forge_json_array_item(const char *json, int index);
 
@@ -11,9 +11,18 @@
  *   forge_router_add("/user/:id",user_handler,    NULL);
  *   forge_router_start();
  *
- *   void home_handler(forge_route_t *route, void *ctx) {
+ *   void home_handler(const forge_route_t *route, void *ctx) {
  *       // render home component
  *   }
+ *
+ * Patterns are split on '/' into segments: literal text, `:name` (one
+ * segment, captured) or a final `*name` (the rest of the path, captured;
+ * `*` alone is named "rest").  At each segment a literal beats a parameter,
+ * which beats a wildcard, and a failed branch falls back to the next.
+ *
+ * forge_router_start() compiles every added route into a segment trie, so
+ * a match costs one sorted-children lookup per path segment however many
+ * routes there are.  Routes added later are picked up by the next match.
  */
 
 #ifndef FORGE_ROUTER_H
@@ -21,22 +30,34 @@
 
 #include <forge/types.h>
 
-#define FORGE_ROUTER_MAX_ROUTES  64
-#define FORGE_ROUTER_MAX_PARAMS  8
-#define FORGE_ROUTER_PARAM_LEN   64
+#define FORGE_ROUTER_MAX_PARAMS  8   /* captures per route */
 
 /* ─── Route Match ──────────────────────────────────────────────────────────── */
 
+/* A capture: `name` points into the route's pattern, `value` into the
+ * matched path.  Neither is NUL-terminated. */
+typedef struct {
+    const char *name;
+    u32         name_len;
+    const char *value;
+    u32         value_len;
+} forge_route_param_t;
+
+/* Valid until the next navigation; the path is owned by the router */
 typedef struct {
-    char  path[256];
-    char  param_names[FORGE_ROUTER_MAX_PARAMS][FORGE_ROUTER_PARAM_LEN];
-    char  param_vals [FORGE_ROUTER_MAX_PARAMS][FORGE_ROUTER_PARAM_LEN];
-    int   param_count;
-    void *userdata;
+    const char          *path;
+    u32                  path_len;
+    const char          *pattern;   /* as passed to forge_router_add */
+    forge_route_param_t  params[FORGE_ROUTER_MAX_PARAMS];
+    int                  param_count;
+    void                *userdata;
 } forge_route_t;
 
 typedef void (*forge_route_handler)(const forge_route_t *route, void *userdata);
 
+/* Capture called `name`, or NULL (and *len untouched) if there is none */
+const char *forge_route_param(const forge_route_t *route, const char *name, u32 *len);
+
 /* ─── Router Mode ──────────────────────────────────────────────────────────── */
 
 typedef enum {
@@ -46,6 +67,7 @@ typedef enum {
 
 /* ─── Public API ───────────────────────────────────────────────────────────── */
 
+/* Patterns are referenced, not copied: pass literals or persistent strings */
 void forge_router_init(ForgeRouterMode mode);
 void forge_router_add(const char *pattern, forge_route_handler handler, void *userdata);
 void forge_router_start(void);
@@ -59,4 +81,29 @@ const char *forge_router_current_path(void);
 /* Register a not-found handler */
 void forge_router_not_found(forge_route_handler handler, void *userdata);
 
+/* Match `path` without navigating: fills *out and returns 1, or returns 0 */
+int forge_router_match(const char *path, u32 len, forge_route_t *out);
+
+/* ─── Prefetch ─────────────────────────────────────────────────────────────── */
+
+/*
+ * When the pointer rests on (or keyboard focus reaches) a same-origin link,
+ * the host matches its path and, for the route registered with `pattern`,
+ * starts loading `chunk` (a .wasm URL, may be NULL) and calls `prefetch`
+ * (may be NULL) with the would-be route, e.g. to warm a forge_http_get.
+ * With the generated SSR server the host also fetches the route's
+ * resolveState() result; read it with ForgeRuntime.routeData(path).
+ * Each link path is prefetched once per page.
+ */
+void forge_router_prefetch(const char *pattern, const char *chunk,
+                           forge_route_handler prefetch);
+
+/* ─── Host Entry Points ────────────────────────────────────────────────────── */
+
+/* The host hands paths over in blocks from forge_props_str_alloc. dispatch
+ * takes ownership of the block (route slices point into it); hover does
+ * not, and returns 1 if the path has a route. */
+FORGE_EXPORT void forge_router_dispatch(u32 path_ptr, u32 len);
+FORGE_EXPORT int  forge_router_hover(u32 path_ptr, u32 len);
+
 #endif /* FORGE_ROUTER_H */
@@ -15,16 +15,22 @@
  *
  *   // Initialize
  *   forge_store_t *store = forge_store_create(sizeof(AppStore));
- *   AppStore *s = forge_store_get(store);
- *   s->count = 0;
+ *   u32 COUNT = forge_store_slice(store, FORGE_STORE_FIELD(AppStore, count));
+ *   u32 USER  = forge_store_slice(store, FORGE_STORE_FIELD(AppStore, username));
  *
- *   // Update from anywhere (triggers re-render in subscribed components)
+ *   // Update from anywhere (re-renders the components reading `count`)
  *   forge_store_begin(store);
- *     forge_store_get(store)->count++;
+ *     ((AppStore *)forge_store_get(store))->count++;
  *   forge_store_commit(store);
  *
- *   // Subscribe from a component
- *   forge_store_subscribe(store, forge_ctx_get(el_id));
+ *   // Subscribe from a component, to the slices it reads
+ *   forge_store_subscribe_mask(store, forge_ctx_get(el_id), COUNT);
+ *
+ * A transaction snapshots the store at forge_store_begin() and compares
+ * each slice at forge_store_commit(), so plain writes are tracked without
+ * marking.  Changes the comparison cannot see (data behind a pointer in
+ * the store) are flagged with forge_store_touch().  A change outside every
+ * declared slice, or in a store with no slices, counts as FORGE_STORE_ALL.
  */
 
 #ifndef FORGE_STORE_H
@@ -33,16 +39,39 @@
 #include <forge/types.h>
 #include <forge/web.h>
 
-#define FORGE_STORE_MAX_SUBSCRIBERS 128
+#define FORGE_STORE_MAX_SLICES 32            /* one mask bit each */
+#define FORGE_STORE_ALL        0xffffffffu
+
+/* offset, size arguments for forge_store_slice */
+#define FORGE_STORE_FIELD(type, field) \
+    (u32)offsetof(type, field), (u32)sizeof(((type *)0)->field)
 
 /* ─── Store Handle ─────────────────────────────────────────────────────────── */
 
+typedef struct {
+    u32 offset;
+    u32 size;
+} forge_store_slice_t;
+
+typedef struct forge_store_sub  forge_store_sub_t;   /* subscribed context */
+typedef struct forge_store_memo forge_store_memo_t;  /* cached selector    */
+
 typedef struct forge_store {
-    void        *data;          /* heap pointer to user struct    */
-    u32          data_size;
-    forge_ctx_t *subscribers[FORGE_STORE_MAX_SUBSCRIBERS];
-    int          sub_count;
-    int          transaction;   /* 1 during begin/commit          */
+    void                *data;          /* heap pointer to user struct    */
+    u32                  data_size;
+    u8                  *snapshot;      /* data as of forge_store_begin   */
+    forge_store_slice_t  slices[FORGE_STORE_MAX_SLICES];
+    int                  slice_count;
+    u32                  touched;       /* forge_store_touch mask         */
+    u32                  version;       /* bumped by each changing commit */
+    u32                  slice_version[FORGE_STORE_MAX_SLICES];
+    forge_store_sub_t   *subs;          /* grown on demand, no limit      */
+    int                  sub_count;
+    int                  sub_cap;
+    forge_store_memo_t  *memos;
+    int                  memo_count;
+    int                  memo_cap;
+    int                  transaction;   /* begin/commit nesting depth     */
 } forge_store_t;
 
 /* ─── Public API ───────────────────────────────────────────────────────────── */
@@ -50,20 +79,33 @@ typedef struct forge_store {
 forge_store_t *forge_store_create(u32 data_size);
 void          *forge_store_get(forge_store_t *store);
 
-/* Mutation: bracket store changes in begin/commit to batch updates */
+/* Declare bytes [offset, offset + size) as a slice; returns its mask bit,
+ * or FORGE_STORE_ALL once FORGE_STORE_MAX_SLICES are declared */
+u32 forge_store_slice(forge_store_t *store, u32 offset, u32 size);
+
+/* Mutation: bracket store changes in begin/commit to batch updates.
+ * Transactions nest; the outermost commit notifies.  A commit with no
+ * begin open compares nothing and notifies only touched slices. */
 void forge_store_begin(forge_store_t *store);
 void forge_store_commit(forge_store_t *store);
 
+/* Mark slices changed in the current (or next) commit */
+void forge_store_touch(forge_store_t *store, u32 mask);
+
 /* Direct update (auto-commits) */
 void forge_store_update(forge_store_t *store, void (*mutate)(void *data, void *userdata), void *userdata);
 
-/* Subscription */
-void forge_store_subscribe(forge_store_t *store, forge_ctx_t *ctx);
+/* Subscription: a commit schedules an update only for contexts whose mask
+ * meets the changed slices.  Subscribing again replaces the mask. */
+void forge_store_subscribe(forge_store_t *store, forge_ctx_t *ctx);   /* FORGE_STORE_ALL */
+void forge_store_subscribe_mask(forge_store_t *store, forge_ctx_t *ctx, u32 mask);
 void forge_store_unsubscribe(forge_store_t *store, forge_ctx_t *ctx);
 
-/* Derived value (memoized getter, only recomputes when store changes) */
+/* Derived value, cached per selector and recomputed only after a commit
+ * changed one of the slices in `mask` (all of them for forge_store_select) */
 typedef forge_val_t (*forge_selector_fn)(const void *store_data);
 forge_val_t forge_store_select(forge_store_t *store, forge_selector_fn selector);
+forge_val_t forge_store_select_mask(forge_store_t *store, forge_selector_fn selector, u32 mask);
 
 /* Destroy store */
 void forge_store_free(forge_store_t *store);
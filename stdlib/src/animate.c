@@ -0,0 +1,377 @@
+/*
+ * Forge Stdlib - Animation Engine
+ *
+ * One pool of parallel arrays indexed by a dense animation index.  A tick
+ * runs three loops over all of them: tween progress, spring integration
+ * (tweens have zero stiffness, damping and velocity, so they pass through
+ * unchanged and the loop needs no branch), then the write-out to each
+ * target.  Finished or cancelled entries are only marked during the tick
+ * and compacted at its end, before any done callback runs, so those may
+ * start or cancel animations freely.  Nothing compacts while the loops
+ * run: an update callback starting an animation in a full pool gets 0.
+ *
+ * Handles name a slot and a generation; slots map to dense indices, which
+ * move when the pool is compacted.
+ */
+
+#include "../include/forge/animate.h"
+#include "../../runtime/include/forge/web.h"
+
+#define MAX          FORGE_MAX_ANIMATIONS
+#define SPRING_STEP  4.0f     /* ms per integration step, stable for k <= 1000 */
+#define SPRING_REST  0.001f   /* |v| and |x - target| below this: at rest */
+
+enum { DEAD, TWEEN, SPRING };
+
+/* ─── Pool ────────────────────────────────────────────────────────────────── */
+
+/* Stepped together */
+static f32 _progress[MAX];   /* tweens: 0 - 1 */
+static f32 _rate[MAX];       /* tweens: progress per ms; springs: 0 */
+static f32 _from[MAX];
+static f32 _to[MAX];         /* tween end, spring target */
+static f32 _value[MAX];
+static f32 _velocity[MAX];
+static f32 _stiffness[MAX];
+static f32 _damping[MAX];
+
+static u8  _kind[MAX];
+static u8  _easing[MAX];
+static u8  _moving[MAX];
+static forge_anim_target_t _target[MAX];
+static u32                 _ctx_handle[MAX];  /* field targets: ctx->handle at start */
+static forge_tween_done_fn _done[MAX];
+static void               *_done_data[MAX];
+
+static u32 _count;            /* dense entries, dead ones included */
+static u32 _dead;
+static u32 _slot_of[MAX];     /* dense index → slot */
+static u32 _index_of[MAX];    /* slot → dense index */
+static u16 _gen[MAX];         /* slot generation */
+static u32 _free_slots[MAX];
+static u32 _free_count;
+static int _ready;
+static int _ticking;          /* dense indices must not move */
+
+/* Done callbacks of tweens finished this tick, run after compaction */
+static forge_tween_done_fn _fired[MAX];
+static void               *_fired_data[MAX];
+
+static int anim_frame(f32 delta_ms) { return forge_anim_tick(delta_ms); }
+
+static u32 handle_of(u32 slot) { return (u32)_gen[slot] << 16 | (slot + 1); }
+
+/* Dense index behind a live handle, or MAX */
+static u32 index_of(forge_anim_t a) {
+    u32 slot = (a & 0xffff) - 1;
+    if (!a || slot >= MAX || _gen[slot] != a >> 16) return MAX;
+    u32 i = _index_of[slot];
+    return _kind[i] == DEAD ? MAX : i;
+}
+
+static void compact(void) {
+    u32 n = 0;
+    for (u32 i = 0; i < _count; i++) {
+        if (_kind[i] == DEAD) {
+            _free_slots[_free_count++] = _slot_of[i];
+            continue;
+        }
+        if (n != i) {
+            _progress[n]   = _progress[i];   _rate[n]      = _rate[i];
+            _from[n]       = _from[i];       _to[n]        = _to[i];
+            _value[n]      = _value[i];      _velocity[n]  = _velocity[i];
+            _stiffness[n]  = _stiffness[i];  _damping[n]   = _damping[i];
+            _kind[n]       = _kind[i];       _easing[n]    = _easing[i];
+            _moving[n]     = _moving[i];     _target[n]    = _target[i];
+            _ctx_handle[n] = _ctx_handle[i];
+            _done[n]       = _done[i];       _done_data[n] = _done_data[i];
+            _slot_of[n]    = _slot_of[i];
+            _index_of[_slot_of[n]] = n;
+        }
+        n++;
+    }
+    _count = n;
+    _dead  = 0;
+}
+
+static void kill(u32 i) {
+    _kind[i]   = DEAD;
+    _moving[i] = 0;
+    _gen[_slot_of[i]]++;
+    _dead++;
+}
+
+static u32 alloc(forge_anim_target_t target, u8 kind, f32 initial) {
+    if (!_ready) {
+        for (u32 s = 0; s < MAX; s++) _free_slots[s] = MAX - 1 - s;
+        _free_count = MAX;
+        _ready      = 1;
+    }
+    if (!_free_count && _dead && !_ticking) compact();
+    if (!_free_count || _count == MAX) return MAX;
+    if (!forge_register_frame_fn(anim_frame)) return MAX;
+
+    u32 slot = _free_slots[--_free_count];
+    u32 i    = _count++;
+    _slot_of[i]    = slot;
+    _index_of[slot] = i;
+
+    _kind[i]       = kind;
+    _moving[i]     = 1;
+    _target[i]     = target;
+    _ctx_handle[i] = target.ctx ? target.ctx->handle : 0;
+    _done[i]       = 0;
+    _done_data[i]  = 0;
+    _progress[i]   = 0;
+    _rate[i]       = 0;
+    _value[i]      = initial;
+    _from[i]       = initial;
+    _to[i]         = initial;
+    _velocity[i]   = 0;
+    _stiffness[i]  = 0;
+    _damping[i]    = 0;
+    _easing[i]     = FORGE_EASE_LINEAR;
+    forge_request_frame();
+    return i;
+}
+
+/* ─── Public API ──────────────────────────────────────────────────────────── */
+
+forge_anim_t forge_tween_to(forge_anim_target_t target, float from, float to,
+                            float duration_ms, ForgeEasing easing) {
+    u32 i = alloc(target, TWEEN, from);
+    if (i == MAX) return 0;
+    _to[i]     = to;
+    _rate[i]   = duration_ms > 0 ? 1.0f / duration_ms : 1e9f;
+    _easing[i] = (u8)easing;
+    return handle_of(_slot_of[i]);
+}
+
+forge_anim_t forge_spring_to(forge_anim_target_t target, float initial,
+                             float stiffness, float damping) {
+    u32 i = alloc(target, SPRING, initial);
+    if (i == MAX) return 0;
+    _stiffness[i] = stiffness > 0 ? stiffness : 170;
+    _damping[i]   = damping   > 0 ? damping   : 26;
+    _moving[i]    = 0; /* at rest until given a target */
+    return handle_of(_slot_of[i]);
+}
+
+void forge_spring_set_target(forge_anim_t s, float target) {
+    u32 i = index_of(s);
+    if (i == MAX || _kind[i] != SPRING || _to[i] == target) return;
+    _to[i]     = target;
+    _moving[i] = 1;
+    forge_request_frame();
+}
+
+void forge_anim_on_done(forge_anim_t a, forge_tween_done_fn on_done, void *userdata) {
+    u32 i = index_of(a);
+    if (i == MAX) return;
+    _done[i]      = on_done;
+    _done_data[i] = userdata;
+}
+
+void forge_anim_cancel(forge_anim_t a) {
+    u32 i = index_of(a);
+    if (i != MAX) kill(i);
+}
+
+int forge_anim_running(forge_anim_t a) {
+    u32 i = index_of(a);
+    return i != MAX && _moving[i];
+}
+
+u32 forge_anim_count(void) {
+    return _count - _dead;
+}
+
+forge_anim_t forge_tween(float from, float to, float duration_ms,
+                         ForgeEasing easing,
+                         forge_tween_update_fn on_update,
+                         forge_tween_done_fn on_done,
+                         void *userdata) {
+    forge_anim_t a = forge_tween_to(forge_target_fn(on_update, userdata), from, to,
+                                    duration_ms, easing);
+    forge_anim_on_done(a, on_done, userdata);
+    return a;
+}
+
+forge_anim_t forge_spring(float initial, float stiffness, float damping,
+                          forge_tween_update_fn on_update, void *userdata) {
+    return forge_spring_to(forge_target_fn(on_update, userdata), initial, stiffness, damping);
+}
+
+/* ─── Tick ────────────────────────────────────────────────────────────────── */
+
+static inline f32 absf(f32 x) { return x < 0 ? -x : x; }
+
+static void write_target(u32 i) {
+    const forge_anim_target_t *t = &_target[i];
+    f32 v = _value[i];
+    switch (t->kind) {
+    case FORGE_TARGET_F32:
+    case FORGE_TARGET_I32:
+        /* The component went away: stop instead of writing freed state */
+        if (t->ctx->handle != _ctx_handle[i]) { kill(i); return; }
+        if (t->kind == FORGE_TARGET_F32) *(f32 *)t->field = v;
+        else *(i32 *)t->field = (i32)(v < 0 ? v - 0.5f : v + 0.5f);
+        t->ctx->dirty |= t->dirty;
+        if (!t->ctx->update_queued) forge_schedule_update(t->ctx);
+        break;
+    case FORGE_TARGET_STYLE:
+        forge_dom_cmd_style(t->node, t->prop, v);
+        break;
+    case FORGE_TARGET_CALLBACK:
+        if (t->on_update) t->on_update(v, t->userdata);
+        break;
+    default:
+        break;
+    }
+}
+
+int forge_anim_tick(float delta_ms) {
+    u32 n = _count;
+    if (!n) return 0;
+    f32 dt = delta_ms > 0 ? delta_ms : 0;
+
+    for (u32 i = 0; i < n; i++) {
+        f32 p = _progress[i] + dt * _rate[i];
+        _progress[i] = p > 1 ? 1 : p;
+    }
+
+    /* Semi-implicit Euler in fixed steps; the last one takes the remainder.
+     * Stiffness and damping are per second, as in CSS-style spring APIs. */
+    for (f32 left = dt; left > 0; left -= SPRING_STEP) {
+        f32 h = (left < SPRING_STEP ? left : SPRING_STEP) * 0.001f;
+        for (u32 i = 0; i < n; i++) {
+            f32 a = -_stiffness[i] * (_value[i] - _to[i]) - _damping[i] * _velocity[i];
+            _velocity[i] += a * h;
+            _value[i]    += _velocity[i] * h;
+        }
+    }
+
+    int again = 0;
+    u32 fired = 0;
+    _ticking = 1;
+    for (u32 i = 0; i < n; i++) {
+        if (!_moving[i]) continue;
+        int finished;
+        if (_kind[i] == TWEEN) {
+            finished  = _progress[i] >= 1;
+            _value[i] = finished ? _to[i]
+                      : _from[i] + (_to[i] - _from[i]) * forge_ease(_progress[i], (ForgeEasing)_easing[i]);
+        } else {
+            finished = absf(_velocity[i]) < SPRING_REST && absf(_value[i] - _to[i]) < SPRING_REST;
+            if (finished) { _value[i] = _to[i]; _velocity[i] = 0; }
+        }
+        write_target(i);
+        if (_kind[i] == DEAD) continue;
+        if (!finished) { again = 1; continue; }
+
+        _moving[i] = 0;
+        if (_kind[i] == TWEEN) {
+            if (_done[i]) {
+                _fired[fired]      = _done[i];
+                _fired_data[fired] = _done_data[i];
+                fired++;
+            }
+            kill(i);
+        }
+    }
+    _ticking = 0;
+
+    if (_dead) compact();
+    for (u32 f = 0; f < fired; f++) _fired[f](_fired_data[f]);
+    /* Callbacks may have started animations that have not stepped yet,
+     * and compaction moved them, so look at every entry */
+    for (u32 i = 0; i < _count && !again; i++) again = _moving[i];
+    return again;
+}
+
+/* ─── Easing ──────────────────────────────────────────────────────────────── */
+
+/* libm-free approximations, accurate to ~1e-4 over the ranges used here */
+
+#define PI 3.14159265f
+
+static f32 exp2_approx(f32 x) {
+    if (x < -126) return 0;
+    i32 e = (i32)x;
+    if ((f32)e > x) e--;          /* floor */
+    f32 f = x - (f32)e;
+    f32 p = 1 + f * (0.6931472f + f * (0.2402265f + f * (0.0555041f + f * 0.0096181f)));
+    union { f32 f; u32 u; } b = { .u = (u32)(e + 127) << 23 };
+    return p * b.f;
+}
+
+static f32 sin_approx(f32 x) {
+    f32 k = x * (1 / (2 * PI));
+    k = (f32)(i32)(k < 0 ? k - 0.5f : k + 0.5f);
+    x -= k * 2 * PI;              /* [-pi, pi] */
+    f32 x2 = x * x;
+    return x * (1 - x2 / 6 * (1 - x2 / 20 * (1 - x2 / 42 * (1 - x2 / 72))));
+}
+
+static f32 bounce_out(f32 t) {
+    const f32 n = 7.5625f, d = 2.75f;
+    if (t < 1 / d)   return n * t * t;
+    if (t < 2 / d)   { t -= 1.5f / d;  return n * t * t + 0.75f; }
+    if (t < 2.5f / d) { t -= 2.25f / d; return n * t * t + 0.9375f; }
+    t -= 2.625f / d;
+    return n * t * t + 0.984375f;
+}
+
+float forge_ease(float t, ForgeEasing easing) {
+    if (t <= 0) return 0;
+    if (t >= 1) return 1;
+    f32 u = 1 - t;
+    switch (easing) {
+    case FORGE_EASE_IN:      return t * t * t;
+    case FORGE_EASE_OUT:     return 1 - u * u * u;
+    case FORGE_EASE_IN_OUT:  return t < 0.5f ? 4 * t * t * t : 1 - 4 * u * u * u;
+    /* Critically-underdamped response: e^-6t decay over 1.5 oscillations */
+    case FORGE_EASE_SPRING:  return 1 - exp2_approx(-8.656f * t) * sin_approx(3 * PI * t + PI / 2);
+    case FORGE_EASE_BOUNCE:  return bounce_out(t);
+    case FORGE_EASE_ELASTIC: return exp2_approx(-10 * t) * sin_approx((t * 10 - 0.75f) * (2 * PI / 3)) + 1;
+    default:                 return t;
+    }
+}
+
+/* ─── CSS Transition Helper ───────────────────────────────────────────────── */
+
+/* CSS has no spring curves; the overshooting ones share a back-out bezier */
+static const char *css_timing(ForgeEasing easing) {
+    switch (easing) {
+    case FORGE_EASE_IN:     return "cubic-bezier(0.32,0,0.67,0)";
+    case FORGE_EASE_OUT:    return "cubic-bezier(0.33,1,0.68,1)";
+    case FORGE_EASE_IN_OUT: return "cubic-bezier(0.65,0,0.35,1)";
+    case FORGE_EASE_SPRING:
+    case FORGE_EASE_BOUNCE:
+    case FORGE_EASE_ELASTIC: return "cubic-bezier(0.34,1.56,0.64,1)";
+    default:                return "linear";
+    }
+}
+
+void forge_dom_transition(forge_dom_node_t *el, const char *property,
+                           float duration_ms, ForgeEasing easing) {
+    forge_str_t s = forge_str_frame(64);
+    forge_str_fmt(&s, "%s %dms %s", property, (int)duration_ms, css_timing(easing));
+    forge_dom_set_style(el, "transition", 0, forge_str_end(&s));
+}
+
+/* ─── Keyframes ───────────────────────────────────────────────────────────── */
+
+float forge_keyframe_sample(const ForgeKeyframe *frames, int count, float t,
+                             ForgeEasing easing) {
+    if (count <= 0) return 0;
+    if (t <= frames[0].time) return frames[0].value;
+    for (int k = 0; k + 1 < count; k++) {
+        const ForgeKeyframe *a = &frames[k], *b = &frames[k + 1];
+        if (t >= b->time) continue;
+        f32 span = b->time - a->time;
+        f32 local = span > 0 ? (t - a->time) / span : 1;
+        return a->value + (b->value - a->value) * forge_ease(local, easing);
+    }
+    return frames[count - 1].value;
+}
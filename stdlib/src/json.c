@@ -0,0 +1,605 @@
+/*
+ * Forge Stdlib - JSON Tape
+ *
+ * Two passes over the bytes, neither of which copies them:
+ *
+ *   1. count_structural() counts `{ [ , :`.  Every value after the first
+ *      starts right after one of them, so the count bounds the tape and
+ *      everything is allocated once.  This pass and the string scan use
+ *      simd128 on wasm and 8-byte words elsewhere, as forge_mem.c does.
+ *   2. parse() writes one token per value.  Children are collected on a
+ *      stack as they are parsed and moved to doc->kids when their container
+ *      closes, so each container's children end up contiguous: arrays index
+ *      in O(1), and object members are hashed on the first find.
+ */
+
+#include "../include/forge/http.h"
+#include "../../runtime/src/arena.h"
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+
+/* ─── Byte Scans ──────────────────────────────────────────────────────────── */
+
+#define ONES  0x0101010101010101ull
+#define LOWS  0x7f7f7f7f7f7f7f7full
+
+/* High bit set in exactly the bytes of w that are zero */
+static inline u64 zero_bytes(u64 w) {
+    return ~(((w & LOWS) + LOWS) | w | LOWS);
+}
+
+static inline u64 load_word(const u8 *p) {
+    u64 w;
+    __builtin_memcpy(&w, p, 8);
+    return w;
+}
+
+static u32 count_structural(const u8 *p, u32 n) {
+    u32 count = 0;
+#if defined(__wasm_simd128__)
+    /* '[' | 0x20 == '{', and no other byte maps there */
+    const v128_t comma = wasm_i8x16_splat(','), colon = wasm_i8x16_splat(':');
+    const v128_t brace = wasm_i8x16_splat('{'), case_ = wasm_i8x16_splat(0x20);
+    for (; n >= 16; p += 16, n -= 16) {
+        v128_t v = wasm_v128_load(p);
+        v128_t m = wasm_v128_or(wasm_v128_or(wasm_i8x16_eq(v, comma), wasm_i8x16_eq(v, colon)),
+                                wasm_i8x16_eq(wasm_v128_or(v, case_), brace));
+        count += (u32)__builtin_popcount(wasm_i8x16_bitmask(m));
+    }
+#else
+    for (; n >= 8; p += 8, n -= 8) {
+        u64 w = load_word(p);
+        u64 m = zero_bytes(w ^ (',' * ONES)) | zero_bytes(w ^ (':' * ONES)) |
+                zero_bytes((w | (0x20 * ONES)) ^ ('{' * ONES));
+        count += (u32)__builtin_popcountll(m);
+    }
+#endif
+    for (; n; p++, n--)
+        count += *p == ',' || *p == ':' || *p == '[' || *p == '{';
+    return count;
+}
+
+/* Offset of the first '"' or '\\' at or after i, or len */
+static u32 find_quote(const u8 *s, u32 i, u32 len) {
+#if defined(__wasm_simd128__)
+    const v128_t quote = wasm_i8x16_splat('"'), bslash = wasm_i8x16_splat('\\');
+    for (; i + 16 <= len; i += 16) {
+        v128_t   v    = wasm_v128_load(s + i);
+        uint32_t mask = wasm_i8x16_bitmask(wasm_v128_or(wasm_i8x16_eq(v, quote),
+                                                        wasm_i8x16_eq(v, bslash)));
+        if (mask) return i + (u32)__builtin_ctz(mask);
+    }
+#else
+    for (; i + 8 <= len; i += 8) {
+        u64 w = load_word(s + i);
+        u64 m = zero_bytes(w ^ ('"' * ONES)) | zero_bytes(w ^ ('\\' * ONES));
+        if (m) return i + (u32)__builtin_ctzll(m) / 8; /* little-endian */
+    }
+#endif
+    for (; i < len; i++)
+        if (s[i] == '"' || s[i] == '\\') return i;
+    return len;
+}
+
+static inline u32 skip_ws(const u8 *s, u32 i, u32 len) {
+    while (i < len && (s[i] == ' ' || s[i] == '\n' || s[i] == '\r' || s[i] == '\t')) i++;
+    return i;
+}
+
+/* ─── Parse ───────────────────────────────────────────────────────────────── */
+
+enum { AT_VALUE, AT_KEY, AFTER_VALUE };
+
+/* String body starting after the opening quote; returns the offset after
+ * the closing quote, or 0 if the string is unterminated */
+static u32 scan_string(const u8 *s, u32 i, u32 len, forge_json_tok_t *t) {
+    t->type    = FORGE_JSON_STRING;
+    t->start   = i;
+    t->escaped = 0;
+    for (;;) {
+        i = find_quote(s, i, len);
+        if (i >= len) return 0;
+        if (s[i] == '"') break;
+        t->escaped = 1;
+        i += 2;
+    }
+    t->len = i - t->start;
+    return i + 1;
+}
+
+static int match_word(const u8 *s, u32 i, u32 len, const char *w, u32 n) {
+    return len - i >= n && forge_memcmp(s + i, w, n) == 0;
+}
+
+int forge_json_parse(forge_json_doc_t *doc, const char *json, u32 len) {
+    forge_memset(doc, 0, sizeof(*doc));
+    const u8 *s     = (const u8 *)json;
+    u32       bound = count_structural(s, len) + 1;
+
+    forge_json_tok_t *toks = FORGE_FRAME_ALLOC((size_t)bound * sizeof(forge_json_tok_t));
+    u32              *pend = FORGE_FRAME_ALLOC((size_t)bound * sizeof(u32));
+    u32              *kids = FORGE_FRAME_ALLOC((size_t)bound * sizeof(u32));
+    if (!toks || !pend || !kids) return 0;
+
+    u32 stack[FORGE_JSON_MAX_DEPTH];
+    int depth = 0;
+    u32 ntok = 0, npend = 0, nkids = 0, nkeys = 0, i = 0;
+    int state = AT_VALUE;
+
+    for (;;) {
+        i = skip_ws(s, i, len);
+        if (i >= len) return 0;
+        const forge_json_tok_t *top = depth ? &toks[stack[depth - 1]] : 0;
+
+        if (state == AFTER_VALUE) {
+            u8 close = top->type == FORGE_JSON_OBJECT ? '}' : ']';
+            if (s[i] == ',') {
+                i++;
+                state = top->type == FORGE_JSON_OBJECT ? AT_KEY : AT_VALUE;
+            } else if (s[i] == close) {
+                /* The container's children are the top of the pending stack */
+                forge_json_tok_t *c = &toks[stack[--depth]];
+                u32 base = c->kids, n = npend - base;
+                if (n) forge_memcpy(kids + nkids, pend + base, n * sizeof(u32));
+                c->kids = nkids;
+                c->len  = n;
+                nkids  += n;
+                npend   = base;
+                i++;
+                if (!depth) break;
+            } else {
+                return 0;
+            }
+            continue;
+        }
+
+        if (ntok == bound) return 0;
+        u32 ti = ntok++;
+        forge_json_tok_t *t = &toks[ti];
+
+        if (state == AT_KEY) {
+            if (s[i] != '"' || !(i = scan_string(s, i + 1, len, t))) return 0;
+            i = skip_ws(s, i, len);
+            if (i >= len || s[i] != ':') return 0;
+            i++;
+            pend[npend++] = ti;
+            nkeys++;
+            state = AT_VALUE;
+            continue;
+        }
+
+        /* AT_VALUE: object values are reached through their key */
+        if (top && top->type == FORGE_JSON_ARRAY) pend[npend++] = ti;
+        t->start   = i;
+        t->escaped = 0;
+        state      = AFTER_VALUE;
+        switch (s[i]) {
+        case '{':
+        case '[':
+            if (depth == FORGE_JSON_MAX_DEPTH) return 0;
+            t->type = s[i] == '{' ? FORGE_JSON_OBJECT : FORGE_JSON_ARRAY;
+            t->kids = npend; /* pending base until the container closes */
+            stack[depth++] = ti;
+            i = skip_ws(s, i + 1, len);
+            if (i < len && s[i] != (t->type == FORGE_JSON_OBJECT ? '}' : ']'))
+                state = t->type == FORGE_JSON_OBJECT ? AT_KEY : AT_VALUE;
+            continue;
+        case '"':
+            if (!(i = scan_string(s, i + 1, len, t))) return 0;
+            break;
+        case 't':
+            if (!match_word(s, i, len, "true", 4)) return 0;
+            t->type = FORGE_JSON_TRUE;  t->len = 4; i += 4;
+            break;
+        case 'f':
+            if (!match_word(s, i, len, "false", 5)) return 0;
+            t->type = FORGE_JSON_FALSE; t->len = 5; i += 5;
+            break;
+        case 'n':
+            if (!match_word(s, i, len, "null", 4)) return 0;
+            t->type = FORGE_JSON_NULL;  t->len = 4; i += 4;
+            break;
+        default: {
+            /* Validated loosely here; forge_json_num reads what it can */
+            u32 e = i;
+            while (e < len && ((s[e] >= '0' && s[e] <= '9') || s[e] == '-' || s[e] == '+' ||
+                               s[e] == '.' || s[e] == 'e' || s[e] == 'E'))
+                e++;
+            if (e == i) return 0;
+            t->type = FORGE_JSON_NUMBER;
+            t->len  = e - i;
+            i       = e;
+            break;
+        }
+        }
+        if (!depth) break;
+    }
+
+    if (skip_ws(s, i, len) != len) return 0; /* trailing content */
+    doc->json      = json;
+    doc->json_len  = len;
+    doc->toks      = toks;
+    doc->tok_count = ntok;
+    doc->kids      = kids;
+    doc->key_count = nkeys;
+    return 1;
+}
+
+/* ─── Navigation ──────────────────────────────────────────────────────────── */
+
+static inline const forge_json_tok_t *tok(const forge_json_doc_t *doc, forge_json_t v) {
+    return v < doc->tok_count ? &doc->toks[v] : 0;
+}
+
+forge_json_t forge_json_root(const forge_json_doc_t *doc) {
+    return doc->tok_count ? 0 : FORGE_JSON_NONE;
+}
+
+ForgeJsonType forge_json_type(const forge_json_doc_t *doc, forge_json_t v) {
+    const forge_json_tok_t *t = tok(doc, v);
+    return t ? (ForgeJsonType)t->type : FORGE_JSON_INVALID;
+}
+
+u32 forge_json_len(const forge_json_doc_t *doc, forge_json_t v) {
+    const forge_json_tok_t *t = tok(doc, v);
+    return t && (t->type == FORGE_JSON_ARRAY || t->type == FORGE_JSON_OBJECT) ? t->len : 0;
+}
+
+forge_json_t forge_json_at(const forge_json_doc_t *doc, forge_json_t array, u32 index) {
+    const forge_json_tok_t *t = tok(doc, array);
+    if (!t || t->type != FORGE_JSON_ARRAY || index >= t->len) return FORGE_JSON_NONE;
+    return doc->kids[t->kids + index];
+}
+
+forge_json_t forge_json_member(const forge_json_doc_t *doc, forge_json_t object, u32 index,
+                               forge_json_t *key) {
+    const forge_json_tok_t *t = tok(doc, object);
+    if (!t || t->type != FORGE_JSON_OBJECT || index >= t->len) {
+        if (key) *key = FORGE_JSON_NONE;
+        return FORGE_JSON_NONE;
+    }
+    u32 k = doc->kids[t->kids + index];
+    if (key) *key = k;
+    return k + 1;
+}
+
+/* ─── Member Hash ─────────────────────────────────────────────────────────── */
+
+/* Open addressing over (object, key) pairs: keys[2h] is the object,
+ * keys[2h + 1] the key token + 1, 0 when the slot is empty */
+
+static u32 key_hash(forge_json_t object, const char *key, u32 len) {
+    u32 h = 2166136261u ^ object;
+    for (u32 i = 0; i < len; i++) {
+        h ^= (u8)key[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int build_keys(forge_json_doc_t *doc) {
+    u32 cap = 16;
+    while (cap < doc->key_count * 2) cap *= 2;
+    u32 *keys = FORGE_FRAME_ALLOC((size_t)cap * 2 * sizeof(u32));
+    if (!keys) return 0;
+    forge_memset(keys, 0, (size_t)cap * 2 * sizeof(u32));
+
+    for (u32 o = 0; o < doc->tok_count; o++) {
+        const forge_json_tok_t *t = &doc->toks[o];
+        if (t->type != FORGE_JSON_OBJECT) continue;
+        for (u32 m = 0; m < t->len; m++) {
+            u32 k = doc->kids[t->kids + m];
+            const forge_json_tok_t *kt = &doc->toks[k];
+            const char *name = doc->json + kt->start;
+            u32 h = key_hash(o, name, kt->len) & (cap - 1);
+            /* A repeated key takes the slot of the earlier one: last wins,
+             * as in JSON.parse */
+            while (keys[2 * h + 1]) {
+                const forge_json_tok_t *ot = &doc->toks[keys[2 * h + 1] - 1];
+                if (keys[2 * h] == o && ot->len == kt->len &&
+                    forge_memcmp(doc->json + ot->start, name, kt->len) == 0)
+                    break;
+                h = (h + 1) & (cap - 1);
+            }
+            keys[2 * h]     = o;
+            keys[2 * h + 1] = k + 1;
+        }
+    }
+    doc->keys    = keys;
+    doc->key_cap = cap;
+    return 1;
+}
+
+forge_json_t forge_json_find_n(forge_json_doc_t *doc, forge_json_t object, const char *key, u32 key_len) {
+    const forge_json_tok_t *t = tok(doc, object);
+    if (!t || t->type != FORGE_JSON_OBJECT || !t->len) return FORGE_JSON_NONE;
+    if (!doc->keys && !build_keys(doc)) return FORGE_JSON_NONE;
+
+    u32 mask = doc->key_cap - 1;
+    for (u32 h = key_hash(object, key, key_len) & mask; doc->keys[2 * h + 1]; h = (h + 1) & mask) {
+        const forge_json_tok_t *kt = &doc->toks[doc->keys[2 * h + 1] - 1];
+        if (doc->keys[2 * h] == object && kt->len == key_len &&
+            forge_memcmp(doc->json + kt->start, key, key_len) == 0)
+            return doc->keys[2 * h + 1]; /* key + 1: the value */
+    }
+    return FORGE_JSON_NONE;
+}
+
+forge_json_t forge_json_find(forge_json_doc_t *doc, forge_json_t object, const char *key) {
+    return forge_json_find_n(doc, object, key, (u32)forge_strlen(key));
+}
+
+/* ─── Scalars ─────────────────────────────────────────────────────────────── */
+
+const char *forge_json_str(const forge_json_doc_t *doc, forge_json_t v, u32 *len) {
+    const forge_json_tok_t *t = tok(doc, v);
+    if (!t || t->type != FORGE_JSON_STRING) {
+        if (len) *len = 0;
+        return 0;
+    }
+    if (len) *len = t->len;
+    return doc->json + t->start;
+}
+
+static u32 hex4(const char *p) {
+    u32 v = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = p[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9')      v |= (u32)(c - '0');
+        else if (c >= 'a' && c <= 'f') v |= (u32)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') v |= (u32)(c - 'A' + 10);
+        else return 0xfffd;
+    }
+    return v;
+}
+
+/* Writes at most cap - 1 bytes and a NUL; returns the bytes written */
+static u32 unescape(const char *s, u32 len, char *out, u32 cap) {
+    if (!cap) return 0;
+    u32 o = 0;
+    for (u32 i = 0; i < len && o + 1 < cap; i++) {
+        char c = s[i];
+        if (c != '\\' || i + 1 >= len) { out[o++] = c; continue; }
+        c = s[++i];
+        u32 cp = 0;
+        switch (c) {
+        case 'b': out[o++] = '\b'; continue;
+        case 'f': out[o++] = '\f'; continue;
+        case 'n': out[o++] = '\n'; continue;
+        case 'r': out[o++] = '\r'; continue;
+        case 't': out[o++] = '\t'; continue;
+        case 'u':
+            if (i + 4 >= len) { i = len; continue; }
+            cp = hex4(s + i + 1);
+            i += 4;
+            /* Surrogate pair */
+            if (cp >= 0xd800 && cp < 0xdc00 && i + 6 < len && s[i + 1] == '\\' && s[i + 2] == 'u') {
+                u32 lo = hex4(s + i + 3);
+                if (lo >= 0xdc00 && lo < 0xe000) {
+                    cp = 0x10000 + ((cp - 0xd800) << 10) + (lo - 0xdc00);
+                    i += 6;
+                }
+            }
+            break;
+        default: out[o++] = c; continue; /* \" \\ \/ */
+        }
+        /* UTF-8 encode cp, dropping it if it does not fit */
+        u8  buf[4];
+        u32 n;
+        if (cp < 0x80)         { buf[0] = (u8)cp; n = 1; }
+        else if (cp < 0x800)   { buf[0] = (u8)(0xc0 | cp >> 6);  buf[1] = (u8)(0x80 | (cp & 0x3f)); n = 2; }
+        else if (cp < 0x10000) { buf[0] = (u8)(0xe0 | cp >> 12); buf[1] = (u8)(0x80 | ((cp >> 6) & 0x3f));
+                                 buf[2] = (u8)(0x80 | (cp & 0x3f)); n = 3; }
+        else                   { buf[0] = (u8)(0xf0 | cp >> 18); buf[1] = (u8)(0x80 | ((cp >> 12) & 0x3f));
+                                 buf[2] = (u8)(0x80 | ((cp >> 6) & 0x3f)); buf[3] = (u8)(0x80 | (cp & 0x3f)); n = 4; }
+        if (o + n >= cap) break;
+        forge_memcpy(out + o, buf, n);
+        o += n;
+    }
+    out[o] = 0;
+    return o;
+}
+
+u32 forge_json_unescape(const forge_json_doc_t *doc, forge_json_t v, char *out, u32 cap) {
+    u32 len;
+    const char *s = forge_json_str(doc, v, &len);
+    if (!s) {
+        if (cap) out[0] = 0;
+        return 0;
+    }
+    return unescape(s, len, out, cap);
+}
+
+f64 forge_json_num(const forge_json_doc_t *doc, forge_json_t v, f64 def) {
+    const forge_json_tok_t *t = tok(doc, v);
+    if (!t || t->type != FORGE_JSON_NUMBER) return def;
+    const char *p = doc->json + t->start, *end = p + t->len;
+
+    int neg = p < end && *p == '-';
+    if (neg) p++;
+    f64 x = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; p++) x = x * 10 + (*p - '0');
+    if (p < end && *p == '.') {
+        f64 scale = 0.1;
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, scale *= 0.1) x += (*p - '0') * scale;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        int eneg = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+')) p++;
+        int e = 0;
+        for (; p < end && *p >= '0' && *p <= '9' && e < 400; p++) e = e * 10 + (*p - '0');
+        f64 f = 10;
+        for (; e; e >>= 1, f *= f)
+            if (e & 1) x = eneg ? x / f : x * f;
+    }
+    return neg ? -x : x;
+}
+
+i64 forge_json_int(const forge_json_doc_t *doc, forge_json_t v, i64 def) {
+    const forge_json_tok_t *t = tok(doc, v);
+    if (!t || t->type != FORGE_JSON_NUMBER) return def;
+    const char *p = doc->json + t->start, *end = p + t->len;
+
+    int neg = *p == '-';
+    if (neg) p++;
+    u64 x = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; p++) x = x * 10 + (u64)(*p - '0');
+    if (p < end) return (i64)forge_json_num(doc, v, (f64)def); /* fraction or exponent */
+    return neg ? -(i64)x : (i64)x;
+}
+
+int forge_json_bool(const forge_json_doc_t *doc, forge_json_t v, int def) {
+    ForgeJsonType type = forge_json_type(doc, v);
+    if (type == FORGE_JSON_TRUE)  return 1;
+    if (type == FORGE_JSON_FALSE) return 0;
+    return def;
+}
+
+/* ─── String Helpers ──────────────────────────────────────────────────────── */
+
+/*
+ * One-off reads skip through the bytes to the value they want instead of
+ * building a tape: nothing is allocated, and a lookup stops at its value.
+ * Keys are compared as written, like forge_json_find, but a repeated key
+ * resolves to its first occurrence.  Input is validated only as far as it
+ * is read.
+ */
+
+/* Offset just past the value starting at i, or 0 if it is malformed */
+static u32 skip_value(const u8 *s, u32 i, u32 len) {
+    forge_json_tok_t t;
+    if (s[i] == '"') return scan_string(s, i + 1, len, &t);
+    if (s[i] != '{' && s[i] != '[') {
+        u32 e = i;
+        while (e < len && s[e] != ',' && s[e] != '}' && s[e] != ']' && s[e] != ' ' &&
+               s[e] != '\n' && s[e] != '\r' && s[e] != '\t')
+            e++;
+        return e > i ? e : 0;
+    }
+    u32 depth = 0;
+    while (i < len) {
+        u8 c = s[i];
+        if (c == '"') {
+            if (!(i = scan_string(s, i + 1, len, &t))) return 0;
+            continue;
+        }
+        if (c == '{' || c == '[') depth++;
+        else if ((c == '}' || c == ']') && !--depth) return i + 1;
+        i++;
+    }
+    return 0;
+}
+
+/* Start of the top-level value for `key`, or 0; *rest is the bytes from
+ * there to the end of the string */
+static const char *root_member(const char *json, const char *key, u32 *rest) {
+    const u8 *s    = (const u8 *)json;
+    u32       len  = (u32)forge_strlen(json), klen = (u32)forge_strlen(key);
+    u32       i    = skip_ws(s, 0, len);
+    if (i >= len || s[i] != '{') return 0;
+    i++;
+    for (;;) {
+        forge_json_tok_t k;
+        i = skip_ws(s, i, len);
+        if (i >= len || s[i] != '"' || !(i = scan_string(s, i + 1, len, &k))) return 0;
+        i = skip_ws(s, i, len);
+        if (i >= len || s[i] != ':') return 0;
+        i = skip_ws(s, i + 1, len);
+        if (i >= len) return 0;
+        if (k.len == klen && forge_memcmp(s + k.start, key, klen) == 0) {
+            *rest = len - i;
+            return json + i;
+        }
+        if (!(i = skip_value(s, i, len))) return 0;
+        i = skip_ws(s, i, len);
+        if (i >= len || s[i] != ',') return 0; /* '}': not found */
+        i++;
+    }
+}
+
+/* Walks the top-level array: returns element `index` (counting all of
+ * them when index < 0, into *count, 0 if malformed), or 0 */
+static const char *root_element(const char *json, int index, int *count) {
+    const u8 *s   = (const u8 *)json;
+    u32       len = (u32)forge_strlen(json);
+    u32       i   = skip_ws(s, 0, len);
+    *count = 0;
+    if (i >= len || s[i] != '[') return 0;
+    i = skip_ws(s, i + 1, len);
+    if (i < len && s[i] == ']') return 0;
+    for (;;) {
+        if (i >= len) break;
+        if (*count == index) return json + i;
+        if (!(i = skip_value(s, i, len))) break;
+        ++*count;
+        i = skip_ws(s, i, len);
+        if (i < len && s[i] == ']') return 0; /* the end */
+        if (i >= len || s[i] != ',') break;
+        i = skip_ws(s, i + 1, len);
+    }
+    *count = 0;
+    return 0;
+}
+
+/* Reads the scalar at `p` through a one-token doc, so the conversions are
+ * the same as forge_json_int / forge_json_str */
+static int scalar_doc(forge_json_doc_t *doc, forge_json_tok_t *t, const char *p, u32 len) {
+    const u8 *s   = (const u8 *)p;
+    u32       end = skip_value(s, 0, len);
+    if (!end) return 0;
+    forge_memset(doc, 0, sizeof(*doc));
+    if (*p == '"') {
+        scan_string(s, 1, len, t);
+    } else {
+        t->type    = *p == '-' || (*p >= '0' && *p <= '9') ? FORGE_JSON_NUMBER : FORGE_JSON_INVALID;
+        t->escaped = 0;
+        t->start   = 0;
+        t->len     = end;
+    }
+    doc->json      = p;
+    doc->json_len  = len;
+    doc->toks      = t;
+    doc->tok_count = 1;
+    return 1;
+}
+
+const char *forge_json_get(const char *json, const char *key) {
+    u32 rest;
+    return root_member(json, key, &rest);
+}
+
+int forge_json_get_int(const char *json, const char *key, int default_val) {
+    u32              rest;
+    const char      *p = root_member(json, key, &rest);
+    forge_json_doc_t doc;
+    forge_json_tok_t t;
+    if (!p || !scalar_doc(&doc, &t, p, rest)) return default_val;
+    return (int)forge_json_int(&doc, 0, default_val);
+}
+
+const char *forge_json_get_str(const char *json, const char *key) {
+    u32              rest, len;
+    const char      *p = root_member(json, key, &rest);
+    forge_json_doc_t doc;
+    forge_json_tok_t t;
+    if (!p || *p != '"' || !scalar_doc(&doc, &t, p, rest)) return 0;
+    const char *s = forge_json_str(&doc, 0, &len);
+    char *out = FORGE_FRAME_ALLOC(len + 1);
+    if (out) unescape(s, len, out, len + 1);
+    return out;
+}
+
+int forge_json_array_len(const char *json) {
+    int count;
+    root_element(json, -1, &count);
+    return count;
+}
+
+const char *forge_json_array_item(const char *json, int index) {
+    int count;
+    return index >= 0 ? root_element(json, index, &count) : 0;
+}
@@ -0,0 +1,309 @@
+/*
+ * Forge Stdlib - Client-Side Router Implementation
+ *
+ * Routes compile into a segment trie.  Each node keeps its literal
+ * children sorted by (length, bytes) for binary search, plus at most one
+ * `:param` child and one `*wildcard` route; matching backtracks from
+ * literal to parameter to wildcard, so the first route found is also the
+ * most specific one.  Captures are recorded as slices of the path and
+ * named from the matched route's pattern afterwards, which lets routes use
+ * different names for the same parameter position.
+ */
+
+#include "../include/forge/router.h"
+#include "../../runtime/include/forge/web.h"
+#include "../../runtime/src/arena.h"
+
+/* ─── Host Imports ────────────────────────────────────────────────────────── */
+
+/* Listen for popstate / hashchange and link clicks; dispatches the current path */
+FORGE_IMPORT("env", "forge_router_listen")
+extern void js_router_listen(u32 mode);
+
+/* Push `path` onto the history (or hash), then dispatch it */
+FORGE_IMPORT("env", "forge_router_push")
+extern void js_router_push(u32 path_ptr, u32 path_len, u32 mode);
+
+FORGE_IMPORT("env", "forge_router_go")
+extern void js_router_go(i32 delta);
+
+/* Start loading a module so a later navigation finds it ready */
+FORGE_IMPORT("env", "forge_router_load")
+extern void js_router_load(u32 url_ptr, u32 url_len);
+
+/* ─── Routes and Trie ─────────────────────────────────────────────────────── */
+
+typedef struct Route {
+    const char          *pattern;
+    forge_route_handler  handler;
+    void                *userdata;
+    const char          *chunk;
+    forge_route_handler  prefetch;
+    struct Route        *next;
+} Route;
+
+typedef struct RouteNode {
+    const char        *seg;       /* literal text, pointing into a pattern */
+    u32                seg_len;
+    struct RouteNode **kids;      /* literal children, sorted */
+    u32                kid_count;
+    u32                kid_cap;
+    struct RouteNode  *param;     /* `:name` child */
+    Route             *end;       /* route ending here */
+    Route             *wild;      /* `*name` route capturing the rest */
+} RouteNode;
+
+static ForgeRouterMode     _mode = FORGE_ROUTER_HASH;
+static Route              *_routes;          /* every route, in add order */
+static Route             **_routes_tail = &_routes;
+static Route              *_pending;         /* first route not in the trie */
+static RouteNode           _root;
+static forge_route_handler _not_found;
+static void               *_not_found_data;
+static int                 _started;
+
+static char *_path;       /* current path block, owned by the router */
+static u32   _path_len;
+
+static int seg_cmp(const char *a, u32 alen, const char *b, u32 blen) {
+    if (alen != blen) return alen < blen ? -1 : 1;
+    return forge_memcmp(a, b, alen);
+}
+
+/* Index of the literal child `s`, or where it would be inserted */
+static u32 kid_search(const RouteNode *n, const char *s, u32 len, int *found) {
+    u32 lo = 0, hi = n->kid_count;
+    *found = 0;
+    while (lo < hi) {
+        u32 mid = (lo + hi) / 2;
+        int c   = seg_cmp(n->kids[mid]->seg, n->kids[mid]->seg_len, s, len);
+        if (c == 0) { *found = 1; return mid; }
+        if (c < 0) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+static RouteNode *kid_insert(RouteNode *n, const char *s, u32 len) {
+    int found;
+    u32 at = kid_search(n, s, len, &found);
+    if (found) return n->kids[at];
+
+    RouteNode *k = FORGE_CALLOC(1, sizeof(RouteNode));
+    if (!k) return 0;
+    if (n->kid_count == n->kid_cap) {
+        u32         cap  = n->kid_cap ? n->kid_cap * 2 : 4;
+        RouteNode **kids = forge_block_alloc(cap * sizeof(RouteNode *));
+        if (!kids) return 0;
+        if (n->kid_count) forge_memcpy(kids, n->kids, n->kid_count * sizeof(RouteNode *));
+        forge_block_free(n->kids, n->kid_cap * sizeof(RouteNode *));
+        n->kids    = kids;
+        n->kid_cap = cap;
+    }
+    for (u32 i = n->kid_count; i > at; i--) n->kids[i] = n->kids[i - 1];
+    n->kids[at] = k;
+    n->kid_count++;
+    k->seg     = s;
+    k->seg_len = len;
+    return k;
+}
+
+/* Next segment of [p, end) after any slashes; returns its end */
+static const char *next_seg(const char **p, const char *end) {
+    const char *s = *p;
+    while (s < end && *s == '/') s++;
+    const char *e = s;
+    while (e < end && *e != '/') e++;
+    *p = s;
+    return e;
+}
+
+static void trie_insert(Route *r) {
+    const char *p = r->pattern, *end = p + forge_strlen(p);
+    RouteNode  *n = &_root;
+    int         params = 0;
+    for (;;) {
+        const char *e = next_seg(&p, end);
+        if (p == e) { n->end = r; return; }
+        if ((*p == ':' || *p == '*') && ++params > FORGE_ROUTER_MAX_PARAMS) {
+            forge_log("router: too many parameters in route");
+            return;
+        }
+        if (*p == '*') { n->wild = r; return; } /* rest of the pattern is ignored */
+        if (*p == ':') {
+            if (!n->param && !(n->param = FORGE_CALLOC(1, sizeof(RouteNode)))) return;
+            n = n->param;
+        } else if (!(n = kid_insert(n, p, (u32)(e - p)))) {
+            return;
+        }
+        p = e;
+    }
+}
+
+static void trie_update(void) {
+    for (; _pending; _pending = _pending->next) trie_insert(_pending);
+}
+
+/* ─── Matching ────────────────────────────────────────────────────────────── */
+
+static Route *match_node(const RouteNode *n, const char *p, const char *end,
+                         forge_route_t *out) {
+    const char *e = next_seg(&p, end);
+    if (p == e) {
+        if (n->end) return n->end;
+        if (!n->wild || out->param_count >= FORGE_ROUTER_MAX_PARAMS) return 0;
+        forge_route_param_t *c = &out->params[out->param_count++];
+        c->value     = p;
+        c->value_len = 0;
+        return n->wild;
+    }
+
+    int found;
+    u32 at = kid_search(n, p, (u32)(e - p), &found);
+    if (found) {
+        Route *r = match_node(n->kids[at], e, end, out);
+        if (r) return r;
+    }
+    if (out->param_count >= FORGE_ROUTER_MAX_PARAMS) return 0;
+    int mark = out->param_count;
+    if (n->param) {
+        forge_route_param_t *c = &out->params[out->param_count++];
+        c->value     = p;
+        c->value_len = (u32)(e - p);
+        Route *r = match_node(n->param, e, end, out);
+        if (r) return r;
+        out->param_count = mark;
+    }
+    if (n->wild) {
+        forge_route_param_t *c = &out->params[out->param_count++];
+        c->value     = p;
+        c->value_len = (u32)(end - p);
+        return n->wild;
+    }
+    return 0;
+}
+
+/* Name the captures after the `:name` / `*name` segments of the pattern */
+static void name_params(forge_route_t *out) {
+    const char *p = out->pattern, *end = p + forge_strlen(p);
+    int         i = 0;
+    while (i < out->param_count) {
+        const char *e = next_seg(&p, end);
+        if (p == e) break;
+        if (*p == ':' || *p == '*') {
+            out->params[i].name     = p + 1;
+            out->params[i].name_len = (u32)(e - p - 1);
+            if (*p == '*' && e == p + 1) {
+                out->params[i].name     = "rest";
+                out->params[i].name_len = 4;
+            }
+            i++;
+        }
+        p = e;
+    }
+}
+
+static Route *route_match(const char *path, u32 len, forge_route_t *out) {
+    trie_update();
+    out->path        = path;
+    out->path_len    = len;
+    out->param_count = 0;
+    out->pattern     = 0;
+    out->userdata    = 0;
+    Route *r = match_node(&_root, path, path + len, out);
+    if (!r) { out->param_count = 0; return 0; }
+    out->pattern  = r->pattern;
+    out->userdata = r->userdata;
+    name_params(out);
+    return r;
+}
+
+int forge_router_match(const char *path, u32 len, forge_route_t *out) {
+    return route_match(path, len, out) != 0;
+}
+
+const char *forge_route_param(const forge_route_t *route, const char *name, u32 *len) {
+    u32 n = (u32)forge_strlen(name);
+    for (int i = 0; i < route->param_count; i++) {
+        const forge_route_param_t *c = &route->params[i];
+        if (c->name_len == n && forge_memcmp(c->name, name, n) == 0) {
+            *len = c->value_len;
+            return c->value;
+        }
+    }
+    return 0;
+}
+
+/* ─── Public API ──────────────────────────────────────────────────────────── */
+
+void forge_router_init(ForgeRouterMode mode) {
+    _mode = mode;
+}
+
+void forge_router_add(const char *pattern, forge_route_handler handler, void *userdata) {
+    Route *r = FORGE_CALLOC(1, sizeof(Route));
+    if (!r) return;
+    r->pattern  = pattern;
+    r->handler  = handler;
+    r->userdata = userdata;
+    *_routes_tail = r;
+    _routes_tail  = &r->next;
+    if (!_pending) _pending = r;
+}
+
+void forge_router_prefetch(const char *pattern, const char *chunk,
+                           forge_route_handler prefetch) {
+    u32 len = (u32)forge_strlen(pattern);
+    for (Route *r = _routes; r; r = r->next) {
+        if (seg_cmp(r->pattern, (u32)forge_strlen(r->pattern), pattern, len) == 0) {
+            r->chunk    = chunk;
+            r->prefetch = prefetch;
+            return;
+        }
+    }
+    forge_log("router: prefetch for a pattern that was never added");
+}
+
+void forge_router_not_found(forge_route_handler handler, void *userdata) {
+    _not_found      = handler;
+    _not_found_data = userdata;
+}
+
+void forge_router_start(void) {
+    trie_update();
+    _started = 1;
+    js_router_listen((u32)_mode);
+}
+
+void forge_router_navigate(const char *path) {
+    js_router_push((u32)(uintptr_t)path, (u32)forge_strlen(path), (u32)_mode);
+}
+
+void forge_router_back(void)    { js_router_go(-1); }
+void forge_router_forward(void) { js_router_go(1); }
+
+const char *forge_router_current_path(void) {
+    return _path ? _path : "/";
+}
+
+/* ─── Host Entry Points ───────────────────────────────────────────────────── */
+
+void forge_router_dispatch(u32 path_ptr, u32 len) {
+    forge_props_str_free((u32)(uintptr_t)_path);
+    _path     = (char *)(uintptr_t)path_ptr;
+    _path_len = len;
+    if (!_started) return;
+
+    forge_route_t route;
+    Route *r = route_match(_path, _path_len, &route);
+    if (r && r->handler) r->handler(&route, r->userdata);
+    else if (!r && _not_found) _not_found(&route, _not_found_data);
+}
+
+int forge_router_hover(u32 path_ptr, u32 len) {
+    forge_route_t route;
+    Route *r = route_match((const char *)(uintptr_t)path_ptr, len, &route);
+    if (!r) return 0;
+    if (r->chunk) js_router_load((u32)(uintptr_t)r->chunk, (u32)forge_strlen(r->chunk));
+    if (r->prefetch) r->prefetch(&route, r->userdata);
+    return 1;
+}
@@ -0,0 +1,237 @@
+/*
+ * Forge Stdlib - Global Reactive Store Implementation
+ *
+ * Change tracking is per slice: forge_store_begin() copies the data aside
+ * and forge_store_commit() compares each declared slice against the copy,
+ * giving a mask of what changed.  Subscribers and cached selectors carry
+ * the mask of slices they read, so a commit only schedules the contexts
+ * (and invalidates the selectors) its mask meets.  Each slice remembers
+ * the store version that last changed it; a selector is stale when any of
+ * its slices changed after the version it was computed at.
+ */
+
+#include "../include/forge/store.h"
+#include "../../runtime/src/arena.h"
+
+struct forge_store_sub {
+    forge_ctx_t *ctx;
+    u32          handle;   /* ctx->handle when subscribed; freed ctxs read 0 */
+    u32          mask;
+};
+
+struct forge_store_memo {
+    forge_selector_fn fn;
+    u32               mask;
+    u32               version;   /* store version the value was computed at */
+    forge_val_t       value;
+};
+
+/* Grow a block-allocated array of `elem` bytes per entry to hold count + 1 */
+static int grow(void **arr, int *cap, int count, size_t elem) {
+    if (count < *cap) return 1;
+    int   ncap = *cap ? *cap * 2 : 8;
+    void *next = forge_block_alloc((size_t)ncap * elem);
+    if (!next) return 0;
+    if (count) forge_memcpy(next, *arr, (size_t)count * elem);
+    forge_block_free(*arr, (size_t)*cap * elem);
+    *arr = next;
+    *cap = ncap;
+    return 1;
+}
+
+/* ─── Create / Free ───────────────────────────────────────────────────────── */
+
+forge_store_t *forge_store_create(u32 data_size) {
+    forge_store_t *s = forge_block_alloc(sizeof(forge_store_t));
+    if (!s) return 0;
+    s->data      = forge_block_alloc(data_size ? data_size : 1);
+    s->snapshot  = forge_block_alloc(data_size ? data_size : 1);
+    s->data_size = data_size;
+    if (!s->data || !s->snapshot) {
+        forge_store_free(s);
+        return 0;
+    }
+    return s;
+}
+
+void forge_store_free(forge_store_t *store) {
+    if (!store) return;
+    size_t n = store->data_size ? store->data_size : 1;
+    forge_block_free(store->data, n);
+    forge_block_free(store->snapshot, n);
+    forge_block_free(store->subs, (size_t)store->sub_cap * sizeof(forge_store_sub_t));
+    forge_block_free(store->memos, (size_t)store->memo_cap * sizeof(forge_store_memo_t));
+    forge_block_free(store, sizeof(forge_store_t));
+}
+
+void *forge_store_get(forge_store_t *store) {
+    return store->data;
+}
+
+u32 forge_store_slice(forge_store_t *store, u32 offset, u32 size) {
+    if (store->slice_count == FORGE_STORE_MAX_SLICES || offset + size > store->data_size)
+        return FORGE_STORE_ALL;
+    forge_store_slice_t *sl = &store->slices[store->slice_count];
+    sl->offset = offset;
+    sl->size   = size;
+    return 1u << store->slice_count++;
+}
+
+/* ─── Transactions ────────────────────────────────────────────────────────── */
+
+void forge_store_begin(forge_store_t *store) {
+    if (store->transaction++ == 0)
+        forge_memcpy(store->snapshot, store->data, store->data_size);
+}
+
+void forge_store_touch(forge_store_t *store, u32 mask) {
+    store->touched |= mask;
+}
+
+/* Slices that differ from the snapshot */
+static u32 changed_slices(const forge_store_t *s) {
+    const u8 *now = (const u8 *)s->data, *was = s->snapshot;
+    if (forge_memcmp(now, was, s->data_size) == 0) return 0;
+    u32 mask = 0;
+    for (int i = 0; i < s->slice_count; i++) {
+        const forge_store_slice_t *sl = &s->slices[i];
+        if (forge_memcmp(now + sl->offset, was + sl->offset, sl->size) != 0)
+            mask |= 1u << i;
+    }
+    return mask ? mask : FORGE_STORE_ALL; /* only undeclared bytes changed */
+}
+
+void forge_store_commit(forge_store_t *store) {
+    /* With no begin open the snapshot dates from an earlier transaction and
+     * would re-report its changes, so only touched slices count */
+    int open = store->transaction > 0;
+    if (open && --store->transaction > 0) return;
+    u32 dirty = (open ? changed_slices(store) : 0) | store->touched;
+    store->touched = 0;
+    if (!dirty) return;
+
+    store->version++;
+    for (int i = 0; i < FORGE_STORE_MAX_SLICES; i++)
+        if (dirty & (1u << i)) store->slice_version[i] = store->version;
+
+    /* Unsubscribe freed contexts instead of scheduling them */
+    for (int i = 0; i < store->sub_count;) {
+        forge_store_sub_t *sub = &store->subs[i];
+        if (sub->ctx->handle != sub->handle) {
+            *sub = store->subs[--store->sub_count];
+            continue;
+        }
+        if (sub->mask & dirty) forge_schedule_update(sub->ctx);
+        i++;
+    }
+}
+
+void forge_store_update(forge_store_t *store, void (*mutate)(void *data, void *userdata), void *userdata) {
+    forge_store_begin(store);
+    mutate(store->data, userdata);
+    forge_store_commit(store);
+}
+
+/* ─── Subscription ────────────────────────────────────────────────────────── */
+
+void forge_store_subscribe(forge_store_t *store, forge_ctx_t *ctx) {
+    forge_store_subscribe_mask(store, ctx, FORGE_STORE_ALL);
+}
+
+void forge_store_subscribe_mask(forge_store_t *store, forge_ctx_t *ctx, u32 mask) {
+    if (!ctx) return;
+    for (int i = 0; i < store->sub_count; i++) {
+        if (store->subs[i].ctx == ctx) {
+            store->subs[i].handle = ctx->handle;
+            store->subs[i].mask   = mask;
+            return;
+        }
+    }
+    if (!grow((void **)&store->subs, &store->sub_cap, store->sub_count, sizeof(forge_store_sub_t)))
+        return;
+    forge_store_sub_t *sub = &store->subs[store->sub_count++];
+    sub->ctx    = ctx;
+    sub->handle = ctx->handle;
+    sub->mask   = mask;
+}
+
+void forge_store_unsubscribe(forge_store_t *store, forge_ctx_t *ctx) {
+    for (int i = 0; i < store->sub_count; i++) {
+        if (store->subs[i].ctx == ctx) {
+            store->subs[i] = store->subs[--store->sub_count];
+            return;
+        }
+    }
+}
+
+/* ─── Selectors ───────────────────────────────────────────────────────────── */
+
+/* Latest version that changed any slice in `mask` */
+static u32 changed_at(const forge_store_t *s, u32 mask) {
+    if (mask == FORGE_STORE_ALL) return s->version;
+    u32 v = 0;
+    for (int i = 0; i < FORGE_STORE_MAX_SLICES; i++)
+        if ((mask & (1u << i)) && s->slice_version[i] > v) v = s->slice_version[i];
+    return v;
+}
+
+forge_val_t forge_store_select(forge_store_t *store, forge_selector_fn selector) {
+    return forge_store_select_mask(store, selector, FORGE_STORE_ALL);
+}
+
+forge_val_t forge_store_select_mask(forge_store_t *store, forge_selector_fn selector, u32 mask) {
+    forge_store_memo_t *m = 0;
+    for (int i = 0; i < store->memo_count; i++) {
+        if (store->memos[i].fn == selector && store->memos[i].mask == mask) {
+            m = &store->memos[i];
+            break;
+        }
+    }
+    if (m && m->version >= changed_at(store, mask)) return m->value;
+
+    forge_val_t value = selector(store->data);
+    if (!m) {
+        if (!grow((void **)&store->memos, &store->memo_cap, store->memo_count, sizeof(forge_store_memo_t)))
+            return value;
+        m       = &store->memos[store->memo_count++];
+        m->fn   = selector;
+        m->mask = mask;
+    }
+    m->version = store->version;
+    m->value   = value;
+    return value;
+}
+
+/* ─── Named Stores ────────────────────────────────────────────────────────── */
+
+typedef struct NamedStore {
+    const char        *name;
+    forge_store_t     *store;
+    struct NamedStore *next;
+} NamedStore;
+
+static NamedStore *_named;
+
+void forge_store_register(const char *name, forge_store_t *store) {
+    u32 len = (u32)forge_strlen(name);
+    for (NamedStore *n = _named; n; n = n->next) {
+        if ((u32)forge_strlen(n->name) == len && forge_memcmp(n->name, name, len) == 0) {
+            n->store = store;
+            return;
+        }
+    }
+    NamedStore *n = FORGE_CALLOC(1, sizeof(NamedStore));
+    if (!n) return;
+    n->name  = name;
+    n->store = store;
+    n->next  = _named;
+    _named   = n;
+}
+
+forge_store_t *forge_store_lookup(const char *name) {
+    u32 len = (u32)forge_strlen(name);
+    for (NamedStore *n = _named; n; n = n->next)
+        if ((u32)forge_strlen(n->name) == len && forge_memcmp(n->name, name, len) == 0)
+            return n->store;
+    return 0;
+}
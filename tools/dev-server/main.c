@@ -4,18 +4,38 @@
  * A minimal HTTP server + file watcher for local development.
  *
  * Features:
- *   - Serves static files from a directory
- *   - Watches .cx files for changes and re-compiles them
- *   - Sends Server-Sent Events (SSE) to browser for hot reload
+ *   - Serves static files from a directory over HTTP/1.1 keep-alive,
+ *     every connection non-blocking on one epoll (Linux) / kqueue (macOS,
+ *     BSD) event loop
+ *   - Watches .cx files with inotify / kqueue — no cap on the file count,
+ *     new files and directories are picked up as they appear
+ *   - Re-compiles changed files in-process (the compiler is linked in and
+ *     keeps every component parsed)
+ *   - Sends Server-Sent Events (SSE) to browser for hot module updates
+ *   - With --profile, builds instrumented components and shows a live
+ *     overlay of their counters and of each rebuild's phase times
  *   - Runs on port 3000 by default
  *
  * Usage:
- *   forge dev [--port 3000] [--dir ./]
+ *   forge dev [--port 3000] [--dir ./] [--out dist] [--prerender] [--ssr]
+ *             [--profile]
  */
 
+#define _POSIX_C_SOURCE 200809L
+#ifdef __APPLE__
+#define _DARWIN_C_SOURCE /* kqueue / O_EVTONLY */
+#endif
+
+#include "analyzer.h"
+#include "binding_gen.h"
+#include "codegen.h"
+#include "lexer.h"
+#include "parser.h"
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <unistd.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -23,16 +43,47 @@
 #include <fcntl.h>
 #include <signal.h>
 #include <pthread.h>
+#include <errno.h>
+#include <dirent.h>
+#include <poll.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/sendfile.h>
+#define DEV_EPOLL 1
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+#include <sys/event.h>
+#include <sys/resource.h>
+#include <sys/uio.h>
+#include <limits.h>
+#define DEV_KQUEUE 1
+#else
+#error "forge-dev needs epoll (Linux) or kqueue (macOS / BSD)"
+#endif
+
+#if defined(__APPLE__)
+#define ST_MTIME_NSEC(st) ((st).st_mtimespec.tv_nsec)
+#else
+#define ST_MTIME_NSEC(st) ((st).st_mtim.tv_nsec)
+#endif
 
 #define DEV_DEFAULT_PORT   3000
-#define DEV_BACKLOG        8
-#define DEV_BUF_SIZE       8192
-#define DEV_MAX_WATCH      128
+#define DEV_BACKLOG        SOMAXCONN
+#define DEV_BUF_SIZE       8192   /* request head limit per connection  */
+#define DEV_MAX_EVENTS     64     /* events taken per loop wakeup       */
+#define DEV_KEEPALIVE_SECS 15     /* idle keep-alive connections closed */
+#define DEV_DEBOUNCE_MS    50     /* editors write a file in bursts     */
+#define DEV_SSE_BACKLOG    (256 * 1024) /* unsent events before a tab is dropped */
 
-static volatile int _running = 1;
+static volatile sig_atomic_t _running = 1;
 static int          _port    = DEV_DEFAULT_PORT;
 static char         _dir[512] = "./";
-static char         _forge_bin[512] = "./build/forge";
+static char         _out_dir[512] = "dist";
+static int          _prerender = 0;
+static int          _ssr       = 0;
+static int          _profile   = 0;
 
 /* ─── MIME Types ──────────────────────────────────────────────────────────── */
 
@@ -50,62 +101,506 @@ static const char *mime_for(const char *path) {
     return "application/octet-stream";
 }
 
+/* ─── Connections ─────────────────────────────────────────────────────────── */
+
+typedef struct {
+    int     fd;
+    char    in[DEV_BUF_SIZE];
+    size_t  in_len;
+    char   *out;          /* queued response bytes */
+    size_t  out_len;
+    size_t  out_cap;
+    size_t  out_off;      /* bytes of `out` already written */
+    int     keep_alive;   /* 0: close once `out` drains */
+    int     want_write;   /* registered for writability */
+    int     sse;          /* held open as a hot-update stream */
+    int     read_paused;  /* `in` is full: reads off until it drains */
+    int     head_only;    /* HEAD request: headers, no body */
+    int     file_fd;      /* file body streamed after `out`, or -1 */
+    off_t   file_off;
+    off_t   file_end;     /* one past the last byte to send */
+    time_t  last_active;
+} Conn;
+
+/* Indexed by fd; grows with the highest descriptor seen */
+static Conn **_conns    = NULL;
+static int    _conn_cap = 0;
+
+static Conn *conn_get(int fd) {
+    return fd >= 0 && fd < _conn_cap ? _conns[fd] : NULL;
+}
+
+static Conn *conn_new(int fd) {
+    if (fd >= _conn_cap) {
+        int cap = _conn_cap ? _conn_cap : 64;
+        while (cap <= fd) cap *= 2;
+        Conn **grown = realloc(_conns, sizeof(Conn *) * (size_t)cap);
+        if (!grown) return NULL;
+        memset(grown + _conn_cap, 0, sizeof(Conn *) * (size_t)(cap - _conn_cap));
+        _conns = grown;
+        _conn_cap = cap;
+    }
+    Conn *c = calloc(1, sizeof(Conn));
+    if (!c) return NULL;
+    c->fd = fd;
+    c->file_fd = -1;
+    c->keep_alive = 1;
+    c->last_active = time(NULL);
+    _conns[fd] = c;
+    return c;
+}
+
+static int out_append(Conn *c, const void *data, size_t len) {
+    if (c->out_len + len > c->out_cap) {
+        size_t cap = c->out_cap ? c->out_cap : 4096;
+        while (cap < c->out_len + len) cap *= 2;
+        char *grown = realloc(c->out, cap);
+        if (!grown) return -1;
+        c->out = grown;
+        c->out_cap = cap;
+    }
+    memcpy(c->out + c->out_len, data, len);
+    c->out_len += len;
+    return 0;
+}
+
+/* ─── Event Loop ──────────────────────────────────────────────────────────── */
+
+static int _loop_fd = -1;
+
+typedef struct {
+    int fd;
+    int readable;
+    int writable;
+    int hangup;
+} LoopEvent;
+
+static int loop_init(void) {
+#if DEV_EPOLL
+    _loop_fd = epoll_create1(0);
+#else
+    _loop_fd = kqueue();
+#endif
+    return _loop_fd;
+}
+
+/* Watch fd for reads while `readable` is set, and writes while `writable`
+ * is.  Both are level-triggered, so an interest nobody acts on spins. */
+static void loop_watch(int fd, int readable, int writable, int added) {
+#if DEV_EPOLL
+    struct epoll_event ev = { .events = (readable ? EPOLLIN | EPOLLRDHUP : 0) |
+                                        (writable ? EPOLLOUT : 0),
+                              .data.fd = fd };
+    epoll_ctl(_loop_fd, added ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev);
+#else
+    struct kevent ev[2];
+    int n = 0;
+    EV_SET(&ev[n++], fd, EVFILT_READ, added ? (readable ? EV_ENABLE : EV_DISABLE)
+                                            : EV_ADD | (readable ? 0 : EV_DISABLE), 0, 0, NULL);
+    EV_SET(&ev[n++], fd, EVFILT_WRITE, writable ? EV_ADD : EV_DELETE, 0, 0, NULL);
+    kevent(_loop_fd, ev, n, NULL, 0, NULL);
+#endif
+}
+
+static void loop_forget(int fd) {
+#if DEV_EPOLL
+    epoll_ctl(_loop_fd, EPOLL_CTL_DEL, fd, NULL);
+#else
+    (void)fd; /* kqueue drops a descriptor's filters when it is closed */
+#endif
+}
+
+static int loop_wait(LoopEvent *out, int max, int timeout_ms) {
+#if DEV_EPOLL
+    struct epoll_event ev[DEV_MAX_EVENTS];
+    int n = epoll_wait(_loop_fd, ev, max < DEV_MAX_EVENTS ? max : DEV_MAX_EVENTS, timeout_ms);
+    for (int i = 0; i < n; i++) {
+        out[i].fd       = ev[i].data.fd;
+        out[i].readable = (ev[i].events & EPOLLIN) != 0;
+        out[i].writable = (ev[i].events & EPOLLOUT) != 0;
+        out[i].hangup   = (ev[i].events & (EPOLLHUP | EPOLLERR)) != 0;
+    }
+    return n;
+#else
+    struct kevent ev[DEV_MAX_EVENTS];
+    struct timespec ts = { timeout_ms / 1000, (long)(timeout_ms % 1000) * 1000000L };
+    int n = kevent(_loop_fd, NULL, 0, ev, max < DEV_MAX_EVENTS ? max : DEV_MAX_EVENTS, &ts);
+    for (int i = 0; i < n; i++) {
+        out[i].fd       = (int)ev[i].ident;
+        out[i].readable = ev[i].filter == EVFILT_READ;
+        out[i].writable = ev[i].filter == EVFILT_WRITE;
+        out[i].hangup   = (ev[i].flags & EV_ERROR) != 0;
+    }
+    return n;
+#endif
+}
+
+static void set_nonblocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
 /* ─── HTTP Response Helpers ───────────────────────────────────────────────── */
 
-static void send_response(int fd, int status, const char *mime,
-                           const char *body, size_t body_len) {
-    char header[1024];
+static const char *status_text(int status) {
+    switch (status) {
+    case 200: return "OK";
+    case 206: return "Partial Content";
+    case 304: return "Not Modified";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 416: return "Range Not Satisfiable";
+    case 431: return "Request Header Fields Too Large";
+    default:  return "Error";
+    }
+}
+
+/* Value of header `name` within the request head, copied into out */
+static int header_value(const char *head, const char *name, char *out, size_t cap) {
+    size_t nl = strlen(name);
+    for (const char *line = strstr(head, "\r\n"); line; line = strstr(line, "\r\n")) {
+        line += 2;
+        if (strncasecmp(line, name, nl) == 0 && line[nl] == ':') {
+            const char *v = line + nl + 1;
+            while (*v == ' ' || *v == '\t') v++;
+            size_t len = strcspn(v, "\r\n");
+            if (len >= cap) len = cap - 1;
+            memcpy(out, v, len);
+            out[len] = '\0';
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Status line and headers; `extra` holds further "Name: value\r\n" lines */
+static void send_head(Conn *c, int status, const char *mime, size_t body_len,
+                      const char *extra) {
+    char header[1536];
     int hlen = snprintf(header, sizeof(header),
-        "HTTP/1.1 %d OK\r\n"
+        "HTTP/1.1 %d %s\r\n"
         "Content-Type: %s\r\n"
         "Content-Length: %zu\r\n"
         "Access-Control-Allow-Origin: *\r\n"
         "Cache-Control: no-cache\r\n"
-        "Connection: close\r\n"
+        "Connection: %s\r\n"
+        "%s"
         "\r\n",
-        status, mime, body_len);
-    write(fd, header, (size_t)hlen);
-    if (body && body_len > 0) write(fd, body, body_len);
+        status, status_text(status), mime, body_len,
+        c->keep_alive ? "keep-alive" : "close", extra ? extra : "");
+    out_append(c, header, (size_t)hlen);
 }
 
-static void send_404(int fd) {
+static void send_response(Conn *c, int status, const char *mime,
+                          const char *body, size_t body_len) {
+    send_head(c, status, mime, body_len, NULL);
+    if (body && body_len > 0 && !c->head_only) out_append(c, body, body_len);
+}
+
+static void send_404(Conn *c) {
     const char *body = "<h1>404 Not Found</h1>";
-    send_response(fd, 404, "text/html", body, strlen(body));
+    send_response(c, 404, "text/html", body, strlen(body));
+}
+
+/* Send up to len bytes of fd from off straight from the page cache.
+ * Returns bytes written, or -1 with errno set. */
+static ssize_t file_send(int sock, int fd, off_t off, size_t len) {
+#if defined(__linux__)
+    return sendfile(sock, fd, &off, len);
+#elif defined(__APPLE__)
+    off_t n = (off_t)len;
+    if (sendfile(fd, sock, off, &n, NULL, 0) < 0 && n == 0) return -1;
+    return (ssize_t)n;
+#elif defined(__FreeBSD__)
+    off_t n = 0;
+    if (sendfile(fd, sock, off, len, NULL, &n, 0) < 0 && n == 0) return -1;
+    return (ssize_t)n;
+#else
+    char buf[65536];
+    ssize_t got = pread(fd, buf, len < sizeof(buf) ? len : sizeof(buf), off);
+    return got <= 0 ? got : write(sock, buf, (size_t)got);
+#endif
 }
 
-static void send_file(int fd, const char *path) {
-    int f = open(path, O_RDONLY);
-    if (f < 0) { send_404(fd); return; }
+/* "bytes=a-b" / "bytes=a-" / "bytes=-n" → [*start, *end] inclusive.
+ * Returns 1 for a range, 0 to send the whole file, -1 if unsatisfiable. */
+static int parse_range(const char *spec, off_t size, off_t *start, off_t *end) {
+    if (strncmp(spec, "bytes=", 6) != 0 || strchr(spec, ',')) return 0;
+    const char *p = spec + 6;
+    char *dash;
+    if (*p == '-') {
+        long long n = strtoll(p + 1, &dash, 10);
+        if (dash == p + 1 || n <= 0) return n == 0 && dash != p + 1 ? -1 : 0;
+        *start = n >= size ? 0 : size - (off_t)n;
+        *end   = size - 1;
+    } else {
+        long long a = strtoll(p, &dash, 10);
+        if (dash == p || *dash != '-') return 0;
+        const char *q = dash + 1;
+        long long b = *q ? strtoll(q, &dash, 10) : (long long)size - 1;
+        if (*q && dash == q) return 0;
+        if (b >= size) b = size - 1;
+        *start = (off_t)a;
+        *end   = (off_t)b;
+    }
+    return *start <= *end && *start < size ? 1 : -1;
+}
+
+/* Static files.  Compressed .br / .gz siblings are preferred when the
+ * client accepts them, validators turn reloads into 304s, and bodies go
+ * out with sendfile() rather than through a userspace copy.  Pages are the
+ * exception: they are read whole so the hot-update client can be spliced
+ * in. */
+static void send_file(Conn *c, const char *head, const char *path) {
+    const char *mime = mime_for(path);
+    int is_page = strncmp(mime, "text/html", 9) == 0;
+
+    char accept[256] = "", variant[1100];
+    const char *send_path = path, *encoding = NULL;
+    header_value(head, "Accept-Encoding", accept, sizeof(accept));
+    static const char *const encodings[][2] = { { "br", ".br" }, { "gzip", ".gz" } };
+    for (int i = 0; i < 2 && !is_page && !encoding; i++) {
+        struct stat vs;
+        snprintf(variant, sizeof(variant), "%s%s", path, encodings[i][1]);
+        if (strstr(accept, encodings[i][0]) && stat(variant, &vs) == 0 && S_ISREG(vs.st_mode)) {
+            send_path = variant;
+            encoding  = encodings[i][0];
+        }
+    }
 
+    int f = open(send_path, O_RDONLY);
+    if (f < 0) { send_404(c); return; }
     struct stat st;
-    fstat(f, &st);
-    size_t size = (size_t)st.st_size;
+    if (fstat(f, &st) != 0 || !S_ISREG(st.st_mode)) { close(f); send_404(c); return; }
+    off_t size = st.st_size;
+
+    /* Rebuilds rewrite files within the same second at the same size, so
+     * the validator takes the inode and the mtime to the nanosecond.  It is
+     * weak (compressed variants share it), which is why If-Range below never
+     * matches it. */
+    char etag[96];
+    snprintf(etag, sizeof(etag), "W/\"%llx-%llx-%llx.%lx\"", (unsigned long long)st.st_ino,
+             (unsigned long long)size, (unsigned long long)st.st_mtime,
+             (unsigned long)ST_MTIME_NSEC(st));
+
+    char inm[256];
+    if (header_value(head, "If-None-Match", inm, sizeof(inm)) &&
+        (strstr(inm, etag) || strcmp(inm, "*") == 0)) {
+        close(f);
+        char extra[128];
+        snprintf(extra, sizeof(extra), "ETag: %s\r\nVary: Accept-Encoding\r\n", etag);
+        send_head(c, 304, mime, 0, extra);
+        return;
+    }
+
+    if (is_page) {
+        static const char hmr_tag[] = "<script src=\"/__forge_hmr.js\"></script>";
+        char *buf = malloc((size_t)size + sizeof(hmr_tag));
+        if (!buf) { close(f); send_404(c); return; }
+        size_t got = 0;
+        while (got < (size_t)size) {
+            ssize_t n = read(f, buf + got, (size_t)size - got);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            got += (size_t)n;
+        }
+        close(f);
+
+        /* Pages get the hot-update client just before </body> */
+        buf[got] = '\0';
+        char *body = strstr(buf, "</body>");
+        size_t at = body ? (size_t)(body - buf) : got;
+        memmove(buf + at + sizeof(hmr_tag) - 1, buf + at, got - at);
+        memcpy(buf + at, hmr_tag, sizeof(hmr_tag) - 1);
+        got += sizeof(hmr_tag) - 1;
+
+        char extra[128];
+        snprintf(extra, sizeof(extra), "ETag: %s\r\n", etag);
+        send_head(c, 200, mime, got, extra);
+        if (!c->head_only) out_append(c, buf, got);
+        free(buf);
+        return;
+    }
+
+    int status = 200;
+    off_t start = 0, end = size - 1;
+    char extra[512], range[128], if_range[8];
+    int n = snprintf(extra, sizeof(extra),
+                     "ETag: %s\r\nAccept-Ranges: bytes\r\nVary: Accept-Encoding\r\n", etag);
+    if (encoding)
+        n += snprintf(extra + n, sizeof(extra) - (size_t)n, "Content-Encoding: %s\r\n", encoding);
 
-    char *buf = malloc(size);
-    if (!buf) { close(f); send_404(fd); return; }
-    read(f, buf, size);
-    close(f);
+    /* If-Range needs a strong match (RFC 9110 13.1.5): with a weak ETag any
+     * If-Range gets the whole file */
+    if (header_value(head, "Range", range, sizeof(range)) &&
+        !header_value(head, "If-Range", if_range, sizeof(if_range))) {
+        int r = parse_range(range, size, &start, &end);
+        if (r < 0) {
+            close(f);
+            snprintf(extra + n, sizeof(extra) - (size_t)n, "Content-Range: bytes */%lld\r\n",
+                     (long long)size);
+            send_head(c, 416, mime, 0, extra);
+            return;
+        }
+        if (r > 0) {
+            status = 206;
+            snprintf(extra + n, sizeof(extra) - (size_t)n, "Content-Range: bytes %lld-%lld/%lld\r\n",
+                     (long long)start, (long long)end, (long long)size);
+        }
+    }
 
-    send_response(fd, 200, mime_for(path), buf, size);
-    free(buf);
+    size_t len = size > 0 ? (size_t)(end - start + 1) : 0;
+    send_head(c, status, mime, len, extra);
+    if (c->head_only || len == 0) { close(f); return; }
+    c->file_fd  = f;
+    c->file_off = start;
+    c->file_end = start + (off_t)len;
 }
 
 /* ─── Hot Reload SSE Endpoint ─────────────────────────────────────────────── */
 
-static int _sse_clients[64];
-static int _sse_count = 0;
-static pthread_mutex_t _sse_mutex = PTHREAD_MUTEX_INITIALIZER;
+/* Events from the watcher thread wait here until the event loop takes
+ * them (sse_deliver) and queues them on each stream like any response, so
+ * a slow tab gets every frame whole.  A byte on the wake pipe rouses the
+ * loop. */
+static char           *_sse_pending     = NULL;
+static size_t          _sse_pending_len = 0;
+static size_t          _sse_pending_cap = 0;
+static pthread_mutex_t _sse_mutex       = PTHREAD_MUTEX_INITIALIZER;
+static int             _wake[2]         = { -1, -1 };
 
-static void send_sse_reload(void) {
-    const char *msg = "data: reload\n\n";
+static void sse_broadcast(const char *msg) {
+    size_t len = strlen(msg);
     pthread_mutex_lock(&_sse_mutex);
-    for (int i = 0; i < _sse_count; i++) {
-        write(_sse_clients[i], msg, strlen(msg));
+    if (_sse_pending_len + len > _sse_pending_cap) {
+        size_t cap = _sse_pending_cap ? _sse_pending_cap : 4096;
+        while (cap < _sse_pending_len + len) cap *= 2;
+        char *grown = realloc(_sse_pending, cap);
+        if (grown) { _sse_pending = grown; _sse_pending_cap = cap; }
+    }
+    if (_sse_pending_len + len <= _sse_pending_cap) {
+        memcpy(_sse_pending + _sse_pending_len, msg, len);
+        _sse_pending_len += len;
     }
     pthread_mutex_unlock(&_sse_mutex);
+    ssize_t n = write(_wake[1], "", 1); /* pipe full: a wakeup is pending anyway */
+    (void)n;
+}
+
+static void send_sse_reload(void) {
+    sse_broadcast("data: reload\n\n");
+}
+
+static const char HMR_CLIENT_JS[] =
+    "(() => {\n"
+    "  const es = globalThis.__forgeEvents = new EventSource('/__forge_sse');\n"
+    "  es.onmessage = (e) => { if (e.data === 'reload') location.reload(); };\n"
+    "  globalThis.__forgeHot = (Old, New) => {\n"
+    "    for (const k of Object.getOwnPropertyNames(New.prototype))\n"
+    "      if (k !== 'constructor')\n"
+    "        Object.defineProperty(Old.prototype, k, Object.getOwnPropertyDescriptor(New.prototype, k));\n"
+    "    const style = document.getElementById(Old.tag.replace(/^forge-/, 'forge-style-'));\n"
+    "    if (style) style.remove();\n"
+    "    for (const el of document.querySelectorAll(Old.tag)) {\n"
+    "      if (!el._mounted) continue;\n"
+    "      const prev = el._state;\n"
+    "      el._initState();\n"
+    "      for (const k in el._state) if (k in prev) el._state[k] = prev[k];\n"
+    "      el.textContent = '';\n"
+    "      el._render();\n"
+    "    }\n"
+    "  };\n"
+    "  es.addEventListener('update', async (e) => {\n"
+    "    const u = JSON.parse(e.data);\n"
+    "    const script = [...document.querySelectorAll('script[src]')]\n"
+    "      .find((s) => s.src.split('?')[0].endsWith('/' + u.file));\n"
+    "    if (!script) { location.reload(); return; }\n"
+    "    try {\n"
+    "      await import(script.src.split('?')[0] + '?t=' + Date.now());\n"
+    "      console.log(`Forge: hot-updated ${u.module}`);\n"
+    "    } catch (err) {\n"
+    "      console.error(err);\n"
+    "      location.reload();\n"
+    "    }\n"
+    "  });\n"
+    "})();\n";
+
+/* --profile: appended to HMR_CLIENT_JS.  Shows the __forgeProf counters of
+ * the page's components, redrawn twice a second, under the phase times of
+ * the last rebuild, which arrive as `stats` events on the client's stream.
+ * Clicking the title folds the panel. */
+static const char HMR_OVERLAY_JS[] =
+    "(() => {\n"
+    "  const box = document.createElement('div');\n"
+    "  box.style.cssText = 'position:fixed;right:8px;bottom:8px;z-index:2147483647;' +\n"
+    "    'font:11px/1.5 ui-monospace,monospace;color:#eee;background:rgba(24,24,28,.92);' +\n"
+    "    'padding:6px 10px;border-radius:6px;max-height:45vh;overflow:auto';\n"
+    "  let open = true, build = '';\n"
+    "  const ms = (v) => v.toFixed(2);\n"
+    "  const draw = () => {\n"
+    "    const p = globalThis.__forgeProf;\n"
+    "    let h = '<b style=\"cursor:pointer\">forge profile</b>';\n"
+    "    if (open) {\n"
+    "      h += build;\n"
+    "      if (!p) h += '<div>no profiled components on this page</div>';\n"
+    "      else {\n"
+    "        const f = p.flush;\n"
+    "        h += `<div>flushes ${f.count} · peak queue ${f.peak} · ${ms(f.ms)} ms</div>` +\n"
+    "          '<table style=\"border-spacing:8px 0\"><tr><th align=left>component</th>' +\n"
+    "          '<th>renders</th><th>refreshes</th><th>updaters</th><th>dom ops</th>' +\n"
+    "          '<th>render ms</th><th>refresh ms</th></tr>';\n"
+    "        for (const c of Object.values(p.components))\n"
+    "          h += `<tr><td>${c.name}</td><td align=right>${c.renders}</td>` +\n"
+    "            `<td align=right>${c.refreshes}</td><td align=right>${c.updaters}</td>` +\n"
+    "            `<td align=right>${c.domOps}</td><td align=right>${ms(c.renderMs)}</td>` +\n"
+    "            `<td align=right>${ms(c.refreshMs)}</td></tr>`;\n"
+    "        h += '</table>';\n"
+    "      }\n"
+    "    }\n"
+    "    box.innerHTML = h;\n"
+    "  };\n"
+    "  box.addEventListener('click', (e) => {\n"
+    "    if (e.target.tagName === 'B') { open = !open; draw(); }\n"
+    "  });\n"
+    "  globalThis.__forgeEvents.addEventListener('stats', (e) => {\n"
+    "    const s = JSON.parse(e.data);\n"
+    "    build = `<div>rebuilt ${s.file}: parse ${ms(s.parse_ms)} · analyze ${ms(s.analyze_ms)}` +\n"
+    "      ` · emit ${ms(s.emit_ms)} · html ${ms(s.html_ms)} · total ${ms(s.total_ms)} ms</div>`;\n"
+    "    draw();\n"
+    "  });\n"
+    "  const start = () => { document.body.appendChild(box); draw(); setInterval(draw, 500); };\n"
+    "  if (document.body) start(); else addEventListener('DOMContentLoaded', start);\n"
+    "})();\n";
+
+/* Tell the browser that `module` (and the pages inlining it) changed */
+static void send_sse_update(const char *module, const char *parents) {
+    char msg[1024];
+    snprintf(msg, sizeof(msg),
+             "event: update\n"
+             "data: {\"module\":\"%s\",\"file\":\"%s.forge.js\",\"parents\":[%s]}\n\n",
+             module, module, parents);
+    sse_broadcast(msg);
+}
+
+/* Rebuild phase times for the --profile overlay */
+enum { RB_PARSE, RB_ANALYZE, RB_EMIT, RB_HTML, RB_COUNT };
+
+static void send_sse_stats(const char *file, const double *ms, double total_ms) {
+    char msg[1024];
+    snprintf(msg, sizeof(msg),
+             "event: stats\n"
+             "data: {\"file\":\"%s\",\"parse_ms\":%.3f,\"analyze_ms\":%.3f,"
+             "\"emit_ms\":%.3f,\"html_ms\":%.3f,\"total_ms\":%.3f}\n\n",
+             file, ms[RB_PARSE], ms[RB_ANALYZE], ms[RB_EMIT], ms[RB_HTML], total_ms);
+    sse_broadcast(msg);
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
 }
 
-static void handle_sse(int fd) {
+static void handle_sse(Conn *c) {
     const char *headers =
         "HTTP/1.1 200 OK\r\n"
         "Content-Type: text/event-stream\r\n"
@@ -114,82 +609,515 @@ static void handle_sse(int fd) {
         "Connection: keep-alive\r\n"
         "\r\n"
         ": connected\n\n";
-    write(fd, headers, strlen(headers));
-
-    pthread_mutex_lock(&_sse_mutex);
-    if (_sse_count < 64) _sse_clients[_sse_count++] = fd;
-    pthread_mutex_unlock(&_sse_mutex);
-    /* Client fd is held open — closed by watcher thread on exit */
+    out_append(c, headers, strlen(headers));
+    c->sse = 1; /* later events queue behind the headers */
 }
 
-/* ─── File Watcher Thread ─────────────────────────────────────────────────── */
+/* ─── Resident Compiler ─────────────────────────────────────────────────────
+ * Every watched .cx file stays parsed and analyzed in memory.  A change
+ * re-compiles only that file, regenerates the prerendered HTML of the
+ * components that inline it (directly or through other components) and the
+ * SSR renderer, then sends one `update` event per changed component.
+ */
 
 typedef struct {
-    char   path[512];
-    time_t mtime;
+    char     path[512];
+    Program *prog;    /* last successful compile, NULL until one succeeds */
+    int      pending; /* changed since the last rebuild */
+    int      fd;      /* kqueue: open descriptor for EVFILT_VNODE, else -1 */
 } WatchEntry;
 
-static WatchEntry _watched[DEV_MAX_WATCH];
-static int        _watch_count = 0;
+/* Grows without limit; only the watcher thread touches it after startup */
+static WatchEntry *_watched     = NULL;
+static int         _watch_count = 0;
+static int         _watch_cap   = 0;
 
-static void watch_add(const char *path) {
-    if (_watch_count >= DEV_MAX_WATCH) return;
-    struct stat st;
-    if (stat(path, &st) != 0) return;
-    strncpy(_watched[_watch_count].path, path, 511);
-    _watched[_watch_count].mtime = st.st_mtime;
-    _watch_count++;
+/* All components, children before parents — the order `forge compile`
+ * expects on its command line, so the last entry is the SSR root */
+static const ComponentNode **_registry      = NULL;
+static int                   _registry_count = 0;
+
+/* Lex → parse → analyze.  The Program owns copies of everything it keeps,
+ * so the source is released before returning.  `ms` (may be NULL) gets
+ * the RB_PARSE and RB_ANALYZE times. */
+static Program *compile_source(const char *path, double *ms) {
+    SourceBuf src;
+    if (source_load(&src, path) != 0) return NULL;
+
+    double t0 = now_ms();
+    Lexer lex;
+    lexer_init(&lex, src.text, path);
+    Parser parser;
+    parser_init(&parser, &lex);
+    Program *prog = parser_parse(&parser);
+    source_release(&src);
+    if (ms) ms[RB_PARSE] = now_ms() - t0;
+
+    if (parser_error_count(&parser) > 0) {
+        fprintf(stderr, "forge: %d parse error(s) in %s\n",
+                parser_error_count(&parser), path);
+        ast_free_program(prog);
+        return NULL;
+    }
+    t0 = now_ms();
+    AnalysisResult ar = analyze_program(prog);
+    if (ms) ms[RB_ANALYZE] = now_ms() - t0;
+    if (ar.error_count > 0) {
+        fprintf(stderr, "forge: %d analysis error(s) in %s\n", ar.error_count, path);
+        ast_free_program(prog);
+        return NULL;
+    }
+    return prog;
+}
+
+static int uses_component(const HtmlNode *n, const char *name) {
+    if (!n) return 0;
+    if (n->kind == HTML_COMPONENT && n->tag && strcmp(n->tag, name) == 0) return 1;
+    for (int i = 0; i < n->child_count; i++)
+        if (uses_component(&n->children[i], name)) return 1;
+    return 0;
+}
+
+static void registry_rebuild(void) {
+    int n = 0;
+    for (int i = 0; i < _watch_count; i++)
+        if (_watched[i].prog) n += _watched[i].prog->component_count;
+
+    const ComponentNode **all = malloc(sizeof(*all) * (size_t)(n + 1));
+    int *placed = calloc((size_t)n + 1, sizeof(int));
+    _registry = realloc(_registry, sizeof(*_registry) * (size_t)(n + 1));
+    n = 0;
+    for (int i = 0; i < _watch_count; i++) {
+        const Program *p = _watched[i].prog;
+        for (int j = 0; p && j < p->component_count; j++)
+            all[n++] = p->components[j];
+    }
+
+    _registry_count = 0;
+    while (_registry_count < n) {
+        int progressed = 0;
+        for (int i = 0; i < n; i++) {
+            if (placed[i]) continue;
+            int ready = 1;
+            for (int j = 0; j < n && ready; j++)
+                if (j != i && !placed[j] && uses_component(all[i]->template_root, all[j]->name))
+                    ready = 0;
+            if (ready) {
+                placed[i] = 1;
+                _registry[_registry_count++] = all[i];
+                progressed = 1;
+            }
+        }
+        if (!progressed) { /* cycle: keep the rest in watch order */
+            for (int i = 0; i < n; i++)
+                if (!placed[i]) { placed[i] = 1; _registry[_registry_count++] = all[i]; }
+        }
+    }
+    free(all);
+    free(placed);
+}
+
+/* .gen.c, .forge.js and .d.ts — the same set `forge compile --no-wasm` writes */
+static int emit_component(const ComponentNode *c) {
+    CodegenOptions cg_opts = { .debug_info = 0, .profile = _profile };
+    BindingOptions b_opts = {
+        .es_modules    = 1,
+        .web_component = 1,
+        .typescript    = 1,
+        .no_wasm       = 1,
+        .prerender     = _prerender,
+        .profile       = _profile,
+    };
+    char path[1024];
+    FILE *f;
+
+    snprintf(path, sizeof(path), "%s/%s.gen.c", _out_dir, c->name);
+    if (!(f = fopen(path, "w"))) return 1;
+    int rc = codegen_component(c, &cg_opts, f);
+    fclose(f);
+
+    snprintf(path, sizeof(path), "%s/%s.forge.js", _out_dir, c->name);
+    if (!(f = fopen(path, "w"))) return 1;
+    binding_gen_component(c, &b_opts, f);
+    fclose(f);
+
+    snprintf(path, sizeof(path), "%s/%s.forge.d.ts", _out_dir, c->name);
+    if (!(f = fopen(path, "w"))) return 1;
+    binding_gen_types(c, f);
+    fclose(f);
+    return rc;
+}
+
+static int same_components(const Program *a, const Program *b) {
+    if (!a || !b || a->component_count != b->component_count) return 0;
+    for (int i = 0; i < a->component_count; i++)
+        if (strcmp(a->components[i]->name, b->components[i]->name) != 0) return 0;
+    return 1;
+}
+
+static void rebuild(WatchEntry *w) {
+    double ms[RB_COUNT] = { 0 };
+    double t_start = now_ms();
+    Program *prog = compile_source(w->path, ms);
+    if (!prog) {
+        printf("forge: \033[31m build failed\033[0m — keeping previous version\n");
+        return;
+    }
+
+    Program *old = w->prog;
+    int hot = same_components(old, prog);
+    w->prog = prog;
+    registry_rebuild();
+
+    mkdir(_out_dir, 0755);
+    int rc = 0;
+    double t0 = now_ms();
+    for (int i = 0; i < prog->component_count; i++)
+        rc |= emit_component(prog->components[i]);
+    ms[RB_EMIT] = now_ms() - t0;
+    t0 = now_ms();
+
+    /* Changed components, then everything that inlines one of them */
+    int *affected = calloc((size_t)_registry_count + 1, sizeof(int));
+    for (int i = 0; i < _registry_count; i++)
+        for (int j = 0; j < prog->component_count; j++)
+            if (_registry[i] == prog->components[j]) affected[i] = 1;
+    for (int grew = 1; grew;) {
+        grew = 0;
+        for (int i = 0; i < _registry_count; i++) {
+            if (affected[i]) continue;
+            for (int j = 0; j < _registry_count && !affected[i]; j++)
+                if (affected[j] && uses_component(_registry[i]->template_root, _registry[j]->name))
+                    affected[i] = grew = 1;
+        }
+    }
+
+    char parents[512] = "";
+    size_t plen = 0;
+    for (int i = 0; i < _registry_count; i++) {
+        int own = 0;
+        for (int j = 0; j < prog->component_count; j++)
+            if (_registry[i] == prog->components[j]) own = 1;
+        if (!affected[i]) continue;
+
+        if (_prerender) {
+            char path[1024];
+            snprintf(path, sizeof(path), "%s/%s.forge.html", _out_dir, _registry[i]->name);
+            FILE *hf = fopen(path, "w");
+            if (hf) {
+                binding_gen_prerender(_registry[i], _registry, _registry_count, hf);
+                fclose(hf);
+            }
+        }
+        if (!own && plen + strlen(_registry[i]->name) + 4 < sizeof(parents))
+            plen += (size_t)snprintf(parents + plen, sizeof(parents) - plen, "%s\"%s\"",
+                                     plen ? "," : "", _registry[i]->name);
+    }
+
+    /* The SSR renderer inlines the whole tree, so any change regenerates it */
+    if (_ssr && _registry_count > 0) {
+        const ComponentNode *root = _registry[_registry_count - 1];
+        BindingOptions ssr_opts = { 0 };
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s.forge.ssr.js", _out_dir, root->name);
+        FILE *sf = fopen(path, "w");
+        if (sf) {
+            binding_gen_ssr_js(root, _registry, _registry_count, &ssr_opts, sf);
+            fclose(sf);
+        }
+    }
+
+    ms[RB_HTML] = now_ms() - t0;
+    free(affected);
+    ast_free_program(old);
+
+    if (rc != 0) {
+        printf("forge: \033[31m build failed\033[0m\n");
+        return;
+    }
+
+    /* Added, removed or renamed components can't be swapped in place */
+    if (!hot) {
+        printf("forge: \033[32m rebuilt\033[0m  — reloading browser\n");
+        send_sse_reload();
+        return;
+    }
+    printf("forge: \033[32m rebuilt\033[0m  — hot-updating");
+    for (int i = 0; i < prog->component_count; i++) {
+        printf(" %s", prog->components[i]->name);
+        send_sse_update(prog->components[i]->name, parents);
+    }
+    printf("\n");
+    send_sse_stats(w->path, ms, now_ms() - t_start);
+}
+
+
+/* ─── File Watcher Thread ───────────────────────────────────────────────────
+ * inotify (Linux) watches every directory under --dir; kqueue (macOS / BSD)
+ * holds an EVFILT_VNODE on every .cx file and directory.  Either way a
+ * directory event re-scans it, which is how new files and folders are
+ * found.  Changes are collected until DEV_DEBOUNCE_MS passes quietly, then
+ * each changed file is rebuilt once.
+ */
+
+static int _fs_fd = -1;
+
+typedef struct {
+    int  wd; /* inotify watch descriptor / kqueue fd */
+    char path[512];
+} DirWatch;
+
+static DirWatch *_dirs      = NULL;
+static int       _dir_count = 0;
+static int       _dir_cap   = 0;
+
+static int has_suffix(const char *s, const char *suffix) {
+    size_t n = strlen(s), m = strlen(suffix);
+    return n >= m && strcmp(s + n - m, suffix) == 0;
+}
+
+static WatchEntry *watch_find(const char *path) {
+    for (int i = 0; i < _watch_count; i++)
+        if (strcmp(_watched[i].path, path) == 0) return &_watched[i];
+    return NULL;
+}
+
+static void fs_watch_file(WatchEntry *w) {
+#if DEV_KQUEUE
+    if (w->fd >= 0) close(w->fd);
+#ifdef O_EVTONLY
+    w->fd = open(w->path, O_EVTONLY);
+#else
+    w->fd = open(w->path, O_RDONLY);
+#endif
+    if (w->fd < 0) return;
+    struct kevent ev;
+    EV_SET(&ev, w->fd, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+           NOTE_WRITE | NOTE_EXTEND | NOTE_ATTRIB | NOTE_DELETE | NOTE_RENAME,
+           0, (void *)(intptr_t)(w - _watched));
+    kevent(_fs_fd, &ev, 1, NULL, 0, NULL);
+#else
+    (void)w; /* inotify reports files through their directory */
+#endif
+}
+
+/* Files found at startup are compiled right away (the registry needs them);
+ * files that appear later are left pending so the watcher builds them. */
+static WatchEntry *watch_add(const char *path, int startup) {
+    if (_watch_count == _watch_cap) {
+        int cap = _watch_cap ? _watch_cap * 2 : 64;
+        WatchEntry *grown = realloc(_watched, sizeof(WatchEntry) * (size_t)cap);
+        if (!grown) return NULL;
+        _watched = grown;
+        _watch_cap = cap;
+    }
+    WatchEntry *w = &_watched[_watch_count++];
+    memset(w, 0, sizeof(*w));
+    w->fd = -1;
+    snprintf(w->path, sizeof(w->path), "%s", path);
+    if (startup) w->prog = compile_source(w->path, NULL);
+    else         w->pending = 1;
+    fs_watch_file(w);
+    return w;
+}
+
+static int dir_watched(const char *path) {
+    for (int i = 0; i < _dir_count; i++)
+        if (strcmp(_dirs[i].path, path) == 0) return 1;
+    return 0;
+}
+
+static void fs_watch_dir(const char *path) {
+    if (_dir_count == _dir_cap) {
+        int cap = _dir_cap ? _dir_cap * 2 : 32;
+        DirWatch *grown = realloc(_dirs, sizeof(DirWatch) * (size_t)cap);
+        if (!grown) return;
+        _dirs = grown;
+        _dir_cap = cap;
+    }
+    DirWatch *d = &_dirs[_dir_count];
+    snprintf(d->path, sizeof(d->path), "%s", path);
+#if DEV_EPOLL
+    d->wd = inotify_add_watch(_fs_fd, path,
+                              IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY);
+    if (d->wd < 0) return;
+#else
+#ifdef O_EVTONLY
+    d->wd = open(path, O_EVTONLY);
+#else
+    d->wd = open(path, O_RDONLY);
+#endif
+    if (d->wd < 0) return;
+    struct kevent ev;
+    EV_SET(&ev, d->wd, EVFILT_VNODE, EV_ADD | EV_CLEAR, NOTE_WRITE, 0,
+           (void *)(intptr_t)-(_dir_count + 1)); /* negative: a directory */
+    kevent(_fs_fd, &ev, 1, NULL, 0, NULL);
+#endif
+    _dir_count++;
+}
+
+/* Watch `dir` and pick up every .cx file below it */
+static void scan_dir(const char *dir, int startup) {
+    if (!dir_watched(dir)) fs_watch_dir(dir);
+
+    DIR *d = opendir(dir);
+    if (!d) return;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        /* Hidden folders (.git, .forge-cache) and node_modules never hold
+         * sources worth watching */
+        if (e->d_name[0] == '.' || strcmp(e->d_name, "node_modules") == 0) continue;
+        char path[1024];
+        size_t dl = strlen(dir);
+        snprintf(path, sizeof(path), "%s%s%s", dir, dl && dir[dl - 1] == '/' ? "" : "/",
+                 e->d_name);
+        struct stat st;
+        if (stat(path, &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) {
+            scan_dir(path, startup);
+        } else if (S_ISREG(st.st_mode) && has_suffix(path, ".cx") && !watch_find(path)) {
+            watch_add(path, startup);
+        }
+    }
+    closedir(d);
+}
+
+/* Wait up to timeout_ms for file events and mark the changed (or new)
+ * entries pending.  Returns 0 if nothing happened. */
+static int fs_wait(int timeout_ms) {
+    struct pollfd pfd = { .fd = _fs_fd, .events = POLLIN };
+    if (poll(&pfd, 1, timeout_ms) <= 0) return 0;
+
+#if DEV_EPOLL
+    char buf[16384] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t n = read(_fs_fd, buf, sizeof(buf));
+    for (char *p = buf; n > 0 && p < buf + n;) {
+        struct inotify_event *ev = (struct inotify_event *)p;
+        p += sizeof(*ev) + ev->len;
+        const char *dir = NULL;
+        for (int i = 0; i < _dir_count && !dir; i++)
+            if (_dirs[i].wd == ev->wd) dir = _dirs[i].path;
+        if (!dir || ev->len == 0) continue;
+
+        char path[1024];
+        size_t dl = strlen(dir);
+        snprintf(path, sizeof(path), "%s%s%s", dir, dl && dir[dl - 1] == '/' ? "" : "/",
+                 ev->name);
+        if (ev->mask & IN_ISDIR) {
+            if (ev->name[0] != '.' && !dir_watched(path)) scan_dir(path, 0);
+        } else if (has_suffix(path, ".cx")) {
+            WatchEntry *w = watch_find(path);
+            if (w) w->pending = 1;
+            else if (access(path, R_OK) == 0) watch_add(path, 0);
+        }
+    }
+#else
+    struct kevent evs[64];
+    struct timespec zero = { 0, 0 };
+    int n = kevent(_fs_fd, NULL, 0, evs, 64, &zero);
+    for (int i = 0; i < n; i++) {
+        intptr_t id = (intptr_t)evs[i].udata;
+        if (id < 0) {
+            scan_dir(_dirs[-id - 1].path, 0); /* entry added or removed */
+        } else if (id < _watch_count) {
+            WatchEntry *w = &_watched[id];
+            w->pending = 1;
+            /* Atomic saves replace the file: follow the new inode */
+            if (evs[i].fflags & (NOTE_DELETE | NOTE_RENAME)) fs_watch_file(w);
+        }
+    }
+#endif
+    return 1;
 }
 
 static void *watcher_thread(void *arg) {
     (void)arg;
-    printf("forge: watching %d files for changes...\n", _watch_count);
+    printf("forge: watching %d files in %d directories for changes...\n",
+           _watch_count, _dir_count);
 
     while (_running) {
-        sleep(1);
+        if (!fs_wait(1000)) continue;
+
+        /* Let the burst of events from one save settle */
+        while (fs_wait(DEV_DEBOUNCE_MS)) {}
+
+        /* A new file has no previous version, so rebuild() reloads for it */
         for (int i = 0; i < _watch_count; i++) {
-            struct stat st;
-            if (stat(_watched[i].path, &st) != 0) continue;
-            if (st.st_mtime != _watched[i].mtime) {
-                _watched[i].mtime = st.st_mtime;
-                printf("forge: \033[33m changed:\033[0m %s — recompiling...\n",
-                       _watched[i].path);
-
-                /* Re-compile the changed file */
-                char cmd[1024];
-                snprintf(cmd, sizeof(cmd),
-                         "%s compile --no-wasm -o dist %s",
-                         _forge_bin, _watched[i].path);
-                int rc = system(cmd);
-                if (rc == 0) {
-                    printf("forge: \033[32m rebuilt\033[0m  — notifying browser\n");
-                    send_sse_reload();
-                } else {
-                    printf("forge: \033[31m build failed\033[0m\n");
-                }
-            }
+            if (!_watched[i].pending) continue;
+            _watched[i].pending = 0;
+            printf("forge: \033[33m changed:\033[0m %s — recompiling...\n",
+                   _watched[i].path);
+            rebuild(&_watched[i]);
         }
+        fflush(stdout);
     }
     return NULL;
 }
 
+static int fs_watch_init(void) {
+#if DEV_EPOLL
+    _fs_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#else
+    /* One descriptor per watched file: lift the soft limit (256 on macOS)
+     * to the hard one */
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+        rl.rlim_cur = rl.rlim_max;
+#ifdef OPEN_MAX
+        if (rl.rlim_cur > OPEN_MAX) rl.rlim_cur = OPEN_MAX;
+#endif
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+    _fs_fd = kqueue();
+#endif
+    return _fs_fd;
+}
+
 /* ─── Request Handler ─────────────────────────────────────────────────────── */
 
-static void handle_request(int fd) {
-    char buf[DEV_BUF_SIZE];
-    ssize_t n = read(fd, buf, sizeof(buf) - 1);
-    if (n <= 0) { close(fd); return; }
-    buf[n] = '\0';
+/* Route one complete request head to a response in c->out */
+static void handle_request(Conn *c, char *head) {
+    /* Parse method, path and version */
+    char method[8], path[512], version[16] = "HTTP/1.0";
+    if (sscanf(head, "%7s %511s %15s", method, path, version) < 2) {
+        c->keep_alive = 0;
+        send_404(c);
+        return;
+    }
+
+    /* HTTP/1.1 keeps the connection unless told otherwise; 1.0 the reverse */
+    char conn_hdr[32] = "";
+    header_value(head, "Connection", conn_hdr, sizeof(conn_hdr));
+    if (strcmp(version, "HTTP/1.1") == 0)
+        c->keep_alive = strcasecmp(conn_hdr, "close") != 0;
+    else
+        c->keep_alive = strcasecmp(conn_hdr, "keep-alive") == 0;
 
-    /* Parse method and path */
-    char method[8], path[512];
-    sscanf(buf, "%7s %511s", method, path);
+    c->head_only = strcmp(method, "HEAD") == 0;
+    if (strcmp(method, "GET") != 0 && !c->head_only) { send_404(c); return; }
 
-    if (strcmp(method, "GET") != 0) { send_404(fd); close(fd); return; }
+    /* Cache-busting queries (?t=… from hot updates) name the same file */
+    path[strcspn(path, "?#")] = '\0';
 
     /* SSE endpoint for hot reload */
     if (strcmp(path, "/__forge_sse") == 0) {
-        handle_sse(fd); /* fd kept open */
+        handle_sse(c); /* fd kept open */
+        return;
+    }
+
+    /* Hot-update client injected into pages */
+    if (strcmp(path, "/__forge_hmr.js") == 0) {
+        if (!_profile) {
+            send_response(c, 200, "application/javascript", HMR_CLIENT_JS,
+                          sizeof(HMR_CLIENT_JS) - 1);
+            return;
+        }
+        send_head(c, 200, "application/javascript",
+                  sizeof(HMR_CLIENT_JS) - 1 + sizeof(HMR_OVERLAY_JS) - 1, NULL);
+        if (!c->head_only) {
+            out_append(c, HMR_CLIENT_JS, sizeof(HMR_CLIENT_JS) - 1);
+            out_append(c, HMR_OVERLAY_JS, sizeof(HMR_OVERLAY_JS) - 1);
+        }
         return;
     }
 
@@ -201,7 +1129,7 @@ static void handle_request(int fd) {
     snprintf(full_path, sizeof(full_path), "%s%s", _dir, path + 1);
 
     /* Security: prevent path traversal */
-    if (strstr(full_path, "..")) { send_404(fd); close(fd); return; }
+    if (strstr(full_path, "..")) { send_404(c); return; }
 
     /* SPA fallback — serve index.html for routes that have no file extension */
     {
@@ -211,12 +1139,157 @@ static void handle_request(int fd) {
         }
     }
 
-    send_file(fd, full_path);
-    close(fd);
+    send_file(c, head, full_path);
 }
 
 /* ─── Main Server Loop ────────────────────────────────────────────────────── */
 
+static void conn_close(Conn *c) {
+    if (c->file_fd >= 0) close(c->file_fd);
+    loop_forget(c->fd);
+    close(c->fd);
+    _conns[c->fd] = NULL;
+    free(c->out);
+    free(c);
+}
+
+/* Write queued output; returns 0 if the connection is still open */
+static int conn_flush(Conn *c) {
+    while (c->out_off < c->out_len) {
+        ssize_t n = write(c->fd, c->out + c->out_off, c->out_len - c->out_off);
+        if (n > 0) { c->out_off += (size_t)n; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno == EAGAIN) {
+            if (!c->want_write) { c->want_write = 1; loop_watch(c->fd, !c->read_paused, 1, 1); }
+            return 0;
+        }
+        conn_close(c);
+        return -1;
+    }
+    c->out_off = c->out_len = 0;
+
+    /* Then the file body, if this response has one */
+    while (c->file_fd >= 0 && c->file_off < c->file_end) {
+        ssize_t n = file_send(c->fd, c->file_fd, c->file_off,
+                              (size_t)(c->file_end - c->file_off));
+        if (n > 0) { c->file_off += n; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno == EAGAIN) {
+            if (!c->want_write) { c->want_write = 1; loop_watch(c->fd, !c->read_paused, 1, 1); }
+            return 0;
+        }
+        conn_close(c); /* error, or the file shrank under us */
+        return -1;
+    }
+    if (c->file_fd >= 0) { close(c->file_fd); c->file_fd = -1; }
+
+    if (c->want_write) { c->want_write = 0; loop_watch(c->fd, !c->read_paused, 0, 1); }
+    if (!c->keep_alive && !c->sse) { conn_close(c); return -1; }
+    return 0;
+}
+
+static char *find_head_end(char *buf, size_t len) {
+    for (size_t i = 0; i + 3 < len; i++)
+        if (buf[i] == '\r' && buf[i + 1] == '\n' && buf[i + 2] == '\r' && buf[i + 3] == '\n')
+            return buf + i;
+    return NULL;
+}
+
+/* Answer every complete request buffered so far.  Stops behind a streamed
+ * file body, since later responses must not overtake it. */
+static void conn_process(Conn *c) {
+    for (;;) {
+        while (c->keep_alive && !c->sse && c->file_fd < 0) {
+            char *end = find_head_end(c->in, c->in_len);
+            if (!end) {
+                if (c->in_len == sizeof(c->in)) {
+                    c->keep_alive = 0;
+                    send_response(c, 431, "text/plain", "Request header too large", 24);
+                }
+                break;
+            }
+            *end = '\0';
+            size_t used = (size_t)(end - c->in) + 4;
+
+            /* Skip a request body; nothing here reads one */
+            char len_hdr[32];
+            if (header_value(c->in, "Content-Length", len_hdr, sizeof(len_hdr))) {
+                size_t body = (size_t)strtoul(len_hdr, NULL, 10);
+                if (used + body > c->in_len) {
+                    c->keep_alive = 0; /* not buffered: reply, then drop it */
+                    body = c->in_len - used;
+                }
+                used += body;
+            }
+
+            handle_request(c, c->in);
+            memmove(c->in, c->in + used, c->in_len - used);
+            c->in_len -= used;
+        }
+        if (conn_flush(c) != 0) return; /* closed */
+        /* A file body just finished: pick up the requests queued behind it */
+        if (c->file_fd >= 0 || !c->keep_alive || c->sse ||
+            !find_head_end(c->in, c->in_len)) return;
+    }
+}
+
+/* Stop reading while `in` is full and nothing can consume it (a file body
+ * is still going out): the data stays readable, and level-triggered
+ * readiness would spin.  Reads resume once processing frees room. */
+static void conn_pace_reads(Conn *c) {
+    int full = c->in_len == sizeof(c->in);
+    if (full == c->read_paused) return;
+    c->read_paused = full;
+    loop_watch(c->fd, !full, c->want_write, 1);
+}
+
+/* Hand the watcher's pending events to every stream */
+static void sse_deliver(void) {
+    char drain[64];
+    while (read(_wake[0], drain, sizeof(drain)) > 0) {}
+
+    pthread_mutex_lock(&_sse_mutex);
+    char  *msg = _sse_pending;
+    size_t len = _sse_pending_len;
+    _sse_pending = NULL;
+    _sse_pending_len = _sse_pending_cap = 0;
+    pthread_mutex_unlock(&_sse_mutex);
+    if (!len) { free(msg); return; }
+
+    for (int fd = 0; fd < _conn_cap; fd++) {
+        Conn *c = _conns[fd];
+        if (!c || !c->sse) continue;
+        /* A tab this far behind is stalled; EventSource reconnects it */
+        if (c->out_len - c->out_off + len > DEV_SSE_BACKLOG ||
+            out_append(c, msg, len) != 0) {
+            conn_close(c);
+            continue;
+        }
+        conn_flush(c);
+    }
+    free(msg);
+}
+
+/* Read what has arrived and answer every complete request in it */
+static void conn_readable(Conn *c) {
+    for (;;) {
+        if (c->in_len == sizeof(c->in)) break;
+        ssize_t n = read(c->fd, c->in + c->in_len, sizeof(c->in) - c->in_len);
+        if (n > 0) { c->in_len += (size_t)n; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno == EAGAIN) break;
+        conn_close(c); /* EOF or error */
+        return;
+    }
+    c->last_active = time(NULL);
+
+    /* An SSE stream only reads to notice the tab closing */
+    if (c->sse) { c->in_len = 0; return; }
+    int fd = c->fd;
+    conn_process(c);
+    if ((c = conn_get(fd))) conn_pace_reads(c);
+}
+
 static void on_signal(int sig) { (void)sig; _running = 0; }
 
 int main(int argc, char **argv) {
@@ -229,27 +1302,48 @@ int main(int argc, char **argv) {
             /* ensure trailing slash */
             size_t l = strlen(_dir);
             if (_dir[l-1] != '/') { _dir[l] = '/'; _dir[l+1] = '\0'; }
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            strncpy(_out_dir, argv[++i], sizeof(_out_dir) - 1);
+        } else if (strcmp(argv[i], "--prerender") == 0) {
+            _prerender = 1;
+        } else if (strcmp(argv[i], "--ssr") == 0) {
+            _ssr = 1;
+        } else if (strcmp(argv[i], "--profile") == 0) {
+            _profile = 1;
         } else if (strcmp(argv[i], "--forge") == 0 && i + 1 < argc) {
-            strncpy(_forge_bin, argv[++i], sizeof(_forge_bin) - 1);
+            i++; /* compiler is linked in; flag accepted for old scripts */
         }
     }
 
     /* Watch all .cx files in dir */
-    char find_cmd[512];
-    snprintf(find_cmd, sizeof(find_cmd), "find %s -name '*.cx' 2>/dev/null", _dir);
-    FILE *fp = popen(find_cmd, "r");
-    if (fp) {
-        char line[512];
-        while (fgets(line, sizeof(line), fp)) {
-            line[strcspn(line, "\n")] = '\0';
-            watch_add(line);
-        }
-        pclose(fp);
+    if (fs_watch_init() < 0) {
+        fprintf(stderr, "forge dev: cannot start file watcher\n");
+        return 1;
     }
+    scan_dir(_dir, 1);
+    registry_rebuild();
+    printf("forge: %d components loaded\n", _registry_count);
 
-    /* Start watcher thread */
-    signal(SIGINT,  on_signal);
-    signal(SIGTERM, on_signal);
+    /* Outputs on disk may predate --profile; instrument them now */
+    if (_profile) {
+        mkdir(_out_dir, 0755);
+        for (int i = 0; i < _registry_count; i++)
+            emit_component(_registry[i]);
+    }
+
+    /* Start watcher thread.  No SA_RESTART, so a signal wakes loop_wait. */
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT,  &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN); /* a closed tab must not kill the server */
+    if (pipe(_wake) != 0) {
+        fprintf(stderr, "forge dev: cannot create wake pipe\n");
+        return 1;
+    }
+    set_nonblocking(_wake[0]);
+    set_nonblocking(_wake[1]);
     pthread_t wt;
     pthread_create(&wt, NULL, watcher_thread, NULL);
 
@@ -259,6 +1353,7 @@ int main(int argc, char **argv) {
     setsockopt(srv, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
 
     struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
     addr.sin_family      = AF_INET;
     addr.sin_port        = htons((uint16_t)_port);
     addr.sin_addr.s_addr = INADDR_ANY;
@@ -268,16 +1363,64 @@ int main(int argc, char **argv) {
         return 1;
     }
     listen(srv, DEV_BACKLOG);
+    set_nonblocking(srv);
+
+    if (loop_init() < 0) {
+        fprintf(stderr, "forge dev: cannot create event loop\n");
+        return 1;
+    }
+    loop_watch(srv, 1, 0, 0);
+    loop_watch(_wake[0], 1, 0, 0);
 
     printf("\n\033[32m  Forge Dev Server\033[0m  v0.1.0\n");
     printf("  \033[36mLocal:\033[0m   http://localhost:%d\n", _port);
     printf("  \033[36mServing:\033[0m %s\n\n", _dir);
     printf("  Press Ctrl+C to stop\n\n");
+    fflush(stdout);
 
+    LoopEvent events[DEV_MAX_EVENTS];
+    time_t last_sweep = time(NULL);
     while (_running) {
-        int client = accept(srv, NULL, NULL);
-        if (client < 0) continue;
-        handle_request(client);
+        int n = loop_wait(events, DEV_MAX_EVENTS, 1000);
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].fd;
+            if (fd == srv) {
+                /* Drain the accept queue */
+                int client;
+                while ((client = accept(srv, NULL, NULL)) >= 0) {
+                    set_nonblocking(client);
+                    if (!conn_new(client)) { close(client); continue; }
+                    loop_watch(client, 1, 0, 0);
+                }
+                continue;
+            }
+            if (fd == _wake[0]) { sse_deliver(); continue; }
+            Conn *c = conn_get(fd);
+            if (!c) continue;
+            if (events[i].hangup) { conn_close(c); continue; }
+            if (events[i].writable) {
+                if (conn_flush(c) != 0) continue;
+                /* Requests pipelined behind a finished file body */
+                if (c->file_fd < 0 && c->in_len) {
+                    conn_process(c);
+                    if (!conn_get(fd)) continue;
+                    conn_pace_reads(c);
+                }
+            }
+            if (events[i].readable) conn_readable(c);
+        }
+
+        /* Close keep-alive connections that went quiet */
+        time_t now = time(NULL);
+        if (now != last_sweep) {
+            last_sweep = now;
+            for (int fd = 0; fd < _conn_cap; fd++) {
+                Conn *c = _conns[fd];
+                if (c && !c->sse && c->out_len == 0 && c->file_fd < 0 &&
+                    now - c->last_active > DEV_KEEPALIVE_SECS)
+                    conn_close(c);
+            }
+        }
     }
 
     close(srv);